@@ -0,0 +1,33 @@
+'use strict';
+const common = require('../common.js');
+
+// Throughput of the bulk base64 and hex codecs, from sizes that barely fill a
+// single vector block up to sizes that are bound by memory bandwidth.
+const bench = common.createBenchmark(main, {
+  encoding: ['base64', 'hex'],
+  type: ['encode', 'decode'],
+  size: [16, 256, 4096, 65536, 1 << 20, 16 << 20],
+  n: [256 << 20]
+});
+
+function main({ encoding, type, size, n }) {
+  // `n` is the number of input bytes to process in total.
+  const iterations = Math.ceil(n / size);
+  const buf = Buffer.allocUnsafe(size);
+  for (var i = 0; i < size; i++)
+    buf[i] = (i * 31) & 0xff;
+  const str = buf.toString(encoding);
+
+  if (type === 'encode') {
+    bench.start();
+    for (i = 0; i < iterations; i++)
+      buf.toString(encoding);
+    bench.end(iterations);
+  } else {
+    const out = Buffer.allocUnsafe(size);
+    bench.start();
+    for (i = 0; i < iterations; i++)
+      out.write(str, encoding);
+    bench.end(iterations);
+  }
+}
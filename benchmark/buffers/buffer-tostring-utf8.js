@@ -0,0 +1,40 @@
+'use strict';
+
+const common = require('../common.js');
+const { TextDecoder } = require('util');
+
+const bench = common.createBenchmark(main, {
+  content: ['ascii', 'latin1', 'json', 'cjk'],
+  method: ['toString', 'TextDecoder'],
+  len: [16, 1024, 65536],
+  n: [1e5]
+});
+
+const samples = {
+  ascii: 'hello world ',
+  latin1: 'caf\u00e9 cr\u00e8me ',
+  json: '{"id":42,"name":"J\u00fcrgen","tags":["\u20ac","x"]}',
+  cjk: '\u6587\u5b57\u5316\u3051 '
+};
+
+function main({ content, method, len, n }) {
+  const sample = samples[content];
+  const buf = Buffer.from(sample.repeat(Math.ceil(len / sample.length)))
+    .slice(0, len);
+  // Cut at a character boundary so that the input stays well-formed.
+  const input = Buffer.from(buf.toString().replace(/\ufffd+$/, ''));
+
+  var i;
+  if (method === 'TextDecoder') {
+    const decoder = new TextDecoder();
+    bench.start();
+    for (i = 0; i < n; i++)
+      decoder.decode(input);
+    bench.end(n);
+  } else {
+    bench.start();
+    for (i = 0; i < n; i++)
+      input.toString('utf8');
+    bench.end(n);
+  }
+}
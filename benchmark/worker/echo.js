@@ -4,7 +4,7 @@ const common = require('../common.js');
 const path = require('path');
 const bench = common.createBenchmark(main, {
   workers: [1],
-  payload: ['string', 'object'],
+  payload: ['string', 'object', 'number', 'arraybuffer'],
   sendsPerBroadcast: [1, 10],
   n: [1e5]
 });
@@ -30,6 +30,12 @@ function main(conf) {
     case 'object':
       payload = { action: 'pewpewpew', powerLevel: 9001 };
       break;
+    case 'number':
+      payload = 9001;
+      break;
+    case 'arraybuffer':
+      payload = new ArrayBuffer(1024 * 1024);
+      break;
     default:
       throw new Error('Unsupported payload type');
   }
@@ -0,0 +1,25 @@
+'use strict';
+const common = require('../common.js');
+const zlib = require('zlib');
+
+// Compresses the same small payload over and over again, as a server does for
+// static responses, with and without the compression cache.
+const bench = common.createBenchmark(main, {
+  algorithm: ['gzip', 'brotli'],
+  cache: ['true', 'false'],
+  inputLen: [1024, 64 * 1024],
+  n: [1e3]
+});
+
+function main({ n, algorithm, cache, inputLen }) {
+  const input = Buffer.from(
+    JSON.stringify({ key: 'value', list: [1, 2, 3] }).repeat(inputLen / 32)
+  ).slice(0, inputLen);
+  const options = { cache: cache === 'true' };
+  const fn = algorithm === 'gzip' ? zlib.gzipSync : zlib.brotliCompressSync;
+
+  bench.start();
+  for (let i = 0; i < n; ++i)
+    fn(input, options);
+  bench.end(n);
+}
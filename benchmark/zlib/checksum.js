@@ -0,0 +1,35 @@
+'use strict';
+const common = require('../common.js');
+const zlib = require('zlib');
+
+// Compressing with level 0 only stores the input, so the time is mostly spent
+// computing the CRC-32 (gzip) or Adler-32 (deflate) checksum of it, both when
+// compressing and when decompressing.
+const bench = common.createBenchmark(main, {
+  format: ['gzip', 'deflate'],
+  operation: ['compress', 'decompress'],
+  inputLen: [64 * 1024, 1024 * 1024],
+  n: [1e3]
+});
+
+function main({ n, format, operation, inputLen }) {
+  const input = Buffer.alloc(inputLen);
+  for (let i = 0; i < inputLen; i++)
+    input[i] = i * 7 % 251;
+
+  const compress = format === 'gzip' ? zlib.gzipSync : zlib.deflateSync;
+  const decompress = format === 'gzip' ? zlib.gunzipSync : zlib.inflateSync;
+  const options = { level: 0 };
+  const compressed = compress(input, options);
+
+  bench.start();
+  if (operation === 'compress') {
+    for (let i = 0; i < n; ++i)
+      compress(input, options);
+  } else {
+    for (let i = 0; i < n; ++i)
+      decompress(compressed);
+  }
+  // Give result in GBit/s, like the net benchmarks do
+  bench.end(n * inputLen * 8 / (1024 ** 3));
+}
@@ -0,0 +1,28 @@
+'use strict';
+const common = require('../common.js');
+const fs = require('fs');
+const zlib = require('zlib');
+
+const bench = common.createBenchmark(main, {
+  parallel: [0, 2, 4],
+  inputLen: [16 * 1024 * 1024],
+  n: [10]
+});
+
+function main({ n, parallel, inputLen }) {
+  const input = Buffer.alloc(inputLen, fs.readFileSync(__filename));
+  const options = parallel > 0 ? { parallel } : {};
+
+  let i = 0;
+  bench.start();
+  (function next() {
+    zlib.gzip(input, options, (err) => {
+      if (err)
+        throw err;
+      if (++i < n)
+        return next();
+      // Give result in GBit/s, like the net benchmarks do
+      bench.end(n * inputLen * 8 / (1024 ** 3));
+    });
+  })();
+}
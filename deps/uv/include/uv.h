@@ -233,6 +233,7 @@ typedef struct uv_work_s uv_work_t;
 typedef struct uv_cpu_info_s uv_cpu_info_t;
 typedef struct uv_interface_address_s uv_interface_address_t;
 typedef struct uv_dirent_s uv_dirent_t;
+typedef struct uv_dir_s uv_dir_t;
 typedef struct uv_passwd_s uv_passwd_t;
 typedef struct uv_utsname_s uv_utsname_t;
 
@@ -544,12 +545,22 @@ UV_EXTERN int uv_tcp_simultaneous_accepts(uv_tcp_t* handle, int enable);
 
 enum uv_tcp_flags {
   /* Used with uv_tcp_bind, when an IPv6 address is used. */
-  UV_TCP_IPV6ONLY = 1
+  UV_TCP_IPV6ONLY = 1,
+
+  /*
+   * Used with uv_tcp_bind, lets several sockets (e.g. one per thread or
+   * process) bind to the same address. The kernel load balances incoming
+   * connections between them. Only supported where the kernel balances,
+   * i.e. Linux, FreeBSD and DragonFly BSD.
+   */
+  UV_TCP_REUSEPORT = 2
 };
 
 UV_EXTERN int uv_tcp_bind(uv_tcp_t* handle,
                           const struct sockaddr* addr,
                           unsigned int flags);
+UV_EXTERN int uv_tcp_reuseport_steer_cpu(uv_tcp_t* handle,
+                                         unsigned int group_size);
 UV_EXTERN int uv_tcp_getsockname(const uv_tcp_t* handle,
                                  struct sockaddr* name,
                                  int* namelen);
@@ -590,7 +601,23 @@ enum uv_udp_flags {
    * (provided they all set the flag) but only the last one to bind will receive
    * any traffic, in effect "stealing" the port from the previous listener.
    */
-  UV_UDP_REUSEADDR = 4
+  UV_UDP_REUSEADDR = 4,
+  /*
+   * Indicates that the message was received by recvmmsg, so the buffer provided
+   * must not be freed by the recv_cb callback. Used in uv_udp_recv_cb.
+   */
+  UV_UDP_MMSG_CHUNK = 8,
+  /*
+   * Indicates that recvmmsg should be used, if available. Passed to
+   * uv_udp_init_ex().
+   */
+  UV_UDP_RECVMMSG = 256,
+  /*
+   * Indicates that uv_udp_try_send_batch() may coalesce datagrams of equal
+   * size into a single UDP generic segmentation offload (GSO) send, if
+   * available.
+   */
+  UV_UDP_SEGMENT = 512
 };
 
 typedef void (*uv_udp_send_cb)(uv_udp_send_t* req, int status);
@@ -658,12 +685,18 @@ UV_EXTERN int uv_udp_try_send(uv_udp_t* handle,
                               const uv_buf_t bufs[],
                               unsigned int nbufs,
                               const struct sockaddr* addr);
+UV_EXTERN int uv_udp_try_send_batch(uv_udp_t* handle,
+                                    const uv_buf_t bufs[],
+                                    unsigned int nbufs,
+                                    const struct sockaddr* addr,
+                                    unsigned int flags);
 UV_EXTERN int uv_udp_recv_start(uv_udp_t* handle,
                                 uv_alloc_cb alloc_cb,
                                 uv_udp_recv_cb recv_cb);
 UV_EXTERN int uv_udp_recv_stop(uv_udp_t* handle);
 UV_EXTERN size_t uv_udp_get_send_queue_size(const uv_udp_t* handle);
 UV_EXTERN size_t uv_udp_get_send_queue_count(const uv_udp_t* handle);
+UV_EXTERN int uv_udp_using_recvmmsg(const uv_udp_t* handle);
 
 
 /*
@@ -807,7 +840,21 @@ struct uv_timer_s {
   UV_TIMER_PRIVATE_FIELDS
 };
 
+/*
+ * uv_timer_init_ex() flags.
+ */
+enum uv_timer_flags {
+  /*
+   * Let the timer fire up to 1/8th of its timeout late in exchange for O(1)
+   * start and stop. Meant for large numbers of idle/keep-alive timeouts.
+   */
+  UV_TIMER_COARSE = 1
+};
+
 UV_EXTERN int uv_timer_init(uv_loop_t*, uv_timer_t* handle);
+UV_EXTERN int uv_timer_init_ex(uv_loop_t*,
+                               uv_timer_t* handle,
+                               unsigned int flags);
 UV_EXTERN int uv_timer_start(uv_timer_t* handle,
                              uv_timer_cb cb,
                              uint64_t timeout,
@@ -1015,10 +1062,29 @@ struct uv_work_s {
   UV_WORK_PRIVATE_FIELDS
 };
 
+/*
+ * Scheduling class of threadpool work. Fast I/O is picked up before
+ * CPU-bound work, which is picked up before slow I/O. No more than half of
+ * the threads run slow I/O at any time.
+ */
+typedef enum {
+  UV_WORK_CPU,
+  UV_WORK_FAST_IO,
+  UV_WORK_SLOW_IO
+} uv_work_kind;
+
 UV_EXTERN int uv_queue_work(uv_loop_t* loop,
                             uv_work_t* req,
                             uv_work_cb work_cb,
                             uv_after_work_cb after_work_cb);
+UV_EXTERN int uv_queue_work_ex(uv_loop_t* loop,
+                               uv_work_t* req,
+                               uv_work_kind kind,
+                               uv_work_cb work_cb,
+                               uv_after_work_cb after_work_cb);
+
+UV_EXTERN int uv_threadpool_resize(unsigned int size);
+UV_EXTERN unsigned int uv_threadpool_size(void);
 
 UV_EXTERN int uv_cancel(uv_req_t* req);
 
@@ -1196,9 +1262,19 @@ typedef enum {
   UV_FS_FCHOWN,
   UV_FS_REALPATH,
   UV_FS_COPYFILE,
-  UV_FS_LCHOWN
+  UV_FS_LCHOWN,
+  UV_FS_OPENDIR,
+  UV_FS_READDIR,
+  UV_FS_CLOSEDIR
 } uv_fs_type;
 
+struct uv_dir_s {
+  uv_dirent_t* dirents;
+  size_t nentries;
+  void* reserved[4];
+  UV_DIR_PRIVATE_FIELDS
+};
+
 /* uv_fs_t is a subclass of uv_req_t. */
 struct uv_fs_s {
   UV_REQ_FIELDS
@@ -1291,6 +1367,18 @@ UV_EXTERN int uv_fs_scandir(uv_loop_t* loop,
                             uv_fs_cb cb);
 UV_EXTERN int uv_fs_scandir_next(uv_fs_t* req,
                                  uv_dirent_t* ent);
+UV_EXTERN int uv_fs_opendir(uv_loop_t* loop,
+                            uv_fs_t* req,
+                            const char* path,
+                            uv_fs_cb cb);
+UV_EXTERN int uv_fs_readdir(uv_loop_t* loop,
+                            uv_fs_t* req,
+                            uv_dir_t* dir,
+                            uv_fs_cb cb);
+UV_EXTERN int uv_fs_closedir(uv_loop_t* loop,
+                             uv_fs_t* req,
+                             uv_dir_t* dir,
+                             uv_fs_cb cb);
 UV_EXTERN int uv_fs_stat(uv_loop_t* loop,
                          uv_fs_t* req,
                          const char* path,
@@ -1657,6 +1745,7 @@ UV_EXTERN void uv_loop_set_data(uv_loop_t*, void* data);
 #undef UV_FS_REQ_PRIVATE_FIELDS
 #undef UV_WORK_PRIVATE_FIELDS
 #undef UV_FS_EVENT_PRIVATE_FIELDS
+#undef UV_DIR_PRIVATE_FIELDS
 #undef UV_SIGNAL_PRIVATE_FIELDS
 #undef UV_LOOP_PRIVATE_FIELDS
 #undef UV_LOOP_PRIVATE_PLATFORM_FIELDS
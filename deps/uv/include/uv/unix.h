@@ -239,6 +239,7 @@ typedef struct {
     unsigned int nelts;                                                       \
   } timer_heap;                                                               \
   uint64_t timer_counter;                                                     \
+  void* timer_wheel;                                                          \
   uint64_t time;                                                              \
   int signal_pipefd[2];                                                       \
   uv__io_t signal_io_watcher;                                                 \
@@ -351,6 +352,9 @@ typedef struct {
   void* queue[2];                                                             \
   int status;                                                                 \
 
+#define UV_DIR_PRIVATE_FIELDS                                                 \
+  DIR* dir;
+
 #define UV_FS_PRIVATE_FIELDS                                                  \
   const char *new_path;                                                       \
   uv_file file;                                                               \
@@ -330,6 +330,8 @@ typedef struct {
   uv_handle_t* endgame_handles;                                               \
   /* TODO(bnoordhuis) Stop heap-allocating |timer_heap| in libuv v2.x. */     \
   void* timer_heap;                                                           \
+  /* Lazily allocated by the first started UV_TIMER_COARSE timer. */          \
+  void* timer_wheel;                                                          \
     /* Lists of active loop (prepare / check / idle) watchers */              \
   uv_prepare_t* prepare_handles;                                              \
   uv_check_t* check_handles;                                                  \
@@ -600,6 +602,11 @@ typedef struct {
   HANDLE process_handle;                                                      \
   volatile char exit_cb_pending;
 
+#define UV_DIR_PRIVATE_FIELDS                                                 \
+  HANDLE dir_handle;                                                          \
+  WIN32_FIND_DATAW find_data;                                                 \
+  BOOL need_find_call;
+
 #define UV_FS_PRIVATE_FIELDS                                                  \
   struct uv__work work_req;                                                   \
   int flags;                                                                  \
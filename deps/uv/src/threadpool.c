@@ -28,19 +28,52 @@
 #include <stdlib.h>
 
 #define MAX_THREADPOOL_SIZE 128
+#define DEFAULT_THREADPOOL_SIZE 4
+
+/* Every worker owns a set of queues, one per uv__work_kind. Workers run their
+ * own work first and steal from the other workers when they run dry. The
+ * global `mutex` only guards the list of idle workers and the pool's size;
+ * it is not needed to pick up work.
+ *
+ * Queued work stays in the queue it was posted to until a worker takes it,
+ * whether that worker is the owner or a thief. The owner is recorded in the
+ * request so that uv_cancel() only has to look at one queue.
+ *
+ * Lock order: the global `mutex`, then a worker's `mutex`, then
+ * `slow_io_mutex` or a loop's `wq_mutex`. Workers never hold any of the
+ * first three together with a loop's `wq_mutex`.
+ */
+struct uv__worker {
+  uv_thread_t thread;
+  uv_mutex_t mutex;  /* Protects `wq`. */
+  uv_cond_t cond;    /* Waited on with the global `mutex`. */
+  QUEUE wq[UV__WORK_SLOW_IO + 1];
+  QUEUE idle_wq;     /* Link in `idle_workers`, protected by global `mutex`. */
+  unsigned int index;
+  int wakeup;        /* Protected by the global `mutex`. */
+  int exiting;       /* Written with both mutexes held, read with either. */
+  int exited;        /* Protected by the global `mutex`. */
+  int started;       /* Thread has been created but not yet joined. */
+};
+
+/* Work kinds in the order workers pick them up. */
+static const enum uv__work_kind priorities[] = {
+  UV__WORK_FAST_IO,
+  UV__WORK_CPU,
+  UV__WORK_SLOW_IO
+};
 
 static uv_once_t once = UV_ONCE_INIT;
-static uv_cond_t cond;
 static uv_mutex_t mutex;
-static unsigned int idle_threads;
+static uv_mutex_t resize_mutex;
+static uv_mutex_t slow_io_mutex;
 static unsigned int slow_io_work_running;
+static unsigned int slow_io_work_limit;
 static unsigned int nthreads;
-static uv_thread_t* threads;
-static uv_thread_t default_threads[4];
-static QUEUE exit_message;
-static QUEUE wq;
-static QUEUE run_slow_work_message;
-static QUEUE slow_io_pending_wq;
+static unsigned int nworkers;
+static unsigned int next_worker;
+static struct uv__worker* workers[MAX_THREADPOOL_SIZE];
+static QUEUE idle_workers;
 
 static unsigned int slow_work_thread_threshold(void) {
   return (nthreads + 1) / 2;
@@ -51,184 +84,410 @@ static void uv__cancelled(struct uv__work* w) {
 }
 
 
-/* To avoid deadlock with uv_cancel() it's crucial that the worker
- * never holds the global mutex and the loop-local mutex at the same time.
+/* Called with the global `mutex` held. */
+static void wake_worker(struct uv__worker* wk) {
+  if (!QUEUE_EMPTY(&wk->idle_wq)) {
+    QUEUE_REMOVE(&wk->idle_wq);
+    QUEUE_INIT(&wk->idle_wq);
+  }
+
+  wk->wakeup = 1;
+  uv_cond_signal(&wk->cond);
+}
+
+
+/* Called with the global `mutex` held. */
+static struct uv__worker* pop_idle_worker(void) {
+  struct uv__worker* wk;
+
+  if (QUEUE_EMPTY(&idle_workers))
+    return NULL;
+
+  wk = QUEUE_DATA(QUEUE_HEAD(&idle_workers), struct uv__worker, idle_wq);
+  QUEUE_REMOVE(&wk->idle_wq);
+  QUEUE_INIT(&wk->idle_wq);
+
+  return wk;
+}
+
+
+/* Called with `wk->mutex` held. Slow I/O work is limited to half of the
+ * threads so that it can't starve everything else, unless `force` is set.
  */
-static void worker(void* arg) {
-  struct uv__work* w;
+static QUEUE* dequeue(struct uv__worker* wk,
+                      enum uv__work_kind* kind,
+                      int force) {
+  unsigned int i;
+  QUEUE* q;
+  int ok;
+
+  for (i = 0; i < ARRAY_SIZE(priorities); i++) {
+    q = &wk->wq[priorities[i]];
+    if (QUEUE_EMPTY(q))
+      continue;
+
+    if (priorities[i] == UV__WORK_SLOW_IO) {
+      uv_mutex_lock(&slow_io_mutex);
+      ok = force || slow_io_work_running < slow_io_work_limit;
+      if (ok)
+        slow_io_work_running++;
+      uv_mutex_unlock(&slow_io_mutex);
+
+      if (!ok)
+        return NULL;
+    }
+
+    q = QUEUE_HEAD(q);
+    QUEUE_REMOVE(q);
+    QUEUE_INIT(q);  /* Signal uv_cancel() that the work req is executing. */
+    *kind = priorities[i];
+
+    return q;
+  }
+
+  return NULL;
+}
+
+
+/* Takes work from the worker's own queues, or steals it from the other
+ * workers if there is none. Exiting workers only drain their own queues.
+ */
+static QUEUE* next_work(struct uv__worker* self, enum uv__work_kind* kind) {
+  struct uv__worker* victim;
+  unsigned int n;
+  unsigned int i;
   QUEUE* q;
-  int is_slow_work;
+  int exiting;
+
+  uv_mutex_lock(&self->mutex);
+  exiting = self->exiting;
+  q = dequeue(self, kind, exiting);
+  uv_mutex_unlock(&self->mutex);
 
-  uv_sem_post((uv_sem_t*) arg);
-  arg = NULL;
+  if (q != NULL || exiting)
+    return q;
 
   uv_mutex_lock(&mutex);
+  n = nworkers;
+  uv_mutex_unlock(&mutex);
+
+  for (i = 1; i < n && q == NULL; i++) {
+    victim = workers[(self->index + i) % n];
+    uv_mutex_lock(&victim->mutex);
+    q = dequeue(victim, kind, 0);
+    uv_mutex_unlock(&victim->mutex);
+  }
+
+  return q;
+}
+
+
+/* Waits until there is work for the worker. Returns NULL when the worker
+ * should exit.
+ */
+static QUEUE* wait_for_work(struct uv__worker* self,
+                            enum uv__work_kind* kind) {
+  QUEUE* q;
+
   for (;;) {
-    /* `mutex` should always be locked at this point. */
-
-    /* Keep waiting while either no work is present or only slow I/O
-       and we're at the threshold for that. */
-    while (QUEUE_EMPTY(&wq) ||
-           (QUEUE_HEAD(&wq) == &run_slow_work_message &&
-            QUEUE_NEXT(&run_slow_work_message) == &wq &&
-            slow_io_work_running >= slow_work_thread_threshold())) {
-      idle_threads += 1;
-      uv_cond_wait(&cond, &mutex);
-      idle_threads -= 1;
-    }
+    q = next_work(self, kind);
 
-    q = QUEUE_HEAD(&wq);
-    if (q == &exit_message) {
-      uv_cond_signal(&cond);
+    uv_mutex_lock(&mutex);
+    if (q != NULL || self->exiting) {
+      if (!QUEUE_EMPTY(&self->idle_wq)) {
+        QUEUE_REMOVE(&self->idle_wq);
+        QUEUE_INIT(&self->idle_wq);
+      }
+
+      /* If someone handed us work after we had already found some, pass it
+       * on to another idle worker rather than let it wait behind ours.
+       */
+      if (self->wakeup && !QUEUE_EMPTY(&idle_workers))
+        wake_worker(pop_idle_worker());
+
+      if (q == NULL)
+        self->exited = 1;
+
+      self->wakeup = 0;
       uv_mutex_unlock(&mutex);
-      break;
+      return q;
     }
 
-    QUEUE_REMOVE(q);
-    QUEUE_INIT(q);  /* Signal uv_cancel() that the work req is executing. */
+    if (QUEUE_EMPTY(&self->idle_wq) && !self->wakeup) {
+      /* Go on the idle list and look once more before going to sleep;
+       * anything posted from here on wakes us up.
+       */
+      QUEUE_INSERT_TAIL(&idle_workers, &self->idle_wq);
+    } else {
+      while (!self->wakeup && !self->exiting)
+        uv_cond_wait(&self->cond, &mutex);
+      self->wakeup = 0;
+    }
+    uv_mutex_unlock(&mutex);
+  }
+}
+
 
-    is_slow_work = 0;
-    if (q == &run_slow_work_message) {
-      /* If we're at the slow I/O threshold, re-schedule until after all
-         other work in the queue is done. */
-      if (slow_io_work_running >= slow_work_thread_threshold()) {
-        QUEUE_INSERT_TAIL(&wq, q);
-        continue;
+/* To avoid deadlock with uv_cancel() it's crucial that the worker
+ * never holds a queue mutex and the loop-local mutex at the same time.
+ */
+static void worker(void* arg) {
+  struct uv__worker* self;
+  enum uv__work_kind kind;
+  struct uv__work* w;
+  QUEUE* q;
+
+  self = arg;
+
+  while ((q = wait_for_work(self, &kind)) != NULL) {
+    do {
+      w = QUEUE_DATA(q, struct uv__work, wq);
+      w->work(w);
+
+      uv_mutex_lock(&w->loop->wq_mutex);
+      w->work = NULL;  /* Signal uv_cancel() that the work req is done
+                          executing. */
+      QUEUE_INSERT_TAIL(&w->loop->wq, &w->wq);
+      uv_async_send(&w->loop->wq_async);
+      uv_mutex_unlock(&w->loop->wq_mutex);
+
+      if (kind == UV__WORK_SLOW_IO) {
+        uv_mutex_lock(&slow_io_mutex);
+        slow_io_work_running--;
+        uv_mutex_unlock(&slow_io_mutex);
+
+        /* There may be slow I/O work that nobody was allowed to pick up. */
+        uv_mutex_lock(&mutex);
+        if (!QUEUE_EMPTY(&idle_workers))
+          wake_worker(pop_idle_worker());
+        uv_mutex_unlock(&mutex);
       }
 
-      /* If we encountered a request to run slow I/O work but there is none
-         to run, that means it's cancelled => Start over. */
-      if (QUEUE_EMPTY(&slow_io_pending_wq))
-        continue;
+      q = next_work(self, &kind);
+    } while (q != NULL);
+  }
+}
 
-      is_slow_work = 1;
-      slow_io_work_running++;
 
-      q = QUEUE_HEAD(&slow_io_pending_wq);
-      QUEUE_REMOVE(q);
-      QUEUE_INIT(q);
+static void post(uv_req_t* req, QUEUE* q, enum uv__work_kind kind) {
+  struct uv__worker* target;
+  struct uv__worker* idle;
 
-      /* If there is more slow I/O work, schedule it to be run as well. */
-      if (!QUEUE_EMPTY(&slow_io_pending_wq)) {
-        QUEUE_INSERT_TAIL(&wq, &run_slow_work_message);
-        if (idle_threads > 0)
-          uv_cond_signal(&cond);
-      }
-    }
+  /* Hand the work to an idle worker if there is one. Otherwise spread it
+   * round-robin and let whoever runs dry first steal it.
+   */
+  uv_mutex_lock(&mutex);
+  idle = pop_idle_worker();
+  target = idle;
+  if (target == NULL)
+    target = workers[next_worker++ % nthreads];
+
+  req->reserved[0] = target;
+  uv_mutex_lock(&target->mutex);
+  QUEUE_INSERT_TAIL(&target->wq[kind], q);
+  uv_mutex_unlock(&target->mutex);
+
+  if (idle != NULL)
+    wake_worker(idle);
+  uv_mutex_unlock(&mutex);
+}
+
+
+static int start_worker(unsigned int i) {
+  struct uv__worker* wk;
+  unsigned int k;
+  int err;
 
+  wk = workers[i];
+
+  if (wk != NULL) {
+    /* A worker that was told to exit but hasn't yet simply carries on. */
+    uv_mutex_lock(&mutex);
+    uv_mutex_lock(&wk->mutex);
+    if (!wk->exited)
+      wk->exiting = 0;
+    uv_mutex_unlock(&wk->mutex);
     uv_mutex_unlock(&mutex);
 
-    w = QUEUE_DATA(q, struct uv__work, wq);
-    w->work(w);
+    if (!wk->exiting)
+      return 0;
 
-    uv_mutex_lock(&w->loop->wq_mutex);
-    w->work = NULL;  /* Signal uv_cancel() that the work req is done
-                        executing. */
-    QUEUE_INSERT_TAIL(&w->loop->wq, &w->wq);
-    uv_async_send(&w->loop->wq_async);
-    uv_mutex_unlock(&w->loop->wq_mutex);
+    if (uv_thread_join(&wk->thread))
+      abort();
+    wk->started = 0;
+  } else {
+    wk = uv__malloc(sizeof(*wk));
+    if (wk == NULL)
+      return UV_ENOMEM;
 
-    /* Lock `mutex` since that is expected at the start of the next
-     * iteration. */
+    if (uv_mutex_init(&wk->mutex))
+      abort();
+
+    if (uv_cond_init(&wk->cond))
+      abort();
+
+    for (k = 0; k < ARRAY_SIZE(wk->wq); k++)
+      QUEUE_INIT(&wk->wq[k]);
+    QUEUE_INIT(&wk->idle_wq);
+    wk->index = i;
+    wk->started = 0;
+  }
+
+  wk->wakeup = 0;
+  wk->exiting = 0;
+  wk->exited = 0;
+
+  /* Start out idle so that work posted right away gets spread out. */
+  uv_mutex_lock(&mutex);
+  QUEUE_INSERT_TAIL(&idle_workers, &wk->idle_wq);
+  uv_mutex_unlock(&mutex);
+
+  err = uv_thread_create(&wk->thread, worker, wk);
+  if (err) {
     uv_mutex_lock(&mutex);
-    if (is_slow_work) {
-      /* `slow_io_work_running` is protected by `mutex`. */
-      slow_io_work_running--;
+    QUEUE_REMOVE(&wk->idle_wq);
+    QUEUE_INIT(&wk->idle_wq);
+    uv_mutex_unlock(&mutex);
+
+    if (workers[i] == NULL) {
+      uv_cond_destroy(&wk->cond);
+      uv_mutex_destroy(&wk->mutex);
+      uv__free(wk);
+    } else {
+      wk->exited = 1;
     }
+
+    return err;
+  }
+
+  wk->started = 1;
+
+  if (workers[i] == NULL) {
+    uv_mutex_lock(&mutex);
+    workers[i] = wk;
+    nworkers = i + 1;
+    uv_mutex_unlock(&mutex);
   }
+
+  return 0;
 }
 
 
-static void post(QUEUE* q, enum uv__work_kind kind) {
+static void stop_worker(struct uv__worker* wk) {
   uv_mutex_lock(&mutex);
-  if (kind == UV__WORK_SLOW_IO) {
-    /* Insert into a separate queue. */
-    QUEUE_INSERT_TAIL(&slow_io_pending_wq, q);
-    if (!QUEUE_EMPTY(&run_slow_work_message)) {
-      /* Running slow I/O tasks is already scheduled => Nothing to do here.
-         The worker that runs said other task will schedule this one as well. */
-      uv_mutex_unlock(&mutex);
-      return;
-    }
-    q = &run_slow_work_message;
+  uv_mutex_lock(&wk->mutex);
+  wk->exiting = 1;
+  uv_mutex_unlock(&wk->mutex);
+  wake_worker(wk);
+  uv_mutex_unlock(&mutex);
+}
+
+
+static int resize(unsigned int n) {
+  unsigned int i;
+  int err;
+
+  if (n == 0)
+    n = 1;
+  if (n > MAX_THREADPOOL_SIZE)
+    n = MAX_THREADPOOL_SIZE;
+
+  uv_mutex_lock(&resize_mutex);
+
+  err = 0;
+  for (i = nthreads; i < n; i++) {
+    err = start_worker(i);
+    if (err)
+      break;
+  }
+
+  if (i < n) {
+    if (i == 0)
+      abort();  /* Can't run without any threads at all. */
+    n = i;
   }
 
-  QUEUE_INSERT_TAIL(&wq, q);
-  if (idle_threads > 0)
-    uv_cond_signal(&cond);
+  uv_mutex_lock(&mutex);
+  i = nthreads;
+  nthreads = n;
   uv_mutex_unlock(&mutex);
+
+  uv_mutex_lock(&slow_io_mutex);
+  slow_io_work_limit = slow_work_thread_threshold();
+  uv_mutex_unlock(&slow_io_mutex);
+
+  /* Workers past the new size finish what's in their queues and exit.
+   * They're joined when the pool grows again or at exit.
+   */
+  for (; i > n; i--)
+    stop_worker(workers[i - 1]);
+
+  uv_mutex_unlock(&resize_mutex);
+
+  return err;
 }
 
 
 #ifndef _WIN32
 UV_DESTRUCTOR(static void cleanup(void)) {
+  struct uv__worker* wk;
   unsigned int i;
 
   if (nthreads == 0)
     return;
 
-  post(&exit_message, UV__WORK_CPU);
+  for (i = 0; i < nworkers; i++)
+    stop_worker(workers[i]);
 
-  for (i = 0; i < nthreads; i++)
-    if (uv_thread_join(threads + i))
-      abort();
+  for (i = 0; i < nworkers; i++) {
+    wk = workers[i];
+    if (wk->started)
+      if (uv_thread_join(&wk->thread))
+        abort();
 
-  if (threads != default_threads)
-    uv__free(threads);
+    uv_cond_destroy(&wk->cond);
+    uv_mutex_destroy(&wk->mutex);
+    uv__free(wk);
+    workers[i] = NULL;
+  }
 
+  uv_mutex_destroy(&slow_io_mutex);
+  uv_mutex_destroy(&resize_mutex);
   uv_mutex_destroy(&mutex);
-  uv_cond_destroy(&cond);
 
-  threads = NULL;
+  nworkers = 0;
   nthreads = 0;
 }
 #endif
 
 
 static void init_threads(void) {
-  unsigned int i;
+  unsigned int n;
   const char* val;
-  uv_sem_t sem;
 
-  nthreads = ARRAY_SIZE(default_threads);
+  n = DEFAULT_THREADPOOL_SIZE;
   val = getenv("UV_THREADPOOL_SIZE");
   if (val != NULL)
-    nthreads = atoi(val);
-  if (nthreads == 0)
-    nthreads = 1;
-  if (nthreads > MAX_THREADPOOL_SIZE)
-    nthreads = MAX_THREADPOOL_SIZE;
-
-  threads = default_threads;
-  if (nthreads > ARRAY_SIZE(default_threads)) {
-    threads = uv__malloc(nthreads * sizeof(threads[0]));
-    if (threads == NULL) {
-      nthreads = ARRAY_SIZE(default_threads);
-      threads = default_threads;
-    }
-  }
-
-  if (uv_cond_init(&cond))
-    abort();
+    n = atoi(val);
 
   if (uv_mutex_init(&mutex))
     abort();
 
-  QUEUE_INIT(&wq);
-  QUEUE_INIT(&slow_io_pending_wq);
-  QUEUE_INIT(&run_slow_work_message);
-
-  if (uv_sem_init(&sem, 0))
+  if (uv_mutex_init(&resize_mutex))
     abort();
 
-  for (i = 0; i < nthreads; i++)
-    if (uv_thread_create(threads + i, worker, &sem))
-      abort();
+  if (uv_mutex_init(&slow_io_mutex))
+    abort();
 
-  for (i = 0; i < nthreads; i++)
-    uv_sem_wait(&sem);
+  /* After a fork the workers of the parent are gone, start from scratch. */
+  memset(workers, 0, sizeof(workers));
+  QUEUE_INIT(&idle_workers);
+  slow_io_work_running = 0;
+  next_worker = 0;
+  nworkers = 0;
+  nthreads = 0;
 
-  uv_sem_destroy(&sem);
+  resize(n);
 }
 
 
@@ -254,6 +513,7 @@ static void init_once(void) {
 
 
 void uv__work_submit(uv_loop_t* loop,
+                     uv_req_t* req,
                      struct uv__work* w,
                      enum uv__work_kind kind,
                      void (*work)(struct uv__work* w),
@@ -262,14 +522,24 @@ void uv__work_submit(uv_loop_t* loop,
   w->loop = loop;
   w->work = work;
   w->done = done;
-  post(&w->wq, kind);
+  post(req, &w->wq, kind);
 }
 
 
 static int uv__work_cancel(uv_loop_t* loop, uv_req_t* req, struct uv__work* w) {
+  struct uv__worker* wk;
   int cancelled;
 
-  uv_mutex_lock(&mutex);
+  /* Work that is still queued sits in the queue of the worker it was posted
+   * to. A worker that picks it up empties `w->wq`, and `w->work` is cleared
+   * once it has run. Requests that never went through post(), such as
+   * io_uring requests, have no owner.
+   */
+  wk = req->reserved[0];
+  if (wk == NULL)
+    return UV_EBUSY;
+
+  uv_mutex_lock(&wk->mutex);
   uv_mutex_lock(&w->loop->wq_mutex);
 
   cancelled = !QUEUE_EMPTY(&w->wq) && w->work != NULL;
@@ -277,7 +547,7 @@ static int uv__work_cancel(uv_loop_t* loop, uv_req_t* req, struct uv__work* w) {
     QUEUE_REMOVE(&w->wq);
 
   uv_mutex_unlock(&w->loop->wq_mutex);
-  uv_mutex_unlock(&mutex);
+  uv_mutex_unlock(&wk->mutex);
 
   if (!cancelled)
     return UV_EBUSY;
@@ -339,22 +609,62 @@ int uv_queue_work(uv_loop_t* loop,
                   uv_work_t* req,
                   uv_work_cb work_cb,
                   uv_after_work_cb after_work_cb) {
+  return uv_queue_work_ex(loop, req, UV_WORK_CPU, work_cb, after_work_cb);
+}
+
+
+int uv_queue_work_ex(uv_loop_t* loop,
+                     uv_work_t* req,
+                     uv_work_kind kind,
+                     uv_work_cb work_cb,
+                     uv_after_work_cb after_work_cb) {
   if (work_cb == NULL)
     return UV_EINVAL;
 
+  switch (kind) {
+  case UV_WORK_CPU:
+  case UV_WORK_FAST_IO:
+  case UV_WORK_SLOW_IO:
+    break;
+  default:
+    return UV_EINVAL;
+  }
+
   uv__req_init(loop, req, UV_WORK);
   req->loop = loop;
   req->work_cb = work_cb;
   req->after_work_cb = after_work_cb;
   uv__work_submit(loop,
+                  (uv_req_t*) req,
                   &req->work_req,
-                  UV__WORK_CPU,
+                  (enum uv__work_kind) kind,
                   uv__queue_work,
                   uv__queue_done);
   return 0;
 }
 
 
+int uv_threadpool_resize(unsigned int size) {
+  if (size == 0 || size > MAX_THREADPOOL_SIZE)
+    return UV_EINVAL;
+
+  uv_once(&once, init_once);
+  return resize(size);
+}
+
+
+unsigned int uv_threadpool_size(void) {
+  unsigned int size;
+
+  uv_once(&once, init_once);
+  uv_mutex_lock(&mutex);
+  size = nthreads;
+  uv_mutex_unlock(&mutex);
+
+  return size;
+}
+
+
 int uv_cancel(uv_req_t* req) {
   struct uv__work* wreq;
   uv_loop_t* loop;
@@ -25,6 +25,44 @@
 #include <assert.h>
 #include <limits.h>
 
+/* Coarse timers are kept in a hierarchical timing wheel instead of the heap.
+ * The wheel has WHEEL_DEPTH levels of WHEEL_LVL_SIZE slots; every level is
+ * 2^WHEEL_CLK_SHIFT times coarser than the one below it. A timer is put in
+ * the lowest level whose range covers its timeout and its expiry is rounded
+ * up to that level's granularity, so it never fires early and at most ~12.5%
+ * late. Timers are never cascaded from level to level, which is what makes
+ * start and stop O(1); the price is the loss of precision described above.
+ *
+ * A slot of level n is due when the wheel clock is a multiple of the level's
+ * granularity, which means all timers in a slot expire as one batch.
+ * Timeouts that don't fit in the wheel (~36 hours and up) go into the heap.
+ */
+#define WHEEL_LVL_BITS 6
+#define WHEEL_LVL_SIZE (1 << WHEEL_LVL_BITS)
+#define WHEEL_LVL_MASK (WHEEL_LVL_SIZE - 1)
+#define WHEEL_CLK_SHIFT 3
+#define WHEEL_CLK_MASK ((1 << WHEEL_CLK_SHIFT) - 1)
+#define WHEEL_DEPTH 8
+#define WHEEL_LVL_SHIFT(n) ((n) * WHEEL_CLK_SHIFT)
+#define WHEEL_LVL_GRAN(n) ((uint64_t) 1 << WHEEL_LVL_SHIFT(n))
+/* Smallest delta that no longer fits in level n - 1. */
+#define WHEEL_LVL_START(n)                                                    \
+  ((uint64_t) (WHEEL_LVL_SIZE - 1) << WHEEL_LVL_SHIFT((n) - 1))
+#define WHEEL_TIMEOUT_MAX (WHEEL_LVL_START(WHEEL_DEPTH) - 1)
+
+struct uv__timer_wheel {
+  uint64_t clk;  /* Next tick (millisecond) that has not been processed. */
+  unsigned int count;
+  uint64_t pending[WHEEL_DEPTH];  /* Bitmap of non-empty slots per level. */
+  QUEUE slots[WHEEL_DEPTH * WHEEL_LVL_SIZE];
+};
+
+/* A timer in the wheel reuses its heap_node: the first two pointers link it
+ * into a slot and the third one stores the slot index.
+ */
+#define WHEEL_TIMER_QUEUE(handle) ((QUEUE*) &(handle)->heap_node)
+#define WHEEL_TIMER_SLOT(handle) ((uintptr_t) (handle)->heap_node[2])
+
 
 static struct heap *timer_heap(const uv_loop_t* loop) {
 #ifdef _WIN32
@@ -60,6 +98,233 @@ static int timer_less_than(const struct heap_node* ha,
 }
 
 
+static unsigned int wheel_ctz(uint64_t v) {
+  unsigned int n;
+
+  assert(v != 0);
+  n = 0;
+  if ((v & 0xFFFFFFFF) == 0) { n += 32; v >>= 32; }
+  if ((v & 0xFFFF) == 0) { n += 16; v >>= 16; }
+  if ((v & 0xFF) == 0) { n += 8; v >>= 8; }
+  if ((v & 0xF) == 0) { n += 4; v >>= 4; }
+  if ((v & 0x3) == 0) { n += 2; v >>= 2; }
+  if ((v & 0x1) == 0) { n += 1; }
+  return n;
+}
+
+
+/* Distance in slots from |start| to the next non-empty slot of a level,
+ * wrapping around, or -1 if the level is empty.
+ */
+static int wheel_next_pending(uint64_t map, unsigned int start) {
+  if (map == 0)
+    return -1;
+
+  if ((map >> start) != 0)
+    return wheel_ctz(map >> start);
+
+  return wheel_ctz(map) + WHEEL_LVL_SIZE - start;
+}
+
+
+static unsigned int wheel_calc_index(uint64_t expires, unsigned int lvl) {
+  expires = (expires + WHEEL_LVL_GRAN(lvl) - 1) >> WHEEL_LVL_SHIFT(lvl);
+  return lvl * WHEEL_LVL_SIZE + (unsigned int) (expires & WHEEL_LVL_MASK);
+}
+
+
+static unsigned int wheel_slot(const struct uv__timer_wheel* wheel,
+                               uint64_t expires) {
+  uint64_t delta;
+  unsigned int lvl;
+
+  if (expires < wheel->clk)
+    expires = wheel->clk;
+
+  delta = expires - wheel->clk;
+  for (lvl = 0; lvl < WHEEL_DEPTH - 1; lvl++)
+    if (delta < WHEEL_LVL_START(lvl + 1))
+      break;
+
+  return wheel_calc_index(expires, lvl);
+}
+
+
+/* Returns the earliest tick at which a slot is due, or (uint64_t) -1. */
+static uint64_t wheel_next_expiry(const struct uv__timer_wheel* wheel) {
+  uint64_t next;
+  uint64_t clk;
+  uint64_t tmp;
+  unsigned int lvl;
+  unsigned int adj;
+  int pos;
+
+  next = (uint64_t) -1;
+  clk = wheel->clk;
+
+  for (lvl = 0; lvl < WHEEL_DEPTH; lvl++) {
+    pos = wheel_next_pending(wheel->pending[lvl],
+                             (unsigned int) (clk & WHEEL_LVL_MASK));
+    if (pos >= 0) {
+      tmp = (clk + pos) << WHEEL_LVL_SHIFT(lvl);
+      if (tmp < next)
+        next = tmp;
+    }
+
+    /* A level's slot is processed on the first tick at or after the current
+     * one that is a multiple of the level's granularity.
+     */
+    adj = (clk & WHEEL_CLK_MASK) != 0;
+    clk >>= WHEEL_CLK_SHIFT;
+    clk += adj;
+  }
+
+  return next;
+}
+
+
+/* Move the timers of all slots that are due at |clk| to |expired|. */
+static void wheel_collect(struct uv__timer_wheel* wheel,
+                          uint64_t clk,
+                          QUEUE* expired) {
+  QUEUE* slot;
+  unsigned int lvl;
+  unsigned int idx;
+
+  for (lvl = 0; lvl < WHEEL_DEPTH; lvl++) {
+    idx = (unsigned int) (clk & WHEEL_LVL_MASK);
+    if (wheel->pending[lvl] & ((uint64_t) 1 << idx)) {
+      wheel->pending[lvl] &= ~((uint64_t) 1 << idx);
+      slot = &wheel->slots[lvl * WHEEL_LVL_SIZE + idx];
+      QUEUE_ADD(expired, slot);
+      QUEUE_INIT(slot);
+    }
+
+    if (clk & WHEEL_CLK_MASK)
+      break;
+    clk >>= WHEEL_CLK_SHIFT;
+  }
+}
+
+
+static struct uv__timer_wheel* timer_wheel(uv_loop_t* loop) {
+  struct uv__timer_wheel* wheel;
+  unsigned int i;
+
+  wheel = loop->timer_wheel;
+  if (wheel != NULL)
+    return wheel;
+
+  wheel = uv__malloc(sizeof(*wheel));
+  if (wheel == NULL)
+    return NULL;
+
+  wheel->clk = loop->time;
+  wheel->count = 0;
+  for (i = 0; i < WHEEL_DEPTH; i++)
+    wheel->pending[i] = 0;
+  for (i = 0; i < ARRAY_SIZE(wheel->slots); i++)
+    QUEUE_INIT(&wheel->slots[i]);
+
+  loop->timer_wheel = wheel;
+  return wheel;
+}
+
+
+/* Returns 0 if the timer was added to the wheel, non-zero if it belongs in
+ * the heap because the timeout is too far in the future or out of memory.
+ */
+static int wheel_insert(uv_timer_t* handle) {
+  struct uv__timer_wheel* wheel;
+  unsigned int idx;
+
+  wheel = timer_wheel(handle->loop);
+  if (wheel == NULL)
+    return -1;
+
+  /* Nothing is pending, fast-forward so the level is picked relative to now.
+   * Otherwise the clock only lags behind, which errs on the late side.
+   */
+  if (wheel->count == 0 && wheel->clk < handle->loop->time)
+    wheel->clk = handle->loop->time;
+
+  if (handle->timeout > wheel->clk &&
+      handle->timeout - wheel->clk > WHEEL_TIMEOUT_MAX) {
+    return -1;
+  }
+
+  idx = wheel_slot(wheel, handle->timeout);
+  handle->heap_node[2] = (void*) (uintptr_t) idx;
+  QUEUE_INSERT_TAIL(&wheel->slots[idx], WHEEL_TIMER_QUEUE(handle));
+  wheel->pending[idx / WHEEL_LVL_SIZE] |=
+      (uint64_t) 1 << (idx % WHEEL_LVL_SIZE);
+  wheel->count++;
+  handle->flags |= UV_HANDLE_TIMER_IN_WHEEL;
+
+  return 0;
+}
+
+
+static void wheel_remove(uv_timer_t* handle) {
+  struct uv__timer_wheel* wheel;
+  unsigned int idx;
+
+  wheel = handle->loop->timer_wheel;
+  idx = (unsigned int) WHEEL_TIMER_SLOT(handle);
+
+  /* Also works for timers that were moved to a list of expired timers. */
+  QUEUE_REMOVE(WHEEL_TIMER_QUEUE(handle));
+  if (QUEUE_EMPTY(&wheel->slots[idx]))
+    wheel->pending[idx / WHEEL_LVL_SIZE] &=
+        ~((uint64_t) 1 << (idx % WHEEL_LVL_SIZE));
+  wheel->count--;
+  handle->flags &= ~UV_HANDLE_TIMER_IN_WHEEL;
+}
+
+
+static void wheel_run(uv_loop_t* loop) {
+  struct uv__timer_wheel* wheel;
+  uv_timer_t* handle;
+  uint64_t next;
+  QUEUE expired;
+  QUEUE* q;
+
+  wheel = loop->timer_wheel;
+  if (wheel == NULL)
+    return;
+
+  QUEUE_INIT(&expired);
+
+  while (wheel->clk <= loop->time) {
+    next = wheel_next_expiry(wheel);
+    if (next > loop->time) {
+      wheel->clk = loop->time + 1;
+      break;
+    }
+
+    wheel_collect(wheel, next, &expired);
+    wheel->clk = next + 1;
+  }
+
+  /* Callbacks can stop or restart any timer, including the ones that are
+   * still on the expired list; uv_timer_stop() unlinks those from it.
+   */
+  while (!QUEUE_EMPTY(&expired)) {
+    q = QUEUE_HEAD(&expired);
+    handle = container_of((void*) q, uv_timer_t, heap_node);
+    uv_timer_stop(handle);
+    uv_timer_again(handle);
+    handle->timer_cb(handle);
+  }
+}
+
+
+void uv__timer_wheel_free(uv_loop_t* loop) {
+  uv__free(loop->timer_wheel);
+  loop->timer_wheel = NULL;
+}
+
+
 int uv_timer_init(uv_loop_t* loop, uv_timer_t* handle) {
   uv__handle_init(loop, (uv_handle_t*)handle, UV_TIMER);
   handle->timer_cb = NULL;
@@ -68,6 +333,18 @@ int uv_timer_init(uv_loop_t* loop, uv_timer_t* handle) {
 }
 
 
+int uv_timer_init_ex(uv_loop_t* loop, uv_timer_t* handle, unsigned int flags) {
+  if (flags & ~UV_TIMER_COARSE)
+    return UV_EINVAL;
+
+  uv_timer_init(loop, handle);
+  if (flags & UV_TIMER_COARSE)
+    handle->flags |= UV_HANDLE_TIMER_COARSE;
+
+  return 0;
+}
+
+
 int uv_timer_start(uv_timer_t* handle,
                    uv_timer_cb cb,
                    uint64_t timeout,
@@ -90,9 +367,12 @@ int uv_timer_start(uv_timer_t* handle,
   /* start_id is the second index to be compared in uv__timer_cmp() */
   handle->start_id = handle->loop->timer_counter++;
 
-  heap_insert(timer_heap(handle->loop),
-              (struct heap_node*) &handle->heap_node,
-              timer_less_than);
+  if (!(handle->flags & UV_HANDLE_TIMER_COARSE) ||
+      wheel_insert(handle) != 0) {
+    heap_insert(timer_heap(handle->loop),
+                (struct heap_node*) &handle->heap_node,
+                timer_less_than);
+  }
   uv__handle_start(handle);
 
   return 0;
@@ -103,9 +383,12 @@ int uv_timer_stop(uv_timer_t* handle) {
   if (!uv__is_active(handle))
     return 0;
 
-  heap_remove(timer_heap(handle->loop),
-              (struct heap_node*) &handle->heap_node,
-              timer_less_than);
+  if (handle->flags & UV_HANDLE_TIMER_IN_WHEEL)
+    wheel_remove(handle);
+  else
+    heap_remove(timer_heap(handle->loop),
+                (struct heap_node*) &handle->heap_node,
+                timer_less_than);
   uv__handle_stop(handle);
 
   return 0;
@@ -136,19 +419,34 @@ uint64_t uv_timer_get_repeat(const uv_timer_t* handle) {
 
 
 int uv__next_timeout(const uv_loop_t* loop) {
+  const struct uv__timer_wheel* wheel;
   const struct heap_node* heap_node;
   const uv_timer_t* handle;
+  uint64_t timeout;
   uint64_t diff;
 
+  timeout = (uint64_t) -1;
+
   heap_node = heap_min(timer_heap(loop));
-  if (heap_node == NULL)
+  if (heap_node != NULL) {
+    handle = container_of(heap_node, uv_timer_t, heap_node);
+    timeout = handle->timeout;
+  }
+
+  wheel = loop->timer_wheel;
+  if (wheel != NULL && wheel->count > 0) {
+    diff = wheel_next_expiry(wheel);
+    if (diff < timeout)
+      timeout = diff;
+  }
+
+  if (heap_node == NULL && timeout == (uint64_t) -1)
     return -1; /* block indefinitely */
 
-  handle = container_of(heap_node, uv_timer_t, heap_node);
-  if (handle->timeout <= loop->time)
+  if (timeout <= loop->time)
     return 0;
 
-  diff = handle->timeout - loop->time;
+  diff = timeout - loop->time;
   if (diff > INT_MAX)
     diff = INT_MAX;
 
@@ -173,6 +471,8 @@ void uv__run_timers(uv_loop_t* loop) {
     uv_timer_again(handle);
     handle->timer_cb(handle);
   }
+
+  wheel_run(loop);
 }
 
 
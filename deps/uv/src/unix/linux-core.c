@@ -35,9 +35,12 @@
 
 #include <net/if.h>
 #include <sys/epoll.h>
+#include <sys/mman.h>
 #include <sys/param.h>
 #include <sys/prctl.h>
 #include <sys/sysinfo.h>
+#include <sys/uio.h>
+#include <sys/utsname.h>
 #include <unistd.h>
 #include <fcntl.h>
 #include <time.h>
@@ -81,6 +84,40 @@ static int read_times(FILE* statfile_fp,
 static void read_speeds(unsigned int numcpus, uv_cpu_info_t* ci);
 static unsigned long read_cpufreq(unsigned int cpunum);
 
+/* Per-loop io_uring instance, used to run file system requests without a
+ * round trip through the threadpool. Lazily created on first use.
+ *
+ * Requests that the kernel hands to its io-wq worker threads run with the
+ * credentials those threads started out with, and they don't follow a later
+ * setuid() in the process. A ring is therefore only used as long as the
+ * effective user and group ids are the ones it was created with.
+ */
+struct uv__iou {
+  uv__io_t watcher;
+  uint32_t* sqhead;
+  uint32_t* sqtail;
+  uint32_t* sqarray;
+  uint32_t sqmask;
+  uint32_t* sqflags;
+  uint32_t* cqhead;
+  uint32_t* cqtail;
+  uint32_t cqmask;
+  struct uv__io_uring_cqe* cqe;
+  void* sq;   /* Pointer to ring, shared between the SQ and the CQ. */
+  void* sqe;  /* Pointer to struct uv__io_uring_sqe array. */
+  size_t maxlen;
+  size_t sqelen;
+  int ringfd;
+  uid_t euid;
+  gid_t egid;
+  QUEUE in_flight;  /* Linked through req->work_req.wq. */
+  QUEUE cancelled;  /* Orphaned by uv_loop_fork(), fail on the next tick. */
+};
+
+static void uv__iou_init(uv_loop_t* loop, struct uv__iou* iou);
+static void uv__iou_delete(uv_loop_t* loop);
+static void uv__iou_reap(uv_loop_t* loop, uv__io_t* w, unsigned int events);
+
 
 int uv__platform_loop_init(uv_loop_t* loop) {
   int fd;
@@ -100,6 +137,7 @@ int uv__platform_loop_init(uv_loop_t* loop) {
   loop->backend_fd = fd;
   loop->inotify_fd = -1;
   loop->inotify_watchers = NULL;
+  loop->iou = NULL;
 
   if (fd == -1)
     return UV__ERR(errno);
@@ -109,11 +147,22 @@ int uv__platform_loop_init(uv_loop_t* loop) {
 
 
 int uv__io_fork(uv_loop_t* loop) {
+  struct uv__iou* iou;
+  QUEUE orphans;
   int err;
   void* old_watchers;
 
   old_watchers = loop->inotify_watchers;
 
+  /* io_uring requests that were in flight in the parent complete there, the
+   * child will never see them. Fail them with UV_ECANCELED instead of leaving
+   * them, and the loop, hanging.
+   */
+  QUEUE_INIT(&orphans);
+  iou = loop->iou;
+  if (iou != NULL)
+    QUEUE_MOVE(&iou->in_flight, &orphans);
+
   uv__close(loop->backend_fd);
   loop->backend_fd = -1;
   uv__platform_loop_delete(loop);
@@ -122,11 +171,23 @@ int uv__io_fork(uv_loop_t* loop) {
   if (err)
     return err;
 
+  if (!QUEUE_EMPTY(&orphans)) {
+    iou = uv__malloc(sizeof(*iou));
+    if (iou == NULL)
+      return UV_ENOMEM;
+
+    uv__iou_init(loop, iou);
+    loop->iou = iou;
+    QUEUE_MOVE(&orphans, &iou->cancelled);
+    uv__io_feed(loop, &iou->watcher);
+  }
+
   return uv__inotify_fork(loop, old_watchers);
 }
 
 
 void uv__platform_loop_delete(uv_loop_t* loop) {
+  uv__iou_delete(loop);
   if (loop->inotify_fd == -1) return;
   uv__io_stop(loop, &loop->inotify_read_watcher, POLLIN);
   uv__close(loop->inotify_fd);
@@ -418,6 +479,480 @@ update_timeout:
 }
 
 
+static int uv__iou_kernel_supported(void) {
+  static int supported = -1;
+  struct utsname u;
+  unsigned int major;
+  unsigned int minor;
+
+  if (supported != -1)
+    return supported;
+
+  supported = 0;
+
+  /* Kernels before 5.10 lack IORING_OP_STATX/OPENAT/CLOSE or have known bugs
+   * in the paths we use; stay on the threadpool there.
+   */
+  if (uname(&u) == 0)
+    if (sscanf(u.release, "%u.%u", &major, &minor) == 2)
+      supported = major > 5 || (major == 5 && minor >= 10);
+
+  return supported;
+}
+
+
+/* io_uring is opt-in through UV_USE_IO_URING=1. It is never used by setuid
+ * or setgid programs, where the environment can't be trusted.
+ */
+static int uv__use_io_uring(void) {
+  static int use_io_uring = -1;
+  const char* val;
+
+  if (use_io_uring == -1) {
+    val = getenv("UV_USE_IO_URING");
+    use_io_uring = val != NULL && atoi(val) == 1;
+    if (getuid() != geteuid() || getgid() != getegid())
+      use_io_uring = 0;
+  }
+
+  return use_io_uring;
+}
+
+
+static void uv__iou_init(uv_loop_t* loop, struct uv__iou* iou) {
+  struct uv__io_uring_params params;
+  uint32_t i;
+  size_t cqlen;
+  size_t sqlen;
+  size_t maxlen;
+  size_t sqelen;
+  char* sq;
+  char* sqe;
+  int ringfd;
+
+  STATIC_ASSERT(16 == sizeof(struct uv__io_uring_cqe));
+  STATIC_ASSERT(64 == sizeof(struct uv__io_uring_sqe));
+  STATIC_ASSERT(40 == sizeof(struct uv__io_cqring_offsets));
+  STATIC_ASSERT(40 == sizeof(struct uv__io_sqring_offsets));
+  STATIC_ASSERT(120 == sizeof(struct uv__io_uring_params));
+
+  iou->ringfd = -1;
+  QUEUE_INIT(&iou->in_flight);
+  QUEUE_INIT(&iou->cancelled);
+  uv__io_init(&iou->watcher, uv__iou_reap, -1);
+
+  if (!uv__use_io_uring() || !uv__iou_kernel_supported())
+    return;
+
+  memset(&params, 0, sizeof(params));
+  ringfd = uv__io_uring_setup(64, &params);
+  if (ringfd == -1)
+    return;  /* ENOSYS, EPERM (seccomp), ENOMEM (RLIMIT_MEMLOCK), etc. */
+
+  /* IORING_FEAT_RW_CUR_POS is needed for reads and writes with off == -1.
+   * IORING_FEAT_NODROP ensures completions are never lost when the CQ
+   * overflows, which can happen because we don't cap the number of requests
+   * in flight.
+   */
+  if (!(params.features & UV__IORING_FEAT_SINGLE_MMAP))
+    goto fail;
+
+  if (!(params.features & UV__IORING_FEAT_NODROP))
+    goto fail;
+
+  if (!(params.features & UV__IORING_FEAT_RW_CUR_POS))
+    goto fail;
+
+  sqlen = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+  cqlen =
+      params.cq_off.cqes + params.cq_entries * sizeof(struct uv__io_uring_cqe);
+  maxlen = sqlen < cqlen ? cqlen : sqlen;
+  sqelen = params.sq_entries * sizeof(struct uv__io_uring_sqe);
+
+  sq = mmap(0,
+            maxlen,
+            PROT_READ | PROT_WRITE,
+            MAP_SHARED | MAP_POPULATE,
+            ringfd,
+            UV__IORING_OFF_SQ_RING);
+
+  if (sq == MAP_FAILED)
+    goto fail;
+
+  sqe = mmap(0,
+             sqelen,
+             PROT_READ | PROT_WRITE,
+             MAP_SHARED | MAP_POPULATE,
+             ringfd,
+             UV__IORING_OFF_SQES);
+
+  if (sqe == MAP_FAILED) {
+    munmap(sq, maxlen);
+    goto fail;
+  }
+
+  uv__cloexec(ringfd, 1);
+
+  iou->sqhead = (uint32_t*) (sq + params.sq_off.head);
+  iou->sqtail = (uint32_t*) (sq + params.sq_off.tail);
+  iou->sqmask = *(uint32_t*) (sq + params.sq_off.ring_mask);
+  iou->sqarray = (uint32_t*) (sq + params.sq_off.array);
+  iou->sqflags = (uint32_t*) (sq + params.sq_off.flags);
+  iou->cqhead = (uint32_t*) (sq + params.cq_off.head);
+  iou->cqtail = (uint32_t*) (sq + params.cq_off.tail);
+  iou->cqmask = *(uint32_t*) (sq + params.cq_off.ring_mask);
+  iou->cqe = (struct uv__io_uring_cqe*) (sq + params.cq_off.cqes);
+  iou->sq = sq;
+  iou->sqe = sqe;
+  iou->maxlen = maxlen;
+  iou->sqelen = sqelen;
+  iou->ringfd = ringfd;
+  iou->euid = geteuid();
+  iou->egid = getegid();
+
+  /* The SQ array is an indirection table; map slot i to sqe i once so that
+   * submitting only has to bump the tail.
+   */
+  for (i = 0; i <= iou->sqmask; i++)
+    iou->sqarray[i] = i;
+
+  /* The ring fd polls readable when there are completions to reap. */
+  uv__io_init(&iou->watcher, uv__iou_reap, ringfd);
+  uv__io_start(loop, &iou->watcher, POLLIN);
+
+  return;
+
+fail:
+  uv__close(ringfd);
+}
+
+
+static void uv__iou_delete(uv_loop_t* loop) {
+  struct uv__iou* iou;
+
+  iou = loop->iou;
+  if (iou == NULL)
+    return;
+
+  if (iou->ringfd != -1) {
+    uv__io_stop(loop, &iou->watcher, POLLIN);
+    munmap(iou->sq, iou->maxlen);
+    munmap(iou->sqe, iou->sqelen);
+    uv__close(iou->ringfd);
+  }
+
+  QUEUE_REMOVE(&iou->watcher.pending_queue);
+  uv__free(iou);
+  loop->iou = NULL;
+}
+
+
+static struct uv__io_uring_sqe* uv__iou_get_sqe(uv_loop_t* loop,
+                                                uv_fs_t* req) {
+  struct uv__io_uring_sqe* sqe;
+  struct uv__iou* iou;
+  uint32_t head;
+  uint32_t tail;
+  uint32_t mask;
+
+  iou = loop->iou;
+
+  if (iou == NULL) {
+    iou = uv__malloc(sizeof(*iou));
+    if (iou == NULL)
+      return NULL;
+
+    uv__iou_init(loop, iou);
+    loop->iou = iou;
+  }
+
+  if (iou->ringfd == -1)
+    return NULL;
+
+  /* The credentials changed, e.g. with setuid(). New requests must not run
+   * with the old ones. Requests that are in flight still complete.
+   */
+  if (geteuid() != iou->euid || getegid() != iou->egid)
+    return NULL;
+
+  head = __atomic_load_n(iou->sqhead, __ATOMIC_ACQUIRE);
+  tail = *iou->sqtail;
+  mask = iou->sqmask;
+
+  if ((head & mask) == ((tail + 1) & mask))
+    return NULL;  /* No room in the ring, use the threadpool instead. */
+
+  sqe = iou->sqe;
+  sqe = &sqe[tail & mask];
+  memset(sqe, 0, sizeof(*sqe));
+  sqe->user_data = (uintptr_t) req;
+
+  /* Make uv_cancel() return UV_EBUSY rather than poke at a work item that was
+   * never submitted to the threadpool. The request isn't in any threadpool
+   * queue, so its queue link is free to track it here.
+   */
+  req->work_req.loop = loop;
+  req->work_req.work = NULL;
+  req->work_req.done = NULL;
+  req->reserved[0] = NULL;
+  QUEUE_INSERT_TAIL(&iou->in_flight, &req->work_req.wq);
+
+  uv__req_register(loop, req);
+
+  return sqe;
+}
+
+
+static void uv__iou_submit(struct uv__iou* iou) {
+  uint32_t pending;
+  int rc;
+
+  __atomic_store_n(iou->sqtail, *iou->sqtail + 1, __ATOMIC_RELEASE);
+
+  pending = *iou->sqtail - __atomic_load_n(iou->sqhead, __ATOMIC_ACQUIRE);
+
+  do
+    rc = uv__io_uring_enter(iou->ringfd, pending, 0, 0);
+  while (rc == -1 && errno == EINTR);
+
+  /* EAGAIN and EBUSY are transient; the entries stay in the SQ and are picked
+   * up by the next uv__io_uring_enter() call, at the latest when reaping.
+   */
+  if (rc == -1 && errno != EAGAIN && errno != EBUSY)
+    abort();
+}
+
+
+int uv__iou_fs_read_or_write(uv_loop_t* loop, uv_fs_t* req, int is_read) {
+  struct uv__io_uring_sqe* sqe;
+
+  /* Writes must be all-or-nothing to keep the semantics of uv__fs_write_all(),
+   * let the threadpool deal with vectors that don't fit in one syscall.
+   */
+  if (req->nbufs > (unsigned int) uv__getiovmax()) {
+    if (!is_read)
+      return 0;
+    req->nbufs = uv__getiovmax();
+  }
+
+  sqe = uv__iou_get_sqe(loop, req);
+  if (sqe == NULL)
+    return 0;
+
+  sqe->addr = (uintptr_t) req->bufs;
+  sqe->fd = req->file;
+  sqe->len = req->nbufs;
+  sqe->off = req->off < 0 ? (uint64_t) -1 : (uint64_t) req->off;
+  sqe->opcode = is_read ? UV__IORING_OP_READV : UV__IORING_OP_WRITEV;
+
+  uv__iou_submit(loop->iou);
+
+  return 1;
+}
+
+
+int uv__iou_fs_open(uv_loop_t* loop, uv_fs_t* req) {
+  struct uv__io_uring_sqe* sqe;
+
+  sqe = uv__iou_get_sqe(loop, req);
+  if (sqe == NULL)
+    return 0;
+
+  sqe->addr = (uintptr_t) req->path;
+  sqe->fd = AT_FDCWD;
+  sqe->len = req->mode;
+  sqe->op_flags = req->flags | O_CLOEXEC;
+  sqe->opcode = UV__IORING_OP_OPENAT;
+
+  uv__iou_submit(loop->iou);
+
+  return 1;
+}
+
+
+int uv__iou_fs_close(uv_loop_t* loop, uv_fs_t* req) {
+  struct uv__io_uring_sqe* sqe;
+
+  sqe = uv__iou_get_sqe(loop, req);
+  if (sqe == NULL)
+    return 0;
+
+  sqe->fd = req->file;
+  sqe->opcode = UV__IORING_OP_CLOSE;
+
+  uv__iou_submit(loop->iou);
+
+  return 1;
+}
+
+
+int uv__iou_fs_fsync_or_fdatasync(uv_loop_t* loop,
+                                  uv_fs_t* req,
+                                  uint32_t fsync_flags) {
+  struct uv__io_uring_sqe* sqe;
+
+  sqe = uv__iou_get_sqe(loop, req);
+  if (sqe == NULL)
+    return 0;
+
+  sqe->fd = req->file;
+  sqe->op_flags = fsync_flags;
+  sqe->opcode = UV__IORING_OP_FSYNC;
+
+  uv__iou_submit(loop->iou);
+
+  return 1;
+}
+
+
+int uv__iou_fs_statx(uv_loop_t* loop,
+                     uv_fs_t* req,
+                     int is_fstat,
+                     int is_lstat) {
+  struct uv__io_uring_sqe* sqe;
+  struct uv__statx* statxbuf;
+
+  statxbuf = uv__malloc(sizeof(*statxbuf));
+  if (statxbuf == NULL)
+    return 0;
+
+  sqe = uv__iou_get_sqe(loop, req);
+  if (sqe == NULL) {
+    uv__free(statxbuf);
+    return 0;
+  }
+
+  req->ptr = statxbuf;
+
+  sqe->addr = (uintptr_t) req->path;
+  sqe->off = (uintptr_t) statxbuf;  /* addr2 */
+  sqe->fd = AT_FDCWD;
+  sqe->len = 0xFFF;  /* STATX_BASIC_STATS + STATX_BTIME */
+  sqe->opcode = UV__IORING_OP_STATX;
+
+  if (is_fstat) {
+    sqe->addr = (uintptr_t) "";
+    sqe->fd = req->file;
+    sqe->op_flags |= 0x1000;  /* AT_EMPTY_PATH */
+  }
+
+  if (is_lstat)
+    sqe->op_flags |= AT_SYMLINK_NOFOLLOW;
+
+  uv__iou_submit(loop->iou);
+
+  return 1;
+}
+
+
+static void uv__iou_fs_done(uv_fs_t* req, int32_t res) {
+  struct uv__statx* statxbuf;
+
+  req->result = res;
+
+  switch (req->fs_type) {
+    case UV_FS_READ:
+    case UV_FS_WRITE:
+      /* Same as the threadpool path: the bufs are not needed anymore. */
+      if (req->bufs != req->bufsml)
+        uv__free(req->bufs);
+      req->bufs = NULL;
+      req->nbufs = 0;
+      break;
+
+    case UV_FS_STAT:
+    case UV_FS_LSTAT:
+    case UV_FS_FSTAT:
+      statxbuf = req->ptr;
+      req->ptr = NULL;
+      if (res == 0) {
+        uv__statx_to_stat(statxbuf, &req->statbuf);
+        req->ptr = &req->statbuf;
+      }
+      uv__free(statxbuf);
+      break;
+
+    default:
+      break;
+  }
+}
+
+
+static void uv__iou_reap(uv_loop_t* loop, uv__io_t* w, unsigned int events) {
+  struct uv__io_uring_cqe* cqe;
+  struct uv__io_uring_cqe* e;
+  struct uv__iou* iou;
+  uv_fs_t* req;
+  QUEUE* q;
+  uint32_t flags;
+  uint32_t head;
+  uint32_t tail;
+  uint32_t mask;
+  uint32_t i;
+  int rc;
+
+  iou = container_of(w, struct uv__iou, watcher);
+
+  while (!QUEUE_EMPTY(&iou->cancelled)) {
+    q = QUEUE_HEAD(&iou->cancelled);
+    QUEUE_REMOVE(q);
+    QUEUE_INIT(q);
+
+    req = container_of(q, uv_fs_t, work_req.wq);
+    uv__req_unregister(loop, req);
+    uv__iou_fs_done(req, UV_ECANCELED);
+    req->cb(req);
+  }
+
+  if (iou->ringfd == -1)
+    return;
+
+again:
+  head = *iou->cqhead;
+  tail = __atomic_load_n(iou->cqtail, __ATOMIC_ACQUIRE);
+  mask = iou->cqmask;
+  cqe = iou->cqe;
+
+  for (i = head; i != tail; i++) {
+    e = &cqe[i & mask];
+
+    req = (uv_fs_t*) (uintptr_t) e->user_data;
+    assert(req->type == UV_FS);
+
+    uv__req_unregister(loop, req);
+    QUEUE_REMOVE(&req->work_req.wq);
+    QUEUE_INIT(&req->work_req.wq);
+
+    uv__iou_fs_done(req, e->res);
+
+    /* Release the slot before calling out, the callback may submit more. */
+    __atomic_store_n(iou->cqhead, i + 1, __ATOMIC_RELEASE);
+
+    req->cb(req);
+  }
+
+  /* Flush entries the kernel had to park because the CQ was full, as well as
+   * submissions that were deferred by EAGAIN/EBUSY.
+   */
+  flags = __atomic_load_n(iou->sqflags, __ATOMIC_ACQUIRE);
+  if (flags & UV__IORING_SQ_CQ_OVERFLOW ||
+      *iou->sqtail != __atomic_load_n(iou->sqhead, __ATOMIC_ACQUIRE)) {
+    do
+      rc = uv__io_uring_enter(iou->ringfd,
+                              *iou->sqtail - *iou->sqhead,
+                              0,
+                              UV__IORING_ENTER_GETEVENTS);
+    while (rc == -1 && errno == EINTR);
+
+    if (rc == -1 && errno != EAGAIN && errno != EBUSY)
+      abort();
+
+    if (flags & UV__IORING_SQ_CQ_OVERFLOW)
+      goto again;
+  }
+}
+
+
 uint64_t uv__hrtime(uv_clocktype_t type) {
   static clock_t fast_clock_id = -1;
   struct timespec t;
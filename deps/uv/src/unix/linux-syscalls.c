@@ -203,6 +203,19 @@
 # endif
 #endif /* __NR_statx */
 
+/* io_uring shares one syscall number across architectures, except alpha. */
+#ifndef __NR_io_uring_setup
+# if !defined(__alpha__)
+#  define __NR_io_uring_setup 425
+# endif
+#endif /* __NR_io_uring_setup */
+
+#ifndef __NR_io_uring_enter
+# if !defined(__alpha__)
+#  define __NR_io_uring_enter 426
+# endif
+#endif /* __NR_io_uring_enter */
+
 int uv__accept4(int fd, struct sockaddr* addr, socklen_t* addrlen, int flags) {
 #if defined(__i386__)
   unsigned long args[4];
@@ -364,3 +377,34 @@ int uv__statx(int dirfd,
   return errno = ENOSYS, -1;
 #endif
 }
+
+
+int uv__io_uring_setup(int entries, struct uv__io_uring_params* params) {
+#if defined(__NR_io_uring_setup)
+  return syscall(__NR_io_uring_setup, entries, params);
+#else
+  return errno = ENOSYS, -1;
+#endif
+}
+
+
+int uv__io_uring_enter(int fd,
+                       unsigned to_submit,
+                       unsigned min_complete,
+                       unsigned flags) {
+#if defined(__NR_io_uring_enter)
+  /* io_uring_enter used to take a sigset_t but it's unused
+   * in newer kernels unless IORING_ENTER_EXT_ARG is set,
+   * in which case it takes a struct io_uring_getevents_arg.
+   */
+  return syscall(__NR_io_uring_enter,
+                 fd,
+                 to_submit,
+                 min_complete,
+                 flags,
+                 NULL,
+                 0L);
+#else
+  return errno = ENOSYS, -1;
+#endif
+}
@@ -27,6 +27,20 @@
 #include <assert.h>
 #include <errno.h>
 
+#if defined(__linux__)
+# include <linux/filter.h>
+#endif
+
+/* FreeBSD's SO_REUSEPORT doesn't balance between listeners, SO_REUSEPORT_LB
+ * does. Other platforms (notably macOS) only hand out connections to the
+ * most recently bound socket, which is not what UV_TCP_REUSEPORT promises.
+ */
+#if defined(SO_REUSEPORT_LB)
+# define UV__SO_REUSEPORT SO_REUSEPORT_LB
+#elif defined(SO_REUSEPORT) && (defined(__linux__) || defined(__DragonFly__))
+# define UV__SO_REUSEPORT SO_REUSEPORT
+#endif
+
 
 static int new_socket(uv_tcp_t* handle, int domain, unsigned long flags) {
   struct sockaddr_storage saddr;
@@ -156,6 +170,11 @@ int uv__tcp_bind(uv_tcp_t* tcp,
   if ((flags & UV_TCP_IPV6ONLY) && addr->sa_family != AF_INET6)
     return UV_EINVAL;
 
+#ifndef UV__SO_REUSEPORT
+  if (flags & UV_TCP_REUSEPORT)
+    return UV_ENOTSUP;
+#endif
+
   err = maybe_new_socket(tcp, addr->sa_family, 0);
   if (err)
     return err;
@@ -164,6 +183,18 @@ int uv__tcp_bind(uv_tcp_t* tcp,
   if (setsockopt(tcp->io_watcher.fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on)))
     return UV__ERR(errno);
 
+#ifdef UV__SO_REUSEPORT
+  if (flags & UV_TCP_REUSEPORT) {
+    if (setsockopt(tcp->io_watcher.fd,
+                   SOL_SOCKET,
+                   UV__SO_REUSEPORT,
+                   &on,
+                   sizeof(on))) {
+      return UV__ERR(errno);
+    }
+  }
+#endif
+
 #ifndef __OpenBSD__
 #ifdef IPV6_V6ONLY
   if (addr->sa_family == AF_INET6) {
@@ -379,6 +410,41 @@ int uv__tcp_keepalive(int fd, int on, unsigned int delay) {
 }
 
 
+int uv_tcp_reuseport_steer_cpu(uv_tcp_t* handle, unsigned int group_size) {
+#if defined(__linux__) && defined(SO_ATTACH_REUSEPORT_CBPF)
+  /* return cpu % group_size */
+  struct sock_filter code[] = {
+    { BPF_LD | BPF_W | BPF_ABS, 0, 0, SKF_AD_OFF + SKF_AD_CPU },
+    { BPF_ALU | BPF_MOD | BPF_K, 0, 0, 0 },
+    { BPF_RET | BPF_A, 0, 0, 0 }
+  };
+  struct sock_fprog prog;
+
+  if (group_size == 0)
+    return UV_EINVAL;
+
+  if (uv__stream_fd(handle) == -1)
+    return UV_EBADF;
+
+  code[1].k = group_size;
+  prog.len = ARRAY_SIZE(code);
+  prog.filter = code;
+
+  if (setsockopt(uv__stream_fd(handle),
+                 SOL_SOCKET,
+                 SO_ATTACH_REUSEPORT_CBPF,
+                 &prog,
+                 sizeof(prog))) {
+    return UV__ERR(errno);
+  }
+
+  return 0;
+#else
+  return UV_ENOTSUP;
+#endif
+}
+
+
 int uv_tcp_nodelay(uv_tcp_t* handle, int on) {
   int err;
 
@@ -39,11 +39,44 @@
 # define IPV6_DROP_MEMBERSHIP IPV6_LEAVE_GROUP
 #endif
 
+#if defined(__linux__)
+# define HAVE_MMSG 1
+#else
+# define HAVE_MMSG 0
+#endif
+
+#if HAVE_MMSG
+/* Max number of datagrams moved by one recvmmsg()/sendmmsg() call. */
+# define UV__MMSG_MAXWIDTH 20
+# ifndef SOL_UDP
+#  define SOL_UDP 17
+# endif
+# ifndef UDP_SEGMENT
+#  define UDP_SEGMENT 103
+# endif
+/* The kernel caps GSO at 64 segments and a 64 KiB super-datagram. */
+# define UV__UDP_MAX_SEGMENTS 64
+# define UV__UDP_GSO_MAXSIZE 65000
+#endif
+
+#define UV__UDP_DGRAM_MAXSIZE (64 * 1024)
+
 
 static void uv__udp_run_completed(uv_udp_t* handle);
 static void uv__udp_io(uv_loop_t* loop, uv__io_t* w, unsigned int revents);
 static void uv__udp_recvmsg(uv_udp_t* handle);
 static void uv__udp_sendmsg(uv_udp_t* handle);
+#if HAVE_MMSG
+static int uv__udp_recvmmsg(uv_udp_t* handle, uv_buf_t* buf);
+static int uv__udp_sendmmsg(uv_udp_t* handle);
+static void uv__udp_mmsg_init(void);
+
+/* Set once by uv__udp_mmsg_init() and only read afterwards, so that loops on
+ * different threads can share it.
+ */
+static uv_once_t uv__udp_mmsg_once = UV_ONCE_INIT;
+static int uv__udp_mmsg_avail;
+#endif
 static int uv__udp_maybe_deferred_bind(uv_udp_t* handle,
                                        int domain,
                                        unsigned int flags);
@@ -148,6 +181,101 @@ static void uv__udp_io(uv_loop_t* loop, uv__io_t* w, unsigned int revents) {
 }
 
 
+#if HAVE_MMSG
+static void uv__udp_mmsg_init(void) {
+  int ret;
+  int s;
+
+  s = uv__socket(AF_INET, SOCK_DGRAM, 0);
+  if (s < 0)
+    return;
+
+  ret = uv__sendmmsg(s, NULL, 0, 0);
+  if (ret == 0 || errno != ENOSYS) {
+    ret = uv__recvmmsg(s, NULL, 0, MSG_DONTWAIT, NULL);
+    if (ret == 0 || errno != ENOSYS)
+      uv__udp_mmsg_avail = 1;
+  }
+
+  uv__close(s);
+}
+
+
+static int uv__udp_recvmmsg(uv_udp_t* handle, uv_buf_t* buf) {
+  struct sockaddr_storage peers[UV__MMSG_MAXWIDTH];
+  struct iovec iov[UV__MMSG_MAXWIDTH];
+  struct uv__mmsghdr msgs[UV__MMSG_MAXWIDTH];
+  uv_udp_recv_cb recv_cb;
+  const struct sockaddr* addr;
+  ssize_t nread;
+  uv_buf_t chunk_buf;
+  size_t chunks;
+  size_t k;
+  int flags;
+
+  /* Carve the buffer into datagram-sized chunks, one per message. */
+  chunks = buf->len / UV__UDP_DGRAM_MAXSIZE;
+  if (chunks > ARRAY_SIZE(iov))
+    chunks = ARRAY_SIZE(iov);
+
+  if (chunks == 0)
+    return UV_ENOSYS;  /* Too small for recvmmsg() to be of any use. */
+
+  memset(msgs, 0, chunks * sizeof(msgs[0]));
+  for (k = 0; k < chunks; k++) {
+    iov[k].iov_base = buf->base + k * UV__UDP_DGRAM_MAXSIZE;
+    iov[k].iov_len = UV__UDP_DGRAM_MAXSIZE;
+    msgs[k].msg_hdr.msg_iov = iov + k;
+    msgs[k].msg_hdr.msg_iovlen = 1;
+    msgs[k].msg_hdr.msg_name = peers + k;
+    msgs[k].msg_hdr.msg_namelen = sizeof(peers[0]);
+  }
+
+  do
+    nread = uv__recvmmsg(handle->io_watcher.fd, msgs, chunks, 0, NULL);
+  while (nread == -1 && errno == EINTR);
+
+  if (nread == -1 && errno == ENOSYS)
+    return UV_ENOSYS;  /* Let the caller fall back to recvmsg(). */
+
+  if (nread < 1) {
+    if (nread == 0 || errno == EAGAIN || errno == EWOULDBLOCK)
+      handle->recv_cb(handle, 0, buf, NULL, 0);
+    else
+      handle->recv_cb(handle, UV__ERR(errno), buf, NULL, 0);
+    return 0;
+  }
+
+  /* The callback may stop reading or close the handle halfway through the
+   * batch. The buffer must still be handed back exactly once, so hold on to
+   * the callback for the final call.
+   */
+  recv_cb = handle->recv_cb;
+
+  for (k = 0; k < (size_t) nread; k++) {
+    if (handle->recv_cb == NULL || handle->io_watcher.fd == -1)
+      break;
+
+    flags = UV_UDP_MMSG_CHUNK;
+    if (msgs[k].msg_hdr.msg_flags & MSG_TRUNC)
+      flags |= UV_UDP_PARTIAL;
+
+    addr = NULL;
+    if (msgs[k].msg_hdr.msg_namelen != 0)
+      addr = (const struct sockaddr*) &peers[k];
+
+    chunk_buf = uv_buf_init(iov[k].iov_base, iov[k].iov_len);
+    handle->recv_cb(handle, msgs[k].msg_len, &chunk_buf, addr, flags);
+  }
+
+  /* One last callback so the original buffer is released. */
+  recv_cb(handle, 0, buf, NULL, 0);
+
+  return nread;
+}
+#endif /* HAVE_MMSG */
+
+
 static void uv__udp_recvmsg(uv_udp_t* handle) {
   struct sockaddr_storage peer;
   struct msghdr h;
@@ -169,7 +297,29 @@ static void uv__udp_recvmsg(uv_udp_t* handle) {
 
   do {
     buf = uv_buf_init(NULL, 0);
-    handle->alloc_cb((uv_handle_t*) handle, 64 * 1024, &buf);
+#if HAVE_MMSG
+    if (uv_udp_using_recvmmsg(handle)) {
+      handle->alloc_cb((uv_handle_t*) handle,
+                       UV__MMSG_MAXWIDTH * UV__UDP_DGRAM_MAXSIZE,
+                       &buf);
+      if (buf.base == NULL || buf.len == 0) {
+        handle->recv_cb(handle, UV_ENOBUFS, &buf, NULL, 0);
+        return;
+      }
+
+      nread = uv__udp_recvmmsg(handle, &buf);
+      if (nread > 0) {
+        count -= nread;
+        continue;
+      }
+
+      if (nread == 0)
+        return;
+
+      /* Undersized buffer or recvmmsg() denied, do a plain recvmsg() into it. */
+    } else
+#endif
+    handle->alloc_cb((uv_handle_t*) handle, UV__UDP_DGRAM_MAXSIZE, &buf);
     if (buf.base == NULL || buf.len == 0) {
       handle->recv_cb(handle, UV_ENOBUFS, &buf, NULL, 0);
       return;
@@ -213,12 +363,92 @@ static void uv__udp_recvmsg(uv_udp_t* handle) {
 }
 
 
+#if HAVE_MMSG
+static void uv__udp_msghdr_init(struct msghdr* h, uv_udp_send_t* req) {
+  memset(h, 0, sizeof(*h));
+  if (req->addr.ss_family == AF_UNSPEC) {
+    h->msg_name = NULL;
+    h->msg_namelen = 0;
+  } else {
+    h->msg_name = &req->addr;
+    h->msg_namelen = req->addr.ss_family == AF_INET6 ?
+      sizeof(struct sockaddr_in6) : sizeof(struct sockaddr_in);
+  }
+  h->msg_iov = (struct iovec*) req->bufs;
+  h->msg_iovlen = req->nbufs;
+}
+
+
+/* Drains the write queue with sendmmsg(), up to UV__MMSG_MAXWIDTH requests per
+ * system call. Returns UV_ENOSYS when the kernel doesn't have sendmmsg(), in
+ * which case the caller falls back to sendmsg().
+ */
+static int uv__udp_sendmmsg(uv_udp_t* handle) {
+  struct uv__mmsghdr h[UV__MMSG_MAXWIDTH];
+  uv_udp_send_t* req;
+  QUEUE* q;
+  ssize_t npkts;
+  size_t pkts;
+  size_t i;
+
+  while (!QUEUE_EMPTY(&handle->write_queue)) {
+    for (pkts = 0, q = QUEUE_HEAD(&handle->write_queue);
+         pkts < UV__MMSG_MAXWIDTH && q != &handle->write_queue;
+         ++pkts, q = QUEUE_NEXT(q)) {
+      req = QUEUE_DATA(q, uv_udp_send_t, queue);
+      uv__udp_msghdr_init(&h[pkts].msg_hdr, req);
+      h[pkts].msg_len = 0;
+    }
+
+    do
+      npkts = uv__sendmmsg(handle->io_watcher.fd, h, pkts, 0);
+    while (npkts == -1 && errno == EINTR);
+
+    if (npkts == -1) {
+      if (errno == ENOSYS)
+        return UV_ENOSYS;
+
+      if (errno == EAGAIN || errno == EWOULDBLOCK || errno == ENOBUFS)
+        break;
+
+      /* sendmmsg() only reports an error when the first datagram fails. Fail
+       * that request and carry on with the rest of the queue.
+       */
+      npkts = 0;
+      req = QUEUE_DATA(QUEUE_HEAD(&handle->write_queue), uv_udp_send_t, queue);
+      req->status = UV__ERR(errno);
+      QUEUE_REMOVE(&req->queue);
+      QUEUE_INSERT_TAIL(&handle->write_completed_queue, &req->queue);
+    }
+
+    /* Sending a datagram is an atomic operation, see uv__udp_sendmsg(). */
+    for (i = 0; i < (size_t) npkts; i++) {
+      q = QUEUE_HEAD(&handle->write_queue);
+      req = QUEUE_DATA(q, uv_udp_send_t, queue);
+      req->status = h[i].msg_len;
+      QUEUE_REMOVE(&req->queue);
+      QUEUE_INSERT_TAIL(&handle->write_completed_queue, &req->queue);
+    }
+
+    uv__io_feed(handle->loop, &handle->io_watcher);
+  }
+
+  return 0;
+}
+#endif /* HAVE_MMSG */
+
+
 static void uv__udp_sendmsg(uv_udp_t* handle) {
   uv_udp_send_t* req;
   QUEUE* q;
   struct msghdr h;
   ssize_t size;
 
+#if HAVE_MMSG
+  if (uv__udp_mmsg_avail && uv__udp_sendmmsg(handle) != UV_ENOSYS)
+    return;
+#endif
+
   while (!QUEUE_EMPTY(&handle->write_queue)) {
     q = QUEUE_HEAD(&handle->write_queue);
     assert(q != NULL);
@@ -542,6 +772,195 @@ int uv__udp_try_send(uv_udp_t* handle,
 }
 
 
+#if HAVE_MMSG
+/* Sends up to UV__UDP_MAX_SEGMENTS equally sized datagrams as one
+ * super-datagram that the kernel or the NIC splits up again. Returns the number
+ * of datagrams sent, or UV_ENOTSUP when the batch isn't eligible or the path
+ * doesn't support segmentation offload.
+ */
+static int uv__udp_try_send_gso(uv_udp_t* handle,
+                                const uv_buf_t bufs[],
+                                unsigned int nbufs,
+                                const struct sockaddr* addr,
+                                unsigned int addrlen) {
+  union {
+    char buf[CMSG_SPACE(sizeof(uint16_t))];
+    struct cmsghdr align;
+  } control;
+  struct cmsghdr* cmsg;
+  struct msghdr h;
+  uint16_t segment_size;
+  unsigned int nsegs;
+  unsigned int i;
+  ssize_t size;
+
+  if (handle->flags & UV_HANDLE_UDP_NO_GSO)
+    return UV_ENOTSUP;
+
+  segment_size = bufs[0].len;
+  if (nbufs < 2 || bufs[0].len == 0 || bufs[0].len > UV__UDP_GSO_MAXSIZE)
+    return UV_ENOTSUP;
+
+  /* All segments but the last one must be exactly segment_size bytes. */
+  nsegs = UV__UDP_GSO_MAXSIZE / segment_size;
+  if (nsegs > UV__UDP_MAX_SEGMENTS)
+    nsegs = UV__UDP_MAX_SEGMENTS;
+  if (nsegs > nbufs)
+    nsegs = nbufs;
+
+  for (i = 1; i < nsegs; i++) {
+    if (bufs[i].len > segment_size)
+      break;
+    if (bufs[i].len < segment_size) {
+      i++;
+      break;
+    }
+  }
+
+  nsegs = i;
+  if (nsegs < 2)
+    return UV_ENOTSUP;
+
+  memset(&control, 0, sizeof(control));
+  memset(&h, 0, sizeof(h));
+  h.msg_name = (struct sockaddr*) addr;
+  h.msg_namelen = addrlen;
+  h.msg_iov = (struct iovec*) bufs;
+  h.msg_iovlen = nsegs;
+  h.msg_control = control.buf;
+  h.msg_controllen = sizeof(control.buf);
+
+  cmsg = CMSG_FIRSTHDR(&h);
+  cmsg->cmsg_level = SOL_UDP;
+  cmsg->cmsg_type = UDP_SEGMENT;
+  cmsg->cmsg_len = CMSG_LEN(sizeof(segment_size));
+  memcpy(CMSG_DATA(cmsg), &segment_size, sizeof(segment_size));
+
+  do
+    size = sendmsg(handle->io_watcher.fd, &h, 0);
+  while (size == -1 && errno == EINTR);
+
+  if (size == -1) {
+    if (errno == EAGAIN || errno == EWOULDBLOCK || errno == ENOBUFS)
+      return UV_EAGAIN;
+
+    /* EIO: no checksum offload on the egress device. EINVAL/ENOPROTOOPT:
+     * kernel predates UDP_SEGMENT (4.18). Don't try again on this handle.
+     */
+    if (errno == EIO || errno == EINVAL || errno == ENOPROTOOPT) {
+      handle->flags |= UV_HANDLE_UDP_NO_GSO;
+      return UV_ENOTSUP;
+    }
+
+    return UV__ERR(errno);
+  }
+
+  return nsegs;
+}
+
+
+static int uv__udp_try_sendmmsg(uv_udp_t* handle,
+                                const uv_buf_t bufs[],
+                                unsigned int nbufs,
+                                const struct sockaddr* addr,
+                                unsigned int addrlen) {
+  struct uv__mmsghdr h[UV__MMSG_MAXWIDTH];
+  unsigned int pkts;
+  int npkts;
+
+  if (nbufs > UV__MMSG_MAXWIDTH)
+    nbufs = UV__MMSG_MAXWIDTH;
+
+  memset(h, 0, nbufs * sizeof(h[0]));
+  for (pkts = 0; pkts < nbufs; pkts++) {
+    h[pkts].msg_hdr.msg_name = (struct sockaddr*) addr;
+    h[pkts].msg_hdr.msg_namelen = addrlen;
+    h[pkts].msg_hdr.msg_iov = (struct iovec*) &bufs[pkts];
+    h[pkts].msg_hdr.msg_iovlen = 1;
+  }
+
+  do
+    npkts = uv__sendmmsg(handle->io_watcher.fd, h, pkts, 0);
+  while (npkts == -1 && errno == EINTR);
+
+  if (npkts == -1) {
+    if (errno == ENOSYS)
+      return UV_ENOSYS;
+
+    if (errno == EAGAIN || errno == EWOULDBLOCK || errno == ENOBUFS)
+      return UV_EAGAIN;
+
+    return UV__ERR(errno);
+  }
+
+  return npkts;
+}
+#endif /* HAVE_MMSG */
+
+
+int uv__udp_try_send_batch(uv_udp_t* handle,
+                           const uv_buf_t bufs[],
+                           unsigned int nbufs,
+                           const struct sockaddr* addr,
+                           unsigned int addrlen,
+                           unsigned int flags) {
+  unsigned int sent;
+  int err;
+
+  assert(nbufs > 0);
+
+  /* Already sending a message. */
+  if (handle->send_queue_count != 0)
+    return UV_EAGAIN;
+
+  if (addr) {
+    err = uv__udp_maybe_deferred_bind(handle, addr->sa_family, 0);
+    if (err)
+      return err;
+  } else {
+    assert(handle->flags & UV_HANDLE_UDP_CONNECTED);
+  }
+
+  sent = 0;
+  while (sent < nbufs) {
+    err = UV_ENOSYS;
+
+#if HAVE_MMSG
+    if (flags & UV_UDP_SEGMENT)
+      err = uv__udp_try_send_gso(handle,
+                                 bufs + sent,
+                                 nbufs - sent,
+                                 addr,
+                                 addrlen);
+
+    if (err == UV_ENOTSUP || err == UV_ENOSYS) {
+      if (!uv__udp_mmsg_avail)
+        err = UV_ENOSYS;
+      else
+        err = uv__udp_try_sendmmsg(handle,
+                                   bufs + sent,
+                                   nbufs - sent,
+                                   addr,
+                                   addrlen);
+    }
+#endif
+
+    if (err == UV_ENOSYS) {
+      err = uv__udp_try_send(handle, bufs + sent, 1, addr, addrlen);
+      if (err >= 0)
+        err = 1;
+    }
+
+    if (err < 0)
+      return sent == 0 ? err : (int) sent;
+
+    sent += err;
+  }
+
+  return sent;
+}
+
+
 static int uv__udp_set_membership4(uv_udp_t* handle,
                                    const struct sockaddr_in* multicast_addr,
                                    const char* interface_addr,
@@ -646,7 +1065,7 @@ int uv_udp_init_ex(uv_loop_t* loop, uv_udp_t* handle, unsigned int flags) {
   if (domain != AF_INET && domain != AF_INET6 && domain != AF_UNSPEC)
     return UV_EINVAL;
 
-  if (flags & ~0xFF)
+  if (flags & ~(0xFF | UV_UDP_RECVMMSG))
     return UV_EINVAL;
 
   if (domain != AF_UNSPEC) {
@@ -659,6 +1078,11 @@ int uv_udp_init_ex(uv_loop_t* loop, uv_udp_t* handle, unsigned int flags) {
   }
 
   uv__handle_init(loop, (uv_handle_t*)handle, UV_UDP);
+#if HAVE_MMSG
+  uv_once(&uv__udp_mmsg_once, uv__udp_mmsg_init);
+  if ((flags & UV_UDP_RECVMMSG) && uv__udp_mmsg_avail)
+    handle->flags |= UV_HANDLE_UDP_RECVMMSG;
+#endif
   handle->alloc_cb = NULL;
   handle->recv_cb = NULL;
   handle->send_queue_size = 0;
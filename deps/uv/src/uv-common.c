@@ -416,6 +416,29 @@ int uv_udp_try_send(uv_udp_t* handle,
 }
 
 
+int uv_udp_try_send_batch(uv_udp_t* handle,
+                          const uv_buf_t bufs[],
+                          unsigned int nbufs,
+                          const struct sockaddr* addr,
+                          unsigned int flags) {
+  int addrlen;
+
+  if (nbufs == 0 || (flags & ~UV_UDP_SEGMENT))
+    return UV_EINVAL;
+
+  addrlen = uv__udp_check_before_send(handle, addr);
+  if (addrlen < 0)
+    return addrlen;
+
+  return uv__udp_try_send_batch(handle, bufs, nbufs, addr, addrlen, flags);
+}
+
+
+int uv_udp_using_recvmmsg(const uv_udp_t* handle) {
+  return (handle->flags & UV_HANDLE_UDP_RECVMMSG) != 0;
+}
+
+
 int uv_udp_recv_start(uv_udp_t* handle,
                       uv_alloc_cb alloc_cb,
                       uv_udp_recv_cb recv_cb) {
@@ -599,6 +622,65 @@ void uv__fs_scandir_cleanup(uv_fs_t* req) {
 }
 
 
+uv_dirent_type_t uv__fs_get_dirent_type(uv__dirent_t* dent) {
+  uv_dirent_type_t type;
+
+#ifdef HAVE_DIRENT_TYPES
+  switch (dent->d_type) {
+    case UV__DT_DIR:
+      type = UV_DIRENT_DIR;
+      break;
+    case UV__DT_FILE:
+      type = UV_DIRENT_FILE;
+      break;
+    case UV__DT_LINK:
+      type = UV_DIRENT_LINK;
+      break;
+    case UV__DT_FIFO:
+      type = UV_DIRENT_FIFO;
+      break;
+    case UV__DT_SOCKET:
+      type = UV_DIRENT_SOCKET;
+      break;
+    case UV__DT_CHAR:
+      type = UV_DIRENT_CHAR;
+      break;
+    case UV__DT_BLOCK:
+      type = UV_DIRENT_BLOCK;
+      break;
+    default:
+      type = UV_DIRENT_UNKNOWN;
+  }
+#else
+  type = UV_DIRENT_UNKNOWN;
+#endif
+
+  return type;
+}
+
+
+void uv__fs_readdir_cleanup(uv_fs_t* req) {
+  uv_dir_t* dir;
+  uv_dirent_t* dirents;
+  int i;
+
+  if (req->ptr == NULL)
+    return;
+
+  dir = req->ptr;
+  dirents = dir->dirents;
+  req->ptr = NULL;
+
+  if (dirents == NULL)
+    return;
+
+  for (i = 0; i < req->result; ++i) {
+    uv__free((char*) dirents[i].name);
+    dirents[i].name = NULL;
+  }
+}
+
+
 int uv_fs_scandir_next(uv_fs_t* req, uv_dirent_t* ent) {
   uv__dirent_t** dents;
   uv__dirent_t* dent;
@@ -631,35 +713,7 @@ int uv_fs_scandir_next(uv_fs_t* req, uv_dirent_t* ent) {
   dent = dents[(*nbufs)++];
 
   ent->name = dent->d_name;
-#ifdef HAVE_DIRENT_TYPES
-  switch (dent->d_type) {
-    case UV__DT_DIR:
-      ent->type = UV_DIRENT_DIR;
-      break;
-    case UV__DT_FILE:
-      ent->type = UV_DIRENT_FILE;
-      break;
-    case UV__DT_LINK:
-      ent->type = UV_DIRENT_LINK;
-      break;
-    case UV__DT_FIFO:
-      ent->type = UV_DIRENT_FIFO;
-      break;
-    case UV__DT_SOCKET:
-      ent->type = UV_DIRENT_SOCKET;
-      break;
-    case UV__DT_CHAR:
-      ent->type = UV_DIRENT_CHAR;
-      break;
-    case UV__DT_BLOCK:
-      ent->type = UV_DIRENT_BLOCK;
-      break;
-    default:
-      ent->type = UV_DIRENT_UNKNOWN;
-  }
-#else
-  ent->type = UV_DIRENT_UNKNOWN;
-#endif
+  ent->type = uv__fs_get_dirent_type(dent);
 
   return 0;
 }
@@ -727,6 +781,7 @@ int uv_loop_close(uv_loop_t* loop) {
   }
 
   uv__loop_close(loop);
+  uv__timer_wheel_free(loop);
 
 #ifndef NDEBUG
   saved_data = loop->data;
@@ -104,6 +104,8 @@ enum {
   /* Only used by uv_udp_t handles. */
   UV_HANDLE_UDP_PROCESSING              = 0x01000000,
   UV_HANDLE_UDP_CONNECTED               = 0x02000000,
+  UV_HANDLE_UDP_RECVMMSG                = 0x04000000,
+  UV_HANDLE_UDP_NO_GSO                  = 0x08000000,
 
   /* Only used by uv_pipe_t handles. */
   UV_HANDLE_NON_OVERLAPPED_PIPE         = 0x01000000,
@@ -120,7 +122,11 @@ enum {
   UV_SIGNAL_ONE_SHOT                    = 0x02000000,
 
   /* Only used by uv_poll_t handles. */
-  UV_HANDLE_POLL_SLOW                   = 0x01000000
+  UV_HANDLE_POLL_SLOW                   = 0x01000000,
+
+  /* Only used by uv_timer_t handles. */
+  UV_HANDLE_TIMER_COARSE                = 0x01000000,
+  UV_HANDLE_TIMER_IN_WHEEL              = 0x02000000
 };
 
 int uv__loop_configure(uv_loop_t* loop, uv_loop_option option, va_list ap);
@@ -165,6 +171,13 @@ int uv__udp_try_send(uv_udp_t* handle,
                      const struct sockaddr* addr,
                      unsigned int addrlen);
 
+int uv__udp_try_send_batch(uv_udp_t* handle,
+                           const uv_buf_t bufs[],
+                           unsigned int nbufs,
+                           const struct sockaddr* addr,
+                           unsigned int addrlen,
+                           unsigned int flags);
+
 int uv__udp_recv_start(uv_udp_t* handle, uv_alloc_cb alloccb,
                        uv_udp_recv_cb recv_cb);
 
@@ -175,12 +188,13 @@ void uv__fs_poll_close(uv_fs_poll_t* handle);
 int uv__getaddrinfo_translate_error(int sys_err);    /* EAI_* error. */
 
 enum uv__work_kind {
-  UV__WORK_CPU,
-  UV__WORK_FAST_IO,
-  UV__WORK_SLOW_IO
+  UV__WORK_CPU = UV_WORK_CPU,
+  UV__WORK_FAST_IO = UV_WORK_FAST_IO,
+  UV__WORK_SLOW_IO = UV_WORK_SLOW_IO
 };
 
 void uv__work_submit(uv_loop_t* loop,
+                     uv_req_t* req,
                      struct uv__work *w,
                      enum uv__work_kind kind,
                      void (*work)(struct uv__work *w),
@@ -193,10 +207,13 @@ size_t uv__count_bufs(const uv_buf_t bufs[], unsigned int nbufs);
 int uv__socket_sockopt(uv_handle_t* handle, int optname, int* value);
 
 void uv__fs_scandir_cleanup(uv_fs_t* req);
+void uv__fs_readdir_cleanup(uv_fs_t* req);
+uv_dirent_type_t uv__fs_get_dirent_type(uv__dirent_t* dent);
 
 int uv__next_timeout(const uv_loop_t* loop);
 void uv__run_timers(uv_loop_t* loop);
 void uv__timer_close(uv_timer_t* handle);
+void uv__timer_wheel_free(uv_loop_t* loop);
 
 #define uv__has_active_reqs(loop)                                             \
   ((loop)->active_reqs.count > 0)
@@ -255,6 +255,7 @@ int uv_loop_init(uv_loop_t* loop) {
   }
 
   heap_init(timer_heap);
+  loop->timer_wheel = NULL;
 
   loop->check_handles = NULL;
   loop->prepare_handles = NULL;
@@ -144,6 +144,7 @@ int uv_getnameinfo(uv_loop_t* loop,
 
   if (getnameinfo_cb) {
     uv__work_submit(loop,
+                    (uv_req_t*) req,
                     &req->work_req,
                     UV__WORK_SLOW_IO,
                     uv__getnameinfo_work,
@@ -298,6 +298,11 @@ static int uv_tcp_try_bind(uv_tcp_t* handle,
   DWORD err;
   int r;
 
+  /* SO_REUSEADDR on Windows lets sockets steal each other's address, it
+   * doesn't balance connections between them. */
+  if (flags & UV_TCP_REUSEPORT)
+    return ERROR_NOT_SUPPORTED;
+
   if (handle->socket == INVALID_SOCKET) {
     SOCKET sock;
 
@@ -1286,6 +1291,11 @@ int uv_tcp_keepalive(uv_tcp_t* handle, int enable, unsigned int delay) {
 }
 
 
+int uv_tcp_reuseport_steer_cpu(uv_tcp_t* handle, unsigned int group_size) {
+  return UV_ENOTSUP;
+}
+
+
 int uv_tcp_simultaneous_accepts(uv_tcp_t* handle, int enable) {
   if (handle->flags & UV_HANDLE_CONNECTION) {
     return UV_EINVAL;
@@ -133,7 +133,8 @@ int uv_udp_init_ex(uv_loop_t* loop, uv_udp_t* handle, unsigned int flags) {
   if (domain != AF_INET && domain != AF_INET6 && domain != AF_UNSPEC)
     return UV_EINVAL;
 
-  if (flags & ~0xFF)
+  /* recvmmsg is not available on Windows, UV_UDP_RECVMMSG is a no-op. */
+  if (flags & ~(0xFF | UV_UDP_RECVMMSG))
     return UV_EINVAL;
 
   uv__handle_init(loop, (uv_handle_t*) handle, UV_UDP);
@@ -1033,3 +1034,22 @@ int uv__udp_try_send(uv_udp_t* handle,
 
   return bytes;
 }
+
+
+int uv__udp_try_send_batch(uv_udp_t* handle,
+                           const uv_buf_t bufs[],
+                           unsigned int nbufs,
+                           const struct sockaddr* addr,
+                           unsigned int addrlen,
+                           unsigned int flags) {
+  unsigned int i;
+  int err;
+
+  for (i = 0; i < nbufs; i++) {
+    err = uv__udp_try_send(handle, &bufs[i], 1, addr, addrlen);
+    if (err < 0)
+      return i == 0 ? err : (int) i;
+  }
+
+  return nbufs;
+}
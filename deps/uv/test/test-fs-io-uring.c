@@ -0,0 +1,288 @@
+/* Copyright libuv project contributors. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+/* These tests are Linux only. */
+#ifdef __linux__
+
+#include "uv.h"
+#include "task.h"
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#define NUM_STATS 200  /* More than fit in the submission queue. */
+#define ROOT_ONLY_FILE "test_file_io_uring"
+
+static uv_fs_t stat_reqs[NUM_STATS];
+static uv_work_t pause_reqs[4];
+static uv_sem_t pause_sem;
+static uv_sem_t running_sem;
+static int stat_cb_called;
+static int open_cb_called;
+static int read_cb_called;
+static ssize_t read_result;
+
+
+/* Returns 1 if the process has an io_uring instance open. */
+static int have_ring(void) {
+  struct dirent* ent;
+  char path[512];
+  char link[64];
+  ssize_t n;
+  DIR* dir;
+  int found;
+
+  dir = opendir("/proc/self/fd");
+  ASSERT(dir != NULL);
+
+  found = 0;
+  while (!found && (ent = readdir(dir)) != NULL) {
+    snprintf(path, sizeof(path), "/proc/self/fd/%s", ent->d_name);
+    n = readlink(path, link, sizeof(link) - 1);
+    if (n < 0)
+      continue;
+    link[n] = '\0';
+    found = strstr(link, "io_uring") != NULL;
+  }
+
+  closedir(dir);
+  return found;
+}
+
+
+static void assert_wait_child(pid_t child_pid) {
+  int child_stat;
+
+  ASSERT(child_pid == waitpid(child_pid, &child_stat, 0));
+  ASSERT(WIFEXITED(child_stat));
+  ASSERT(0 == WEXITSTATUS(child_stat));
+}
+
+
+static void pause_cb(uv_work_t* req) {
+  uv_sem_post(&running_sem);
+  uv_sem_wait(&pause_sem);
+}
+
+
+/* Occupies every thread of the pool, so that new work stays queued. */
+static void saturate_threadpool(uv_loop_t* loop) {
+  size_t i;
+
+  ASSERT(0 == uv_sem_init(&pause_sem, 0));
+  ASSERT(0 == uv_sem_init(&running_sem, 0));
+  for (i = 0; i < ARRAY_SIZE(pause_reqs); i++)
+    ASSERT(0 == uv_queue_work(loop, pause_reqs + i, pause_cb, NULL));
+
+  for (i = 0; i < ARRAY_SIZE(pause_reqs); i++)
+    uv_sem_wait(&running_sem);
+}
+
+
+static void unblock_threadpool(void) {
+  size_t i;
+
+  for (i = 0; i < ARRAY_SIZE(pause_reqs); i++)
+    uv_sem_post(&pause_sem);
+}
+
+
+static void stat_cb(uv_fs_t* req) {
+  ASSERT(req->result == 0);
+  ASSERT(S_ISDIR(req->statbuf.st_mode));
+  uv_fs_req_cleanup(req);
+  stat_cb_called++;
+}
+
+
+static void open_cb(uv_fs_t* req) {
+  open_cb_called++;
+}
+
+
+static void read_cb(uv_fs_t* req) {
+  read_result = req->result;
+  read_cb_called++;
+  uv_fs_req_cleanup(req);
+}
+
+
+TEST_IMPL(fs_io_uring_opt_in) {
+  uv_loop_t* loop;
+
+  /* io_uring is off unless the environment asks for it. */
+  unsetenv("UV_USE_IO_URING");
+  loop = uv_default_loop();
+
+  ASSERT(0 == uv_fs_stat(loop, &stat_reqs[0], ".", stat_cb));
+  ASSERT(0 == uv_run(loop, UV_RUN_DEFAULT));
+  ASSERT(1 == stat_cb_called);
+  ASSERT(0 == have_ring());
+
+  MAKE_VALGRIND_HAPPY();
+  return 0;
+}
+
+
+TEST_IMPL(fs_io_uring_fallback) {
+  uv_loop_t* loop;
+  int i;
+
+  /* Requests that don't fit in the ring go to the threadpool. Either way,
+   * all of them complete.
+   */
+  setenv("UV_USE_IO_URING", "1", 1);
+  loop = uv_default_loop();
+
+  for (i = 0; i < NUM_STATS; i++)
+    ASSERT(0 == uv_fs_stat(loop, &stat_reqs[i], ".", stat_cb));
+
+  ASSERT(0 == uv_run(loop, UV_RUN_DEFAULT));
+  ASSERT(NUM_STATS == stat_cb_called);
+
+  MAKE_VALGRIND_HAPPY();
+  return 0;
+}
+
+
+TEST_IMPL(fs_io_uring_creds) {
+  uv_loop_t* loop;
+  uv_fs_t req;
+  int fd;
+
+  if (geteuid() != 0)
+    RETURN_SKIP("Needs root to change credentials.");
+
+  setenv("UV_USE_IO_URING", "1", 1);
+  setenv("UV_THREADPOOL_SIZE", "4", 1);  /* ARRAY_SIZE(pause_reqs) */
+  loop = uv_default_loop();
+
+  unlink(ROOT_ONLY_FILE);
+  fd = open(ROOT_ONLY_FILE, O_WRONLY | O_CREAT, 0600);
+  ASSERT(fd >= 0);
+  close(fd);
+
+  /* Create the ring while still root. */
+  ASSERT(0 == uv_fs_open(loop, &req, ROOT_ONLY_FILE, O_RDONLY, 0, open_cb));
+  ASSERT(0 == uv_run(loop, UV_RUN_DEFAULT));
+  ASSERT(1 == open_cb_called);
+  ASSERT(req.result >= 0);
+  ASSERT(0 == uv_fs_close(NULL, &req, req.result, NULL));
+  uv_fs_req_cleanup(&req);
+
+  /* After dropping privileges, requests must not run with the credentials
+   * the ring was created with. They go to the threadpool instead, where they
+   * can be cancelled while queued; io_uring requests can't.
+   */
+  ASSERT(0 == setegid(65534));
+  ASSERT(0 == seteuid(65534));
+  saturate_threadpool(loop);
+  ASSERT(0 == uv_fs_open(loop, &req, ROOT_ONLY_FILE, O_RDONLY, 0, open_cb));
+  ASSERT(0 == uv_cancel((uv_req_t*) &req));
+  unblock_threadpool();
+  ASSERT(0 == uv_run(loop, UV_RUN_DEFAULT));
+  ASSERT(2 == open_cb_called);
+  ASSERT(req.result == UV_ECANCELED);
+  uv_fs_req_cleanup(&req);
+
+  ASSERT(0 == uv_fs_open(loop, &req, ROOT_ONLY_FILE, O_RDONLY, 0, open_cb));
+  ASSERT(0 == uv_run(loop, UV_RUN_DEFAULT));
+  ASSERT(0 == seteuid(0));
+  ASSERT(0 == setegid(0));
+
+  ASSERT(3 == open_cb_called);
+  ASSERT(req.result == UV_EACCES);
+  uv_fs_req_cleanup(&req);
+
+  uv_sem_destroy(&pause_sem);
+  uv_sem_destroy(&running_sem);
+
+  unlink(ROOT_ONLY_FILE);
+
+  MAKE_VALGRIND_HAPPY();
+  return 0;
+}
+
+
+TEST_IMPL(fork_fs_io_uring) {
+  /* A child doesn't see the completions of io_uring requests that were in
+   * flight when it forked. They fail with UV_ECANCELED there and complete
+   * normally in the parent.
+   */
+  uv_loop_t* loop;
+  uv_fs_t req;
+  uv_buf_t buf;
+  pid_t child_pid;
+  int fds[2];
+  char c;
+
+  setenv("UV_USE_IO_URING", "1", 1);
+  loop = uv_default_loop();
+
+  ASSERT(0 == pipe(fds));
+  buf = uv_buf_init(&c, 1);
+  ASSERT(0 == uv_fs_read(loop, &req, fds[0], &buf, 1, -1, read_cb));
+
+  if (!have_ring()) {
+    /* The read is blocking a threadpool thread, let it finish. */
+    ASSERT(1 == write(fds[1], "x", 1));
+    ASSERT(0 == uv_run(loop, UV_RUN_DEFAULT));
+    close(fds[0]);
+    close(fds[1]);
+    RETURN_SKIP("io_uring is not available.");
+  }
+
+  child_pid = fork();
+  ASSERT(child_pid != -1);
+
+  if (child_pid != 0) {
+    /* Parent. */
+    ASSERT(1 == write(fds[1], "x", 1));
+    ASSERT(0 == uv_run(loop, UV_RUN_DEFAULT));
+    ASSERT(1 == read_cb_called);
+    ASSERT(1 == read_result);
+    assert_wait_child(child_pid);
+  } else {
+    /* Child. */
+    ASSERT(0 == uv_loop_fork(loop));
+    ASSERT(0 == uv_run(loop, UV_RUN_DEFAULT));
+    ASSERT(1 == read_cb_called);
+    ASSERT(UV_ECANCELED == read_result);
+  }
+
+  close(fds[0]);
+  close(fds[1]);
+
+  MAKE_VALGRIND_HAPPY();
+  return 0;
+}
+
+#else
+
+typedef int file_has_no_tests; /* ISO C forbids an empty translation unit. */
+
+#endif /* __linux__ */
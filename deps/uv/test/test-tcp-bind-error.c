@@ -67,6 +67,52 @@ TEST_IMPL(tcp_bind_error_addrinuse) {
 }
 
 
+TEST_IMPL(tcp_bind_reuseport) {
+  struct sockaddr_in addr;
+  uv_tcp_t server1, server2, server3;
+  int r;
+
+  ASSERT(0 == uv_ip4_addr("127.0.0.1", TEST_PORT, &addr));
+  ASSERT(0 == uv_tcp_init(uv_default_loop(), &server1));
+  r = uv_tcp_bind(&server1, (const struct sockaddr*) &addr, UV_TCP_REUSEPORT);
+  if (r == UV_ENOTSUP) {
+    uv_close((uv_handle_t*) &server1, NULL);
+    uv_run(uv_default_loop(), UV_RUN_DEFAULT);
+    MAKE_VALGRIND_HAPPY();
+    RETURN_SKIP("UV_TCP_REUSEPORT not supported on this platform");
+  }
+  ASSERT(r == 0);
+
+  ASSERT(0 == uv_tcp_init(uv_default_loop(), &server2));
+  r = uv_tcp_bind(&server2, (const struct sockaddr*) &addr, UV_TCP_REUSEPORT);
+  ASSERT(r == 0);
+
+  /* Every socket in the group has to opt in. */
+  ASSERT(0 == uv_tcp_init(uv_default_loop(), &server3));
+  ASSERT(0 == uv_tcp_bind(&server3, (const struct sockaddr*) &addr, 0));
+
+  ASSERT(0 == uv_listen((uv_stream_t*) &server1, 128, NULL));
+  ASSERT(0 == uv_listen((uv_stream_t*) &server2, 128, NULL));
+  ASSERT(UV_EADDRINUSE == uv_listen((uv_stream_t*) &server3, 128, NULL));
+
+  r = uv_tcp_reuseport_steer_cpu(&server1, 2);
+  ASSERT(r == 0 || r == UV_ENOTSUP);
+  if (r == 0)
+    ASSERT(UV_EINVAL == uv_tcp_reuseport_steer_cpu(&server1, 0));
+
+  uv_close((uv_handle_t*) &server1, close_cb);
+  uv_close((uv_handle_t*) &server2, close_cb);
+  uv_close((uv_handle_t*) &server3, close_cb);
+
+  uv_run(uv_default_loop(), UV_RUN_DEFAULT);
+
+  ASSERT(close_cb_called == 3);
+
+  MAKE_VALGRIND_HAPPY();
+  return 0;
+}
+
+
 TEST_IMPL(tcp_bind_error_addrnotavail_1) {
   struct sockaddr_in addr;
   uv_tcp_t server;
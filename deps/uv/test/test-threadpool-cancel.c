@@ -43,9 +43,11 @@ static unsigned done2_cb_called;
 static unsigned timer_cb_called;
 static uv_work_t pause_reqs[4];
 static uv_sem_t pause_sems[ARRAY_SIZE(pause_reqs)];
+static uv_sem_t running_sem;
 
 
 static void work_cb(uv_work_t* req) {
+  uv_sem_post(&running_sem);
   uv_sem_wait(pause_sems + (req - pause_reqs));
 }
 
@@ -67,10 +69,18 @@ static void saturate_threadpool(void) {
   putenv(buf);
 
   loop = uv_default_loop();
+  ASSERT(0 == uv_sem_init(&running_sem, 0));
   for (i = 0; i < ARRAY_SIZE(pause_reqs); i += 1) {
     ASSERT(0 == uv_sem_init(pause_sems + i, 0));
     ASSERT(0 == uv_queue_work(loop, pause_reqs + i, work_cb, done_cb));
   }
+
+  /* Higher priority work can overtake the pause requests while they are
+   * still queued, so wait until all of them are occupying a thread.
+   */
+  for (i = 0; i < ARRAY_SIZE(pause_reqs); i += 1)
+    uv_sem_wait(&running_sem);
+  uv_sem_destroy(&running_sem);
 }
 
 
@@ -243,6 +253,13 @@ TEST_IMPL(threadpool_cancel_fs) {
   unsigned n;
   uv_buf_t iov;
 
+#if defined(__linux__)
+  /* Requests that go through io_uring bypass the threadpool and can't be
+   * cancelled. Force them onto the threadpool for this test.
+   */
+  setenv("UV_USE_IO_URING", "0", 1);
+#endif
+
   INIT_CANCEL_INFO(&ci, reqs);
   loop = uv_default_loop();
   saturate_threadpool();
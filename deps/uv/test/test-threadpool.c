@@ -74,3 +74,124 @@ TEST_IMPL(threadpool_queue_work_einval) {
   MAKE_VALGRIND_HAPPY();
   return 0;
 }
+
+
+static uv_work_t kind_reqs[3];
+static int kind_work_cb_count;
+static int kind_after_work_cb_count;
+
+
+static void kind_work_cb(uv_work_t* req) {
+  kind_work_cb_count++;  /* Races are fine, only checked for non-zero. */
+}
+
+
+static void kind_after_work_cb(uv_work_t* req, int status) {
+  ASSERT(status == 0);
+  kind_after_work_cb_count++;
+}
+
+
+TEST_IMPL(threadpool_queue_work_ex) {
+  uv_loop_t* loop;
+
+  loop = uv_default_loop();
+  ASSERT(0 == uv_queue_work_ex(loop,
+                               kind_reqs + 0,
+                               UV_WORK_CPU,
+                               kind_work_cb,
+                               kind_after_work_cb));
+  ASSERT(0 == uv_queue_work_ex(loop,
+                               kind_reqs + 1,
+                               UV_WORK_FAST_IO,
+                               kind_work_cb,
+                               kind_after_work_cb));
+  ASSERT(0 == uv_queue_work_ex(loop,
+                               kind_reqs + 2,
+                               UV_WORK_SLOW_IO,
+                               kind_work_cb,
+                               kind_after_work_cb));
+  ASSERT(UV_EINVAL == uv_queue_work_ex(loop,
+                                       &work_req,
+                                       (uv_work_kind) 42,
+                                       kind_work_cb,
+                                       kind_after_work_cb));
+
+  ASSERT(0 == uv_run(loop, UV_RUN_DEFAULT));
+  ASSERT(kind_work_cb_count > 0);
+  ASSERT(kind_after_work_cb_count == 3);
+
+  MAKE_VALGRIND_HAPPY();
+  return 0;
+}
+
+
+static uv_work_t blocking_reqs[8];
+static uv_sem_t started_sem;
+static uv_sem_t release_sem;
+static int blocking_after_work_cb_count;
+
+
+static void blocking_work_cb(uv_work_t* req) {
+  uv_sem_post(&started_sem);
+  uv_sem_wait(&release_sem);
+}
+
+
+static void blocking_after_work_cb(uv_work_t* req, int status) {
+  ASSERT(status == 0);
+  blocking_after_work_cb_count++;
+}
+
+
+static void run_blocking_work(unsigned int n) {
+  uv_loop_t* loop;
+  unsigned int i;
+
+  loop = uv_default_loop();
+  blocking_after_work_cb_count = 0;
+
+  for (i = 0; i < n; i++)
+    ASSERT(0 == uv_queue_work(loop,
+                              blocking_reqs + i,
+                              blocking_work_cb,
+                              blocking_after_work_cb));
+
+  /* All of them must be running at the same time for this to return. */
+  for (i = 0; i < n; i++)
+    uv_sem_wait(&started_sem);
+
+  for (i = 0; i < n; i++)
+    uv_sem_post(&release_sem);
+
+  ASSERT(0 == uv_run(loop, UV_RUN_DEFAULT));
+  ASSERT(blocking_after_work_cb_count == (int) n);
+}
+
+
+TEST_IMPL(threadpool_resize) {
+  ASSERT(UV_EINVAL == uv_threadpool_resize(0));
+  ASSERT(UV_EINVAL == uv_threadpool_resize(1024));
+
+  ASSERT(0 == uv_sem_init(&started_sem, 0));
+  ASSERT(0 == uv_sem_init(&release_sem, 0));
+
+  ASSERT(0 == uv_threadpool_resize(ARRAY_SIZE(blocking_reqs)));
+  ASSERT(ARRAY_SIZE(blocking_reqs) == uv_threadpool_size());
+  run_blocking_work(ARRAY_SIZE(blocking_reqs));
+
+  ASSERT(0 == uv_threadpool_resize(2));
+  ASSERT(2 == uv_threadpool_size());
+  run_blocking_work(2);
+
+  /* Growing again revives or restarts the workers that were stopped. */
+  ASSERT(0 == uv_threadpool_resize(6));
+  ASSERT(6 == uv_threadpool_size());
+  run_blocking_work(6);
+
+  uv_sem_destroy(&started_sem);
+  uv_sem_destroy(&release_sem);
+
+  MAKE_VALGRIND_HAPPY();
+  return 0;
+}
@@ -328,3 +328,90 @@ TEST_IMPL(timer_early_check) {
   MAKE_VALGRIND_HAPPY();
   return 0;
 }
+
+
+static uv_timer_t coarse_timers[8];
+static uint64_t coarse_timer_start;
+static int coarse_timer_cb_called;
+
+
+static void coarse_timer_cb(uv_timer_t* handle) {
+  uint64_t elapsed;
+  uint64_t timeout;
+
+  timeout = (uint64_t) (uintptr_t) handle->data;
+  elapsed = uv_now(handle->loop) - coarse_timer_start;
+
+  /* Coarse timers never fire early and at most ~1/8th of the timeout late,
+   * plus scheduling noise.
+   */
+  ASSERT(elapsed >= timeout);
+  ASSERT(elapsed <= timeout + timeout / 8 + 100);
+
+  coarse_timer_cb_called++;
+  uv_close((uv_handle_t*) handle, NULL);
+}
+
+
+static void coarse_never_cb(uv_timer_t* handle) {
+  FATAL("coarse_never_cb should never be called");
+}
+
+
+TEST_IMPL(timer_coarse) {
+  static const uint64_t timeouts[] = { 0, 1, 7, 63, 64, 100, 250, 600 };
+  uv_timer_t stopped;
+  uv_loop_t* loop;
+  unsigned int i;
+
+  loop = uv_default_loop();
+  ASSERT(UV_EINVAL == uv_timer_init_ex(loop, &stopped, 2));
+  ASSERT(0 == uv_timer_init_ex(loop, &stopped, UV_TIMER_COARSE));
+  ASSERT(0 == uv_timer_start(&stopped, coarse_never_cb, 50, 0));
+
+  coarse_timer_start = uv_now(loop);
+  for (i = 0; i < ARRAY_SIZE(timeouts); i++) {
+    ASSERT(0 == uv_timer_init_ex(loop, &coarse_timers[i], UV_TIMER_COARSE));
+    coarse_timers[i].data = (void*) (uintptr_t) timeouts[i];
+    ASSERT(0 == uv_timer_start(&coarse_timers[i],
+                               coarse_timer_cb,
+                               timeouts[i],
+                               0));
+  }
+
+  ASSERT(0 == uv_timer_stop(&stopped));
+  ASSERT(0 == uv_is_active((uv_handle_t*) &stopped));
+  uv_close((uv_handle_t*) &stopped, NULL);
+
+  ASSERT(0 == uv_run(loop, UV_RUN_DEFAULT));
+  ASSERT(coarse_timer_cb_called == ARRAY_SIZE(timeouts));
+
+  MAKE_VALGRIND_HAPPY();
+  return 0;
+}
+
+
+static void coarse_repeat_cb(uv_timer_t* handle) {
+  if (++repeat_cb_called == 5) {
+    uv_close((uv_handle_t*) handle, NULL);
+    uv_close((uv_handle_t*) &huge_timer1, NULL);
+  }
+}
+
+
+TEST_IMPL(timer_coarse_repeat) {
+  uv_timer_t handle;
+
+  /* The huge timeout doesn't fit in the wheel and falls back to the heap. */
+  ASSERT(0 == uv_timer_init_ex(uv_default_loop(), &handle, UV_TIMER_COARSE));
+  ASSERT(0 == uv_timer_init_ex(uv_default_loop(),
+                               &huge_timer1,
+                               UV_TIMER_COARSE));
+  ASSERT(0 == uv_timer_start(&huge_timer1, coarse_never_cb, (uint64_t) -1, 0));
+  ASSERT(0 == uv_timer_start(&handle, coarse_repeat_cb, 10, 10));
+  ASSERT(0 == uv_run(uv_default_loop(), UV_RUN_DEFAULT));
+  ASSERT(5 == repeat_cb_called);
+
+  MAKE_VALGRIND_HAPPY();
+  return 0;
+}
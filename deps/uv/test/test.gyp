@@ -34,6 +34,8 @@
         'test-fs.c',
         'test-fs-copyfile.c',
         'test-fs-event.c',
+        'test-fs-io-uring.c',
+        'test-fs-readdir.c',
         'test-fs-poll.c',
         'test-getters-setters.c',
         'test-get-currentexe.c',
@@ -141,6 +143,7 @@
         'test-udp-create-socket-early.c',
         'test-udp-dgram-too-big.c',
         'test-udp-ipv6.c',
+        'test-udp-mmsg.c',
         'test-udp-open.c',
         'test-udp-options.c',
         'test-udp-send-and-recv.c',
@@ -0,0 +1,121 @@
+/* adler32_simd.c -- Adler-32 using SIMD instructions.
+ * Copyright Node.js contributors. All rights reserved.
+ * For conditions of distribution and use, see copyright notice in zlib.h
+ */
+
+#include "adler32_simd.h"
+
+#if defined(ADLER32_SIMD_SSSE3)
+
+/*
+ * The input is processed in blocks of 32 bytes. For each block, the sum of
+ * its bytes is added to s1, and the sum of its bytes multiplied by
+ * 32, 31, ..., 1 to s2, plus 32 times the value s1 had before the block.
+ * Like in adler32_z(), at most NMAX bytes are added up before the sums are
+ * reduced modulo BASE.
+ */
+
+#include <tmmintrin.h>
+
+#if defined(_MSC_VER)
+#define TARGET_SSSE3
+#else
+#define TARGET_SSSE3 __attribute__((target("ssse3")))
+#endif
+
+#define BASE 65521U     /* largest prime smaller than 65536 */
+#define NMAX 5552
+#define BLOCK_SIZE 32
+
+TARGET_SSSE3
+uLong ZLIB_INTERNAL adler32_simd_(uLong adler,
+                                  const unsigned char *buf,
+                                  z_size_t len)
+{
+    /*
+     * Split Adler-32 into component sums.
+     */
+    unsigned long s1 = adler & 0xffff;
+    unsigned long s2 = (adler >> 16) & 0xffff;
+
+    z_size_t blocks = len / BLOCK_SIZE;
+    len -= blocks * BLOCK_SIZE;
+
+    while (blocks) {
+        const __m128i tap1 = _mm_setr_epi8(32, 31, 30, 29, 28, 27, 26, 25,
+                                           24, 23, 22, 21, 20, 19, 18, 17);
+        const __m128i tap2 = _mm_setr_epi8(16, 15, 14, 13, 12, 11, 10, 9,
+                                           8, 7, 6, 5, 4, 3, 2, 1);
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i ones = _mm_set1_epi16(1);
+        __m128i v_ps, v_s1, v_s2;
+
+        unsigned n = NMAX / BLOCK_SIZE;
+        if (n > blocks)
+            n = (unsigned)blocks;
+        blocks -= n;
+
+        /*
+         * v_ps accumulates the values of s1 before each block, which are
+         * multiplied by BLOCK_SIZE and added to s2 at the end.
+         */
+        v_ps = _mm_set_epi32(0, 0, 0, (int)(s1 * n));
+        v_s2 = _mm_set_epi32(0, 0, 0, (int)s2);
+        v_s1 = _mm_setzero_si128();
+
+        do {
+            const __m128i bytes1 = _mm_loadu_si128((const __m128i *)buf);
+            const __m128i bytes2 = _mm_loadu_si128((const __m128i *)(buf + 16));
+            __m128i mad;
+
+            v_ps = _mm_add_epi32(v_ps, v_s1);
+
+            /*
+             * Horizontally add the bytes for s1, and multiply-add them with
+             * the taps for s2.
+             */
+            v_s1 = _mm_add_epi32(v_s1, _mm_sad_epu8(bytes1, zero));
+            mad = _mm_maddubs_epi16(bytes1, tap1);
+            v_s2 = _mm_add_epi32(v_s2, _mm_madd_epi16(mad, ones));
+
+            v_s1 = _mm_add_epi32(v_s1, _mm_sad_epu8(bytes2, zero));
+            mad = _mm_maddubs_epi16(bytes2, tap2);
+            v_s2 = _mm_add_epi32(v_s2, _mm_madd_epi16(mad, ones));
+
+            buf += BLOCK_SIZE;
+        } while (--n);
+
+        v_s2 = _mm_add_epi32(v_s2, _mm_slli_epi32(v_ps, 5));
+
+        /*
+         * Add up the four 32-bit lanes of v_s1 and v_s2.
+         */
+        v_s1 = _mm_add_epi32(v_s1, _mm_shuffle_epi32(v_s1, 0xb1));
+        v_s1 = _mm_add_epi32(v_s1, _mm_shuffle_epi32(v_s1, 0x4e));
+        s1 += (unsigned)_mm_cvtsi128_si32(v_s1);
+
+        v_s2 = _mm_add_epi32(v_s2, _mm_shuffle_epi32(v_s2, 0xb1));
+        v_s2 = _mm_add_epi32(v_s2, _mm_shuffle_epi32(v_s2, 0x4e));
+        s2 = (unsigned)_mm_cvtsi128_si32(v_s2);
+
+        s1 %= BASE;
+        s2 %= BASE;
+    }
+
+    /*
+     * Handle the remaining bytes, if there are any.
+     */
+    if (len) {
+        while (len--) {
+            s1 += *buf++;
+            s2 += s1;
+        }
+        if (s1 >= BASE)
+            s1 -= BASE;
+        s2 %= BASE;
+    }
+
+    return s1 | (s2 << 16);
+}
+
+#endif /* ADLER32_SIMD_SSSE3 */
@@ -0,0 +1,20 @@
+/* adler32_simd.h -- Adler-32 using SIMD instructions.
+ * Copyright Node.js contributors. All rights reserved.
+ * For conditions of distribution and use, see copyright notice in zlib.h
+ */
+
+#ifndef ADLER32_SIMD_H
+#define ADLER32_SIMD_H
+
+#include "zutil.h"
+
+/* adler32_z() only uses adler32_simd_() for at least this many bytes. */
+#define Z_ADLER32_SIMD_MINIMUM_LENGTH 64
+
+/* Updates the Adler-32 checksum `adler` with `len` bytes at `buf`, using
+ * SSSE3. Only call this when x86_cpu_enable_ssse3 is set. */
+uLong ZLIB_INTERNAL adler32_simd_ OF((uLong adler,
+                                      const unsigned char *buf,
+                                      z_size_t len));
+
+#endif /* ADLER32_SIMD_H */
@@ -0,0 +1,87 @@
+/* cpu_features.c -- Processor features detection.
+ * Copyright Node.js contributors. All rights reserved.
+ * For conditions of distribution and use, see copyright notice in zlib.h
+ */
+
+#include "cpu_features.h"
+
+/* SSSE3, used by adler32_simd_(). */
+int ZLIB_INTERNAL x86_cpu_enable_ssse3 = 0;
+/* SSE2, SSE4.2 and PCLMULQDQ, used by crc32_sse42_simd_(). */
+int ZLIB_INTERNAL x86_cpu_enable_simd = 0;
+
+#if defined(ADLER32_SIMD_SSSE3) || defined(CRC32_SIMD_SSE42_PCLMUL)
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#include <windows.h>
+#else
+#include <cpuid.h>
+#include <pthread.h>
+#endif
+
+local void _cpu_check_features OF((void));
+
+#if defined(_MSC_VER)
+local INIT_ONCE cpu_check_inited_once = INIT_ONCE_STATIC_INIT;
+
+local BOOL CALLBACK _cpu_check_features_forwarder(PINIT_ONCE once,
+                                                  PVOID param,
+                                                  PVOID* context)
+{
+    _cpu_check_features();
+    return TRUE;
+}
+
+void ZLIB_INTERNAL cpu_check_features(void)
+{
+    InitOnceExecuteOnce(&cpu_check_inited_once, _cpu_check_features_forwarder,
+                        NULL, NULL);
+}
+#else
+local pthread_once_t cpu_check_inited_once = PTHREAD_ONCE_INIT;
+
+void ZLIB_INTERNAL cpu_check_features(void)
+{
+    pthread_once(&cpu_check_inited_once, _cpu_check_features);
+}
+#endif
+
+local void _cpu_check_features(void)
+{
+    int x86_cpu_has_sse2;
+    int x86_cpu_has_ssse3;
+    int x86_cpu_has_sse42;
+    int x86_cpu_has_pclmulqdq;
+    unsigned ecx, edx;
+
+#if defined(_MSC_VER)
+    int regs[4];
+    __cpuid(regs, 1);
+    ecx = (unsigned)regs[2];
+    edx = (unsigned)regs[3];
+#else
+    unsigned eax, ebx;
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+        return;
+#endif
+
+    x86_cpu_has_sse2 = edx & 0x4000000;
+    x86_cpu_has_ssse3 = ecx & 0x000200;
+    x86_cpu_has_sse42 = ecx & 0x100000;
+    x86_cpu_has_pclmulqdq = ecx & 0x2;
+
+    x86_cpu_enable_ssse3 = x86_cpu_has_ssse3;
+
+    x86_cpu_enable_simd = x86_cpu_has_sse2 &&
+                          x86_cpu_has_sse42 &&
+                          x86_cpu_has_pclmulqdq;
+}
+
+#else /* !(ADLER32_SIMD_SSSE3 || CRC32_SIMD_SSE42_PCLMUL) */
+
+void ZLIB_INTERNAL cpu_check_features(void)
+{
+}
+
+#endif
@@ -0,0 +1,19 @@
+/* cpu_features.h -- Processor features detection.
+ * Copyright Node.js contributors. All rights reserved.
+ * For conditions of distribution and use, see copyright notice in zlib.h
+ */
+
+#ifndef CPU_FEATURES_H
+#define CPU_FEATURES_H
+
+#include "zutil.h"
+
+/* Set by cpu_check_features(), and only ever read afterwards. */
+extern int ZLIB_INTERNAL x86_cpu_enable_ssse3;
+extern int ZLIB_INTERNAL x86_cpu_enable_simd;
+
+/* Detects the features of the processor the first time it is called, and
+ * does nothing afterwards. Safe to call from multiple threads. */
+void ZLIB_INTERNAL cpu_check_features OF((void));
+
+#endif /* CPU_FEATURES_H */
@@ -30,6 +30,11 @@
 
 #include "zutil.h"      /* for STDC and FAR definitions */
 
+#if defined(CRC32_SIMD_SSE42_PCLMUL)
+#include "cpu_features.h"
+#include "crc32_simd.h"
+#endif
+
 /* Definitions for doing the crc four data bytes at a time. */
 #if !defined(NOBYFOUR) && defined(Z_U4)
 #  define BYFOUR
@@ -206,6 +211,22 @@ unsigned long ZEXPORT crc32_z(crc, buf, len)
 {
     if (buf == Z_NULL) return 0UL;
 
+#if defined(CRC32_SIMD_SSE42_PCLMUL)
+    if (len >= Z_CRC32_SSE42_MINIMUM_LENGTH) {
+        cpu_check_features();
+        if (x86_cpu_enable_simd) {
+            /* Fold the multiple of 16 bytes, then handle the rest below. */
+            z_size_t chunk_size = len & ~(z_size_t)Z_CRC32_SSE42_CHUNKSIZE_MASK;
+            crc = ~crc32_sse42_simd_(buf, chunk_size,
+                                     ~(z_crc_t)crc) & 0xffffffffUL;
+            len -= chunk_size;
+            if (len == 0)
+                return crc;
+            buf += chunk_size;
+        }
+    }
+#endif /* CRC32_SIMD_SSE42_PCLMUL */
+
 #ifdef DYNAMIC_CRC_TABLE
     if (crc_table_empty)
         make_crc_table();
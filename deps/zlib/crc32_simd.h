@@ -0,0 +1,23 @@
+/* crc32_simd.h -- CRC-32 using SIMD instructions.
+ * Copyright Node.js contributors. All rights reserved.
+ * For conditions of distribution and use, see copyright notice in zlib.h
+ */
+
+#ifndef CRC32_SIMD_H
+#define CRC32_SIMD_H
+
+#include "zutil.h"
+
+/* crc32_sse42_simd_() needs at least this many bytes, and a multiple of
+ * Z_CRC32_SSE42_CHUNKSIZE_MASK + 1 bytes. */
+#define Z_CRC32_SSE42_MINIMUM_LENGTH 64
+#define Z_CRC32_SSE42_CHUNKSIZE_MASK 15
+
+/* Updates the raw (not pre- and post-conditioned) CRC-32 register `crc`
+ * with `len` bytes at `buf`, using PCLMULQDQ folding. Only call this when
+ * x86_cpu_enable_simd is set. */
+z_crc_t ZLIB_INTERNAL crc32_sse42_simd_ OF((const unsigned char *buf,
+                                            z_size_t len,
+                                            z_crc_t crc));
+
+#endif /* CRC32_SIMD_H */
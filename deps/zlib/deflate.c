@@ -51,6 +51,10 @@
 
 #include "deflate.h"
 
+#if defined(DEFLATE_SLIDE_HASH_SSE2)
+#include <emmintrin.h>
+#endif
+
 const char deflate_copyright[] =
    " deflate 1.2.11 Copyright 1995-2017 Jean-loup Gailly and Mark Adler ";
 /*
@@ -201,6 +205,27 @@ local const config configuration_table[10] = {
  * bit values at the expense of memory usage). We slide even when level == 0 to
  * keep the hash table consistent if we switch back to level > 0 later.
  */
+#if defined(DEFLATE_SLIDE_HASH_SSE2)
+/* ===========================================================================
+ * Does the same as the loops in slide_hash() below, eight entries at a time:
+ * Pos is 16 bits wide, so subtracting wsize with unsigned saturation turns
+ * the entries that are smaller than it into NIL. entries is a power of two
+ * of at least 256.
+ */
+local void slide_hash_sse2(table, entries, wsize)
+    Posf *table;
+    unsigned entries;
+    uInt wsize;
+{
+    const __m128i xmm_wsize = _mm_set1_epi16((short)wsize);
+    __m128i *p = (__m128i *)table;
+    unsigned n;
+
+    for (n = entries / 8; n != 0; n--, p++)
+        _mm_storeu_si128(p, _mm_subs_epu16(_mm_loadu_si128(p), xmm_wsize));
+}
+#endif
+
 local void slide_hash(s)
     deflate_state *s;
 {
@@ -208,6 +233,13 @@ local void slide_hash(s)
     Posf *p;
     uInt wsize = s->w_size;
 
+#if defined(DEFLATE_SLIDE_HASH_SSE2)
+    slide_hash_sse2(s->head, s->hash_size, wsize);
+#ifndef FASTEST
+    slide_hash_sse2(s->prev, wsize, wsize);
+#endif
+    return;
+#endif
     n = s->hash_size;
     p = &s->head[n];
     do {
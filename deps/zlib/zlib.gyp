@@ -14,9 +14,15 @@
           'type': 'static_library',
           'sources': [
             'adler32.c',
+            'adler32_simd.c',
+            'adler32_simd.h',
             'compress.c',
+            'cpu_features.c',
+            'cpu_features.h',
             'crc32.c',
             'crc32.h',
+            'crc32_simd.c',
+            'crc32_simd.h',
             'deflate.c',
             'deflate.h',
             'gzclose.c',
@@ -61,6 +67,18 @@
                 'USE_FILE32API'
               ],
             }],
+            # The SIMD code is selected at runtime, based on what the CPU
+            # supports, and produces the same output as the portable code.
+            ['target_arch in "ia32 x64" and OS!="ios"', {
+              'defines': [
+                'ADLER32_SIMD_SSSE3',
+                'CRC32_SIMD_SSE42_PCLMUL',
+              ],
+            }],
+            # SSE2 is part of x64 itself.
+            ['target_arch=="x64"', {
+              'defines': [ 'DEFLATE_SLIDE_HASH_SSE2' ],
+            }],
           ],
         },
       ],
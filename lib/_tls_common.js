@@ -31,6 +31,10 @@ const {
   ERR_TLS_INVALID_PROTOCOL_VERSION,
   ERR_TLS_PROTOCOL_VERSION_CONFLICT,
 } = require('internal/errors').codes;
+const {
+  validateString,
+  validateUint32
+} = require('internal/validators');
 const {
   SSL_OP_CIPHER_SERVER_PREFERENCE,
   TLS1_VERSION,
@@ -73,6 +77,25 @@ function SecureContext(secureProtocol, secureOptions, minVersion, maxVersion) {
   if (secureOptions) this.context.setOptions(secureOptions);
 }
 
+function setSessionCache(context, sessionCache) {
+  if (typeof sessionCache === 'string') {
+    sessionCache = { name: sessionCache };
+  } else if (sessionCache === null || typeof sessionCache !== 'object') {
+    throw new ERR_INVALID_ARG_TYPE('options.sessionCache',
+                                   ['string', 'Object'], sessionCache);
+  }
+
+  const {
+    name,
+    maxEntries = 20480,
+    ticketKeyRotation = 0
+  } = sessionCache;
+  validateString(name, 'options.sessionCache.name');
+  validateUint32(maxEntries, 'options.sessionCache.maxEntries');
+  validateUint32(ticketKeyRotation, 'options.sessionCache.ticketKeyRotation');
+  context.setSessionCache(name, maxEntries, ticketKeyRotation);
+}
+
 function validateKeyCert(name, value) {
   if (typeof value !== 'string' && !isArrayBufferView(value)) {
     throw new ERR_INVALID_ARG_TYPE(
@@ -206,6 +229,9 @@ exports.createSecureContext = function createSecureContext(options) {
     c.context.setSessionIdContext(options.sessionIdContext);
   }
 
+  if (options.sessionCache !== undefined)
+    setSessionCache(c.context, options.sessionCache);
+
   if (options.pfx) {
     if (!toBuf)
       toBuf = require('internal/crypto/util').toBuf;
@@ -233,6 +259,10 @@ exports.createSecureContext = function createSecureContext(options) {
     }
   }
 
+  // Keys that cannot be used asynchronously keep signing on the main thread.
+  if (options.asyncPrivateKey)
+    c.context.enableAsyncPrivateKey();
+
   // Do not keep read/write buffers in free list for OpenSSL < 1.1.0. (For
   // OpenSSL 1.1.0, buffers are malloced and freed without the use of a
   // freelist.)
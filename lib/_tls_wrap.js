@@ -57,6 +57,7 @@ const {
 const { validateString } = require('internal/validators');
 const kConnectOptions = Symbol('connect-options');
 const kDisableRenegotiation = Symbol('disable-renegotiation');
+const kEnableKernelTLS = Symbol('enable-kernel-tls');
 const kErrorEmitted = Symbol('error-emitted');
 const kHandshakeTimeout = Symbol('handshake-timeout');
 const kRes = Symbol('res');
@@ -379,7 +380,8 @@ function TLSSocket(socket, opts) {
     handle: this._wrapHandle(wrap),
     allowHalfOpen: socket && socket.allowHalfOpen,
     readable: false,
-    writable: false
+    writable: false,
+    onread: tlsOptions.onread
   });
 
   // Proxy for API compatibility
@@ -607,6 +609,9 @@ TLSSocket.prototype._init = function(socket, wrap) {
     ssl.setALPNProtocols(ssl._secureContext.alpnBuffer);
   }
 
+  if (options.enableKernelTLS)
+    ssl.enableKernelTLS();
+
   if (options.handshakeTimeout > 0)
     this.setTimeout(options.handshakeTimeout, this._handleTimeout);
 
@@ -866,7 +871,8 @@ function tlsConnectionListener(rawSocket) {
     rejectUnauthorized: this.rejectUnauthorized,
     handshakeTimeout: this[kHandshakeTimeout],
     ALPNProtocols: this.ALPNProtocols,
-    SNICallback: this[kSNICallback] || SNICallback
+    SNICallback: this[kSNICallback] || SNICallback,
+    enableKernelTLS: this[kEnableKernelTLS]
   });
 
   socket.on('secure', onServerSocketSecure);
@@ -971,6 +977,7 @@ function Server(options, listener) {
 
   this[kHandshakeTimeout] = options.handshakeTimeout || (120 * 1000);
   this[kSNICallback] = options.SNICallback;
+  this[kEnableKernelTLS] = !!options.enableKernelTLS;
 
   if (typeof this[kHandshakeTimeout] !== 'number') {
     throw new ERR_INVALID_ARG_TYPE(
@@ -1104,7 +1111,9 @@ Server.prototype.setSecureContext = function(options) {
     secureOptions: this.secureOptions,
     honorCipherOrder: this.honorCipherOrder,
     crl: this.crl,
-    sessionIdContext: this.sessionIdContext
+    sessionIdContext: this.sessionIdContext,
+    sessionCache: options.sessionCache,
+    asyncPrivateKey: options.asyncPrivateKey
   });
 
   if (this.sessionTimeout)
@@ -1348,7 +1357,9 @@ exports.connect = function connect(...args) {
     rejectUnauthorized: options.rejectUnauthorized !== false,
     session: options.session,
     ALPNProtocols: options.ALPNProtocols,
-    requestOCSP: options.requestOCSP
+    requestOCSP: options.requestOCSP,
+    onread: options.onread,
+    enableKernelTLS: options.enableKernelTLS
   });
 
   tlssock[kConnectOptions] = options;
@@ -84,7 +84,9 @@ const {
 } = require('internal/crypto/sig');
 const {
   Hash,
-  Hmac
+  Hmac,
+  hash,
+  hashBatch
 } = require('internal/crypto/hash');
 const {
   getCiphers,
@@ -161,6 +163,8 @@ module.exports = exports = {
   getCurves,
   getDiffieHellman: createDiffieHellmanGroup,
   getHashes,
+  hash,
+  hashBatch,
   pbkdf2,
   pbkdf2Sync,
   generateKeyPair,
@@ -53,9 +53,10 @@ const {
   symbols: { async_id_symbol, owner_symbol }
 } = require('internal/async_hooks');
 const { UV_UDP_REUSEADDR } = internalBinding('constants').os;
+const { UV_EAGAIN } = internalBinding('uv');
 
 const {
-  constants: { UV_UDP_IPV6ONLY },
+  constants: { UV_UDP_IPV6ONLY, UV_UDP_SEGMENT },
   UDP,
   SendWrap
 } = internalBinding('udp_wrap');
@@ -79,6 +80,7 @@ function Socket(type, listener) {
   var lookup;
   let recvBufferSize;
   let sendBufferSize;
+  let recvmmsg = false;
 
   if (type !== null && typeof type === 'object') {
     var options = type;
@@ -86,9 +88,16 @@ function Socket(type, listener) {
     lookup = options.lookup;
     recvBufferSize = options.recvBufferSize;
     sendBufferSize = options.sendBufferSize;
+    if (options.recvmmsg !== undefined) {
+      if (typeof options.recvmmsg !== 'boolean') {
+        throw new ERR_INVALID_ARG_TYPE('options.recvmmsg', 'boolean',
+                                       options.recvmmsg);
+      }
+      recvmmsg = options.recvmmsg;
+    }
   }
 
-  var handle = newHandle(type, lookup);
+  var handle = newHandle(type, lookup, recvmmsg);
   handle[owner_symbol] = this;
 
   this[async_id_symbol] = handle.getAsyncId();
@@ -105,7 +114,9 @@ function Socket(type, listener) {
     reuseAddr: options && options.reuseAddr, // Use UV_UDP_REUSEADDR if true.
     ipv6Only: options && options.ipv6Only,
     recvBufferSize,
-    sendBufferSize
+    sendBufferSize,
+    // Use UV_UDP_SEGMENT (UDP GSO) for sendBatch() if true.
+    udpSegment: options && options.udpSegment
   };
 }
 Object.setPrototypeOf(Socket.prototype, EventEmitter.prototype);
@@ -521,6 +532,119 @@ function doSend(ex, self, ip, list, address, port, callback) {
   }
 }
 
+// valid combinations
+// sendBatch(list, port, address, callback)
+// sendBatch(list, port, address)
+// sendBatch(list, port, callback)
+// sendBatch(list, port)
+Socket.prototype.sendBatch = function(list, port, address, callback) {
+  if (!Array.isArray(list)) {
+    throw new ERR_INVALID_ARG_TYPE('list', 'Array', list);
+  }
+
+  const msgs = fixBufferList(list);
+  if (msgs === null) {
+    throw new ERR_INVALID_ARG_TYPE('list elements',
+                                   ['Buffer', 'Uint8Array', 'string'], list);
+  }
+
+  port = port >>> 0;
+  if (port === 0 || port > 65535)
+    throw new ERR_SOCKET_BAD_PORT(port);
+
+  if (typeof callback !== 'function')
+    callback = undefined;
+
+  if (typeof address === 'function') {
+    callback = address;
+    address = undefined;
+  } else if (address && typeof address !== 'string') {
+    throw new ERR_INVALID_ARG_TYPE('address', ['string', 'falsy'], address);
+  }
+
+  healthCheck(this);
+
+  const state = this[kStateSymbol];
+
+  if (state.bindState === BIND_STATE_UNBOUND)
+    this.bind({ port: 0, exclusive: true }, null);
+
+  if (state.bindState !== BIND_STATE_BOUND) {
+    enqueue(this, this.sendBatch.bind(this, msgs, port, address, callback));
+    return;
+  }
+
+  const afterDns = (ex, ip) => {
+    defaultTriggerAsyncIdScope(
+      this[async_id_symbol],
+      doSendBatch,
+      ex, this, ip, msgs, address, port, callback
+    );
+  };
+
+  state.handle.lookup(address, afterDns);
+};
+
+function doSendBatch(ex, self, ip, list, address, port, callback) {
+  const state = self[kStateSymbol];
+
+  if (ex) {
+    if (typeof callback === 'function') {
+      process.nextTick(callback, ex);
+      return;
+    }
+
+    process.nextTick(() => self.emit('error', ex));
+    return;
+  } else if (!state.handle) {
+    return;
+  }
+
+  var bytes = 0;
+  for (var i = 0; i < list.length; i++)
+    bytes += list[i].length;
+
+  // Try to hand the whole batch to the kernel in one go. Whatever doesn't fit
+  // in the socket buffer is sent the regular way below.
+  var sent = 0;
+  if (list.length > 0) {
+    const flags = state.udpSegment ? UV_UDP_SEGMENT : 0;
+    sent = state.handle.sendBatch(list, list.length, port, ip, flags);
+  }
+
+  if (sent === UV_EAGAIN) {
+    sent = 0;
+  } else if (sent < 0) {
+    if (callback) {
+      const ex = exceptionWithHostPort(sent, 'send', address, port);
+      process.nextTick(callback, ex);
+    }
+    return;
+  }
+
+  if (sent === list.length) {
+    if (callback)
+      process.nextTick(callback, null, bytes);
+    return;
+  }
+
+  var pending = list.length - sent;
+  var failed = false;
+  const afterEach = callback && ((err) => {
+    if (failed)
+      return;
+    if (err) {
+      failed = true;
+      callback(err);
+    } else if (--pending === 0) {
+      callback(null, bytes);
+    }
+  });
+
+  for (i = sent; i < list.length; i++)
+    doSend(null, self, ip, [list[i]], address, port, afterEach);
+}
+
 function afterSend(err, sent) {
   if (err) {
     err = exceptionWithHostPort(err, 'send', this.address, this.port);
@@ -61,6 +61,7 @@ const {
   Dirent,
   getDirents,
   getOptions,
+  handleErrorFromBinding,
   nullCheck,
   preprocessSymlinkDestination,
   Stats,
@@ -74,6 +75,11 @@ const {
   validateOffsetLengthWrite,
   validatePath
 } = require('internal/fs/utils');
+const {
+  Dir,
+  opendir,
+  opendirSync
+} = require('internal/fs/dir');
 const {
   CHAR_FORWARD_SLASH,
   CHAR_BACKWARD_SLASH,
@@ -114,23 +120,6 @@ function showTruncateDeprecation() {
   }
 }
 
-function handleErrorFromBinding(ctx) {
-  if (ctx.errno !== undefined) {  // libuv error numbers
-    const err = uvException(ctx);
-    // eslint-disable-next-line no-restricted-syntax
-    Error.captureStackTrace(err, handleErrorFromBinding);
-    throw err;
-  }
-  if (ctx.error !== undefined) {  // errors created in C++ land.
-    // TODO(joyeecheung): currently, ctx.error are encoding errors
-    // usually caused by memory problems. We need to figure out proper error
-    // code(s) for this.
-    // eslint-disable-next-line no-restricted-syntax
-    Error.captureStackTrace(ctx.error, handleErrorFromBinding);
-    throw ctx.error;
-  }
-}
-
 function maybeCallback(cb) {
   if (typeof cb === 'function')
     return cb;
@@ -286,16 +275,16 @@ function readFileAfterStat(err, stats) {
 function readFile(path, options, callback) {
   callback = maybeCallback(callback || options);
   options = getOptions(options, { flag: 'r' });
-  if (!ReadFileContext)
-    ReadFileContext = require('internal/fs/read_file_context');
-  const context = new ReadFileContext(callback, options.encoding);
-  context.isUserFd = isFd(path); // file descriptor ownership
 
-  const req = new FSReqCallback();
-  req.context = context;
-  req.oncomplete = readFileAfterOpen;
+  if (isFd(path)) { // File descriptor ownership stays with the user.
+    if (!ReadFileContext)
+      ReadFileContext = require('internal/fs/read_file_context');
+    const context = new ReadFileContext(callback, options.encoding);
+    context.isUserFd = true;
 
-  if (context.isUserFd) {
+    const req = new FSReqCallback();
+    req.context = context;
+    req.oncomplete = readFileAfterOpen;
     process.nextTick(function tick() {
       req.oncomplete(null, path);
     });
@@ -304,10 +293,14 @@ function readFile(path, options, callback) {
 
   path = toPathIfFileURL(path);
   validatePath(path);
-  binding.open(pathModule.toNamespacedPath(path),
-               stringToFlags(options.flag || 'r'),
-               0o666,
-               req);
+
+  // Opening, reading and closing the file happen in a single threadpool job.
+  const req = new FSReqCallback();
+  req.oncomplete = makeCallback(callback);
+  binding.readFile(pathModule.toNamespacedPath(path),
+                   stringToFlags(options.flag || 'r'),
+                   options.encoding,
+                   req);
 }
 
 function tryStatSync(fd, isUserFd) {
@@ -1842,6 +1835,8 @@ module.exports = fs = {
   mkdtempSync,
   open,
   openSync,
+  opendir,
+  opendirSync,
   readdir,
   readdirSync,
   read,
@@ -1873,6 +1868,7 @@ module.exports = fs = {
   writeFileSync,
   write,
   writeSync,
+  Dir,
   Dirent,
   Stats,
 
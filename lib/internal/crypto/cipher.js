@@ -8,6 +8,7 @@ const {
 const {
   ERR_CRYPTO_INVALID_STATE,
   ERR_INVALID_ARG_TYPE,
+  ERR_INVALID_CALLBACK,
   ERR_INVALID_OPT_VALUE
 } = require('internal/errors').codes;
 const { validateString } = require('internal/validators');
@@ -18,12 +19,20 @@ const {
   prepareSecretKey
 } = require('internal/crypto/keys');
 const {
+  checkNoQueuedOperations,
   getDefaultEncoding,
   kHandle,
+  kMinThreadpoolSize,
   legacyNativeHandle,
-  toBuf
+  queueOperation,
+  toBuf,
+  toUpdateBuffer,
+  updateInChunks
 } = require('internal/crypto/util');
 
+const { Providers } = internalBinding('async_wrap');
+const { Buffer } = require('buffer');
+
 const { isArrayBufferView } = require('internal/util/types');
 
 const {
@@ -134,12 +143,14 @@ Object.setPrototypeOf(Cipher.prototype, LazyTransform.prototype);
 Object.setPrototypeOf(Cipher, LazyTransform);
 
 Cipher.prototype._transform = function _transform(chunk, encoding, callback) {
+  checkNoQueuedOperations(this);
   this.push(this[kHandle].update(chunk, encoding));
   callback();
 };
 
 Cipher.prototype._flush = function _flush(callback) {
   try {
+    checkNoQueuedOperations(this);
     this.push(this[kHandle].final());
   } catch (e) {
     callback(e);
@@ -148,7 +159,70 @@ Cipher.prototype._flush = function _flush(callback) {
   callback();
 };
 
-Cipher.prototype.update = function update(data, inputEncoding, outputEncoding) {
+function encodeOutput(self, ret, outputEncoding, end) {
+  if (outputEncoding && outputEncoding !== 'buffer') {
+    self._decoder = getDecoder(self._decoder, outputEncoding);
+    return end ? self._decoder.end(ret) : self._decoder.write(ret);
+  }
+
+  return ret;
+}
+
+// Encrypts or decrypts `data` after the operations that are already queued on
+// `self`, on the threadpool if it is large.
+function updateAsync(self, data, outputEncoding, callback) {
+  const handle = self[kHandle];
+  queueOperation(self, (done) => {
+    const output = [];
+    function finish(err) {
+      if (err)
+        return done(err);
+      let ret;
+      try {
+        ret = encodeOutput(self, Buffer.concat(output), outputEncoding, false);
+      } catch (err) {
+        return done(err);
+      }
+      done(null, ret);
+    }
+
+    function updateSync() {
+      try {
+        output.push(handle.update(data));
+      } catch (err) {
+        process.nextTick(finish, err);
+        return;
+      }
+      process.nextTick(finish, null);
+    }
+
+    if (data.byteLength < kMinThreadpoolSize)
+      return updateSync();
+
+    updateInChunks(data, Providers.CIPHERREQUEST, (chunk, wrap, next) => {
+      wrap.handle = handle;
+      wrap.ondone = (err, ret) => {
+        if (ret !== undefined)
+          output.push(ret);
+        next(err);
+      };
+      // CCM messages must be passed in one piece, the first chunk tells.
+      if (!handle.update(chunk, undefined, wrap))
+        updateSync();
+    }, finish);
+  }, callback);
+}
+
+Cipher.prototype.update = function update(data, inputEncoding, outputEncoding,
+                                          callback) {
+  if (typeof inputEncoding === 'function') {
+    callback = inputEncoding;
+    inputEncoding = undefined;
+  } else if (typeof outputEncoding === 'function') {
+    callback = outputEncoding;
+    outputEncoding = undefined;
+  }
+
   const encoding = getDefaultEncoding();
   inputEncoding = inputEncoding || encoding;
   outputEncoding = outputEncoding || encoding;
@@ -157,37 +231,58 @@ Cipher.prototype.update = function update(data, inputEncoding, outputEncoding) {
     throw invalidArrayBufferView('data', data);
   }
 
-  const ret = this[kHandle].update(data, inputEncoding);
-
-  if (outputEncoding && outputEncoding !== 'buffer') {
-    this._decoder = getDecoder(this._decoder, outputEncoding);
-    return this._decoder.write(ret);
+  if (callback !== undefined) {
+    if (typeof callback !== 'function')
+      throw new ERR_INVALID_CALLBACK();
+    updateAsync(this, toUpdateBuffer(data, inputEncoding), outputEncoding,
+                callback);
+    return;
   }
 
-  return ret;
+  checkNoQueuedOperations(this);
+  const ret = this[kHandle].update(data, inputEncoding);
+  return encodeOutput(this, ret, outputEncoding, false);
 };
 
 
-Cipher.prototype.final = function final(outputEncoding) {
+Cipher.prototype.final = function final(outputEncoding, callback) {
+  if (typeof outputEncoding === 'function') {
+    callback = outputEncoding;
+    outputEncoding = undefined;
+  }
   outputEncoding = outputEncoding || getDefaultEncoding();
-  const ret = this[kHandle].final();
 
-  if (outputEncoding && outputEncoding !== 'buffer') {
-    this._decoder = getDecoder(this._decoder, outputEncoding);
-    return this._decoder.end(ret);
+  if (callback !== undefined) {
+    if (typeof callback !== 'function')
+      throw new ERR_INVALID_CALLBACK();
+    queueOperation(this, (done) => {
+      let ret;
+      try {
+        ret = encodeOutput(this, this[kHandle].final(), outputEncoding, true);
+      } catch (err) {
+        process.nextTick(done, err);
+        return;
+      }
+      process.nextTick(done, null, ret);
+    }, callback);
+    return;
   }
 
-  return ret;
+  checkNoQueuedOperations(this);
+  const ret = this[kHandle].final();
+  return encodeOutput(this, ret, outputEncoding, true);
 };
 
 
 Cipher.prototype.setAutoPadding = function setAutoPadding(ap) {
+  checkNoQueuedOperations(this);
   if (!this[kHandle].setAutoPadding(!!ap))
     throw new ERR_CRYPTO_INVALID_STATE('setAutoPadding');
   return this;
 };
 
 Cipher.prototype.getAuthTag = function getAuthTag() {
+  checkNoQueuedOperations(this);
   const ret = this[kHandle].getAuthTag();
   if (ret === undefined)
     throw new ERR_CRYPTO_INVALID_STATE('getAuthTag');
@@ -201,6 +296,7 @@ function setAuthTag(tagbuf) {
                                    ['Buffer', 'TypedArray', 'DataView'],
                                    tagbuf);
   }
+  checkNoQueuedOperations(this);
   if (!this[kHandle].setAuthTag(tagbuf))
     throw new ERR_CRYPTO_INVALID_STATE('setAuthTag');
   return this;
@@ -214,6 +310,7 @@ Cipher.prototype.setAAD = function setAAD(aadbuf, options) {
   }
 
   const plaintextLength = getUIntOption(options, 'plaintextLength');
+  checkNoQueuedOperations(this);
   if (!this[kHandle].setAAD(aadbuf, plaintextLength))
     throw new ERR_CRYPTO_INVALID_STATE('setAAD');
   return this;
@@ -2,14 +2,23 @@
 
 const {
   Hash: _Hash,
-  Hmac: _Hmac
+  Hmac: _Hmac,
+  hash: _hash,
+  hashBatch: _hashBatch
 } = internalBinding('crypto');
 
+const { AsyncWrap, Providers } = internalBinding('async_wrap');
+
 const {
+  checkNoQueuedOperations,
   getDefaultEncoding,
   kHandle,
+  kMinThreadpoolSize,
   legacyNativeHandle,
-  toBuf
+  queueOperation,
+  toBuf,
+  toUpdateBuffer,
+  updateInChunks
 } = require('internal/crypto/util');
 
 const {
@@ -22,7 +31,10 @@ const {
   ERR_CRYPTO_HASH_DIGEST_NO_UTF16,
   ERR_CRYPTO_HASH_FINALIZED,
   ERR_CRYPTO_HASH_UPDATE_FAILED,
-  ERR_INVALID_ARG_TYPE
+  ERR_CRYPTO_INVALID_DIGEST,
+  ERR_INVALID_ARG_TYPE,
+  ERR_INVALID_CALLBACK,
+  ERR_OUT_OF_RANGE
 } = require('internal/errors').codes;
 const { validateString } = require('internal/validators');
 const { normalizeEncoding } = require('internal/util');
@@ -31,6 +43,12 @@ const LazyTransform = require('internal/streams/lazy_transform');
 const kState = Symbol('kState');
 const kFinalized = Symbol('kFinalized');
 
+// Asynchronous batches are split across at most this many requests, which is
+// libuv's default threadpool size, but not into parts smaller than
+// kMinBatchPartSize bytes.
+const kMaxBatchParts = 4;
+const kMinBatchPartSize = 1024 * 1024;
+
 function Hash(algorithm, options) {
   if (!(this instanceof Hash))
     return new Hash(algorithm, options);
@@ -46,20 +64,60 @@ Object.setPrototypeOf(Hash.prototype, LazyTransform.prototype);
 Object.setPrototypeOf(Hash, LazyTransform);
 
 Hash.prototype._transform = function _transform(chunk, encoding, callback) {
+  checkNoQueuedOperations(this);
   this[kHandle].update(chunk, encoding);
   callback();
 };
 
 Hash.prototype._flush = function _flush(callback) {
+  checkNoQueuedOperations(this);
   this.push(this[kHandle].digest());
   callback();
 };
 
-Hash.prototype.update = function update(data, encoding) {
+// Feeds `data` to `handle` after the operations that are already queued on
+// `self`, on the threadpool if it is large.
+function updateAsync(self, handle, data, callback) {
+  queueOperation(self, (done) => {
+    if (data.byteLength < kMinThreadpoolSize) {
+      const ok = handle.update(data);
+      process.nextTick(done, ok ? null : new ERR_CRYPTO_HASH_UPDATE_FAILED());
+      return;
+    }
+
+    updateInChunks(data, Providers.HASHREQUEST, (chunk, wrap, next) => {
+      wrap.handle = handle;
+      wrap.ondone = (ok) => {
+        next(ok ? null : new ERR_CRYPTO_HASH_UPDATE_FAILED());
+      };
+      handle.update(chunk, undefined, wrap);
+    }, done);
+  }, callback);
+}
+
+function digestAsync(self, handle, outputEncoding, callback) {
+  queueOperation(self, (done) => {
+    let ret;
+    try {
+      ret = handle.digest(`${outputEncoding}`);
+    } catch (err) {
+      process.nextTick(done, err);
+      return;
+    }
+    process.nextTick(done, null, ret);
+  }, callback);
+}
+
+Hash.prototype.update = function update(data, encoding, callback) {
   const state = this[kState];
   if (state[kFinalized])
     throw new ERR_CRYPTO_HASH_FINALIZED();
 
+  if (typeof encoding === 'function') {
+    callback = encoding;
+    encoding = undefined;
+  }
+
   if (typeof data !== 'string' && !isArrayBufferView(data)) {
     throw new ERR_INVALID_ARG_TYPE('data',
                                    ['string',
@@ -69,20 +127,43 @@ Hash.prototype.update = function update(data, encoding) {
                                    data);
   }
 
-  if (!this[kHandle].update(data, encoding || getDefaultEncoding()))
+  encoding = encoding || getDefaultEncoding();
+
+  if (callback !== undefined) {
+    if (typeof callback !== 'function')
+      throw new ERR_INVALID_CALLBACK();
+    updateAsync(this, this[kHandle], toUpdateBuffer(data, encoding), callback);
+    return this;
+  }
+
+  checkNoQueuedOperations(this);
+  if (!this[kHandle].update(data, encoding))
     throw new ERR_CRYPTO_HASH_UPDATE_FAILED();
   return this;
 };
 
 
-Hash.prototype.digest = function digest(outputEncoding) {
+Hash.prototype.digest = function digest(outputEncoding, callback) {
   const state = this[kState];
   if (state[kFinalized])
     throw new ERR_CRYPTO_HASH_FINALIZED();
+  if (typeof outputEncoding === 'function') {
+    callback = outputEncoding;
+    outputEncoding = undefined;
+  }
   outputEncoding = outputEncoding || getDefaultEncoding();
   if (normalizeEncoding(outputEncoding) === 'utf16le')
     throw new ERR_CRYPTO_HASH_DIGEST_NO_UTF16();
 
+  if (callback !== undefined) {
+    if (typeof callback !== 'function')
+      throw new ERR_INVALID_CALLBACK();
+    state[kFinalized] = true;
+    digestAsync(this, this[kHandle], outputEncoding, callback);
+    return;
+  }
+
+  checkNoQueuedOperations(this);
   // Explicit conversion for backward compatibility.
   const ret = this[kHandle].digest(`${outputEncoding}`);
   state[kFinalized] = true;
@@ -110,17 +191,36 @@ Object.setPrototypeOf(Hmac, LazyTransform);
 
 Hmac.prototype.update = Hash.prototype.update;
 
-Hmac.prototype.digest = function digest(outputEncoding) {
+Hmac.prototype.digest = function digest(outputEncoding, callback) {
   const state = this[kState];
+  if (typeof outputEncoding === 'function') {
+    callback = outputEncoding;
+    outputEncoding = undefined;
+  }
   outputEncoding = outputEncoding || getDefaultEncoding();
   if (normalizeEncoding(outputEncoding) === 'utf16le')
     throw new ERR_CRYPTO_HASH_DIGEST_NO_UTF16();
 
+  if (callback !== undefined) {
+    if (typeof callback !== 'function')
+      throw new ERR_INVALID_CALLBACK();
+    if (state[kFinalized]) {
+      const buf = Buffer.from('');
+      process.nextTick(callback, null, outputEncoding === 'buffer' ?
+        buf : buf.toString(outputEncoding));
+      return;
+    }
+    state[kFinalized] = true;
+    digestAsync(this, this[kHandle], outputEncoding, callback);
+    return;
+  }
+
   if (state[kFinalized]) {
     const buf = Buffer.from('');
     return outputEncoding === 'buffer' ? buf : buf.toString(outputEncoding);
   }
 
+  checkNoQueuedOperations(this);
   // Explicit conversion for backward compatibility.
   const ret = this[kHandle].digest(`${outputEncoding}`);
   state[kFinalized] = true;
@@ -132,7 +232,167 @@ Hmac.prototype._transform = Hash.prototype._transform;
 
 legacyNativeHandle(Hmac);
 
+
+// Hashes `data` in one go on the threadpool.
+function hash(algorithm, data, outputEncoding, callback) {
+  if (typeof outputEncoding === 'function') {
+    callback = outputEncoding;
+    outputEncoding = undefined;
+  }
+  validateString(algorithm, 'algorithm');
+  if (typeof data !== 'string' && !isArrayBufferView(data)) {
+    throw new ERR_INVALID_ARG_TYPE('data',
+                                   ['string',
+                                    'Buffer',
+                                    'TypedArray',
+                                    'DataView'],
+                                   data);
+  }
+  outputEncoding = outputEncoding || getDefaultEncoding();
+  if (normalizeEncoding(outputEncoding) === 'utf16le')
+    throw new ERR_CRYPTO_HASH_DIGEST_NO_UTF16();
+  if (typeof callback !== 'function')
+    throw new ERR_INVALID_CALLBACK();
+
+  data = toUpdateBuffer(data, 'utf8');
+  const wrap = new AsyncWrap(Providers.HASHREQUEST);
+  wrap.data = data;
+  wrap.ondone = (digest) => {
+    if (digest === undefined)
+      return callback.call(wrap, new ERR_CRYPTO_HASH_UPDATE_FAILED());
+    if (outputEncoding === 'buffer')
+      return callback.call(wrap, null, digest);
+    callback.call(wrap, null, digest.toString(outputEncoding));
+  };
+
+  if (!_hash(algorithm, data, wrap))
+    throw new ERR_CRYPTO_INVALID_DIGEST(algorithm);
+}
+
+
+// Converts the offsets at which the inputs in `data` start into a table of
+// the offsets at which they start and end.
+function toBatchOffsets(offsets, byteLength) {
+  if (!Array.isArray(offsets) && !isArrayBufferView(offsets)) {
+    throw new ERR_INVALID_ARG_TYPE('options.offsets',
+                                   ['Array', 'TypedArray'], offsets);
+  }
+  const ret = new Uint32Array(offsets.length + 1);
+  let prev = 0;
+  for (var i = 0; i < offsets.length; i++) {
+    const offset = offsets[i];
+    if (!Number.isInteger(offset) || offset < prev || offset > byteLength) {
+      throw new ERR_OUT_OF_RANGE(`options.offsets[${i}]`,
+                                 `an integer >= ${prev} and <= ${byteLength}`,
+                                 offset);
+    }
+    ret[i] = prev = offset;
+  }
+  ret[offsets.length] = byteLength;
+  return ret;
+}
+
+// Splits the `count` inputs of a batch into consecutive ranges of roughly the
+// same number of bytes, one for each threadpool request.
+function splitBatch(count, byteLengthOf) {
+  let total = 0;
+  for (var n = 0; n < count; n++)
+    total += byteLengthOf(n);
+  const parts = Math.max(1, Math.min(kMaxBatchParts, count,
+                                     Math.floor(total / kMinBatchPartSize)));
+  const ranges = [];
+  let start = 0;
+  let bytes = 0;
+  for (var i = 0; i < count && ranges.length < parts - 1; i++) {
+    bytes += byteLengthOf(i);
+    if (bytes >= total * (ranges.length + 1) / parts) {
+      ranges.push([start, i + 1]);
+      start = i + 1;
+    }
+  }
+  ranges.push([start, count]);
+  return ranges;
+}
+
+function hashBatch(algorithm, data, options, callback) {
+  if (typeof options === 'function') {
+    callback = options;
+    options = undefined;
+  }
+  validateString(algorithm, 'algorithm');
+  if (options != null && typeof options !== 'object')
+    throw new ERR_INVALID_ARG_TYPE('options', 'Object', options);
+  if (callback !== undefined && typeof callback !== 'function')
+    throw new ERR_INVALID_CALLBACK();
+
+  let offsets;
+  let count;
+  if (Array.isArray(data)) {
+    for (var i = 0; i < data.length; i++) {
+      if (!isArrayBufferView(data[i])) {
+        throw new ERR_INVALID_ARG_TYPE(`data[${i}]`,
+                                       ['Buffer', 'TypedArray', 'DataView'],
+                                       data[i]);
+      }
+    }
+    count = data.length;
+  } else if (isArrayBufferView(data)) {
+    offsets = toBatchOffsets(options != null ? options.offsets : undefined,
+                             data.byteLength);
+    count = offsets.length - 1;
+  } else {
+    throw new ERR_INVALID_ARG_TYPE('data',
+                                   ['Array', 'Buffer', 'TypedArray',
+                                    'DataView'],
+                                   data);
+  }
+
+  if (callback === undefined) {
+    const ret = _hashBatch(algorithm, data, offsets);
+    if (ret === false)
+      throw new ERR_CRYPTO_INVALID_DIGEST(algorithm);
+    if (ret === undefined)
+      throw new ERR_CRYPTO_HASH_UPDATE_FAILED();
+    return ret;
+  }
+
+  const ranges = splitBatch(count, (i) => {
+    return offsets === undefined ?
+      data[i].byteLength : offsets[i + 1] - offsets[i];
+  });
+  const results = new Array(ranges.length);
+  let pending = ranges.length;
+  let failed = false;
+  ranges.forEach(([start, end], i) => {
+    const wrap = new AsyncWrap(Providers.HASHREQUEST);
+    if (offsets === undefined) {
+      wrap.data = data.slice(start, end);
+    } else {
+      wrap.data = data;
+      wrap.offsets = offsets.subarray(start, end + 1);
+    }
+    wrap.ondone = (digests) => {
+      if (failed)
+        return;
+      if (digests === undefined) {
+        failed = true;
+        return callback.call(wrap, new ERR_CRYPTO_HASH_UPDATE_FAILED());
+      }
+      results[i] = digests;
+      if (--pending === 0) {
+        callback.call(wrap, null,
+                      results.length === 1 ? digests : Buffer.concat(results));
+      }
+    };
+    // Only the first request can fail, before any work is queued.
+    if (!_hashBatch(algorithm, wrap.data, wrap.offsets, wrap))
+      throw new ERR_CRYPTO_INVALID_DIGEST(algorithm);
+  });
+}
+
 module.exports = {
   Hash,
-  Hmac
+  Hmac,
+  hash,
+  hashBatch
 };
@@ -12,8 +12,11 @@ const {
   ENGINE_METHOD_ALL
 } = internalBinding('constants').crypto;
 
+const { AsyncWrap } = internalBinding('async_wrap');
+
 const {
   ERR_CRYPTO_ENGINE_UNKNOWN,
+  ERR_CRYPTO_OPERATION_PENDING,
   ERR_CRYPTO_TIMING_SAFE_EQUAL_LENGTH,
   ERR_INVALID_ARG_TYPE,
 } = require('internal/errors').codes;
@@ -22,7 +25,8 @@ const { Buffer } = require('buffer');
 const {
   cachedResult,
   deprecate,
-  filterDuplicateStrings
+  filterDuplicateStrings,
+  normalizeEncoding
 } = require('internal/util');
 const {
   isArrayBufferView
@@ -109,7 +113,77 @@ function validateArrayBufferView(buffer, name) {
   return buffer;
 }
 
+// Hash, Hmac and Cipher objects run asynchronous operations one at a time, in
+// the order in which they were requested, because the threadpool may be using
+// their handle.
+const kQueue = Symbol('kQueue');
+// Inputs that are smaller than this are not worth a trip to the threadpool.
+const kMinThreadpoolSize = 64 * 1024;
+// Larger inputs are split up, so that they do not occupy a thread for long.
+const kMaxThreadpoolChunkSize = 1024 * 1024;
+
+// Runs `op(done)` once all operations that were queued on `self` before are
+// done, and passes the arguments of `done()` on to `callback`.
+function queueOperation(self, op, callback) {
+  let queue = self[kQueue];
+  if (queue === undefined)
+    queue = self[kQueue] = [];
+  queue.push({ op, callback });
+  if (queue.length === 1)
+    runQueuedOperation(queue);
+}
+
+function runQueuedOperation(queue) {
+  const { op, callback } = queue[0];
+  op((err, result) => {
+    queue.shift();
+    if (queue.length > 0)
+      runQueuedOperation(queue);
+    callback(err, result);
+  });
+}
+
+// Synchronous methods must not be used while asynchronous operations are
+// pending.
+function checkNoQueuedOperations(self) {
+  const queue = self[kQueue];
+  if (queue !== undefined && queue.length > 0)
+    throw new ERR_CRYPTO_OPERATION_PENDING();
+}
+
+// Converts the data passed to an asynchronous update() to a buffer, the same
+// way the synchronous one decodes strings.
+function toUpdateBuffer(data, encoding) {
+  if (typeof data !== 'string')
+    return data;
+  return Buffer.from(data, normalizeEncoding(encoding) || 'utf8');
+}
+
+// Calls `update(chunk, wrap, next)` for each chunk of `data` in turn. `wrap`
+// is a new AsyncWrap for each chunk, which retains it. `update()` passes an
+// error or null to `next()`, and `done()` is called after the last chunk or
+// the first error.
+function updateInChunks(data, provider, update, done) {
+  let offset = 0;
+  function next(err) {
+    if (err || offset === data.byteLength)
+      return done(err);
+    const length = Math.min(data.byteLength - offset, kMaxThreadpoolChunkSize);
+    const chunk = new Uint8Array(data.buffer, data.byteOffset + offset, length);
+    offset += length;
+    const wrap = new AsyncWrap(provider);
+    wrap.chunk = chunk;
+    update(chunk, wrap, next);
+  }
+  next(null);
+}
+
 module.exports = {
+  checkNoQueuedOperations,
+  kMinThreadpoolSize,
+  queueOperation,
+  toUpdateBuffer,
+  updateInChunks,
   validateArrayBufferView,
   getCiphers,
   getCurves,
@@ -396,6 +396,10 @@ function makeTextDecoderICU() {
       if (typeof ret === 'number') {
         throw new ERR_ENCODING_INVALID_ENCODED_DATA(this.encoding, ret);
       }
+      // Well-formed UTF-8 is decoded to a string natively.
+      if (typeof ret === 'string') {
+        return ret;
+      }
       return ret.toString('ucs2');
     }
   }
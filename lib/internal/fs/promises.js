@@ -39,6 +39,7 @@ const {
 } = require('internal/validators');
 const pathModule = require('path');
 const { promisify } = require('internal/util');
+const { opendir } = require('internal/fs/dir');
 
 const kHandle = Symbol('handle');
 const { kUsePromises } = binding;
@@ -487,8 +488,12 @@ async function readFile(path, options) {
   if (path instanceof FileHandle)
     return readFileHandle(path, options);
 
-  const fd = await open(path, flag, 0o666);
-  return readFileHandle(fd, options).finally(fd.close.bind(fd));
+  path = toPathIfFileURL(path);
+  validatePath(path);
+  return binding.readFile(pathModule.toNamespacedPath(path),
+                          stringToFlags(flag),
+                          options.encoding,
+                          kUsePromises);
 }
 
 module.exports = {
@@ -499,6 +504,7 @@ module.exports = {
   truncate,
   rmdir,
   mkdir,
+  opendir: promisify(opendir),
   readdir,
   readlink,
   symlink,
@@ -2,6 +2,7 @@
 
 const { Buffer } = require('buffer');
 const { FastBuffer } = require('internal/buffer');
+const { isUint8Array } = require('internal/util/types');
 const {
   WriteWrap,
   kReadBytesOrError,
@@ -13,6 +14,7 @@ const {
 const { UV_EOF } = internalBinding('uv');
 const {
   codes: {
+    ERR_INVALID_ARG_VALUE,
     ERR_INVALID_CALLBACK
   },
   errnoException
@@ -29,9 +31,21 @@ const kUpdateTimer = Symbol('kUpdateTimer');
 const kAfterAsyncWrite = Symbol('kAfterAsyncWrite');
 const kHandle = Symbol('kHandle');
 const kSession = Symbol('kSession');
+const kBuffer = Symbol('kBuffer');
+const kBufferGen = Symbol('kBufferGen');
+const kBufferCb = Symbol('kBufferCb');
 
 const debug = require('util').debuglog('stream');
 
+// A user-supplied read buffer must have room for at least one byte, or reads
+// into it can never make progress.
+function validateUserBuffer(buffer) {
+  if (buffer.length === 0) {
+    throw new ERR_INVALID_ARG_VALUE('options.onread.buffer', buffer,
+                                    'must not be empty');
+  }
+}
+
 function handleWriteReq(req, data, encoding) {
   const { handle } = req;
 
@@ -160,9 +174,26 @@ function onStreamRead(arrayBuffer) {
   stream[kUpdateTimer]();
 
   if (nread > 0 && !stream.destroyed) {
-    const offset = streamBaseState[kArrayBufferOffset];
-    const buf = new FastBuffer(arrayBuffer, offset, nread);
-    if (!stream.push(buf)) {
+    let ret;
+    let result;
+    const userBuf = stream[kBuffer];
+    if (userBuf) {
+      // The data was read straight into the user-supplied buffer.
+      result = (stream[kBufferCb](nread, userBuf) !== false);
+      const bufGen = stream[kBufferGen];
+      if (bufGen !== null) {
+        const nextBuf = bufGen();
+        if (isUint8Array(nextBuf)) {
+          validateUserBuffer(nextBuf);
+          stream[kBuffer] = ret = nextBuf;
+        }
+      }
+    } else {
+      const offset = streamBaseState[kArrayBufferOffset];
+      const buf = new FastBuffer(arrayBuffer, offset, nread);
+      result = stream.push(buf);
+    }
+    if (!result) {
       handle.reading = false;
       if (!stream.destroyed) {
         const err = handle.readStop();
@@ -171,7 +202,7 @@ function onStreamRead(arrayBuffer) {
       }
     }
 
-    return;
+    return ret;
   }
 
   if (nread === 0) {
@@ -240,5 +271,9 @@ module.exports = {
   kUpdateTimer,
   kHandle,
   kSession,
-  setStreamTimeout
+  kBuffer,
+  kBufferCb,
+  kBufferGen,
+  setStreamTimeout,
+  validateUserBuffer
 };
@@ -0,0 +1,395 @@
+'use strict';
+
+const { Buffer } = require('buffer');
+const FixedQueue = require('internal/fixed_queue');
+const {
+  DeflateBlock,
+  checksum,
+  combineChecksums
+} = internalBinding('zlib');
+const {
+  Z_NO_FLUSH, Z_FULL_FLUSH, Z_FINISH, Z_DEFAULT_COMPRESSION, Z_HUFFMAN_ONLY,
+  DEFLATE, DEFLATERAW, GZIP
+} = internalBinding('constants').zlib;
+
+// The input is compressed in blocks of this size. Each block costs a few bytes
+// for the flush at its end and loses the matches that the compressor would
+// have found while filling in its dictionary, so they must not be too small.
+const kBlockSize = 128 * 1024;
+// The largest window that deflate can refer back to. Every block is primed
+// with this much of the input that precedes it.
+const kDictionarySize = 32 * 1024;
+// The upper limit for the `parallel` option, i.e. the size of the threadpool.
+const kMaxParallel = 128;
+
+// Matches OS_CODE in deps/zlib/zutil.h.
+const kOSCode = process.platform === 'win32' ? 10 :
+  process.platform === 'darwin' ? 19 : 3;
+
+const emptyBuffer = Buffer.alloc(0);
+
+// This mirrors what deflate() writes at the start of a gzip stream.
+function gzipHeader(level, strategy) {
+  const header = Buffer.from([0x1f, 0x8b, 8, 0, 0, 0, 0, 0, 0, kOSCode]);
+  if (level === 9)
+    header[8] = 2;
+  else if (strategy >= Z_HUFFMAN_ONLY || level < 2)
+    header[8] = 4;
+  return header;
+}
+
+// This mirrors what deflate() writes at the start of a zlib stream.
+function zlibHeader(windowBits, level, strategy, dictionaryId) {
+  var levelFlags = 3;
+  if (strategy >= Z_HUFFMAN_ONLY || level < 2)
+    levelFlags = 0;
+  else if (level < 6)
+    levelFlags = 1;
+  else if (level === 6)
+    levelFlags = 2;
+
+  var header = (8 + ((windowBits - 8) << 4)) << 8 | levelFlags << 6;
+  if (dictionaryId !== undefined)
+    header |= 0x20;
+  header += 31 - (header % 31);
+
+  const buf = Buffer.allocUnsafe(dictionaryId === undefined ? 2 : 6);
+  buf.writeUInt16BE(header, 0);
+  if (dictionaryId !== undefined)
+    buf.writeUInt32BE(dictionaryId, 2);
+  return buf;
+}
+
+// Returns the last kDictionarySize bytes of `previous` followed by `input`.
+function nextDictionary(previous, input) {
+  if (input.length === 0)
+    return previous;
+  if (previous === undefined || input.length >= kDictionarySize)
+    return input.slice(Math.max(input.length - kDictionarySize, 0));
+  const joined = Buffer.concat([previous, input]);
+  return joined.slice(Math.max(joined.length - kDictionarySize, 0));
+}
+
+function onBlockDone(output, blockChecksum) {
+  const handle = this.handle;
+  const block = this.block;
+  block.output = output;
+  block.checksum = blockChecksum;
+  block.dictionary = undefined;
+  block.done = true;
+  if (block.borrowed)
+    handle.borrowed--;
+
+  if (this.async && !handle.closed) {
+    handle.running--;
+    handle.schedule();
+    handle.maybeCompleteWrite();
+  }
+}
+
+function onBlockError(message, errno, code) {
+  const handle = this.handle;
+  if (handle.closed)
+    return;
+  // This closes the handle, so that none of the other blocks are used.
+  handle.onerror(message, errno, code);
+}
+
+function maybeCompleteWrite(handle) {
+  handle.maybeCompleteWrite();
+}
+
+// Used in place of the native handle of Gzip, Deflate and DeflateRaw streams
+// that are created with the `parallel` option, with the same interface.
+//
+// The input is split into blocks that are compressed on the threadpool, up to
+// `parallel` of them at a time, as independent raw deflate streams that are
+// primed with the input preceding them and end with a sync flush. Their
+// output is emitted in order between the header and the trailer that deflate()
+// itself would have written, with the checksum combined from the checksums
+// of all blocks, which makes for a standard stream that any inflater accepts.
+class ParallelDeflate {
+  constructor(mode, parallel) {
+    this.mode = mode;
+    this.parallel = parallel;
+    this.closed = false;
+  }
+
+  init(windowBits, level, memLevel, strategy, writeState, writeCallback,
+       dictionary) {
+    // Just like zlib, which does not support dictionaries for gzip streams
+    // either.
+    if (dictionary !== undefined && this.mode === GZIP)
+      return false;
+
+    this.windowBits = windowBits === 8 ? 9 : windowBits;
+    this.memLevel = memLevel;
+    this.writeState = writeState;
+    this.writeCallback = writeCallback;
+    this.params(level, strategy);
+
+    this.dictionary = undefined;
+    this.dictionaryId = undefined;
+    if (dictionary !== undefined) {
+      dictionary = Buffer.from(dictionary.buffer,
+                               dictionary.byteOffset,
+                               dictionary.byteLength);
+      if (this.mode === DEFLATE)
+        this.dictionaryId = checksum(DEFLATE, dictionary);
+      this.dictionary = Buffer.from(nextDictionary(undefined, dictionary));
+    }
+
+    this.reset();
+    return true;
+  }
+
+  params(level, strategy) {
+    this.level = level === Z_DEFAULT_COMPRESSION ? 6 : level;
+    this.strategy = strategy;
+  }
+
+  reset() {
+    // Blocks in order, from the oldest one whose output has not been emitted
+    // completely yet.
+    this.blocks = [];
+    this.outputOffset = 0;
+    // Blocks that wait for a thread, and the number of running ones.
+    this.queued = new FixedQueue();
+    this.running = 0;
+    // The number of unfinished blocks that point into the input of the
+    // current write() call instead of a copy of it.
+    this.borrowed = 0;
+    // Input that is not enough for a block yet.
+    this.pending = null;
+    this.pendingLength = 0;
+    // The dictionary for the next block.
+    this.previous = this.dictionary;
+    this.checksum = this.mode === GZIP ? 0 : 1;
+    this.totalLength = 0;
+    this.ended = false;
+    this.writing = false;
+
+    if (this.mode === GZIP) {
+      this.addOutput(gzipHeader(this.level, this.strategy));
+    } else if (this.mode === DEFLATE) {
+      this.addOutput(zlibHeader(this.windowBits, this.level, this.strategy,
+                                this.dictionaryId));
+    }
+  }
+
+  close() {
+    this.closed = true;
+    this.blocks = null;
+    this.queued = null;
+    this.pending = null;
+    this.previous = undefined;
+    this.writeOut = null;
+  }
+
+  write(flush, input, inOff, inLen, out, outOff, outLen) {
+    this.writeFlush = flush;
+    this.writeOut = out;
+    this.writeOutOff = outOff;
+    this.writeOutLen = outLen;
+    this.writeAvailIn = this.consume(flush, input, inOff, inLen, false);
+    this.writing = true;
+    this.schedule();
+    process.nextTick(maybeCompleteWrite, this);
+  }
+
+  writeSync(flush, input, inOff, inLen, out, outOff, outLen) {
+    const availIn = this.consume(flush, input, inOff, inLen, true);
+    if (this.closed)
+      return;
+    this.writeState[0] = outLen - this.drain(out, outOff, outLen);
+    this.writeState[1] = availIn;
+  }
+
+  // Splits the input into blocks and returns the number of bytes that were
+  // not accepted because the stream has already ended.
+  consume(flush, input, inOff, inLen, sync) {
+    if (this.ended)
+      return inLen;
+
+    if (inLen > 0 && !Buffer.isBuffer(input))
+      input = Buffer.from(input.buffer, input.byteOffset, input.byteLength);
+
+    const end = inOff + inLen;
+    var offset = inOff;
+    if (this.pendingLength > 0 && offset < end) {
+      const length = Math.min(kBlockSize - this.pendingLength, end - offset);
+      input.copy(this.pending, this.pendingLength, offset, offset + length);
+      this.pendingLength += length;
+      offset += length;
+      if (this.pendingLength === kBlockSize)
+        this.dispatchPending(false, sync);
+    }
+
+    if (end - offset >= kBlockSize) {
+      // Whole blocks are compressed straight from the input, and the write
+      // only completes once they are done.
+      do {
+        this.dispatch(input.slice(offset, offset + kBlockSize),
+                      false, !sync, sync);
+        offset += kBlockSize;
+      } while (end - offset >= kBlockSize && !this.closed);
+      // The next block may only start after the input may have been reused.
+      this.previous = Buffer.from(this.previous);
+    }
+
+    if (offset < end) {
+      if (this.pending === null)
+        this.pending = Buffer.allocUnsafe(kBlockSize);
+      input.copy(this.pending, this.pendingLength, offset, end);
+      this.pendingLength += end - offset;
+    }
+
+    if (flush === Z_FINISH) {
+      this.ended = true;
+      this.dispatchPending(true, sync);
+    } else if (flush !== Z_NO_FLUSH) {
+      if (this.pendingLength > 0)
+        this.dispatchPending(false, sync);
+      // Inflating can start over after a full flush, so the next block must
+      // not refer back to anything before it.
+      if (flush === Z_FULL_FLUSH)
+        this.previous = undefined;
+    }
+    return 0;
+  }
+
+  dispatchPending(finish, sync) {
+    const input = this.pendingLength > 0 ?
+      this.pending.slice(0, this.pendingLength) : emptyBuffer;
+    this.pending = null;
+    this.pendingLength = 0;
+    this.dispatch(input, finish, false, sync);
+  }
+
+  dispatch(input, finish, borrowed, sync) {
+    if (this.closed)
+      return;
+    const block = {
+      input,
+      dictionary: this.previous,
+      finish,
+      borrowed,
+      done: false,
+      output: null,
+      checksum: 0
+    };
+    this.previous = nextDictionary(this.previous, input);
+    this.blocks.push(block);
+    if (borrowed)
+      this.borrowed++;
+
+    if (sync)
+      this.compress(block, false);
+    else
+      this.queued.push(block);
+  }
+
+  schedule() {
+    while (this.running < this.parallel && !this.queued.isEmpty()) {
+      this.running++;
+      this.compress(this.queued.shift(), true);
+    }
+  }
+
+  compress(block, async) {
+    const req = new DeflateBlock();
+    req.handle = this;
+    req.block = block;
+    req.async = async;
+    req.ondone = onBlockDone;
+    req.onerror = onBlockError;
+    const compress = async ? req.compress : req.compressSync;
+    compress.call(req, this.mode, block.input, block.dictionary, this.level,
+                  this.windowBits, this.memLevel, this.strategy, block.finish);
+  }
+
+  addOutput(output) {
+    this.blocks.push({ input: null, done: true, output });
+  }
+
+  // Copies as much of the output of the finished blocks as fits into `out`,
+  // in order, and returns the number of bytes copied.
+  drain(out, outOff, outLen) {
+    const blocks = this.blocks;
+    var copied = 0;
+    while (blocks.length > 0 && blocks[0].done && copied < outLen) {
+      const block = blocks[0];
+      if (block.input !== null) {
+        const length = block.input.length;
+        if (this.mode !== DEFLATERAW) {
+          this.checksum = combineChecksums(this.mode, this.checksum,
+                                           block.checksum, length);
+        }
+        this.totalLength += length;
+        block.input = null;
+        if (block.finish)
+          this.addOutput(this.trailer());
+      }
+
+      const output = block.output;
+      const end = Math.min(output.length, this.outputOffset + outLen - copied);
+      copied += output.copy(out, outOff + copied, this.outputOffset, end);
+      if (end === output.length) {
+        blocks.shift();
+        this.outputOffset = 0;
+      } else {
+        this.outputOffset = end;
+      }
+    }
+    return copied;
+  }
+
+  trailer() {
+    if (this.mode === GZIP) {
+      const trailer = Buffer.allocUnsafe(8);
+      trailer.writeUInt32LE(this.checksum, 0);
+      trailer.writeUInt32LE(this.totalLength % 0x100000000, 4);
+      return trailer;
+    }
+    if (this.mode === DEFLATE) {
+      const trailer = Buffer.allocUnsafe(4);
+      trailer.writeUInt32BE(this.checksum, 0);
+      return trailer;
+    }
+    return emptyBuffer;
+  }
+
+  // Completes the current write() call, once its output buffer is full, or
+  // once enough blocks are done: all of them when flushing, and otherwise
+  // enough for all blocks to have a thread, so that the amount of buffered
+  // input stays bounded.
+  maybeCompleteWrite() {
+    if (!this.writing || this.closed)
+      return;
+
+    const copied = this.drain(this.writeOut,
+                              this.writeOutOff,
+                              this.writeOutLen);
+    this.writeOutOff += copied;
+    this.writeOutLen -= copied;
+    if (this.writeOutLen > 0) {
+      if (this.borrowed > 0)
+        return;
+      if (this.writeFlush === Z_NO_FLUSH ?
+        !this.queued.isEmpty() : this.blocks.length > 0) {
+        return;
+      }
+    }
+
+    this.writing = false;
+    this.writeOut = null;
+    this.writeState[0] = this.writeOutLen;
+    this.writeState[1] = this.writeAvailIn;
+    this.writeCallback();
+  }
+}
+
+module.exports = {
+  ParallelDeflate,
+  kMaxParallel
+};
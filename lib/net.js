@@ -34,14 +34,22 @@ const {
   makeSyncWrite
 } = require('internal/net');
 const assert = require('internal/assert');
+const { isUint8Array } = require('internal/util/types');
 const {
   UV_EADDRINUSE,
-  UV_EINVAL
+  UV_EINVAL,
+  UV_EOF
 } = internalBinding('uv');
 
 const { Buffer } = require('buffer');
 const TTYWrap = internalBinding('tty_wrap');
-const { ShutdownWrap } = internalBinding('stream_wrap');
+const {
+  ShutdownWrap,
+  kReadBytesOrError,
+  streamBaseState
+} = internalBinding('stream_wrap');
+const { FileHandle } = internalBinding('fs');
+const { StreamPipe } = internalBinding('stream_pipe');
 const {
   TCP,
   TCPConnectWrap,
@@ -64,7 +72,11 @@ const {
   kAfterAsyncWrite,
   kHandle,
   kUpdateTimer,
-  setStreamTimeout
+  kBuffer,
+  kBufferCb,
+  kBufferGen,
+  setStreamTimeout,
+  validateUserBuffer
 } = require('internal/stream_base_commons');
 const {
   codes: {
@@ -101,8 +113,13 @@ const DEFAULT_IPV6_ADDR = '::';
 
 function noop() {}
 
-function getFlags(ipv6Only) {
-  return ipv6Only === true ? TCPConstants.UV_TCP_IPV6ONLY : 0;
+function getFlags(options) {
+  let flags = 0;
+  if (options.ipv6Only === true)
+    flags |= TCPConstants.UV_TCP_IPV6ONLY;
+  if (options.reusePort === true)
+    flags |= TCPConstants.UV_TCP_REUSEPORT;
+  return flags;
 }
 
 function createHandle(fd, is_server) {
@@ -223,6 +240,19 @@ function initSocketHandle(self) {
     self._handle[owner_symbol] = self;
     self._handle.onread = onStreamRead;
     self[async_id_symbol] = getNewAsyncId(self._handle);
+
+    let userBuf = self[kBuffer];
+    if (userBuf) {
+      const bufGen = self[kBufferGen];
+      if (bufGen !== null) {
+        userBuf = bufGen();
+        if (!isUint8Array(userBuf))
+          return;
+        validateUserBuffer(userBuf);
+        self[kBuffer] = userBuf;
+      }
+      self._handle.useUserBuffer(userBuf);
+    }
   }
 }
 
@@ -245,6 +275,9 @@ function Socket(options) {
   this._host = null;
   this[kLastWriteQueueSize] = 0;
   this[kTimeout] = null;
+  this[kBuffer] = null;
+  this[kBufferCb] = null;
+  this[kBufferGen] = null;
 
   if (typeof options === 'number')
     options = { fd: options }; // Legacy interface.
@@ -306,6 +339,20 @@ function Socket(options) {
     }
   }
 
+  const onread = options.onread;
+  if (onread !== null && typeof onread === 'object' &&
+      (isUint8Array(onread.buffer) || typeof onread.buffer === 'function') &&
+      typeof onread.callback === 'function') {
+    if (typeof onread.buffer === 'function') {
+      this[kBuffer] = true;
+      this[kBufferGen] = onread.buffer;
+    } else {
+      validateUserBuffer(onread.buffer);
+      this[kBuffer] = onread.buffer;
+    }
+    this[kBufferCb] = onread.callback;
+  }
+
   // Shut down the socket when we're finished with it.
   this.on('end', onReadableStreamEnd);
 
@@ -391,6 +438,67 @@ function afterShutdown(status) {
   }
 }
 
+Socket.prototype.sendFile = function(fd, options, callback) {
+  if (typeof options === 'function') {
+    callback = options;
+    options = undefined;
+  }
+  if (options === undefined)
+    options = {};
+  else if (options === null || typeof options !== 'object')
+    throw new ERR_INVALID_ARG_TYPE('options', 'Object', options);
+
+  validateInt32(fd, 'fd', 0);
+  const { offset = 0, length = -1 } = options;
+  if (typeof offset !== 'number')
+    throw new ERR_INVALID_OPT_VALUE('offset', offset);
+  if (typeof length !== 'number')
+    throw new ERR_INVALID_OPT_VALUE('length', length);
+
+  // The file takes the place of the shutdown, so that it is only sent once
+  // everything written before has been passed to the handle.
+  this._final = (cb) => pipeFile(this, fd, offset, length, cb);
+  return this.end(callback);
+};
+
+function pipeFile(self, fd, offset, length, cb) {
+  if (self.pending) {
+    debug('sendFile: not yet connected');
+    return self.once('connect', () => pipeFile(self, fd, offset, length, cb));
+  }
+
+  if (!self._handle)
+    return cb();
+
+  debug('sendFile: piping fd %d', fd);
+
+  // StreamPipe moves the data with sendfile(2) where it can, and shuts down
+  // the socket once the end of the file is reached.
+  const handle = new FileHandle(fd, offset, length);
+  handle.onread = onPipedFileRead;
+  handle[owner_symbol] = self;
+
+  const pipe = new StreamPipe(handle, self._handle);
+  pipe.onunpipe = onFileUnpipe;
+  pipe.handle = self._handle;
+  pipe.callback = cb;
+  pipe.start();
+}
+
+// This is only called once the pipe has returned back control, so
+// it only has to handle errors and End-of-File.
+function onPipedFileRead() {
+  const err = streamBaseState[kReadBytesOrError];
+  if (err < 0 && err !== UV_EOF)
+    this[owner_symbol].destroy(errnoException(err, 'sendfile'));
+}
+
+function onFileUnpipe() {
+  // The fd belongs to the caller.
+  this.source.releaseFD();
+  afterShutdown.call(this, 0);
+}
+
 // Provide a better error message when we call end() as a result
 // of the other side sending a FIN.  The standard 'write after end'
 // is overly vague, and makes it seem like the user's code is to blame.
@@ -1171,12 +1279,13 @@ function createServerHandle(address, port, addressType, fd, flags) {
       if (err) {
         handle.close();
         // Fallback to ipv4
-        return createServerHandle(DEFAULT_IPV4_ADDR, port);
+        return createServerHandle(DEFAULT_IPV4_ADDR, port, 4, undefined,
+                                  flags);
       }
     } else if (addressType === 6) {
       err = handle.bind6(address, port, flags);
     } else {
-      err = handle.bind(address, port);
+      err = handle.bind(address, port, flags & ~TCPConstants.UV_TCP_IPV6ONLY);
     }
   }
 
@@ -1279,7 +1388,10 @@ function listenInCluster(server, address, port, addressType,
 
   if (cluster === undefined) cluster = require('cluster');
 
-  if (cluster.isMaster || exclusive) {
+  // With reusePort every worker binds a socket of its own and the kernel
+  // balances incoming connections between them.
+  if (cluster.isMaster || exclusive ||
+      (flags & TCPConstants.UV_TCP_REUSEPORT)) {
     // Will create a new handle
     // _listen2 sets up the listened handle, it is still named like this
     // to avoid breaking code that wraps this method
@@ -1333,7 +1445,7 @@ Server.prototype.listen = function(...args) {
     toNumber(args.length > 2 && args[2]);  // (port, host, backlog)
 
   options = options._handle || options.handle || options;
-  const flags = getFlags(options.ipv6Only);
+  const flags = getFlags(options);
   // (handle[, backlog][, cb]) where handle is an object with a handle
   if (options instanceof TCP) {
     this._handle = options;
@@ -1372,7 +1484,7 @@ Server.prototype.listen = function(...args) {
     } else { // Undefined host, listens on unspecified address
       // Default addressType 4 will be used to search for master server
       listenInCluster(this, null, options.port | 0, 4,
-                      backlog, undefined, options.exclusive);
+                      backlog, undefined, options.exclusive, flags);
     }
     return this;
   }
@@ -29,6 +29,7 @@ const internalUtil = require('internal/util');
 const internalTLS = require('internal/tls');
 internalUtil.assertCrypto();
 const { isArrayBufferView } = require('internal/util/types');
+const { validateString } = require('internal/validators');
 
 const net = require('net');
 const { getOptionValue } = require('internal/options');
@@ -77,6 +78,24 @@ exports.getCiphers = internalUtil.cachedResult(
   () => internalUtil.filterDuplicateStrings(binding.getSSLCiphers(), true)
 );
 
+// Filled in by getSessionCacheStats() as
+// [size, hits, misses, evictions, ticketHits, ticketMisses].
+const sessionCacheStats = new Float64Array(6);
+
+exports.getSessionCacheStats = function getSessionCacheStats(name) {
+  validateString(name, 'name');
+  if (!binding.getSessionCacheStats(name, sessionCacheStats))
+    return undefined;
+  return {
+    size: sessionCacheStats[0],
+    hits: sessionCacheStats[1],
+    misses: sessionCacheStats[2],
+    evictions: sessionCacheStats[3],
+    ticketHits: sessionCacheStats[4],
+    ticketMisses: sessionCacheStats[5]
+  };
+};
+
 // Convert protocols array into valid OpenSSL protocols list
 // ("\x06spdy/2\x08http/1.1\x08http/1.0")
 function convertProtocols(protocols) {
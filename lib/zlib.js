@@ -46,6 +46,10 @@ const {
   kMaxLength
 } = require('buffer');
 const { owner_symbol } = require('internal/async_hooks').symbols;
+const {
+  ParallelDeflate,
+  kMaxParallel
+} = require('internal/zlib/parallel');
 
 const constants = internalBinding('constants').zlib;
 const {
@@ -82,6 +86,9 @@ for (var ck = 0; ck < ckeys.length; ck++) {
   codes[codes[ckey]] = ckey;
 }
 
+const kCacheKey = Symbol('kCacheKey');
+const kCacheInput = Symbol('kCacheInput');
+
 function zlibBuffer(engine, buffer, callback) {
   if (typeof callback !== 'function')
     throw new ERR_INVALID_ARG_TYPE('callback', 'function', callback);
@@ -93,6 +100,24 @@ function zlibBuffer(engine, buffer, callback) {
   } else if (isAnyArrayBuffer(buffer)) {
     buffer = Buffer.from(buffer);
   }
+  if (engine[kCacheKey] !== undefined) {
+    const isString = typeof buffer === 'string';
+    if (isString)
+      buffer = Buffer.from(buffer);
+    if (isArrayBufferView(buffer)) {
+      const cached = binding.cacheLookup(engine[kCacheKey], buffer);
+      if (cached !== undefined) {
+        _close(engine);
+        process.nextTick(callback, null, cached);
+        return;
+      }
+      // The caller may modify the input before compression is done.
+      // Compress a copy, so that the output is stored for the right input.
+      if (!isString)
+        buffer = Buffer.from(buffer);
+      engine[kCacheInput] = buffer;
+    }
+  }
   engine.buffers = null;
   engine.nread = 0;
   engine.cb = callback;
@@ -127,6 +152,10 @@ function zlibBufferOnEnd() {
     buf = (bufs.length === 1 ? bufs[0] : Buffer.concat(bufs, this.nread));
   }
   this.close();
+  if (!err && this[kCacheInput]) {
+    binding.cacheStore(this[kCacheKey], this[kCacheInput], buf);
+    this[kCacheInput] = null;
+  }
   if (err)
     this.cb(err);
   else if (this._info)
@@ -149,6 +178,17 @@ function zlibBufferSync(engine, buffer) {
       );
     }
   }
+  const cacheKey = engine[kCacheKey];
+  if (cacheKey !== undefined) {
+    const cached = binding.cacheLookup(cacheKey, buffer);
+    if (cached !== undefined) {
+      _close(engine);
+      return cached;
+    }
+    const output = processChunkSync(engine, buffer, engine._finishFlushFlag);
+    binding.cacheStore(cacheKey, buffer, output);
+    return output;
+  }
   buffer = processChunkSync(engine, buffer, engine._finishFlushFlag);
   if (engine._info)
     return { buffer, engine };
@@ -213,6 +253,16 @@ const checkRangesOrGetDefault = hideStackFrames(
   }
 );
 
+// Returns whether the output of the convenience methods should be looked up
+// in and added to the compression cache.
+function useCompressionCache(opts) {
+  if (!opts || opts.cache === undefined)
+    return false;
+  if (typeof opts.cache !== 'boolean')
+    throw new ERR_INVALID_ARG_TYPE('options.cache', 'boolean', opts.cache);
+  return opts.cache && !opts.info;
+}
+
 // The base class for all Zlib-style streams.
 function ZlibBase(opts, mode, handle, { flush, finishFlush, fullFlush }) {
   var chunkSize = Z_DEFAULT_CHUNK;
@@ -263,6 +313,8 @@ function ZlibBase(opts, mode, handle, { flush, finishFlush, fullFlush }) {
   this._defaultFullFlushFlag = fullFlush;
   this.once('end', this.close);
   this._info = opts && opts.info;
+  this[kCacheKey] = undefined;
+  this[kCacheInput] = null;
 }
 Object.setPrototypeOf(ZlibBase.prototype, Transform.prototype);
 Object.setPrototypeOf(ZlibBase, Transform);
@@ -585,6 +637,7 @@ function Zlib(opts, mode) {
   var memLevel = Z_DEFAULT_MEMLEVEL;
   var strategy = Z_DEFAULT_STRATEGY;
   var dictionary;
+  var parallel;
 
   if (opts) {
     // windowBits is special. On the compression side, 0 is an invalid value.
@@ -625,9 +678,16 @@ function Zlib(opts, mode) {
         );
       }
     }
+
+    if (mode === DEFLATE || mode === GZIP || mode === DEFLATERAW) {
+      parallel = checkRangesOrGetDefault(
+        opts.parallel, 'options.parallel',
+        1, kMaxParallel, undefined);
+    }
   }
 
-  const handle = new binding.Zlib(mode);
+  const handle = parallel === undefined ?
+    new binding.Zlib(mode) : new ParallelDeflate(mode, parallel);
   // Ideally, we could let ZlibBase() set up _writeState. I haven't been able
   // to come up with a good solution that doesn't break our internal API,
   // and with it all supported npm versions at the time of writing.
@@ -649,6 +709,11 @@ function Zlib(opts, mode) {
 
   this._level = level;
   this._strategy = strategy;
+  if ((mode === DEFLATE || mode === GZIP || mode === DEFLATERAW) &&
+      useCompressionCache(opts) && dictionary === undefined) {
+    this[kCacheKey] = `${mode},${level},${windowBits},${memLevel},` +
+                      `${strategy},${parallel},${this._finishFlushFlag}`;
+  }
 }
 Object.setPrototypeOf(Zlib.prototype, ZlibBase.prototype);
 Object.setPrototypeOf(Zlib, ZlibBase);
@@ -797,6 +862,10 @@ function Brotli(opts, mode) {
   }
 
   ZlibBase.call(this, opts, mode, handle, brotliDefaultOpts);
+  if (mode === BROTLI_ENCODE && useCompressionCache(opts)) {
+    this[kCacheKey] = `${mode},${brotliInitParamsArray.join()},` +
+                      `${this._finishFlushFlag}`;
+  }
 }
 Object.setPrototypeOf(Brotli.prototype, Zlib.prototype);
 Object.setPrototypeOf(Brotli, Zlib);
@@ -818,6 +887,20 @@ Object.setPrototypeOf(BrotliDecompress.prototype, Brotli.prototype);
 Object.setPrototypeOf(BrotliDecompress, Brotli);
 
 
+// Filled in by getCompressionCacheStats().
+const compressionCacheStats = new Float64Array(5);
+
+function getCompressionCacheStats() {
+  binding.getCacheStats(compressionCacheStats);
+  return {
+    entries: compressionCacheStats[0],
+    size: compressionCacheStats[1],
+    hits: compressionCacheStats[2],
+    misses: compressionCacheStats[3],
+    evictions: compressionCacheStats[4]
+  };
+}
+
 function createProperty(ctor) {
   return {
     configurable: true,
@@ -866,6 +949,8 @@ module.exports = {
   brotliCompressSync: createConvenienceMethod(BrotliCompress, true),
   brotliDecompress: createConvenienceMethod(BrotliDecompress, false),
   brotliDecompressSync: createConvenienceMethod(BrotliDecompress, true),
+
+  getCompressionCacheStats,
 };
 
 Object.defineProperties(module.exports, {
@@ -123,6 +123,7 @@
       'lib/internal/fixed_queue.js',
       'lib/internal/freelist.js',
       'lib/internal/freeze_intrinsics.js',
+      'lib/internal/fs/dir.js',
       'lib/internal/fs/promises.js',
       'lib/internal/fs/read_file_context.js',
       'lib/internal/fs/streams.js',
@@ -199,6 +200,7 @@
       'lib/internal/vm/source_text_module.js',
       'lib/internal/worker.js',
       'lib/internal/worker/io.js',
+      'lib/internal/zlib/parallel.js',
       'lib/internal/streams/lazy_transform.js',
       'lib/internal/streams/async_iterator.js',
       'lib/internal/streams/buffer_list.js',
@@ -471,6 +473,9 @@
         'src/process_wrap.cc',
         'src/sharedarraybuffer_metadata.cc',
         'src/signal_wrap.cc',
+        'src/simd_codecs.cc',
+        'src/simd_utf8.cc',
+        'src/slab_allocator.cc',
         'src/spawn_sync.cc',
         'src/stream_base.cc',
         'src/stream_pipe.cc',
@@ -544,10 +549,14 @@
         'src/node_v8_platform-inl.h',
         'src/node_watchdog.h',
         'src/node_worker.h',
+        'src/node_zlib.h',
         'src/pipe_wrap.h',
         'src/req_wrap.h',
         'src/req_wrap-inl.h',
         'src/sharedarraybuffer_metadata.h',
+        'src/simd_codecs.h',
+        'src/simd_utf8.h',
+        'src/slab_allocator.h',
         'src/spawn_sync.h',
         'src/stream_base.h',
         'src/stream_base-inl.h',
@@ -694,13 +703,19 @@
         [ 'node_use_openssl=="true"', {
           'sources': [
             'src/node_crypto.cc',
+            'src/node_crypto_async_key.cc',
             'src/node_crypto_bio.cc',
             'src/node_crypto_clienthello.cc',
+            'src/node_crypto_ktls.cc',
+            'src/node_crypto_session_cache.cc',
             'src/node_crypto.h',
+            'src/node_crypto_async_key.h',
             'src/node_crypto_bio.h',
             'src/node_crypto_clienthello.h',
             'src/node_crypto_clienthello-inl.h',
             'src/node_crypto_groups.h',
+            'src/node_crypto_ktls.h',
+            'src/node_crypto_session_cache.h',
             'src/tls_wrap.cc',
             'src/tls_wrap.h'
           ],
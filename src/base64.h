@@ -3,6 +3,7 @@
 
 #if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
 
+#include "simd_codecs.h"
 #include "util.h"
 
 #include <cstddef>
@@ -85,6 +86,22 @@ bool base64_decode_group_slow(char* const dst, const size_t dstlen,
 }
 
 
+// Only plain char input is handed to the vector decoder; other code unit
+// types always take the scalar path.
+inline size_t base64_decode_simd(char* const dst, const size_t dstlen,
+                                 const char* const src, const size_t srclen) {
+  return simd::Base64Decode(src, srclen, dst, dstlen);
+}
+
+
+template <typename TypeName>
+inline size_t base64_decode_simd(char* const dst, const size_t dstlen,
+                                 const TypeName* const src,
+                                 const size_t srclen) {
+  return 0;
+}
+
+
 template <typename TypeName>
 size_t base64_decode_fast(char* const dst, const size_t dstlen,
                           const TypeName* const src, const size_t srclen,
@@ -92,8 +109,8 @@ size_t base64_decode_fast(char* const dst, const size_t dstlen,
   const size_t available = dstlen < decoded_size ? dstlen : decoded_size;
   const size_t max_k = available / 3 * 3;
   size_t max_i = srclen / 4 * 4;
-  size_t i = 0;
-  size_t k = 0;
+  size_t i = base64_decode_simd(dst, max_k, src, max_i);
+  size_t k = i / 4 * 3;
   while (i < max_i && k < max_k) {
     const uint32_t v =
         unbase64(src[i + 0]) << 24 |
@@ -105,6 +122,12 @@ size_t base64_decode_fast(char* const dst, const size_t dstlen,
       if (!base64_decode_group_slow(dst, dstlen, src, srclen, &i, &k))
         return k;
       max_i = i + (srclen - i) / 4 * 4;  // Align max_i again.
+      if (k < max_k) {
+        const size_t n =
+            base64_decode_simd(dst + k, max_k - k, src + i, max_i - i);
+        i += n;
+        k += n / 4 * 3;
+      }
     } else {
       dst[k + 0] = ((v >> 22) & 0xFC) | ((v >> 20) & 0x03);
       dst[k + 1] = ((v >> 12) & 0xF0) | ((v >> 10) & 0x0F);
@@ -148,9 +171,9 @@ static size_t base64_encode(const char* src,
                               "abcdefghijklmnopqrstuvwxyz"
                               "0123456789+/";
 
-  i = 0;
-  k = 0;
   n = slen / 3 * 3;
+  i = simd::Base64Encode(src, n, dst);
+  k = i / 3 * 4;
 
   while (i < n) {
     a = src[i + 0] & 0xff;
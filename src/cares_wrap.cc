@@ -493,7 +493,8 @@ void ChannelWrap::StartTimer() {
   if (timer_handle_ == nullptr) {
     timer_handle_ = new uv_timer_t();
     timer_handle_->data = static_cast<void*>(this);
-    uv_timer_init(env()->event_loop(), timer_handle_);
+    // The timer only polls c-ares for expired queries, it can run late.
+    uv_timer_init_ex(env()->event_loop(), timer_handle_, UV_TIMER_COARSE);
   } else if (uv_is_active(reinterpret_cast<uv_handle_t*>(timer_handle_))) {
     return;
   }
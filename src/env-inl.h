@@ -580,6 +580,20 @@ inline void Environment::set_http2_state(
   http2_state_ = std::move(buffer);
 }
 
+inline SlabAllocator* Environment::read_slab_allocator() const {
+  return read_slab_allocator_.get();
+}
+
+#if HAVE_OPENSSL
+inline crypto::BIOBufferPool* Environment::bio_buffer_pool() const {
+  return bio_buffer_pool_.get();
+}
+#endif
+
+inline zlib::ZlibContextPool* Environment::zlib_context_pool() const {
+  return zlib_context_pool_.get();
+}
+
 bool Environment::debug_enabled(DebugCategory category) const {
   DCHECK_GE(static_cast<int>(category), 0);
   DCHECK_LT(static_cast<int>(category),
@@ -12,10 +12,16 @@
 #include "node_process.h"
 #include "node_v8_platform-inl.h"
 #include "node_worker.h"
+#include "slab_allocator.h"
 #include "tracing/agent.h"
 #include "tracing/traced_value.h"
 #include "v8-profiler.h"
 
+#if HAVE_OPENSSL
+#include "node_crypto_bio.h"
+#endif
+#include "node_zlib.h"
+
 #include <algorithm>
 #include <atomic>
 #include <cstdio>
@@ -187,6 +193,11 @@ Environment::Environment(IsolateData* isolate_data,
   // part of the per-process option set.
   options_.reset(new EnvironmentOptions(*isolate_data->options()->per_env));
   inspector_host_port_.reset(new HostPort(options_->debug_options().host_port));
+  read_slab_allocator_ = std::make_unique<SlabAllocator>(isolate());
+#if HAVE_OPENSSL
+  bio_buffer_pool_ = std::make_unique<crypto::BIOBufferPool>(isolate());
+#endif
+  zlib_context_pool_ = std::make_unique<zlib::ZlibContextPool>(isolate());
 
 #if HAVE_INSPECTOR
   // We can only create the inspector agent after having cloned the options.
@@ -853,9 +864,14 @@ void Environment::BuildEmbedderGraph(Isolate* isolate,
                                      EmbedderGraph* graph,
                                      void* data) {
   MemoryTracker tracker(isolate, graph);
-  static_cast<Environment*>(data)->ForEachBaseObject([&](BaseObject* obj) {
+  Environment* env = static_cast<Environment*>(data);
+  env->ForEachBaseObject([&](BaseObject* obj) {
     tracker.Track(obj);
   });
+#if HAVE_OPENSSL
+  tracker.Track(env->bio_buffer_pool());
+#endif
+  tracker.Track(env->zlib_context_pool());
 }
 
 char* Environment::Reallocate(char* data, size_t old_size, size_t size) {
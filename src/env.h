@@ -58,6 +58,14 @@ namespace fs {
 class FileHandleReadWrap;
 }
 
+class SlabAllocator;
+
+#if HAVE_OPENSSL
+namespace crypto {
+class BIOBufferPool;
+}
+#endif
+
 namespace performance {
 class performance_state;
 }
@@ -70,6 +78,10 @@ namespace worker {
 class Worker;
 }
 
+namespace zlib {
+class ZlibContextPool;
+}
+
 namespace loader {
 class ModuleWrap;
 
@@ -343,6 +355,7 @@ constexpr size_t kFsStatsBufferLength = kFsStatsFieldsNumber * 2;
   V(context, v8::Context)                                                      \
   V(crypto_key_object_constructor, v8::Function)                               \
   V(domain_callback, v8::Function)                                             \
+  V(dir_instance_template, v8::ObjectTemplate)                                 \
   V(domexception_function, v8::Function)                                       \
   V(fd_constructor_template, v8::ObjectTemplate)                               \
   V(fdclose_constructor_template, v8::ObjectTemplate)                          \
@@ -838,6 +851,17 @@ class Environment {
   inline http2::Http2State* http2_state() const;
   inline void set_http2_state(std::unique_ptr<http2::Http2State> state);
 
+  // Read buffers for streams that pass their data on to JS.
+  inline SlabAllocator* read_slab_allocator() const;
+
+#if HAVE_OPENSSL
+  // Recycled buffers for the NodeBIOs of TLS connections.
+  inline crypto::BIOBufferPool* bio_buffer_pool() const;
+#endif
+
+  // Initialized deflate streams of closed zlib streams, for reuse.
+  inline zlib::ZlibContextPool* zlib_context_pool() const;
+
   inline bool debug_enabled(DebugCategory category) const;
   inline void set_debug_enabled(DebugCategory category, bool enabled);
   void set_debug_categories(const std::string& cats, bool enabled);
@@ -1147,6 +1171,11 @@ class Environment {
   char* http_parser_buffer_ = nullptr;
   bool http_parser_buffer_in_use_ = false;
   std::unique_ptr<http2::Http2State> http2_state_;
+  std::unique_ptr<SlabAllocator> read_slab_allocator_;
+#if HAVE_OPENSSL
+  std::unique_ptr<crypto::BIOBufferPool> bio_buffer_pool_;
+#endif
+  std::unique_ptr<zlib::ZlibContextPool> zlib_context_pool_;
 
   bool debug_enabled_[static_cast<int>(DebugCategory::CATEGORY_COUNT)] = {0};
 
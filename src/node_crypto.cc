@@ -23,6 +23,7 @@
 #include "node.h"
 #include "node_buffer.h"
 #include "node_constants.h"
+#include "node_crypto_async_key.h"
 #include "node_crypto_bio.h"
 #include "node_crypto_clienthello-inl.h"
 #include "node_crypto_groups.h"
@@ -66,6 +67,7 @@ using v8::EscapableHandleScope;
 using v8::Exception;
 using v8::External;
 using v8::False;
+using v8::Float64Array;
 using v8::Function;
 using v8::FunctionCallback;
 using v8::FunctionCallbackInfo;
@@ -88,6 +90,7 @@ using v8::SideEffectType;
 using v8::Signature;
 using v8::String;
 using v8::Uint32;
+using v8::Uint32Array;
 using v8::Undefined;
 using v8::Value;
 
@@ -351,6 +354,8 @@ void SecureContext::Initialize(Environment* env, Local<Object> target) {
   env->SetProtoMethod(t, "setOptions", SetOptions);
   env->SetProtoMethod(t, "setSessionIdContext", SetSessionIdContext);
   env->SetProtoMethod(t, "setSessionTimeout", SetSessionTimeout);
+  env->SetProtoMethod(t, "setSessionCache", SetSessionCache);
+  env->SetProtoMethod(t, "enableAsyncPrivateKey", EnableAsyncPrivateKey);
   env->SetProtoMethod(t, "close", Close);
   env->SetProtoMethod(t, "loadPKCS12", LoadPKCS12);
 #ifndef OPENSSL_NO_ENGINE
@@ -1179,6 +1184,68 @@ void SecureContext::SetSessionTimeout(const FunctionCallbackInfo<Value>& args) {
 }
 
 
+void SecureContext::SetSessionCache(const FunctionCallbackInfo<Value>& args) {
+  SecureContext* sc;
+  ASSIGN_OR_RETURN_UNWRAP(&sc, args.Holder());
+  Environment* env = sc->env();
+
+  CHECK_EQ(args.Length(), 3);
+  CHECK(args[0]->IsString());
+  CHECK(args[1]->IsUint32());
+  CHECK(args[2]->IsUint32());
+
+  const node::Utf8Value name(env->isolate(), args[0]);
+  uint32_t max_entries = args[1].As<Uint32>()->Value();
+  uint32_t ticket_key_rotation = args[2].As<Uint32>()->Value();
+
+  std::shared_ptr<SessionCache> cache =
+      SessionCache::GetOrCreate(*name, max_entries, ticket_key_rotation);
+  if (!cache)
+    return env->ThrowError("Error generating ticket keys");
+  if (!cache->HasParameters(max_entries, ticket_key_rotation)) {
+    std::string message = "The session cache '" + std::string(*name) +
+                          "' already exists with a different maxEntries or "
+                          "ticketKeyRotation";
+    return THROW_ERR_INVALID_ARG_VALUE(env, message.c_str());
+  }
+  sc->session_cache_ = std::move(cache);
+}
+
+
+void SecureContext::EnableAsyncPrivateKey(
+    const FunctionCallbackInfo<Value>& args) {
+  SecureContext* sc;
+  ASSIGN_OR_RETURN_UNWRAP(&sc, args.Holder());
+
+  EVP_PKEY* pkey = SSL_CTX_get0_privatekey(sc->ctx_.get());
+  sc->async_private_key_ = crypto::EnableAsyncPrivateKey(pkey);
+  args.GetReturnValue().Set(sc->async_private_key_);
+}
+
+
+void GetSessionCacheStats(const FunctionCallbackInfo<Value>& args) {
+  CHECK(args[0]->IsString());
+  CHECK(args[1]->IsFloat64Array());
+
+  const node::Utf8Value name(args.GetIsolate(), args[0]);
+  std::shared_ptr<SessionCache> cache = SessionCache::Get(*name);
+  if (!cache)
+    return args.GetReturnValue().Set(false);
+
+  Local<Float64Array> array = args[1].As<Float64Array>();
+  CHECK_EQ(array->Length(), 6);
+  double* fields = static_cast<double*>(array->Buffer()->GetContents().Data());
+  SessionCache::Stats stats = cache->GetStats();
+  fields[0] = static_cast<double>(stats.size);
+  fields[1] = static_cast<double>(stats.hits);
+  fields[2] = static_cast<double>(stats.misses);
+  fields[3] = static_cast<double>(stats.evictions);
+  fields[4] = static_cast<double>(stats.ticket_hits);
+  fields[5] = static_cast<double>(stats.ticket_misses);
+  args.GetReturnValue().Set(true);
+}
+
+
 void SecureContext::Close(const FunctionCallbackInfo<Value>& args) {
   SecureContext* sc;
   ASSIGN_OR_RETURN_UNWRAP(&sc, args.Holder());
@@ -1314,6 +1381,11 @@ void SecureContext::GetTicketKeys(const FunctionCallbackInfo<Value>& args) {
   ASSIGN_OR_RETURN_UNWRAP(&wrap, args.Holder());
 
   Local<Object> buff = Buffer::New(wrap->env(), 48).ToLocalChecked();
+  if (wrap->session_cache_) {
+    wrap->session_cache_->GetTicketKeys(
+        reinterpret_cast<unsigned char*>(Buffer::Data(buff)));
+    return args.GetReturnValue().Set(buff);
+  }
   memcpy(Buffer::Data(buff), wrap->ticket_key_name_, 16);
   memcpy(Buffer::Data(buff) + 16, wrap->ticket_key_hmac_, 16);
   memcpy(Buffer::Data(buff) + 32, wrap->ticket_key_aes_, 16);
@@ -1342,6 +1414,13 @@ void SecureContext::SetTicketKeys(const FunctionCallbackInfo<Value>& args) {
         env, "Ticket keys length must be 48 bytes");
   }
 
+  if (wrap->session_cache_) {
+    // The keys are shared, so is replacing them.
+    wrap->session_cache_->SetTicketKeys(
+        reinterpret_cast<const unsigned char*>(buf.data()));
+    return args.GetReturnValue().Set(true);
+  }
+
   memcpy(wrap->ticket_key_name_, buf.data(), 16);
   memcpy(wrap->ticket_key_hmac_, buf.data() + 16, 16);
   memcpy(wrap->ticket_key_aes_, buf.data() + 32, 16);
@@ -1454,6 +1533,44 @@ int SecureContext::TicketKeyCallback(SSL* ssl,
 }
 
 
+static int SharedTicketKeyCallback(SessionCache* cache,
+                                   unsigned char* name,
+                                   unsigned char* iv,
+                                   EVP_CIPHER_CTX* ectx,
+                                   HMAC_CTX* hctx,
+                                   int enc) {
+  SessionCache::TicketKey key;
+  bool renew = false;
+
+  if (enc) {
+    cache->GetEncryptionKey(&key);
+    memcpy(name, key.name, sizeof(key.name));
+    if (RAND_bytes(iv, 16) <= 0 ||
+        EVP_EncryptInit_ex(ectx, EVP_aes_128_cbc(), nullptr,
+                           key.aes, iv) <= 0 ||
+        HMAC_Init_ex(hctx, key.hmac, sizeof(key.hmac),
+                     EVP_sha256(), nullptr) <= 0) {
+      return -1;
+    }
+    return 1;
+  }
+
+  if (!cache->GetDecryptionKey(name, &key, &renew)) {
+    // The ticket key name does not match. Discard the ticket.
+    return 0;
+  }
+
+  if (EVP_DecryptInit_ex(ectx, EVP_aes_128_cbc(), nullptr, key.aes,
+                         iv) <= 0 ||
+      HMAC_Init_ex(hctx, key.hmac, sizeof(key.hmac),
+                   EVP_sha256(), nullptr) <= 0) {
+    return -1;
+  }
+  // Tickets that use the previous key are replaced with new ones.
+  return renew ? 2 : 1;
+}
+
+
 int SecureContext::TicketCompatibilityCallback(SSL* ssl,
                                                unsigned char* name,
                                                unsigned char* iv,
@@ -1463,6 +1580,10 @@ int SecureContext::TicketCompatibilityCallback(SSL* ssl,
   SecureContext* sc = static_cast<SecureContext*>(
       SSL_CTX_get_app_data(SSL_get_SSL_CTX(ssl)));
 
+  if (sc->session_cache_)
+    return SharedTicketKeyCallback(sc->session_cache_.get(),
+                                   name, iv, ectx, hctx, enc);
+
   if (enc) {
     memcpy(name, sc->ticket_key_name_, sizeof(sc->ticket_key_name_));
     if (RAND_bytes(iv, 16) <= 0 ||
@@ -1573,6 +1694,12 @@ SSL_SESSION* SSLWrap<Base>::GetSessionCallback(SSL* s,
   Base* w = static_cast<Base*>(SSL_get_app_data(s));
 
   *copy = 0;
+  if (!w->next_sess_ && w->is_server()) {
+    SecureContext* sc = static_cast<SecureContext*>(
+        SSL_CTX_get_app_data(SSL_get_SSL_CTX(s)));
+    if (sc->session_cache_)
+      return sc->session_cache_->Lookup(key, len);
+  }
   return w->next_sess_.release();
 }
 
@@ -1584,6 +1711,18 @@ int SSLWrap<Base>::NewSessionCallback(SSL* s, SSL_SESSION* sess) {
   HandleScope handle_scope(env->isolate());
   Context::Scope context_scope(env->context());
 
+  if (w->is_server()) {
+    SecureContext* sc = static_cast<SecureContext*>(
+        SSL_CTX_get_app_data(SSL_get_SSL_CTX(s)));
+    // TLS 1.3 sessions are resumed through stateless tickets, unless those
+    // are disabled.
+    if (sc->session_cache_ &&
+        (SSL_version(s) != TLS1_3_VERSION ||
+         (SSL_get_options(s) & SSL_OP_NO_TICKET) != 0)) {
+      sc->session_cache_->Store(sess);
+    }
+  }
+
   if (!w->session_callbacks_)
     return 0;
 
@@ -2618,11 +2757,37 @@ int SSLWrap<Base>::SSLCertCallback(SSL* s, void* arg) {
     // handshake will continue after certcb is done.
     return -1;
 
+  w->cert_cb_running_ = true;
+
+  // JS must not run on the stack of an OpenSSL async job, see
+  // AsyncKeyOperation. Suspend the handshake, and call into JS right after.
+  if (ASYNC_get_current_job() != nullptr) {
+    w->env()->SetImmediate([](Environment* env, void* data) {
+      Base* w = static_cast<Base*>(data);
+      if (w->ssl_)
+        w->InvokeCertCb();
+    }, w, w->object());
+    return -1;
+  }
+
+  w->InvokeCertCb();
+
+  if (!w->cert_cb_running_)
+    return 1;
+
+  // Performing async action, wait...
+  return -1;
+}
+
+
+template <class Base>
+void SSLWrap<Base>::InvokeCertCb() {
+  Base* w = static_cast<Base*>(this);
   Environment* env = w->env();
   Local<Context> context = env->context();
   HandleScope handle_scope(env->isolate());
   Context::Scope context_scope(context);
-  w->cert_cb_running_ = true;
+  SSL* s = ssl_.get();
 
   Local<Object> info = Object::New(env->isolate());
 
@@ -2643,12 +2808,6 @@ int SSLWrap<Base>::SSLCertCallback(SSL* s, void* arg) {
 
   Local<Value> argv[] = { info };
   w->MakeCallback(env->oncertcb_string(), arraysize(argv), argv);
-
-  if (!w->cert_cb_running_)
-    return 1;
-
-  // Performing async action, wait...
-  return -1;
 }
 
 
@@ -2733,6 +2892,9 @@ void SSLWrap<Base>::DestroySSL() {
 template <class Base>
 void SSLWrap<Base>::SetSNIContext(SecureContext* sc) {
   ConfigureSecureContext(sc);
+  // The key log callback is read from the connection's current context.
+  if (static_cast<Base*>(this)->WantsKeylog())
+    SSL_CTX_set_keylog_callback(sc->ctx_.get(), Base::KeylogCallback);
   CHECK_EQ(SSL_set_SSL_CTX(ssl_.get(), sc->ctx_.get()), sc->ctx_.get());
 
   SetCACerts(sc);
@@ -3609,6 +3771,91 @@ MaybeLocal<Value> KeyObject::ExportPrivateKey(
 }
 
 
+// TODO(addaleax): If there is an `AsyncWrap`, it currently has no access to
+// this object. This makes proper reporting of memory usage impossible.
+struct CryptoJob : public ThreadPoolWork {
+  Environment* const env;
+  std::unique_ptr<AsyncWrap> async_wrap;
+  inline explicit CryptoJob(Environment* env) : ThreadPoolWork(env), env(env) {}
+  inline void AfterThreadPoolWork(int status) final;
+  virtual void AfterThreadPoolWork() = 0;
+  static inline void Run(std::unique_ptr<CryptoJob> job, Local<Value> wrap);
+};
+
+
+void CryptoJob::AfterThreadPoolWork(int status) {
+  CHECK(status == 0 || status == UV_ECANCELED);
+  std::unique_ptr<CryptoJob> job(this);
+  if (status == UV_ECANCELED) return;
+  HandleScope handle_scope(env->isolate());
+  Context::Scope context_scope(env->context());
+  CHECK_EQ(false, async_wrap->persistent().IsWeak());
+  AfterThreadPoolWork();
+}
+
+
+void CryptoJob::Run(std::unique_ptr<CryptoJob> job, Local<Value> wrap) {
+  CHECK(wrap->IsObject());
+  CHECK_NULL(job->async_wrap);
+  job->async_wrap.reset(Unwrap<AsyncWrap>(wrap.As<Object>()));
+  CHECK_EQ(false, job->async_wrap->persistent().IsWeak());
+  job->ScheduleWork();
+  job.release();  // Run free, little job!
+}
+
+
+// Feeds data to a Hash or an Hmac on the threadpool. The wrap object retains
+// the data and the object, and JS does not use the object until ondone() has
+// been called.
+template <typename T, bool (T::*Update)(const char*, int)>
+struct DigestUpdateJob : public CryptoJob {
+  T* object;
+  const char* data;
+  int size;
+  bool ok = false;
+
+  inline explicit DigestUpdateJob(Environment* env) : CryptoJob(env) {}
+
+  inline void DoThreadPoolWork() override {
+    ok = (object->*Update)(data, size);
+  }
+
+  inline void AfterThreadPoolWork() override {
+    Local<Value> arg = Boolean::New(env->isolate(), ok);
+    async_wrap->MakeCallback(env->ondone_string(), 1, &arg);
+  }
+};
+
+
+// Like DigestUpdateJob, for CipherBase::Update().
+struct CipherBase::UpdateJob : public CryptoJob {
+  CipherBase* cipher;
+  const char* data;
+  int size;
+  AllocatedBuffer out;
+  UpdateResult result = kErrorState;
+
+  inline explicit UpdateJob(Environment* env) : CryptoJob(env) {}
+
+  inline void DoThreadPoolWork() override {
+    result = cipher->Update(data, size, &out);
+  }
+
+  inline void AfterThreadPoolWork() override {
+    Local<Value> argv[2];
+    if (result == kSuccess) {
+      argv[0] = Null(env->isolate());
+      argv[1] = out.ToBuffer().ToLocalChecked();
+    } else {
+      argv[0] = Exception::Error(FIXED_ONE_BYTE_STRING(
+          env->isolate(), "Trying to add data in unsupported state"));
+      argv[1] = Undefined(env->isolate());
+    }
+    async_wrap->MakeCallback(env->ondone_string(), arraysize(argv), argv);
+  }
+};
+
+
 void CipherBase::Initialize(Environment* env, Local<Object> target) {
   Local<FunctionTemplate> t = env->NewFunctionTemplate(New);
 
@@ -4110,6 +4357,23 @@ void CipherBase::Update(const FunctionCallbackInfo<Value>& args) {
   CipherBase* cipher;
   ASSIGN_OR_RETURN_UNWRAP(&cipher, args.Holder());
 
+  // With a wrap object, encrypt on the threadpool. CCM messages are limited
+  // to a single update() and checked up front, so they stay synchronous.
+  if (args[2]->IsObject()) {
+    CHECK(args[0]->IsArrayBufferView());
+    CHECK_LE(Buffer::Length(args[0]), INT_MAX);
+    if (cipher->ctx_ != nullptr &&
+        EVP_CIPHER_CTX_mode(cipher->ctx_.get()) == EVP_CIPH_CCM_MODE) {
+      return args.GetReturnValue().Set(false);
+    }
+    std::unique_ptr<UpdateJob> job(new UpdateJob(env));
+    job->cipher = cipher;
+    job->data = Buffer::Data(args[0]);
+    job->size = Buffer::Length(args[0]);
+    CryptoJob::Run(std::move(job), args[2]);
+    return args.GetReturnValue().Set(true);
+  }
+
   AllocatedBuffer out;
   UpdateResult r;
 
@@ -4296,6 +4560,18 @@ void Hmac::HmacUpdate(const FunctionCallbackInfo<Value>& args) {
   Hmac* hmac;
   ASSIGN_OR_RETURN_UNWRAP(&hmac, args.Holder());
 
+  // With a wrap object, hash on the threadpool.
+  if (args[2]->IsObject()) {
+    CHECK(args[0]->IsArrayBufferView());
+    CHECK_LE(Buffer::Length(args[0]), INT_MAX);
+    using Job = DigestUpdateJob<Hmac, &Hmac::HmacUpdate>;
+    std::unique_ptr<Job> job(new Job(env));
+    job->object = hmac;
+    job->data = Buffer::Data(args[0]);
+    job->size = Buffer::Length(args[0]);
+    return CryptoJob::Run(std::move(job), args[2]);
+  }
+
   // Only copy the data if we have to, because it's a string
   bool r = false;
   if (args[0]->IsString()) {
@@ -4403,6 +4679,18 @@ void Hash::HashUpdate(const FunctionCallbackInfo<Value>& args) {
   Hash* hash;
   ASSIGN_OR_RETURN_UNWRAP(&hash, args.Holder());
 
+  // With a wrap object, hash on the threadpool.
+  if (args[2]->IsObject()) {
+    CHECK(args[0]->IsArrayBufferView());
+    CHECK_LE(Buffer::Length(args[0]), INT_MAX);
+    using Job = DigestUpdateJob<Hash, &Hash::HashUpdate>;
+    std::unique_ptr<Job> job(new Job(env));
+    job->object = hash;
+    job->data = Buffer::Data(args[0]);
+    job->size = Buffer::Length(args[0]);
+    return CryptoJob::Run(std::move(job), args[2]);
+  }
+
   // Only copy the data if we have to, because it's a string
   bool r = true;
   if (args[0]->IsString()) {
@@ -5474,39 +5762,6 @@ bool ECDH::IsKeyPairValid() {
 }
 
 
-// TODO(addaleax): If there is an `AsyncWrap`, it currently has no access to
-// this object. This makes proper reporting of memory usage impossible.
-struct CryptoJob : public ThreadPoolWork {
-  Environment* const env;
-  std::unique_ptr<AsyncWrap> async_wrap;
-  inline explicit CryptoJob(Environment* env) : ThreadPoolWork(env), env(env) {}
-  inline void AfterThreadPoolWork(int status) final;
-  virtual void AfterThreadPoolWork() = 0;
-  static inline void Run(std::unique_ptr<CryptoJob> job, Local<Value> wrap);
-};
-
-
-void CryptoJob::AfterThreadPoolWork(int status) {
-  CHECK(status == 0 || status == UV_ECANCELED);
-  std::unique_ptr<CryptoJob> job(this);
-  if (status == UV_ECANCELED) return;
-  HandleScope handle_scope(env->isolate());
-  Context::Scope context_scope(env->context());
-  CHECK_EQ(false, async_wrap->persistent().IsWeak());
-  AfterThreadPoolWork();
-}
-
-
-void CryptoJob::Run(std::unique_ptr<CryptoJob> job, Local<Value> wrap) {
-  CHECK(wrap->IsObject());
-  CHECK_NULL(job->async_wrap);
-  job->async_wrap.reset(Unwrap<AsyncWrap>(wrap.As<Object>()));
-  CHECK_EQ(false, job->async_wrap->persistent().IsWeak());
-  job->ScheduleWork();
-  job.release();  // Run free, little job!
-}
-
-
 inline void CopyBuffer(Local<Value> buf, std::vector<char>* vec) {
   CHECK(buf->IsArrayBufferView());
   vec->clear();
@@ -5630,6 +5885,143 @@ inline void PBKDF2(const FunctionCallbackInfo<Value>& args) {
 }
 
 
+struct HashJob : public CryptoJob {
+  const EVP_MD* md;
+  const char* data;
+  size_t size;
+  unsigned char md_value[EVP_MAX_MD_SIZE];
+  unsigned int md_len = 0;
+  bool ok = false;
+
+  inline explicit HashJob(Environment* env) : CryptoJob(env) {}
+
+  inline void DoThreadPoolWork() override {
+    ok = EVP_Digest(data, size, md_value, &md_len, md, nullptr) == 1;
+  }
+
+  inline void AfterThreadPoolWork() override {
+    Local<Value> arg = Undefined(env->isolate());
+    if (ok) {
+      arg = Buffer::Copy(env, reinterpret_cast<const char*>(md_value), md_len)
+                .ToLocalChecked();
+    }
+    async_wrap->MakeCallback(env->ondone_string(), 1, &arg);
+  }
+};
+
+
+inline void HashOneShot(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CHECK(args[0]->IsString());  // digest_name
+  CHECK(args[1]->IsArrayBufferView());  // data; wrap object retains ref.
+  CHECK(args[2]->IsObject());  // wrap object
+  std::unique_ptr<HashJob> job(new HashJob(env));
+  Utf8Value digest_name(args.GetIsolate(), args[0]);
+  job->md = EVP_get_digestbyname(*digest_name);
+  if (job->md == nullptr) return args.GetReturnValue().Set(false);
+  job->data = Buffer::Data(args[1]);
+  job->size = Buffer::Length(args[1]);
+  HashJob::Run(std::move(job), args[2]);
+  args.GetReturnValue().Set(true);
+}
+
+
+// Hashes many, typically small inputs, reusing one EVP_MD_CTX for all of them
+// so that there are no allocations per input.
+struct HashBatchJob : public CryptoJob {
+  const EVP_MD* md;
+  std::vector<std::pair<const char*, size_t>> inputs;
+  AllocatedBuffer out;
+  bool ok = false;
+
+  inline explicit HashBatchJob(Environment* env) : CryptoJob(env) {}
+
+  inline void DoThreadPoolWork() override {
+    EVPMDPointer ctx(EVP_MD_CTX_new());
+    if (!ctx)
+      return;
+    auto md_value = reinterpret_cast<unsigned char*>(out.data());
+    const int md_len = EVP_MD_size(md);
+    for (const auto& input : inputs) {
+      if (EVP_DigestInit_ex(ctx.get(), md, nullptr) != 1 ||
+          EVP_DigestUpdate(ctx.get(), input.first, input.second) != 1 ||
+          EVP_DigestFinal_ex(ctx.get(), md_value, nullptr) != 1) {
+        return;
+      }
+      md_value += md_len;
+    }
+    ok = true;
+  }
+
+  inline void AfterThreadPoolWork() override {
+    Local<Value> arg = ToResult();
+    async_wrap->MakeCallback(env->ondone_string(), 1, &arg);
+  }
+
+  inline Local<Value> ToResult() {
+    if (!ok) return Undefined(env->isolate());
+    if (inputs.empty()) return Buffer::New(env, 0).ToLocalChecked();
+    return out.ToBuffer().ToLocalChecked();
+  }
+};
+
+
+void HashBatch(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CHECK(args[0]->IsString());  // digest_name
+  // Either an array of inputs, or one input and the Uint32Array of offsets
+  // at which each of the parts of it start and end. The wrap object retains
+  // a reference to them.
+  CHECK(args[1]->IsArray() || args[1]->IsArrayBufferView());
+  CHECK(args[2]->IsUint32Array() || args[2]->IsUndefined());
+  CHECK(args[3]->IsObject() || args[3]->IsUndefined());  // wrap object
+  std::unique_ptr<HashBatchJob> job(new HashBatchJob(env));
+  Utf8Value digest_name(args.GetIsolate(), args[0]);
+  job->md = EVP_get_digestbyname(*digest_name);
+  if (job->md == nullptr) return args.GetReturnValue().Set(false);
+
+  if (args[1]->IsArray()) {
+    Local<Array> inputs = args[1].As<Array>();
+    const uint32_t count = inputs->Length();
+    job->inputs.reserve(count);
+    for (uint32_t i = 0; i < count; i++) {
+      Local<Value> input;
+      if (!inputs->Get(env->context(), i).ToLocal(&input))
+        return;
+      CHECK(input->IsArrayBufferView());
+      job->inputs.emplace_back(Buffer::Data(input), Buffer::Length(input));
+    }
+  } else {
+    CHECK(args[2]->IsUint32Array());
+    const char* data = Buffer::Data(args[1]);
+    const size_t length = Buffer::Length(args[1]);
+    const uint32_t* offsets =
+        reinterpret_cast<const uint32_t*>(Buffer::Data(args[2]));
+    const size_t count = args[2].As<Uint32Array>()->Length();
+    CHECK_GT(count, 0);
+    job->inputs.reserve(count - 1);
+    for (size_t i = 1; i < count; i++) {
+      CHECK_LE(offsets[i - 1], offsets[i]);
+      CHECK_LE(offsets[i], length);
+      job->inputs.emplace_back(data + offsets[i - 1],
+                               offsets[i] - offsets[i - 1]);
+    }
+  }
+
+  if (!job->inputs.empty()) {
+    job->out =
+        env->AllocateManaged(job->inputs.size() * EVP_MD_size(job->md));
+  }
+  if (args[3]->IsObject()) {
+    HashBatchJob::Run(std::move(job), args[3]);
+    return args.GetReturnValue().Set(true);
+  }
+  env->PrintSyncTrace();
+  job->DoThreadPoolWork();
+  args.GetReturnValue().Set(job->ToResult());
+}
+
+
 #ifndef OPENSSL_NO_SCRYPT
 struct ScryptJob : public CryptoJob {
   unsigned char* keybuf_data;
@@ -6434,6 +6826,8 @@ void Initialize(Local<Object> target,
                              IsExtraRootCertsFileLoaded);
 
   env->SetMethodNoSideEffect(target, "ECDHConvertKey", ConvertKey);
+  env->SetMethodNoSideEffect(target, "getSessionCacheStats",
+                             GetSessionCacheStats);
 #ifndef OPENSSL_NO_ENGINE
   env->SetMethod(target, "setEngine", SetEngine);
 #endif  // !OPENSSL_NO_ENGINE
@@ -6444,6 +6838,8 @@ void Initialize(Local<Object> target,
 #endif
 
   env->SetMethod(target, "pbkdf2", PBKDF2);
+  env->SetMethod(target, "hash", HashOneShot);
+  env->SetMethod(target, "hashBatch", HashBatch);
   env->SetMethod(target, "generateKeyPairRSA", GenerateKeyPairRSA);
   env->SetMethod(target, "generateKeyPairDSA", GenerateKeyPairDSA);
   env->SetMethod(target, "generateKeyPairEC", GenerateKeyPairEC);
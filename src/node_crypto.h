@@ -27,6 +27,7 @@
 #include "node.h"
 // ClientHelloParser
 #include "node_crypto_clienthello.h"
+#include "node_crypto_session_cache.h"
 
 #include "node_buffer.h"
 
@@ -131,6 +132,11 @@ class SecureContext : public BaseObject {
   unsigned char ticket_key_hmac_[16];
 #endif
 
+  // If set, server sessions and ticket keys are shared with other contexts.
+  std::shared_ptr<SessionCache> session_cache_;
+  // If set, server-side TLSWraps sign handshakes on the threadpool.
+  bool async_private_key_ = false;
+
  protected:
 #if OPENSSL_VERSION_NUMBER < 0x10100000L
   static const int64_t kExternalSize = sizeof(SSL_CTX);
@@ -156,6 +162,9 @@ class SecureContext : public BaseObject {
       const v8::FunctionCallbackInfo<v8::Value>& args);
   static void SetSessionTimeout(
       const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void SetSessionCache(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void EnableAsyncPrivateKey(
+      const v8::FunctionCallbackInfo<v8::Value>& args);
   static void SetMinProto(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void SetMaxProto(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void GetMinProto(const v8::FunctionCallbackInfo<v8::Value>& args);
@@ -316,6 +325,7 @@ class SSLWrap {
   static int SSLCertCallback(SSL* s, void* arg);
 
   void DestroySSL();
+  void InvokeCertCb();
   void WaitForCertCb(CertCb cb, void* arg);
   void SetSNIContext(SecureContext* sc);
   int SetCACerts(SecureContext* sc);
@@ -524,6 +534,8 @@ class CipherBase : public BaseObject {
   };
   static const unsigned kNoAuthTagLength = static_cast<unsigned>(-1);
 
+  struct UpdateJob;
+
   void CommonInit(const char* cipher_type,
                   const EVP_CIPHER* cipher,
                   const unsigned char* key,
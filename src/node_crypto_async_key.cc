@@ -0,0 +1,181 @@
+#include "node_crypto_async_key.h"
+
+#include <openssl/ec.h>
+#include <openssl/err.h>
+#include <openssl/rsa.h>
+
+#include <cstring>
+#include <vector>
+
+namespace node {
+namespace crypto {
+
+namespace {
+
+thread_local std::shared_ptr<AsyncKeyOperation> pending_operation;
+
+// Pauses the current job until `operation` is done and returns its result.
+int WaitFor(std::shared_ptr<AsyncKeyOperation> operation) {
+  pending_operation = operation;
+  while (!operation->done) {
+    if (ASYNC_pause_job() == 0) {
+      pending_operation.reset();
+      operation->Run();
+      break;
+    }
+  }
+
+  if (operation->error != 0) {
+    ERR_put_error(ERR_GET_LIB(operation->error),
+                  ERR_GET_FUNC(operation->error),
+                  ERR_GET_REASON(operation->error),
+                  __FILE__,
+                  __LINE__);
+  }
+  return operation->result;
+}
+
+
+using RSAOperation =
+    int (*)(int flen, const unsigned char* from, unsigned char* to, RSA* rsa,
+            int padding);
+
+int RunRSAOperation(RSAOperation operation,
+                    int flen,
+                    const unsigned char* from,
+                    unsigned char* to,
+                    RSA* rsa,
+                    int padding) {
+  if (ASYNC_get_current_job() == nullptr)
+    return operation(flen, from, to, rsa, padding);
+
+  auto input = std::make_shared<std::vector<unsigned char>>(from, from + flen);
+  auto output = std::make_shared<std::vector<unsigned char>>(RSA_size(rsa));
+  RSA_up_ref(rsa);
+  std::shared_ptr<RSA> key(rsa, RSA_free);
+
+  int result = WaitFor(std::make_shared<AsyncKeyOperation>([=]() {
+    return operation(flen, input->data(), output->data(), key.get(), padding);
+  }));
+  if (result > 0)
+    memcpy(to, output->data(), result);
+  return result;
+}
+
+
+int RSAPrivateEncrypt(int flen,
+                      const unsigned char* from,
+                      unsigned char* to,
+                      RSA* rsa,
+                      int padding) {
+  return RunRSAOperation(RSA_meth_get_priv_enc(RSA_PKCS1_OpenSSL()),
+                         flen, from, to, rsa, padding);
+}
+
+
+using ECSignOperation =
+    int (*)(int type, const unsigned char* dgst, int dlen, unsigned char* sig,
+            unsigned int* siglen, const BIGNUM* kinv, const BIGNUM* r,
+            EC_KEY* eckey);
+
+int ECSign(int type,
+           const unsigned char* dgst,
+           int dlen,
+           unsigned char* sig,
+           unsigned int* siglen,
+           const BIGNUM* kinv,
+           const BIGNUM* r,
+           EC_KEY* eckey) {
+  ECSignOperation sign;
+  EC_KEY_METHOD_get_sign(EC_KEY_OpenSSL(), &sign, nullptr, nullptr);
+
+  if (ASYNC_get_current_job() == nullptr || kinv != nullptr || r != nullptr)
+    return sign(type, dgst, dlen, sig, siglen, kinv, r, eckey);
+
+  auto input = std::make_shared<std::vector<unsigned char>>(dgst, dgst + dlen);
+  auto output = std::make_shared<std::vector<unsigned char>>(
+      ECDSA_size(eckey));
+  auto length = std::make_shared<unsigned int>(0);
+  EC_KEY_up_ref(eckey);
+  std::shared_ptr<EC_KEY> key(eckey, EC_KEY_free);
+
+  int result = WaitFor(std::make_shared<AsyncKeyOperation>([=]() {
+    return sign(type, input->data(), dlen, output->data(), length.get(),
+                nullptr, nullptr, key.get());
+  }));
+  if (result == 1) {
+    memcpy(sig, output->data(), *length);
+    *siglen = *length;
+  }
+  return result;
+}
+
+
+const RSA_METHOD* AsyncRSAMethod() {
+  static RSA_METHOD* method = []() {
+    RSA_METHOD* method = RSA_meth_dup(RSA_PKCS1_OpenSSL());
+    RSA_meth_set1_name(method, "node.js async RSA");
+    RSA_meth_set_priv_enc(method, RSAPrivateEncrypt);
+    return method;
+  }();
+  return method;
+}
+
+
+const EC_KEY_METHOD* AsyncECMethod() {
+  static EC_KEY_METHOD* method = []() {
+    EC_KEY_METHOD* method = EC_KEY_METHOD_new(EC_KEY_OpenSSL());
+    int (*sign_setup)(EC_KEY*, BN_CTX*, BIGNUM**, BIGNUM**);
+    ECDSA_SIG* (*sign_sig)(const unsigned char*, int, const BIGNUM*,
+                           const BIGNUM*, EC_KEY*);
+    EC_KEY_METHOD_get_sign(method, nullptr, &sign_setup, &sign_sig);
+    EC_KEY_METHOD_set_sign(method, ECSign, sign_setup, sign_sig);
+    return method;
+  }();
+  return method;
+}
+
+}  // anonymous namespace
+
+
+void AsyncKeyOperation::Run() {
+  result = work();
+  error = ERR_peek_last_error();
+  ERR_clear_error();
+}
+
+
+bool EnableAsyncPrivateKey(EVP_PKEY* pkey) {
+  if (pkey == nullptr || !ASYNC_is_capable())
+    return false;
+
+  // Keys that are backed by an engine keep their own methods.
+  switch (EVP_PKEY_id(pkey)) {
+    case EVP_PKEY_RSA: {
+      RSA* rsa = EVP_PKEY_get0_RSA(pkey);
+      if (RSA_get_method(rsa) == AsyncRSAMethod())
+        return true;
+      if (RSA_get_method(rsa) != RSA_PKCS1_OpenSSL())
+        return false;
+      return RSA_set_method(rsa, AsyncRSAMethod()) == 1;
+    }
+    case EVP_PKEY_EC: {
+      EC_KEY* ec = EVP_PKEY_get0_EC_KEY(pkey);
+      if (EC_KEY_get_method(ec) == AsyncECMethod())
+        return true;
+      if (EC_KEY_get_method(ec) != EC_KEY_OpenSSL())
+        return false;
+      return EC_KEY_set_method(ec, AsyncECMethod()) == 1;
+    }
+    default:
+      return false;
+  }
+}
+
+
+std::shared_ptr<AsyncKeyOperation> TakeAsyncKeyOperation() {
+  return std::move(pending_operation);
+}
+
+}  // namespace crypto
+}  // namespace node
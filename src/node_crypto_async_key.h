@@ -0,0 +1,54 @@
+#ifndef SRC_NODE_CRYPTO_ASYNC_KEY_H_
+#define SRC_NODE_CRYPTO_ASYNC_KEY_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include <openssl/async.h>
+#include <openssl/evp.h>
+
+#include <functional>
+#include <memory>
+
+namespace node {
+namespace crypto {
+
+// A private key operation that was started from within an OpenSSL async job,
+// i.e. during a call to SSL_read() or SSL_write() on an SSL with
+// SSL_MODE_ASYNC set. Instead of computing the signature on the spot, the job
+// is paused, and that call fails with SSL_ERROR_WANT_ASYNC. The caller is
+// expected to pick up the operation with TakeAsyncKeyOperation(), Run() it
+// elsewhere, set `done` on the original thread and then repeat the call, which
+// resumes the job with the result.
+//
+// Callbacks that OpenSSL invokes while a job is running run on the job's own,
+// small stack, and must not call into JS.
+struct AsyncKeyOperation {
+  explicit AsyncKeyOperation(std::function<int()> work)
+      : work(std::move(work)) {}
+
+  // May be called from any thread.
+  void Run();
+
+  std::function<int()> work;
+  int result = -1;
+  unsigned long error = 0;  // NOLINT(runtime/int)
+  bool done = false;
+};
+
+// Makes signing with `pkey` pause the current OpenSSL async job, if there is
+// one, and run synchronously otherwise. Returns false if the key type is not
+// RSA or EC, or if async jobs are not supported. Decryption, i.e. RSA key
+// exchange, is left alone: it happens after the first flight, when TLSWrap
+// has left async mode again.
+bool EnableAsyncPrivateKey(EVP_PKEY* pkey);
+
+// Returns the operation that the async job paused last on this thread is
+// waiting for, if it has not been taken yet.
+std::shared_ptr<AsyncKeyOperation> TakeAsyncKeyOperation();
+
+}  // namespace crypto
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#endif  // SRC_NODE_CRYPTO_ASYNC_KEY_H_
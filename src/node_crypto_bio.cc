@@ -38,10 +38,63 @@ namespace crypto {
 #endif
 
 
+BIOBufferPool::BIOBufferPool(v8::Isolate* isolate) : isolate_(isolate) {}
+
+
+BIOBufferPool::~BIOBufferPool() {
+  for (std::vector<char*>& free_list : free_lists_) {
+    for (char* data : free_list)
+      delete[] data;
+  }
+  isolate_->AdjustAmountOfExternalAllocatedMemory(
+      -static_cast<int64_t>(pooled_bytes_));
+}
+
+
+char* BIOBufferPool::Acquire(size_t* size) {
+  if (*size <= kMaxBufferSize) {
+    size_t index = 0;
+    size_t len = kMinBufferSize;
+    while (len < *size) {
+      len <<= 1;
+      index++;
+    }
+    *size = len;
+
+    std::vector<char*>& free_list = free_lists_[index];
+    if (!free_list.empty()) {
+      char* data = free_list.back();
+      free_list.pop_back();
+      pooled_bytes_ -= len;
+      return data;
+    }
+  }
+
+  isolate_->AdjustAmountOfExternalAllocatedMemory(*size);
+  return new char[*size];
+}
+
+
+void BIOBufferPool::Release(char* data, size_t size) {
+  if (size <= kMaxBufferSize && pooled_bytes_ + size <= kMaxPooledBytes) {
+    size_t index = 0;
+    for (size_t len = kMinBufferSize; len < size; len <<= 1)
+      index++;
+    CHECK_LT(index, kSizeClassCount);
+    free_lists_[index].push_back(data);
+    pooled_bytes_ += size;
+    return;
+  }
+
+  delete[] data;
+  isolate_->AdjustAmountOfExternalAllocatedMemory(-static_cast<int64_t>(size));
+}
+
+
 BIOPointer NodeBIO::New(Environment* env) {
   BIOPointer bio(BIO_new(GetMethod()));
   if (bio && env != nullptr)
-    NodeBIO::FromBIO(bio.get())->env_ = env;
+    NodeBIO::FromBIO(bio.get())->pool_ = env->bio_buffer_pool();
   return bio;
 }
 
@@ -101,12 +154,21 @@ int NodeBIO::Read(BIO* bio, char* out, int len) {
 
 
 char* NodeBIO::Peek(size_t* size) {
+  if (read_head_ == nullptr) {
+    *size = 0;
+    return nullptr;
+  }
   *size = read_head_->write_pos_ - read_head_->read_pos_;
   return read_head_->data_ + read_head_->read_pos_;
 }
 
 
 size_t NodeBIO::PeekMultiple(char** out, size_t* size, size_t* count) {
+  if (read_head_ == nullptr) {
+    *count = 0;
+    return 0;
+  }
+
   Buffer* pos = read_head_;
   size_t max = *count;
   size_t total = 0;
@@ -311,8 +373,12 @@ size_t NodeBIO::Read(char* out, size_t size) {
   CHECK_EQ(expected, bytes_read);
   length_ -= bytes_read;
 
-  // Free all empty buffers, but write_head's child
-  FreeEmpty();
+  // An idle BIO does not hold on to any memory. Otherwise, free all empty
+  // buffers, but write_head's child
+  if (length_ == 0)
+    FreeAll();
+  else
+    FreeEmpty();
 
   return bytes_read;
 }
@@ -341,6 +407,23 @@ void NodeBIO::FreeEmpty() {
 }
 
 
+void NodeBIO::FreeAll() {
+  CHECK_EQ(length_, 0);
+  if (read_head_ == nullptr)
+    return;
+
+  Buffer* current = read_head_;
+  do {
+    Buffer* next = current->next_;
+    delete current;
+    current = next;
+  } while (current != read_head_);
+
+  read_head_ = nullptr;
+  write_head_ = nullptr;
+}
+
+
 size_t NodeBIO::IndexOf(char delim, size_t limit) {
   size_t bytes_read = 0;
   size_t max = Length() > limit ? limit : Length();
@@ -463,7 +546,7 @@ void NodeBIO::TryAllocateForWrite(size_t hint) {
                              kThroughputBufferLength;
     if (len < hint)
       len = hint;
-    Buffer* next = new Buffer(env_, len);
+    Buffer* next = new Buffer(pool_, len);
 
     if (w == nullptr) {
       next->next_ = next;
@@ -478,36 +561,14 @@ void NodeBIO::TryAllocateForWrite(size_t hint) {
 
 
 void NodeBIO::Reset() {
-  if (read_head_ == nullptr)
-    return;
-
-  while (read_head_->read_pos_ != read_head_->write_pos_) {
-    CHECK(read_head_->write_pos_ > read_head_->read_pos_);
-
-    length_ -= read_head_->write_pos_ - read_head_->read_pos_;
-    read_head_->write_pos_ = 0;
-    read_head_->read_pos_ = 0;
-
-    read_head_ = read_head_->next_;
-  }
-  write_head_ = read_head_;
-  CHECK_EQ(length_, 0);
+  length_ = 0;
+  FreeAll();
 }
 
 
 NodeBIO::~NodeBIO() {
-  if (read_head_ == nullptr)
-    return;
-
-  Buffer* current = read_head_;
-  do {
-    Buffer* next = current->next_;
-    delete current;
-    current = next;
-  } while (current != read_head_);
-
-  read_head_ = nullptr;
-  write_head_ = nullptr;
+  length_ = 0;
+  FreeAll();
 }
 
 
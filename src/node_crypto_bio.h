@@ -30,9 +30,51 @@
 #include "util-inl.h"
 #include "v8.h"
 
+#include <vector>
+
 namespace node {
 namespace crypto {
 
+// Keeps the memory of drained NodeBIO buffers of one Environment around for
+// reuse, so that busy TLS connections do not allocate and free their buffers
+// over and over. Buffers are handed out in power-of-two size classes from
+// kMinBufferSize to kMaxBufferSize; larger ones bypass the pool. At most
+// kMaxPooledBytes are kept, anything beyond that is freed right away.
+class BIOBufferPool : public MemoryRetainer {
+ public:
+  static constexpr size_t kMinBufferSize = 1024;
+  static constexpr size_t kMaxBufferSize = 64 * 1024;
+  static constexpr size_t kMaxPooledBytes = 4 * 1024 * 1024;
+
+  explicit BIOBufferPool(v8::Isolate* isolate);
+  ~BIOBufferPool() override;
+
+  BIOBufferPool(const BIOBufferPool&) = delete;
+  BIOBufferPool& operator=(const BIOBufferPool&) = delete;
+
+  // Returns a buffer of at least `*size` bytes and sets `*size` to its
+  // actual length, which has to be passed back to Release().
+  char* Acquire(size_t* size);
+  void Release(char* data, size_t size);
+
+  inline size_t pooled_bytes() const { return pooled_bytes_; }
+
+  void MemoryInfo(MemoryTracker* tracker) const override {
+    tracker->TrackFieldWithSize("free_buffers", pooled_bytes_,
+                                "NodeBIO::Buffer");
+  }
+
+  SET_MEMORY_INFO_NAME(BIOBufferPool)
+  SET_SELF_SIZE(BIOBufferPool)
+
+ private:
+  static constexpr size_t kSizeClassCount = 7;  // 1 KB ... 64 KB
+
+  v8::Isolate* const isolate_;
+  size_t pooled_bytes_ = 0;
+  std::vector<char*> free_lists_[kSizeClassCount];
+};
+
 // This class represents buffers for OpenSSL I/O, implemented as a singly-linked
 // list of chunks. It can be used either for writing data from Node to OpenSSL,
 // or for reading data back, but not both.
@@ -55,13 +97,17 @@ class NodeBIO : public MemoryRetainer {
   // Allocate new buffer for write if needed
   void TryAllocateForWrite(size_t hint);
 
-  // Read `len` bytes maximum into `out`, return actual number of read bytes
+  // Read `len` bytes maximum into `out`, return actual number of read bytes.
+  // Once the BIO is drained, all of its buffers are released.
   size_t Read(char* out, size_t size);
 
   // Memory optimization:
   // Deallocate children of write head's child if they're empty
   void FreeEmpty();
 
+  // Deallocate all buffers, the BIO has to be empty
+  void FreeAll();
+
   // Return pointer to internal data and amount of
   // contiguous data available to read
   char* Peek(size_t* size);
@@ -133,25 +179,25 @@ class NodeBIO : public MemoryRetainer {
 
   class Buffer {
    public:
-    Buffer(Environment* env, size_t len) : env_(env),
-                                           read_pos_(0),
-                                           write_pos_(0),
-                                           len_(len),
-                                           next_(nullptr) {
-      data_ = new char[len];
-      if (env_ != nullptr)
-        env_->isolate()->AdjustAmountOfExternalAllocatedMemory(len);
+    Buffer(BIOBufferPool* pool, size_t len) : pool_(pool),
+                                              read_pos_(0),
+                                              write_pos_(0),
+                                              len_(len),
+                                              next_(nullptr) {
+      if (pool_ != nullptr)
+        data_ = pool_->Acquire(&len_);
+      else
+        data_ = new char[len];
     }
 
     ~Buffer() {
-      delete[] data_;
-      if (env_ != nullptr) {
-        const int64_t len = static_cast<int64_t>(len_);
-        env_->isolate()->AdjustAmountOfExternalAllocatedMemory(-len);
-      }
+      if (pool_ != nullptr)
+        pool_->Release(data_, len_);
+      else
+        delete[] data_;
     }
 
-    Environment* env_;
+    BIOBufferPool* pool_;
     size_t read_pos_;
     size_t write_pos_;
     size_t len_;
@@ -159,7 +205,7 @@ class NodeBIO : public MemoryRetainer {
     char* data_;
   };
 
-  Environment* env_ = nullptr;
+  BIOBufferPool* pool_ = nullptr;
   size_t initial_ = kInitialBufferLength;
   size_t length_ = 0;
   int eof_return_ = -1;
@@ -0,0 +1,315 @@
+#include "node_crypto_ktls.h"
+#include "util-inl.h"
+#include "uv.h"
+
+#include <openssl/crypto.h>
+#include <openssl/evp.h>
+#include <openssl/kdf.h>
+#include <openssl/objects.h>
+
+#include <cstring>
+#include <string>
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/tls.h>)
+#include <linux/tls.h>
+#endif
+#endif
+
+#ifdef TLS_TX
+#include <errno.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#define NODE_HAVE_KTLS 1
+#ifndef SOL_TLS
+#define SOL_TLS 282
+#endif
+#ifndef TCP_ULP
+#define TCP_ULP 31
+#endif
+#endif  // TLS_TX
+
+namespace node {
+namespace crypto {
+
+#ifdef NODE_HAVE_KTLS
+
+namespace {
+
+struct TrafficKeys {
+  unsigned char key[32];
+  size_t key_len;
+  unsigned char iv[12];
+  size_t iv_len;
+};
+
+// TLS 1.2: key_block = PRF(master_secret, "key expansion",
+//                          server_random + client_random),
+// split into client and server write keys, then client and server IVs.
+// AEAD suites have no MAC keys, and only the fixed part of the IV is derived.
+bool DeriveTLS12Keys(SSL* ssl, const EVP_MD* md, TrafficKeys* keys) {
+  unsigned char master[SSL_MAX_MASTER_KEY_LENGTH];
+  size_t master_len = SSL_SESSION_get_master_key(SSL_get_session(ssl),
+                                                 master,
+                                                 sizeof(master));
+  unsigned char client_random[SSL3_RANDOM_SIZE];
+  unsigned char server_random[SSL3_RANDOM_SIZE];
+  SSL_get_client_random(ssl, client_random, sizeof(client_random));
+  SSL_get_server_random(ssl, server_random, sizeof(server_random));
+
+  static const unsigned char label[] = "key expansion";
+  unsigned char block[2 * (sizeof(keys->key) + sizeof(keys->iv))];
+  size_t block_len = 2 * (keys->key_len + keys->iv_len);
+
+  EVP_PKEY_CTX* pctx = EVP_PKEY_CTX_new_id(EVP_PKEY_TLS1_PRF, nullptr);
+  bool ok = pctx != nullptr &&
+            EVP_PKEY_derive_init(pctx) > 0 &&
+            EVP_PKEY_CTX_set_tls1_prf_md(pctx, md) > 0 &&
+            EVP_PKEY_CTX_set1_tls1_prf_secret(pctx, master, master_len) > 0 &&
+            EVP_PKEY_CTX_add1_tls1_prf_seed(pctx, label,
+                                            sizeof(label) - 1) > 0 &&
+            EVP_PKEY_CTX_add1_tls1_prf_seed(pctx, server_random,
+                                            sizeof(server_random)) > 0 &&
+            EVP_PKEY_CTX_add1_tls1_prf_seed(pctx, client_random,
+                                            sizeof(client_random)) > 0 &&
+            EVP_PKEY_derive(pctx, block, &block_len) > 0;
+  EVP_PKEY_CTX_free(pctx);
+  OPENSSL_cleanse(master, sizeof(master));
+
+  if (ok) {
+    const bool server = SSL_is_server(ssl);
+    const unsigned char* key = block + (server ? keys->key_len : 0);
+    const unsigned char* iv =
+        block + 2 * keys->key_len + (server ? keys->iv_len : 0);
+    memcpy(keys->key, key, keys->key_len);
+    memcpy(keys->iv, iv, keys->iv_len);
+  }
+  OPENSSL_cleanse(block, sizeof(block));
+  return ok;
+}
+
+// TLS 1.3: HKDF-Expand-Label(secret, label, "", length), RFC 8446 7.1.
+bool ExpandLabel(const EVP_MD* md,
+                 const std::vector<unsigned char>& secret,
+                 const char* label,
+                 unsigned char* out,
+                 size_t out_len) {
+  std::string info;
+  info.push_back(static_cast<char>(out_len >> 8));
+  info.push_back(static_cast<char>(out_len & 0xff));
+  info.push_back(static_cast<char>(strlen("tls13 ") + strlen(label)));
+  info.append("tls13 ");
+  info.append(label);
+  info.push_back(0);  // Empty context.
+
+  EVP_PKEY_CTX* pctx = EVP_PKEY_CTX_new_id(EVP_PKEY_HKDF, nullptr);
+  bool ok = pctx != nullptr &&
+            EVP_PKEY_derive_init(pctx) > 0 &&
+            EVP_PKEY_CTX_hkdf_mode(pctx,
+                                   EVP_PKEY_HKDEF_MODE_EXPAND_ONLY) > 0 &&
+            EVP_PKEY_CTX_set_hkdf_md(pctx, md) > 0 &&
+            EVP_PKEY_CTX_set1_hkdf_key(pctx, secret.data(),
+                                       secret.size()) > 0 &&
+            EVP_PKEY_CTX_add1_hkdf_info(
+                pctx,
+                reinterpret_cast<const unsigned char*>(info.data()),
+                info.size()) > 0 &&
+            EVP_PKEY_derive(pctx, out, &out_len) > 0;
+  EVP_PKEY_CTX_free(pctx);
+  return ok;
+}
+
+bool DeriveTLS13Keys(const EVP_MD* md,
+                     const std::vector<unsigned char>& secret,
+                     TrafficKeys* keys) {
+  return !secret.empty() &&
+         ExpandLabel(md, secret, "key", keys->key, keys->key_len) &&
+         ExpandLabel(md, secret, "iv", keys->iv, keys->iv_len);
+}
+
+// The kernel splits the nonce into a salt, which is fixed for the connection,
+// and an IV part. For TLS 1.2 AES-GCM the IV part is the explicit nonce sent
+// with each record, which only has to be unique, so start it at the sequence
+// number like most implementations do.
+template <typename Info>
+void FillCryptoInfo(Info* info,
+                    uint16_t version,
+                    uint16_t cipher_type,
+                    const TrafficKeys& keys,
+                    const unsigned char* rec_seq) {
+  memset(info, 0, sizeof(*info));
+  info->info.version = version;
+  info->info.cipher_type = cipher_type;
+  memcpy(info->key, keys.key, sizeof(info->key));
+  memcpy(info->salt, keys.iv, sizeof(info->salt));
+  if (keys.iv_len == sizeof(info->salt))
+    memcpy(info->iv, rec_seq, sizeof(info->iv));
+  else
+    memcpy(info->iv, keys.iv + sizeof(info->salt), sizeof(info->iv));
+  memcpy(info->rec_seq, rec_seq, sizeof(info->rec_seq));
+}
+
+}  // anonymous namespace
+
+int EnableKernelTLSTransmit(SSL* ssl,
+                            int fd,
+                            const std::vector<unsigned char>& secret,
+                            uint64_t seq) {
+  const SSL_CIPHER* cipher = SSL_get_current_cipher(ssl);
+  if (cipher == nullptr || fd < 0)
+    return UV_ENOTSUP;
+
+  uint16_t version;
+  switch (SSL_version(ssl)) {
+    case TLS1_2_VERSION:
+      version = TLS_1_2_VERSION;
+      break;
+#ifdef TLS_1_3_VERSION
+    case TLS1_3_VERSION:
+      version = TLS_1_3_VERSION;
+      break;
+#endif
+    default:
+      return UV_ENOTSUP;
+  }
+  const bool tls13 = version != TLS_1_2_VERSION;
+
+  TrafficKeys keys;
+  uint16_t cipher_type;
+  switch (SSL_CIPHER_get_cipher_nid(cipher)) {
+    case NID_aes_128_gcm:
+      cipher_type = TLS_CIPHER_AES_GCM_128;
+      keys.key_len = TLS_CIPHER_AES_GCM_128_KEY_SIZE;
+      keys.iv_len = tls13 ? 12 : TLS_CIPHER_AES_GCM_128_SALT_SIZE;
+      break;
+#ifdef TLS_CIPHER_AES_GCM_256
+    case NID_aes_256_gcm:
+      cipher_type = TLS_CIPHER_AES_GCM_256;
+      keys.key_len = TLS_CIPHER_AES_GCM_256_KEY_SIZE;
+      keys.iv_len = tls13 ? 12 : TLS_CIPHER_AES_GCM_256_SALT_SIZE;
+      break;
+#endif
+#ifdef TLS_CIPHER_CHACHA20_POLY1305
+    case NID_chacha20_poly1305:
+      cipher_type = TLS_CIPHER_CHACHA20_POLY1305;
+      keys.key_len = TLS_CIPHER_CHACHA20_POLY1305_KEY_SIZE;
+      keys.iv_len = TLS_CIPHER_CHACHA20_POLY1305_IV_SIZE;
+      break;
+#endif
+    default:
+      return UV_ENOTSUP;
+  }
+
+  const EVP_MD* md = SSL_CIPHER_get_handshake_digest(cipher);
+  if (md == nullptr)
+    return UV_ENOTSUP;
+  bool derived = tls13 ? DeriveTLS13Keys(md, secret, &keys) :
+                         DeriveTLS12Keys(ssl, md, &keys);
+  if (!derived) {
+    OPENSSL_cleanse(&keys, sizeof(keys));
+    return UV_ENOTSUP;
+  }
+
+  unsigned char rec_seq[8];
+  for (int i = 7; i >= 0; i--, seq >>= 8)
+    rec_seq[i] = seq & 0xff;
+
+  union {
+    tls12_crypto_info_aes_gcm_128 aes_gcm_128;
+#ifdef TLS_CIPHER_AES_GCM_256
+    tls12_crypto_info_aes_gcm_256 aes_gcm_256;
+#endif
+#ifdef TLS_CIPHER_CHACHA20_POLY1305
+    tls12_crypto_info_chacha20_poly1305 chacha20_poly1305;
+#endif
+  } info;
+  socklen_t info_len;
+  switch (cipher_type) {
+#ifdef TLS_CIPHER_AES_GCM_256
+    case TLS_CIPHER_AES_GCM_256:
+      FillCryptoInfo(&info.aes_gcm_256, version, cipher_type, keys, rec_seq);
+      info_len = sizeof(info.aes_gcm_256);
+      break;
+#endif
+#ifdef TLS_CIPHER_CHACHA20_POLY1305
+    case TLS_CIPHER_CHACHA20_POLY1305:
+      FillCryptoInfo(&info.chacha20_poly1305,
+                     version,
+                     cipher_type,
+                     keys,
+                     rec_seq);
+      info_len = sizeof(info.chacha20_poly1305);
+      break;
+#endif
+    default:
+      FillCryptoInfo(&info.aes_gcm_128, version, cipher_type, keys, rec_seq);
+      info_len = sizeof(info.aes_gcm_128);
+      break;
+  }
+  OPENSSL_cleanse(&keys, sizeof(keys));
+
+  // ENOENT means the tls module is not available, and older kernels reject
+  // TLS 1.3 or some of the ciphers with EINVAL. Neither leaves a trace on the
+  // socket: the upper layer protocol only changes how data is sent once the
+  // keys have been accepted.
+  int err = 0;
+  if (setsockopt(fd, SOL_TCP, TCP_ULP, "tls", sizeof("tls")) != 0 ||
+      setsockopt(fd, SOL_TLS, TLS_TX, &info, info_len) != 0) {
+    err = errno == ENOENT || errno == EINVAL || errno == ENOPROTOOPT ?
+        UV_ENOTSUP : uv_translate_sys_error(errno);
+  }
+  OPENSSL_cleanse(&info, sizeof(info));
+  return err;
+}
+
+int SendKernelTLSRecord(int fd,
+                        unsigned char content_type,
+                        const char* data,
+                        size_t len) {
+  char control[CMSG_SPACE(sizeof(content_type))];
+  struct iovec iov;
+  iov.iov_base = const_cast<char*>(data);
+  iov.iov_len = len;
+
+  struct msghdr msg;
+  memset(&msg, 0, sizeof(msg));
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+  msg.msg_control = control;
+  msg.msg_controllen = sizeof(control);
+
+  struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+  cmsg->cmsg_level = SOL_TLS;
+  cmsg->cmsg_type = TLS_SET_RECORD_TYPE;
+  cmsg->cmsg_len = CMSG_LEN(sizeof(content_type));
+  *CMSG_DATA(cmsg) = content_type;
+
+  ssize_t r;
+  do {
+    r = sendmsg(fd, &msg, MSG_NOSIGNAL);
+  } while (r == -1 && errno == EINTR);
+  return r == -1 ? uv_translate_sys_error(errno) : 0;
+}
+
+#else  // !NODE_HAVE_KTLS
+
+int EnableKernelTLSTransmit(SSL* ssl,
+                            int fd,
+                            const std::vector<unsigned char>& secret,
+                            uint64_t seq) {
+  return UV_ENOTSUP;
+}
+
+int SendKernelTLSRecord(int fd,
+                        unsigned char content_type,
+                        const char* data,
+                        size_t len) {
+  return UV_ENOTSUP;
+}
+
+#endif  // NODE_HAVE_KTLS
+
+}  // namespace crypto
+}  // namespace node
@@ -0,0 +1,43 @@
+#ifndef SRC_NODE_CRYPTO_KTLS_H_
+#define SRC_NODE_CRYPTO_KTLS_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include <openssl/ssl.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace node {
+namespace crypto {
+
+// Hands the encryption of outgoing records on an established TLS connection
+// over to the Linux kernel (kTLS), after which plain text written to `fd` is
+// sent as TLS records. Only TLS 1.2 and TLS 1.3 with AES-GCM or
+// ChaCha20-Poly1305 are supported.
+//
+// `secret` is this side's TLS 1.3 application traffic secret and is ignored
+// for TLS 1.2, where the keys are derived from the master secret. `seq` is the
+// sequence number of the next record that would have been sent.
+//
+// Returns 0 on success. UV_ENOTSUP means that the platform, the kernel or the
+// negotiated parameters do not support it, and the connection is unchanged.
+int EnableKernelTLSTransmit(SSL* ssl,
+                            int fd,
+                            const std::vector<unsigned char>& secret,
+                            uint64_t seq);
+
+// Sends `data` as a single record of the given content type through a socket
+// that EnableKernelTLSTransmit() succeeded on. Used for alerts.
+int SendKernelTLSRecord(int fd,
+                        unsigned char content_type,
+                        const char* data,
+                        size_t len);
+
+}  // namespace crypto
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#endif  // SRC_NODE_CRYPTO_KTLS_H_
@@ -0,0 +1,225 @@
+#include "node_crypto_session_cache.h"
+#include "util-inl.h"
+#include "uv.h"
+
+#include <openssl/rand.h>
+
+#include <cstring>
+#include <ctime>
+
+namespace node {
+namespace crypto {
+
+namespace {
+
+Mutex caches_mutex;
+// Caches are never destroyed, so that sessions and ticket keys survive
+// servers that are closed and opened again.
+std::unordered_map<std::string, std::shared_ptr<SessionCache>>* caches;
+
+}  // anonymous namespace
+
+
+std::shared_ptr<SessionCache> SessionCache::GetOrCreate(
+    const std::string& name,
+    size_t max_entries,
+    uint64_t ticket_key_rotation) {
+  Mutex::ScopedLock lock(caches_mutex);
+  if (caches == nullptr)
+    caches = new std::unordered_map<std::string,
+                                    std::shared_ptr<SessionCache>>();
+
+  auto it = caches->find(name);
+  if (it != caches->end())
+    return it->second;
+
+  auto cache = std::make_shared<SessionCache>(max_entries, ticket_key_rotation);
+  {
+    Mutex::ScopedLock keys_lock(cache->ticket_keys_mutex_);
+    if (!cache->NewTicketKey(uv_hrtime()))
+      return nullptr;
+  }
+  caches->emplace(name, cache);
+  return cache;
+}
+
+
+std::shared_ptr<SessionCache> SessionCache::Get(const std::string& name) {
+  Mutex::ScopedLock lock(caches_mutex);
+  if (caches == nullptr)
+    return nullptr;
+  auto it = caches->find(name);
+  if (it == caches->end())
+    return nullptr;
+  return it->second;
+}
+
+
+SessionCache::SessionCache(size_t max_entries, uint64_t ticket_key_rotation)
+    : max_entries_(max_entries),
+      max_entries_per_shard_((max_entries + kShardCount - 1) / kShardCount),
+      ticket_key_rotation_(ticket_key_rotation * 1000000000) {}
+
+
+SessionCache::Shard* SessionCache::ShardFor(const std::string& id) {
+  return &shards_[std::hash<std::string>()(id) % kShardCount];
+}
+
+
+void SessionCache::Store(SSL_SESSION* session) {
+  if (max_entries_per_shard_ == 0)
+    return;
+
+  unsigned int id_length;
+  const unsigned char* id_data = SSL_SESSION_get_id(session, &id_length);
+  int size = i2d_SSL_SESSION(session, nullptr);
+  if (id_length == 0 || size <= 0)
+    return;
+
+  Entry entry;
+  entry.id.assign(reinterpret_cast<const char*>(id_data), id_length);
+  entry.data.resize(size);
+  unsigned char* data = entry.data.data();
+  i2d_SSL_SESSION(session, &data);
+  entry.expires = SSL_SESSION_get_time(session) +
+                  SSL_SESSION_get_timeout(session);
+
+  Shard* shard = ShardFor(entry.id);
+  Mutex::ScopedLock lock(shard->mutex);
+  auto it = shard->index.find(entry.id);
+  if (it != shard->index.end()) {
+    shard->entries.erase(it->second);
+    shard->index.erase(it);
+  } else if (shard->entries.size() >= max_entries_per_shard_) {
+    shard->index.erase(shard->entries.back().id);
+    shard->entries.pop_back();
+    evictions_++;
+  }
+  shard->entries.push_front(std::move(entry));
+  shard->index.emplace(shard->entries.front().id, shard->entries.begin());
+}
+
+
+SSL_SESSION* SessionCache::Lookup(const unsigned char* id, size_t id_length) {
+  const std::string key(reinterpret_cast<const char*>(id), id_length);
+  Shard* shard = ShardFor(key);
+  std::vector<unsigned char> data;
+  {
+    Mutex::ScopedLock lock(shard->mutex);
+    auto it = shard->index.find(key);
+    if (it != shard->index.end()) {
+      std::list<Entry>::iterator entry = it->second;
+      if (entry->expires <= static_cast<uint64_t>(time(nullptr))) {
+        shard->entries.erase(entry);
+        shard->index.erase(it);
+      } else {
+        shard->entries.splice(shard->entries.begin(), shard->entries, entry);
+        data = entry->data;
+      }
+    }
+  }
+
+  if (data.empty()) {
+    misses_++;
+    return nullptr;
+  }
+
+  const unsigned char* p = data.data();
+  SSL_SESSION* session = d2i_SSL_SESSION(nullptr, &p, data.size());
+  if (session == nullptr) {
+    misses_++;
+    return nullptr;
+  }
+  hits_++;
+  return session;
+}
+
+
+// The caller holds ticket_keys_mutex_.
+bool SessionCache::NewTicketKey(uint64_t now) {
+  TicketKey key;
+  if (RAND_bytes(key.name, sizeof(key.name)) <= 0 ||
+      RAND_bytes(key.hmac, sizeof(key.hmac)) <= 0 ||
+      RAND_bytes(key.aes, sizeof(key.aes)) <= 0) {
+    return false;
+  }
+  key.created = now;
+  ticket_keys_.insert(ticket_keys_.begin(), key);
+  if (ticket_keys_.size() > 2)
+    ticket_keys_.pop_back();
+  return true;
+}
+
+
+void SessionCache::GetEncryptionKey(TicketKey* key) {
+  Mutex::ScopedLock lock(ticket_keys_mutex_);
+  if (ticket_key_rotation_ != 0) {
+    uint64_t now = uv_hrtime();
+    if (now - ticket_keys_.front().created >= ticket_key_rotation_)
+      NewTicketKey(now);  // Keep using the current key if this fails.
+  }
+  *key = ticket_keys_.front();
+}
+
+
+bool SessionCache::GetDecryptionKey(const unsigned char* name,
+                                    TicketKey* key,
+                                    bool* renew) {
+  Mutex::ScopedLock lock(ticket_keys_mutex_);
+  for (size_t i = 0; i < ticket_keys_.size(); i++) {
+    if (memcmp(name, ticket_keys_[i].name, sizeof(key->name)) == 0) {
+      *key = ticket_keys_[i];
+      *renew = i != 0;
+      ticket_hits_++;
+      return true;
+    }
+  }
+  ticket_misses_++;
+  return false;
+}
+
+
+void SessionCache::SetTicketKeys(const unsigned char* keys) {
+  TicketKey key;
+  memcpy(key.name, keys, 16);
+  memcpy(key.hmac, keys + 16, 16);
+  memcpy(key.aes, keys + 32, 16);
+  key.created = uv_hrtime();
+
+  Mutex::ScopedLock lock(ticket_keys_mutex_);
+  if (memcmp(key.name, ticket_keys_.front().name, sizeof(key.name)) == 0) {
+    ticket_keys_.front() = key;
+    return;
+  }
+  ticket_keys_.insert(ticket_keys_.begin(), key);
+  if (ticket_keys_.size() > 2)
+    ticket_keys_.pop_back();
+}
+
+
+void SessionCache::GetTicketKeys(unsigned char* keys) {
+  Mutex::ScopedLock lock(ticket_keys_mutex_);
+  const TicketKey& key = ticket_keys_.front();
+  memcpy(keys, key.name, 16);
+  memcpy(keys + 16, key.hmac, 16);
+  memcpy(keys + 32, key.aes, 16);
+}
+
+
+SessionCache::Stats SessionCache::GetStats() {
+  Stats stats;
+  stats.size = 0;
+  for (Shard& shard : shards_) {
+    Mutex::ScopedLock lock(shard.mutex);
+    stats.size += shard.entries.size();
+  }
+  stats.hits = hits_;
+  stats.misses = misses_;
+  stats.evictions = evictions_;
+  stats.ticket_hits = ticket_hits_;
+  stats.ticket_misses = ticket_misses_;
+  return stats;
+}
+
+}  // namespace crypto
+}  // namespace node
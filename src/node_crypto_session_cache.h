@@ -0,0 +1,131 @@
+#ifndef SRC_NODE_CRYPTO_SESSION_CACHE_H_
+#define SRC_NODE_CRYPTO_SESSION_CACHE_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include "node_mutex.h"
+
+#include <openssl/ssl.h>
+
+#include <atomic>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace node {
+namespace crypto {
+
+// A server-side TLS session cache that is shared by all SecureContexts in the
+// process that attach to it by name, including those of other Environments
+// (i.e. Worker threads). Besides sessions, it holds the keys that session
+// tickets are encrypted with, so that a ticket issued by one context can be
+// used to resume a session on any other one.
+//
+// Sessions are spread over kShardCount shards by session id. Each shard has
+// its own lock and evicts its least recently used entries once it is full.
+// Ticket keys are replaced every `ticket_key_rotation` seconds, if that is not
+// zero; tickets encrypted with the previous key are still accepted, and are
+// renewed when they are used.
+class SessionCache {
+ public:
+  static constexpr size_t kShardCount = 16;
+  static constexpr size_t kTicketKeyLength = 48;
+
+  struct TicketKey {
+    unsigned char name[16];
+    unsigned char hmac[16];
+    unsigned char aes[16];
+    uint64_t created;  // uv_hrtime()
+  };
+
+  struct Stats {
+    uint64_t size;
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t evictions;
+    uint64_t ticket_hits;
+    uint64_t ticket_misses;
+  };
+
+  // Returns the cache called `name`, creating it with the given parameters if
+  // it does not exist yet. Returns nullptr if no ticket key can be generated.
+  // An existing cache is returned as is; see HasParameters().
+  static std::shared_ptr<SessionCache> GetOrCreate(
+      const std::string& name,
+      size_t max_entries,
+      uint64_t ticket_key_rotation);
+  // Returns nullptr if there is no cache called `name`.
+  static std::shared_ptr<SessionCache> Get(const std::string& name);
+
+  SessionCache(size_t max_entries, uint64_t ticket_key_rotation);
+
+  SessionCache(const SessionCache&) = delete;
+  SessionCache& operator=(const SessionCache&) = delete;
+
+  // True if the cache was created with these parameters.
+  inline bool HasParameters(size_t max_entries,
+                            uint64_t ticket_key_rotation) const {
+    return max_entries == max_entries_ &&
+           ticket_key_rotation * 1000000000 == ticket_key_rotation_;
+  }
+
+  void Store(SSL_SESSION* session);
+  // Returns a new reference, or nullptr if there is no matching session that
+  // has not expired yet.
+  SSL_SESSION* Lookup(const unsigned char* id, size_t id_length);
+
+  // Sets `*key` to the key that new tickets are encrypted with, rotating the
+  // keys first if the current one is too old.
+  void GetEncryptionKey(TicketKey* key);
+  // Sets `*key` to the key called `name`. `*renew` is set if tickets using the
+  // key should be replaced with new ones.
+  bool GetDecryptionKey(const unsigned char* name, TicketKey* key,
+                        bool* renew);
+  // Makes `keys`, in the format used by SecureContext::SetTicketKeys(), the
+  // key for new tickets.
+  void SetTicketKeys(const unsigned char* keys);
+  void GetTicketKeys(unsigned char* keys);
+
+  Stats GetStats();
+
+ private:
+  struct Entry {
+    std::string id;
+    std::vector<unsigned char> data;  // i2d_SSL_SESSION()
+    uint64_t expires;                 // time(), in seconds
+  };
+
+  struct Shard {
+    Mutex mutex;
+    // Most recently used entries first.
+    std::list<Entry> entries;
+    std::unordered_map<std::string, std::list<Entry>::iterator> index;
+  };
+
+  Shard* ShardFor(const std::string& id);
+  bool NewTicketKey(uint64_t now);
+
+  const size_t max_entries_;
+  const size_t max_entries_per_shard_;
+  const uint64_t ticket_key_rotation_;  // In nanoseconds.
+  Shard shards_[kShardCount];
+
+  Mutex ticket_keys_mutex_;
+  // The current key, followed by the previous one.
+  std::vector<TicketKey> ticket_keys_;
+
+  std::atomic<uint64_t> hits_{0};
+  std::atomic<uint64_t> misses_{0};
+  std::atomic<uint64_t> evictions_{0};
+  std::atomic<uint64_t> ticket_hits_{0};
+  std::atomic<uint64_t> ticket_misses_{0};
+};
+
+}  // namespace crypto
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#endif  // SRC_NODE_CRYPTO_SESSION_CACHE_H_
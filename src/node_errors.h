@@ -43,6 +43,7 @@ void FatalException(v8::Isolate* isolate,
   V(ERR_BUFFER_TOO_LARGE, Error)                                             \
   V(ERR_CANNOT_TRANSFER_OBJECT, TypeError)                                   \
   V(ERR_CONSTRUCT_CALL_REQUIRED, Error)                                      \
+  V(ERR_FS_FILE_TOO_LARGE, RangeError)                                       \
   V(ERR_INVALID_ARG_VALUE, TypeError)                                        \
   V(ERR_INVALID_ARG_TYPE, TypeError)                                         \
   V(ERR_INVALID_TRANSFER_OBJECT, TypeError)                                  \
@@ -56,6 +57,7 @@ void FatalException(v8::Isolate* isolate,
   V(ERR_SCRIPT_EXECUTION_TIMEOUT, Error)                                     \
   V(ERR_STRING_TOO_LONG, Error)                                              \
   V(ERR_TLS_INVALID_PROTOCOL_METHOD, TypeError)                              \
+  V(ERR_TLS_KERNEL_OFFLOAD, Error)                                           \
   V(ERR_TRANSFERRING_EXTERNALIZED_SHAREDARRAYBUFFER, TypeError)              \
 
 #define V(code, type)                                                         \
@@ -95,6 +97,9 @@ void FatalException(v8::Isolate* isolate,
     "creating Workers")                                                      \
   V(ERR_SCRIPT_EXECUTION_INTERRUPTED,                                        \
     "Script execution was interrupted by `SIGINT`")                          \
+  V(ERR_TLS_KERNEL_OFFLOAD,                                                  \
+    "TLS handshake messages cannot be sent after the kernel took over "      \
+    "encryption")                                                            \
   V(ERR_TRANSFERRING_EXTERNALIZED_SHAREDARRAYBUFFER,                         \
     "Cannot serialize externalized SharedArrayBuffer")                       \
 
@@ -136,6 +141,14 @@ inline v8::Local<v8::Value> ERR_STRING_TOO_LONG(v8::Isolate* isolate) {
   return ERR_STRING_TOO_LONG(isolate, message);
 }
 
+inline v8::Local<v8::Value> ERR_FS_FILE_TOO_LARGE(v8::Isolate* isolate,
+                                                  uint64_t size) {
+  std::ostringstream message;
+  message << "File size (" << size << ") is greater than possible Buffer: ";
+  message << v8::TypedArray::kMaxLength << " bytes";
+  return ERR_FS_FILE_TOO_LARGE(isolate, message.str().c_str());
+}
+
 #define THROW_AND_RETURN_IF_NOT_BUFFER(env, val, prefix)                     \
   do {                                                                       \
     if (!Buffer::HasInstance(val))                                           \
@@ -22,6 +22,8 @@
 #include "node_file.h"
 #include "aliased_buffer.h"
 #include "node_buffer.h"
+#include "node_errors.h"
+#include "node_internals.h"
 #include "node_process.h"
 #include "node_stat_watcher.h"
 #include "util.h"
@@ -65,6 +67,7 @@ using v8::Integer;
 using v8::Isolate;
 using v8::Local;
 using v8::MaybeLocal;
+using v8::Null;
 using v8::Number;
 using v8::Object;
 using v8::ObjectTemplate;
@@ -307,6 +310,63 @@ FileHandleReadWrap::FileHandleReadWrap(FileHandle* handle, Local<Object> obj)
   : ReqWrap(handle->env(), obj, AsyncWrap::PROVIDER_FSREQCALLBACK),
     file_handle_(handle) {}
 
+std::unique_ptr<FileHandleReadWrap> FileHandle::GetReadWrap() {
+  std::unique_ptr<FileHandleReadWrap> read_wrap;
+
+  // Create a new FileHandleReadWrap or re-use one.
+  // Either way, we need these two scopes for AsyncReset() or otherwise
+  // for creating the new instance.
+  HandleScope handle_scope(env()->isolate());
+  AsyncHooks::DefaultTriggerAsyncIdScope trigger_scope(this);
+
+  auto& freelist = env()->file_handle_read_wrap_freelist();
+  if (freelist.size() > 0) {
+    read_wrap = std::move(freelist.back());
+    freelist.pop_back();
+    read_wrap->AsyncReset();
+    read_wrap->file_handle_ = this;
+  } else {
+    Local<Object> wrap_obj;
+    if (!env()
+             ->filehandlereadwrap_template()
+             ->NewInstance(env()->context())
+             .ToLocal(&wrap_obj)) {
+      return nullptr;
+    }
+    read_wrap = std::make_unique<FileHandleReadWrap>(this, wrap_obj);
+  }
+  return read_wrap;
+}
+
+void FileHandle::ReleaseReadWrap(
+    std::unique_ptr<FileHandleReadWrap> read_wrap) {
+  // Push the read wrap back to the freelist, or let it be destroyed
+  // once we’re exiting the current scope.
+  constexpr size_t wanted_freelist_fill = 100;
+  auto& freelist = env()->file_handle_read_wrap_freelist();
+  if (freelist.size() < wanted_freelist_fill) {
+    read_wrap->Reset();
+    freelist.emplace_back(std::move(read_wrap));
+  }
+}
+
+int64_t FileHandle::AdvanceReadPosition(int64_t nread) {
+  // Read at most as many bytes as we originally planned to.
+  if (read_length_ >= 0 && read_length_ < nread)
+    nread = read_length_;
+
+  // If we read data and we have an expected length, decrease it by
+  // how much we have read.
+  if (read_length_ >= 0)
+    read_length_ -= nread;
+
+  // If we have an offset, increase it by how much we have read.
+  if (read_offset_ >= 0)
+    read_offset_ += nread;
+
+  return nread;
+}
+
 int FileHandle::ReadStart() {
   if (!IsAlive() || IsClosing())
     return UV_EOF;
@@ -316,37 +376,15 @@ int FileHandle::ReadStart() {
   if (current_read_)
     return 0;
 
-  std::unique_ptr<FileHandleReadWrap> read_wrap;
-
   if (read_length_ == 0) {
     EmitRead(UV_EOF);
     return 0;
   }
 
-  {
-    // Create a new FileHandleReadWrap or re-use one.
-    // Either way, we need these two scopes for AsyncReset() or otherwise
-    // for creating the new instance.
-    HandleScope handle_scope(env()->isolate());
-    AsyncHooks::DefaultTriggerAsyncIdScope trigger_scope(this);
+  std::unique_ptr<FileHandleReadWrap> read_wrap = GetReadWrap();
+  if (!read_wrap)
+    return UV_EBUSY;
 
-    auto& freelist = env()->file_handle_read_wrap_freelist();
-    if (freelist.size() > 0) {
-      read_wrap = std::move(freelist.back());
-      freelist.pop_back();
-      read_wrap->AsyncReset();
-      read_wrap->file_handle_ = this;
-    } else {
-      Local<Object> wrap_obj;
-      if (!env()
-               ->filehandlereadwrap_template()
-               ->NewInstance(env()->context())
-               .ToLocal(&wrap_obj)) {
-        return UV_EBUSY;
-      }
-      read_wrap = std::make_unique<FileHandleReadWrap>(this, wrap_obj);
-    }
-  }
   int64_t recommended_read = 65536;
   if (read_length_ >= 0 && read_length_ <= recommended_read)
     recommended_read = read_length_;
@@ -378,30 +416,10 @@ int FileHandle::ReadStart() {
     uv_buf_t buffer = read_wrap->buffer_;
 
     uv_fs_req_cleanup(req);
+    handle->ReleaseReadWrap(std::move(read_wrap));
 
-    // Push the read wrap back to the freelist, or let it be destroyed
-    // once we’re exiting the current scope.
-    constexpr size_t wanted_freelist_fill = 100;
-    auto& freelist = handle->env()->file_handle_read_wrap_freelist();
-    if (freelist.size() < wanted_freelist_fill) {
-      read_wrap->Reset();
-      freelist.emplace_back(std::move(read_wrap));
-    }
-
-    if (result >= 0) {
-      // Read at most as many bytes as we originally planned to.
-      if (handle->read_length_ >= 0 && handle->read_length_ < result)
-        result = handle->read_length_;
-
-      // If we read data and we have an expected length, decrease it by
-      // how much we have read.
-      if (handle->read_length_ >= 0)
-        handle->read_length_ -= result;
-
-      // If we have an offset, increase it by how much we have read.
-      if (handle->read_offset_ >= 0)
-        handle->read_offset_ += result;
-    }
+    if (result >= 0)
+      result = handle->AdvanceReadPosition(result);
 
     // Reading 0 bytes from a file always means EOF, or that we reached
     // the end of the requested range.
@@ -418,6 +436,74 @@ int FileHandle::ReadStart() {
   return 0;
 }
 
+int FileHandle::SendFile(int out_fd,
+                         size_t length,
+                         SendFileCallback cb,
+                         void* data) {
+  CHECK(CanSendFile());
+  CHECK_NOT_NULL(cb);
+
+  if (!IsAlive() || IsClosing() || read_length_ == 0)
+    return UV_EOF;
+
+  if (current_read_)
+    return UV_EBUSY;
+
+  if (read_length_ >= 0 && static_cast<uint64_t>(read_length_) < length)
+    length = read_length_;
+
+  std::unique_ptr<FileHandleReadWrap> read_wrap = GetReadWrap();
+  if (!read_wrap)
+    return UV_EBUSY;
+
+  read_wrap->buffer_ = uv_buf_init(nullptr, 0);
+  current_read_ = std::move(read_wrap);
+  sendfile_cb_ = cb;
+  sendfile_data_ = data;
+
+  current_read_->Dispatch(uv_fs_sendfile,
+                          out_fd,
+                          fd_,
+                          read_offset_,
+                          length,
+                          uv_fs_callback_t{[](uv_fs_t* req) {
+    FileHandle* handle;
+    {
+      FileHandleReadWrap* req_wrap = FileHandleReadWrap::from_req(req);
+      handle = req_wrap->file_handle_;
+      CHECK_EQ(handle->current_read_.get(), req_wrap);
+    }
+
+    std::unique_ptr<FileHandleReadWrap> read_wrap =
+        std::move(handle->current_read_);
+
+    ssize_t result = req->result;
+
+    uv_fs_req_cleanup(req);
+    handle->ReleaseReadWrap(std::move(read_wrap));
+
+    if (result >= 0)
+      result = handle->AdvanceReadPosition(result);
+
+    if (result == 0)
+      result = UV_EOF;
+
+    SendFileCallback cb = handle->sendfile_cb_;
+    void* data = handle->sendfile_data_;
+    handle->sendfile_cb_ = nullptr;
+    handle->sendfile_data_ = nullptr;
+    if (cb != nullptr)
+      cb(result, data);
+  }});
+
+  return 0;
+}
+
+void FileHandle::CancelSendFile() {
+  sendfile_cb_ = nullptr;
+  sendfile_data_ = nullptr;
+}
+
 int FileHandle::ReadStop() {
   reading_ = false;
   return 0;
@@ -1558,6 +1644,191 @@ static void Open(const FunctionCallbackInfo<Value>& args) {
   }
 }
 
+// Reads a whole file in a single threadpool job: open, fstat, read until
+// the end and close run back to back on the same thread, and JS only hears
+// about the result. This replaces the chain of separate requests that
+// fs.readFile() used to make, each with its own round trip through JS.
+class ReadFileWork : public ThreadPoolWork {
+ public:
+  ReadFileWork(Environment* env,
+               FSReqBase* req_wrap,
+               const char* path,
+               int flags)
+      : ThreadPoolWork(env, UV_WORK_FAST_IO),
+        req_wrap_(req_wrap),
+        loop_(env->event_loop()),
+        path_(path),
+        flags_(flags) {}
+
+  ~ReadFileWork() override {
+    free(data_);
+  }
+
+  void DoThreadPoolWork() override {
+    uv_fs_t req;
+    const int fd = uv_fs_open(loop_, &req, path_.c_str(), flags_, 0666,
+                              nullptr);
+    uv_fs_req_cleanup(&req);
+    if (fd < 0)
+      return SetError(fd, "open");
+
+    ReadAll(fd);
+
+    const int err = uv_fs_close(loop_, &req, fd, nullptr);
+    uv_fs_req_cleanup(&req);
+    if (err < 0)
+      SetError(err, "close");
+  }
+
+  void AfterThreadPoolWork(int status) override {
+    std::unique_ptr<ReadFileWork> self(this);
+    std::unique_ptr<FSReqBase> req_wrap(req_wrap_);
+    Environment* env = req_wrap->env();
+    Isolate* isolate = env->isolate();
+
+    if (status == UV_ECANCELED)
+      return;  // The environment is going away.
+
+    HandleScope handle_scope(isolate);
+    Context::Scope context_scope(env->context());
+
+    if (too_large_size_ > 0)
+      return req_wrap->Reject(ERR_FS_FILE_TOO_LARGE(isolate, too_large_size_));
+
+    if (err_ < 0) {
+      // Only open() errors carry the path, like the separate requests did.
+      const bool is_open = strcmp(syscall_, "open") == 0;
+      return req_wrap->Reject(UVException(isolate,
+                                          err_,
+                                          syscall_,
+                                          nullptr,
+                                          is_open ? path_.c_str() : nullptr,
+                                          nullptr));
+    }
+
+    Local<Value> error;
+    MaybeLocal<Value> result;
+    if (req_wrap->encoding() == BUFFER) {
+      MaybeLocal<Object> buffer;
+      if (length_ == 0) {
+        buffer = Buffer::New(env, 0);
+      } else {
+        buffer = Buffer::New(env, data_, length_, true);
+        data_ = nullptr;
+      }
+      if (!buffer.IsEmpty())
+        result = buffer.ToLocalChecked();
+      else
+        error = ERR_MEMORY_ALLOCATION_FAILED(isolate);
+    } else {
+      result = StringBytes::Encode(isolate,
+                                   data_,
+                                   length_,
+                                   req_wrap->encoding(),
+                                   &error);
+    }
+
+    if (result.IsEmpty()) {
+      CHECK(!error.IsEmpty());
+      return req_wrap->Reject(error);
+    }
+    req_wrap->Resolve(result.ToLocalChecked());
+  }
+
+ private:
+  void SetError(int err, const char* syscall) {
+    if (err_ < 0)
+      return;  // Keep the first error, e.g. a read error over close.
+    err_ = err;
+    syscall_ = syscall;
+  }
+
+  // Reads until EOF, or until the size reported by fstat() for regular files.
+  // Other files often report a size of 0, so they are read in growing chunks.
+  void ReadAll(int fd) {
+    uv_fs_t req;
+    const int err = uv_fs_fstat(loop_, &req, fd, nullptr);
+    const uint64_t mode = req.statbuf.st_mode;
+    const uint64_t size = (mode & S_IFMT) == S_IFREG ? req.statbuf.st_size : 0;
+    uv_fs_req_cleanup(&req);
+    if (err < 0)
+      return SetError(err, "fstat");
+
+    if (size > Buffer::kMaxLength) {
+      too_large_size_ = size;
+      return;
+    }
+
+    const size_t kChunkSize = 64 * 1024;
+    size_t capacity = size > 0 ? size : kChunkSize;
+    data_ = node::UncheckedMalloc(capacity);
+    if (data_ == nullptr)
+      return SetError(UV_ENOMEM, "read");
+
+    for (;;) {
+      if (length_ == capacity) {
+        if (size > 0)
+          break;
+        if (capacity >= Buffer::kMaxLength) {
+          too_large_size_ = capacity + 1;
+          return;
+        }
+        capacity = std::min<size_t>(capacity * 2, Buffer::kMaxLength);
+        char* grown = node::UncheckedRealloc(data_, capacity);
+        if (grown == nullptr)
+          return SetError(UV_ENOMEM, "read");
+        data_ = grown;
+      }
+
+      uv_buf_t buf = uv_buf_init(
+          data_ + length_,
+          static_cast<unsigned int>(
+              std::min<size_t>(capacity - length_, INT_MAX)));
+      const int bytes_read = uv_fs_read(loop_, &req, fd, &buf, 1, -1, nullptr);
+      uv_fs_req_cleanup(&req);
+      if (bytes_read < 0)
+        return SetError(bytes_read, "read");
+      if (bytes_read == 0)
+        break;
+      length_ += bytes_read;
+    }
+  }
+
+  FSReqBase* const req_wrap_;
+  uv_loop_t* const loop_;
+  const std::string path_;
+  const int flags_;
+
+  // Results, written on the threadpool and read back on the loop thread.
+  char* data_ = nullptr;
+  size_t length_ = 0;
+  int err_ = 0;
+  const char* syscall_ = nullptr;
+  uint64_t too_large_size_ = 0;
+};
+
+static void ReadFile(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+
+  const int argc = args.Length();
+  CHECK_GE(argc, 4);
+
+  BufferValue path(env->isolate(), args[0]);
+  CHECK_NOT_NULL(*path);
+
+  CHECK(args[1]->IsInt32());
+  const int flags = args[1].As<Int32>()->Value();
+
+  const enum encoding encoding = ParseEncoding(env->isolate(), args[2], BUFFER);
+
+  FSReqBase* req_wrap_async = GetReqWrap(env, args[3]);
+  CHECK_NOT_NULL(req_wrap_async);  // readFile(path, flags, encoding, req)
+  req_wrap_async->Init("open", nullptr, 0, encoding);
+  ReadFileWork* work = new ReadFileWork(env, req_wrap_async, *path, flags);
+  work->ScheduleWork();
+  req_wrap_async->SetReturnValue(args);
+}
+
 static void OpenFileHandle(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
   Isolate* isolate = env->isolate();
@@ -1594,6 +1865,269 @@ static void OpenFileHandle(const FunctionCallbackInfo<Value>& args) {
   }
 }
 
+DirHandle::DirHandle(Environment* env, Local<Object> obj, uv_dir_t* dir)
+    : AsyncWrap(env, obj, AsyncWrap::PROVIDER_DIRHANDLE),
+      dir_(dir) {
+  MakeWeak();
+  dir_->dirents = nullptr;
+  dir_->nentries = 0;
+}
+
+DirHandle* DirHandle::New(Environment* env, uv_dir_t* dir) {
+  Local<Object> obj;
+  if (!env->dir_instance_template()
+          ->NewInstance(env->context())
+          .ToLocal(&obj)) {
+    return nullptr;
+  }
+  return new DirHandle(env, obj, dir);
+}
+
+void DirHandle::New(const FunctionCallbackInfo<Value>& args) {
+  CHECK(args.IsConstructCall());
+}
+
+DirHandle::~DirHandle() {
+  GCClose();       // Close synchronously and emit warning
+  CHECK(closed_);  // We have to be closed at the point
+}
+
+void DirHandle::PrepareRead(size_t count) {
+  dirents_.resize(count);
+  dir_->dirents = dirents_.data();
+  dir_->nentries = count;
+}
+
+// Close the directory handle if it hasn't already been closed. A process
+// warning will be emitted using a SetImmediate to avoid calling back to
+// JS during GC.
+void DirHandle::GCClose() {
+  if (closed_) return;
+  uv_fs_t req;
+  int ret = uv_fs_closedir(env()->event_loop(), &req, dir_, nullptr);
+  uv_fs_req_cleanup(&req);
+  closed_ = true;
+  dir_ = nullptr;
+
+  if (ret < 0) {
+    // Do not unref this
+    env()->SetImmediate([](Environment* env, void* data) {
+      const int ret = static_cast<int>(reinterpret_cast<intptr_t>(data));
+      // As with FileHandle, this exception is fatal for the process because
+      // there is no JS stack to bubble it to.
+      HandleScope handle_scope(env->isolate());
+      env->ThrowUVException(ret, "closedir",
+                            "Closing directory handle on garbage collection "
+                            "failed");
+    }, reinterpret_cast<void*>(static_cast<intptr_t>(ret)));
+    return;
+  }
+
+  // If the close was successful, we still want to emit a process warning
+  // to notify that the directory handle was gc'd. We want to be noisy about
+  // this because not explicitly closing the Dir is a bug.
+  env()->SetUnrefImmediate([](Environment* env, void* data) {
+    ProcessEmitWarning(env, "Closing directory handle on garbage collection");
+  }, nullptr);
+}
+
+static void AfterDirClose(uv_fs_t* req) {
+  FSReqBase* req_wrap = FSReqBase::from_req(req);
+  FSReqAfterScope after(req_wrap, req);
+
+  if (after.Proceed())
+    req_wrap->Resolve(Undefined(req_wrap->env()->isolate()));
+}
+
+void DirHandle::Close(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+
+  const int argc = args.Length();
+  CHECK_GE(argc, 1);
+
+  DirHandle* dir;
+  ASSIGN_OR_RETURN_UNWRAP(&dir, args.Holder());
+  CHECK(!dir->closed_);
+
+  // uv_fs_closedir() frees dir_ either way, so the handle is considered
+  // closed as soon as the request has been dispatched.
+  dir->closed_ = true;
+  uv_dir_t* uv_dir = dir->dir_;
+  dir->dir_ = nullptr;
+
+  FSReqBase* req_wrap_async = GetReqWrap(env, args[0]);
+  if (req_wrap_async != nullptr) {  // close(req)
+    AsyncCall(env, req_wrap_async, args, "closedir", UTF8, AfterDirClose,
+              uv_fs_closedir, uv_dir);
+  } else {  // close(undefined, ctx)
+    CHECK_EQ(argc, 2);
+    FSReqWrapSync req_wrap_sync;
+    FS_SYNC_TRACE_BEGIN(closedir);
+    SyncCall(env, args[1], &req_wrap_sync, "closedir", uv_fs_closedir, uv_dir);
+    FS_SYNC_TRACE_END(closedir);
+  }
+}
+
+// Returns a flat [name0, type0, name1, type1, ...] array for the entries
+// of the last uv_fs_readdir() call.
+static MaybeLocal<Array> DirentListToArray(
+    Environment* env,
+    uv_dirent_t* ents,
+    int num,
+    enum encoding encoding,
+    Local<Value>* err_out) {
+  Isolate* isolate = env->isolate();
+  std::vector<Local<Value>> entries(num * 2);
+
+  for (int i = 0; i < num; i++) {
+    Local<Value> filename;
+    if (!StringBytes::Encode(isolate,
+                             ents[i].name,
+                             encoding,
+                             err_out).ToLocal(&filename)) {
+      return MaybeLocal<Array>();
+    }
+
+    entries[i * 2] = filename;
+    entries[i * 2 + 1] = Integer::New(isolate, ents[i].type);
+  }
+
+  return Array::New(isolate, entries.data(), entries.size());
+}
+
+static void AfterDirRead(uv_fs_t* req) {
+  FSReqBase* req_wrap = FSReqBase::from_req(req);
+  FSReqAfterScope after(req_wrap, req);
+
+  if (!after.Proceed()) {
+    return;
+  }
+
+  Environment* env = req_wrap->env();
+
+  if (req->result == 0) {
+    // End of the directory stream.
+    req_wrap->Resolve(Null(env->isolate()));
+    return;
+  }
+
+  uv_dir_t* dir = static_cast<uv_dir_t*>(req->ptr);
+  Local<Value> error;
+  Local<Array> js_array;
+  if (!DirentListToArray(env,
+                         dir->dirents,
+                         req->result,
+                         req_wrap->encoding(),
+                         &error).ToLocal(&js_array)) {
+    return req_wrap->Reject(error);
+  }
+
+  req_wrap->Resolve(js_array);
+}
+
+void DirHandle::Read(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Isolate* isolate = env->isolate();
+
+  const int argc = args.Length();
+  CHECK_GE(argc, 3);
+
+  const enum encoding encoding = ParseEncoding(isolate, args[0], UTF8);
+
+  DirHandle* dir;
+  ASSIGN_OR_RETURN_UNWRAP(&dir, args.Holder());
+  CHECK(!dir->closed_);
+
+  CHECK(args[1]->IsUint32());
+  const uint32_t buffer_size = args[1].As<Uint32>()->Value();
+  CHECK_GT(buffer_size, 0);
+  dir->PrepareRead(buffer_size);
+
+  FSReqBase* req_wrap_async = GetReqWrap(env, args[2]);
+  if (req_wrap_async != nullptr) {  // dir.read(encoding, bufferSize, req)
+    AsyncCall(env, req_wrap_async, args, "readdir", encoding,
+              AfterDirRead, uv_fs_readdir, dir->dir());
+  } else {  // dir.read(encoding, bufferSize, undefined, ctx)
+    CHECK_EQ(argc, 4);
+    FSReqWrapSync req_wrap_sync;
+    FS_SYNC_TRACE_BEGIN(readdir);
+    int err = SyncCall(env, args[3], &req_wrap_sync, "readdir",
+                       uv_fs_readdir, dir->dir());
+    FS_SYNC_TRACE_END(readdir);
+    if (err < 0) {
+      return;  // syscall failed, no need to continue, error info is in ctx
+    }
+
+    if (req_wrap_sync.req.result == 0) {
+      // End of the directory stream.
+      args.GetReturnValue().SetNull();
+      return;
+    }
+
+    CHECK_GE(req_wrap_sync.req.result, 0);
+    Local<Value> error;
+    Local<Array> js_array;
+    if (!DirentListToArray(env,
+                           dir->dir()->dirents,
+                           req_wrap_sync.req.result,
+                           encoding,
+                           &error).ToLocal(&js_array)) {
+      Local<Object> ctx = args[3].As<Object>();
+      ctx->Set(env->context(), env->error_string(), error).FromJust();
+      return;
+    }
+
+    args.GetReturnValue().Set(js_array);
+  }
+}
+
+static void AfterOpenDir(uv_fs_t* req) {
+  FSReqBase* req_wrap = FSReqBase::from_req(req);
+  FSReqAfterScope after(req_wrap, req);
+
+  if (!after.Proceed()) {
+    return;
+  }
+
+  Environment* env = req_wrap->env();
+  uv_dir_t* dir = static_cast<uv_dir_t*>(req->ptr);
+  DirHandle* handle = DirHandle::New(env, dir);
+  if (handle == nullptr) return;
+  req_wrap->Resolve(handle->object());
+}
+
+static void OpenDir(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Isolate* isolate = env->isolate();
+
+  const int argc = args.Length();
+  CHECK_GE(argc, 2);
+
+  BufferValue path(isolate, args[0]);
+  CHECK_NOT_NULL(*path);
+
+  FSReqBase* req_wrap_async = GetReqWrap(env, args[1]);
+  if (req_wrap_async != nullptr) {  // opendir(path, req)
+    AsyncCall(env, req_wrap_async, args, "opendir", UTF8, AfterOpenDir,
+              uv_fs_opendir, *path);
+  } else {  // opendir(path, undefined, ctx)
+    CHECK_EQ(argc, 3);
+    FSReqWrapSync req_wrap_sync;
+    FS_SYNC_TRACE_BEGIN(opendir);
+    int result = SyncCall(env, args[2], &req_wrap_sync, "opendir",
+                          uv_fs_opendir, *path);
+    FS_SYNC_TRACE_END(opendir);
+    if (result < 0) {
+      return;  // syscall failed, no need to continue, error info is in ctx
+    }
+
+    uv_dir_t* dir = static_cast<uv_dir_t*>(req_wrap_sync.req.ptr);
+    DirHandle* handle = DirHandle::New(env, dir);
+    if (handle == nullptr) return;
+    args.GetReturnValue().Set(handle->object());
+  }
+}
+
 static void CopyFile(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
   Isolate* isolate = env->isolate();
@@ -2141,6 +2675,7 @@ void Initialize(Local<Object> target,
   env->SetMethod(target, "close", Close);
   env->SetMethod(target, "open", Open);
   env->SetMethod(target, "openFileHandle", OpenFileHandle);
+  env->SetMethod(target, "readFile", ReadFile);
   env->SetMethod(target, "read", Read);
   env->SetMethod(target, "fdatasync", Fdatasync);
   env->SetMethod(target, "fsync", Fsync);
@@ -2149,6 +2684,7 @@ void Initialize(Local<Object> target,
   env->SetMethod(target, "rmdir", RMDir);
   env->SetMethod(target, "mkdir", MKDir);
   env->SetMethod(target, "readdir", ReadDir);
+  env->SetMethod(target, "opendir", OpenDir);
   env->SetMethod(target, "internalModuleReadJSON", InternalModuleReadJSON);
   env->SetMethod(target, "internalModuleStat", InternalModuleStat);
   env->SetMethod(target, "stat", Stat);
@@ -2242,6 +2778,21 @@ void Initialize(Local<Object> target,
       .FromJust();
   env->set_fd_constructor_template(fdt);
 
+  // Create FunctionTemplate for DirHandle
+  Local<FunctionTemplate> dir = env->NewFunctionTemplate(DirHandle::New);
+  dir->Inherit(AsyncWrap::GetConstructorTemplate(env));
+  env->SetProtoMethod(dir, "read", DirHandle::Read);
+  env->SetProtoMethod(dir, "close", DirHandle::Close);
+  Local<ObjectTemplate> dirt = dir->InstanceTemplate();
+  dirt->SetInternalFieldCount(1);
+  Local<String> dirString = FIXED_ONE_BYTE_STRING(isolate, "DirHandle");
+  dir->SetClassName(dirString);
+  target
+      ->Set(context, dirString,
+            dir->GetFunction(env->context()).ToLocalChecked())
+      .FromJust();
+  env->set_dir_instance_template(dirt);
+
   // Create FunctionTemplate for FileHandle::CloseReq
   Local<FunctionTemplate> fdclose = FunctionTemplate::New(isolate);
   fdclose->SetClassName(FIXED_ONE_BYTE_STRING(isolate,
@@ -377,8 +377,19 @@ class FileHandle : public AsyncWrap, public StreamBase {
 
   bool IsAlive() override { return !closed_; }
   bool IsClosing() override { return closing_; }
+  FileHandle* GetFileHandle() override { return this; }
   AsyncWrap* GetAsyncWrap() override { return this; }
 
+  // Sends up to `length` bytes from the current read position straight to
+  // `out_fd` with uv_fs_sendfile(), bypassing EmitAlloc()/EmitRead().
+  // `cb` receives the number of bytes sent, UV_EOF at the end of the file
+  // (range) or an error code, unless CancelSendFile() was called first.
+  // Only possible when the FileHandle was created with an explicit offset.
+  typedef void (*SendFileCallback)(ssize_t result, void* data);
+  bool CanSendFile() const { return read_offset_ >= 0; }
+  int SendFile(int out_fd, size_t length, SendFileCallback cb, void* data);
+  void CancelSendFile();
+
   // In the case of file streams, shutting down corresponds to closing.
   ShutdownWrap* CreateShutdownWrap(v8::Local<v8::Object> object) override;
   int DoShutdown(ShutdownWrap* req_wrap) override;
@@ -457,6 +468,11 @@ class FileHandle : public AsyncWrap, public StreamBase {
   // Asynchronous close
   inline MaybeLocal<Promise> ClosePromise();
 
+  std::unique_ptr<FileHandleReadWrap> GetReadWrap();
+  void ReleaseReadWrap(std::unique_ptr<FileHandleReadWrap> read_wrap);
+  // Returns the number of bytes that count towards the read range.
+  int64_t AdvanceReadPosition(int64_t nread);
+
   int fd_;
   bool closing_ = false;
   bool closed_ = false;
@@ -465,6 +481,53 @@ class FileHandle : public AsyncWrap, public StreamBase {
 
   bool reading_ = false;
   std::unique_ptr<FileHandleReadWrap> current_read_ = nullptr;
+
+  SendFileCallback sendfile_cb_ = nullptr;
+  void* sendfile_data_ = nullptr;
+};
+
+// A wrapper for a uv_dir_t opened with uv_fs_opendir(). Entries are read in
+// batches of at most `bufferSize`, so iterating over a directory never holds
+// more than one batch in memory. The directory stream is closed
+// synchronously, with a process warning, if the handle is garbage collected
+// while still open.
+class DirHandle : public AsyncWrap {
+ public:
+  static DirHandle* New(Environment* env, uv_dir_t* dir);
+  ~DirHandle() override;
+
+  static void New(const FunctionCallbackInfo<Value>& args);
+  static void Read(const FunctionCallbackInfo<Value>& args);
+  static void Close(const FunctionCallbackInfo<Value>& args);
+
+  uv_dir_t* dir() { return dir_; }
+
+  // Points dir_->dirents at a buffer with room for `count` entries.
+  void PrepareRead(size_t count);
+
+  void MemoryInfo(MemoryTracker* tracker) const override {
+    tracker->TrackFieldWithSize("dir", sizeof(*dir_));
+    tracker->TrackFieldWithSize("dirents",
+                                dirents_.capacity() * sizeof(uv_dirent_t));
+  }
+
+  SET_MEMORY_INFO_NAME(DirHandle)
+  SET_SELF_SIZE(DirHandle)
+
+  DirHandle(const DirHandle&) = delete;
+  DirHandle& operator=(const DirHandle&) = delete;
+  DirHandle(const DirHandle&&) = delete;
+  DirHandle& operator=(const DirHandle&&) = delete;
+
+ private:
+  DirHandle(Environment* env, v8::Local<v8::Object> obj, uv_dir_t* dir);
+
+  // Synchronous close that emits a warning
+  void GCClose();
+
+  uv_dir_t* dir_;
+  std::vector<uv_dirent_t> dirents_;
+  bool closed_ = false;
 };
 
 }  // namespace fs
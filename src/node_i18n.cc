@@ -50,6 +50,8 @@
 #include "node_buffer.h"
 #include "node_errors.h"
 #include "node_internals.h"
+#include "simd_utf8.h"
+#include "string_bytes.h"
 #include "util-inl.h"
 #include "v8.h"
 
@@ -237,6 +239,29 @@ class ConverterObject : public BaseObject, Converter {
       converter->bomSeen_ = true;
     }
 
+    // Well-formed UTF-8 that does not continue a sequence from an earlier
+    // chunk decodes the same without ICU, and can be turned into a string
+    // directly instead of going through a UTF-16 buffer.
+    UErrorCode pending_status = U_ZERO_ERROR;
+    if (converter->utf8_ &&
+        U_SUCCESS(status) &&
+        ucnv_toUCountPending(converter->conv, &pending_status) == 0 &&
+        simd::IsValidUtf8(source, source_length)) {
+      Local<Value> error;
+      MaybeLocal<Value> str = StringBytes::Encode(env->isolate(),
+                                                  source,
+                                                  source_length,
+                                                  UTF8,
+                                                  &error);
+      if (str.IsEmpty()) {
+        CHECK(!error.IsEmpty());
+        env->isolate()->ThrowException(error);
+        return;
+      }
+      args.GetReturnValue().Set(str.ToLocalChecked());
+      return;
+    }
+
     UChar* target = *result;
     ucnv_toUnicode(converter->conv,
                    &target, target + (limit * sizeof(UChar)),
@@ -271,6 +296,9 @@ class ConverterObject : public BaseObject, Converter {
 
     switch (ucnv_getType(converter)) {
       case UCNV_UTF8:
+        utf8_ = true;
+        unicode_ = true;
+        break;
       case UCNV_UTF16_BigEndian:
       case UCNV_UTF16_LittleEndian:
         unicode_ = true;
@@ -282,6 +310,7 @@ class ConverterObject : public BaseObject, Converter {
 
  private:
   bool unicode_ = false;     // True if this is a Unicode converter
+  bool utf8_ = false;        // True if this is the UTF-8 converter
   bool ignoreBOM_ = false;   // True if the BOM should be ignored on Unicode
   bool bomSeen_ = false;     // True if the BOM has been seen
 };
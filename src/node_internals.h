@@ -233,9 +233,13 @@ class DebugSealHandleScope {
 #endif
 };
 
+// `kind` tells libuv how to schedule the work: queued fs work is picked up
+// ahead of CPU-bound work, and slow I/O is limited to half of the threads.
 class ThreadPoolWork {
  public:
-  explicit inline ThreadPoolWork(Environment* env) : env_(env) {
+  explicit inline ThreadPoolWork(Environment* env,
+                                 uv_work_kind kind = UV_WORK_CPU)
+      : env_(env), kind_(kind) {
     CHECK_NOT_NULL(env);
   }
   inline virtual ~ThreadPoolWork() = default;
@@ -248,14 +252,16 @@ class ThreadPoolWork {
 
  private:
   Environment* env_;
+  uv_work_kind kind_;
   uv_work_t work_req_;
 };
 
 void ThreadPoolWork::ScheduleWork() {
   env_->IncreaseWaitingRequestCounter();
-  int status = uv_queue_work(
+  int status = uv_queue_work_ex(
       env_->event_loop(),
       &work_req_,
+      kind_,
       [](uv_work_t* req) {
         ThreadPoolWork* self = ContainerOf(&ThreadPoolWork::work_req_, req);
         self->DoThreadPoolWork();
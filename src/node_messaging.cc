@@ -12,6 +12,7 @@ using node::contextify::ContextifyContext;
 using v8::Array;
 using v8::ArrayBuffer;
 using v8::ArrayBufferCreationMode;
+using v8::ArrayBufferView;
 using v8::Context;
 using v8::EscapableHandleScope;
 using v8::Exception;
@@ -24,11 +25,15 @@ using v8::Just;
 using v8::Local;
 using v8::Maybe;
 using v8::MaybeLocal;
+using v8::NewStringType;
 using v8::Nothing;
+using v8::Null;
+using v8::Number;
 using v8::Object;
 using v8::ObjectTemplate;
 using v8::SharedArrayBuffer;
 using v8::String;
+using v8::Undefined;
 using v8::Value;
 using v8::ValueDeserializer;
 using v8::ValueSerializer;
@@ -42,6 +47,118 @@ Message::Message(MallocedBuffer<char>&& buffer)
 
 namespace {
 
+// The first byte of messages that SerializePrimitive() encodes. Buffers
+// written by ValueSerializer always start with its version tag, 0xFF.
+enum PrimitiveTag : uint8_t {
+  kUndefinedTag = 1,
+  kNullTag,
+  kTrueTag,
+  kFalseTag,
+  kNumberTag,
+  kOneByteStringTag,
+  kTwoByteStringTag
+};
+
+// The tag is followed by one byte of padding, so that the characters of
+// two-byte strings are aligned.
+constexpr size_t kPrimitiveHeaderSize = 2;
+constexpr uint8_t kValueSerializerVersionTag = 0xFF;
+
+// ArrayBuffers of at least this size that are posted directly, or as the
+// buffer of a posted view, are copied once into memory that the receiving
+// side takes over, rather than being written into and read back from the
+// serialized message.
+constexpr size_t kMinCopiedArrayBufferSize = 64 * 1024;
+
+}  // anonymous namespace
+
+bool Message::SerializePrimitive(Isolate* isolate, Local<Value> input) {
+  PrimitiveTag tag;
+  size_t length = 0;
+  if (input->IsUndefined()) {
+    tag = kUndefinedTag;
+  } else if (input->IsNull()) {
+    tag = kNullTag;
+  } else if (input->IsTrue()) {
+    tag = kTrueTag;
+  } else if (input->IsFalse()) {
+    tag = kFalseTag;
+  } else if (input->IsNumber()) {
+    tag = kNumberTag;
+    length = sizeof(double);
+  } else if (input->IsString()) {
+    Local<String> string = input.As<String>();
+    tag = string->IsOneByte() ? kOneByteStringTag : kTwoByteStringTag;
+    length = string->Length() * (tag == kOneByteStringTag ? 1 : 2);
+  } else {
+    return false;
+  }
+
+  MallocedBuffer<char> buf(kPrimitiveHeaderSize + length);
+  buf.data[0] = tag;
+  buf.data[1] = 0;
+  char* payload = buf.data + kPrimitiveHeaderSize;
+  if (tag == kNumberTag) {
+    double value = input.As<Number>()->Value();
+    memcpy(payload, &value, sizeof(value));
+  } else if (tag == kOneByteStringTag) {
+    input.As<String>()->WriteOneByte(isolate,
+                                     reinterpret_cast<uint8_t*>(payload),
+                                     0,
+                                     -1,
+                                     String::NO_NULL_TERMINATION);
+  } else if (tag == kTwoByteStringTag) {
+    input.As<String>()->Write(isolate,
+                              reinterpret_cast<uint16_t*>(payload),
+                              0,
+                              -1,
+                              String::NO_NULL_TERMINATION);
+  }
+  main_message_buf_ = std::move(buf);
+  return true;
+}
+
+bool Message::IsPrimitive() const {
+  return main_message_buf_.size > 0 &&
+         static_cast<uint8_t>(main_message_buf_.data[0]) !=
+             kValueSerializerVersionTag;
+}
+
+Local<Value> Message::DeserializePrimitive(Isolate* isolate) {
+  const char* payload = main_message_buf_.data + kPrimitiveHeaderSize;
+  const size_t length = main_message_buf_.size - kPrimitiveHeaderSize;
+  switch (static_cast<uint8_t>(main_message_buf_.data[0])) {
+    case kUndefinedTag:
+      return Undefined(isolate);
+    case kNullTag:
+      return Null(isolate);
+    case kTrueTag:
+      return v8::True(isolate);
+    case kFalseTag:
+      return v8::False(isolate);
+    case kNumberTag: {
+      double value;
+      CHECK_EQ(length, sizeof(value));
+      memcpy(&value, payload, sizeof(value));
+      return Number::New(isolate, value);
+    }
+    case kOneByteStringTag:
+      return String::NewFromOneByte(isolate,
+                                    reinterpret_cast<const uint8_t*>(payload),
+                                    NewStringType::kNormal,
+                                    length).ToLocalChecked();
+    case kTwoByteStringTag:
+      return String::NewFromTwoByte(isolate,
+                                    reinterpret_cast<const uint16_t*>(payload),
+                                    NewStringType::kNormal,
+                                    length / 2).ToLocalChecked();
+    default:
+      UNREACHABLE();
+  }
+}
+
+namespace {
+
 // This is used to tell V8 how to read transferred host objects, like other
 // `MessagePort`s and `SharedArrayBuffer`s, and make new JS objects out of them.
 class DeserializerDelegate : public ValueDeserializer::Delegate {
@@ -94,6 +211,9 @@ MaybeLocal<Value> Message::Deserialize(Environment* env,
   EscapableHandleScope handle_scope(env->isolate());
   Context::Scope context_scope(context);
 
+  if (IsPrimitive())
+    return handle_scope.Escape(DeserializePrimitive(env->isolate()));
+
   // Create all necessary MessagePort handles.
   std::vector<MessagePort*> ports(message_ports_.size());
   for (uint32_t i = 0; i < message_ports_.size(); ++i) {
@@ -298,6 +418,13 @@ Maybe<bool> Message::Serialize(Environment* env,
   // Verify that we're not silently overwriting an existing message.
   CHECK(main_message_buf_.is_empty());
 
+  if ((transfer_list_v->IsUndefined() ||
+       (transfer_list_v->IsArray() &&
+        transfer_list_v.As<Array>()->Length() == 0)) &&
+      SerializePrimitive(env->isolate(), input)) {
+    return Just(true);
+  }
+
   SerializerDelegate delegate(env, context, this);
   ValueSerializer serializer(env->isolate(), &delegate);
   delegate.serializer = &serializer;
@@ -371,6 +498,25 @@ Maybe<bool> Message::Serialize(Environment* env,
     }
   }
 
+  // The transfer IDs of copied ArrayBuffers follow those of the transferred
+  // ones, in the same order as their contents in array_buffer_contents_.
+  Local<ArrayBuffer> copied_array_buffer;
+  if (input->IsArrayBuffer()) {
+    copied_array_buffer = input.As<ArrayBuffer>();
+  } else if (input->IsArrayBufferView() &&
+             input.As<ArrayBufferView>()->HasBuffer()) {
+    copied_array_buffer = input.As<ArrayBufferView>()->Buffer();
+  }
+  if (!copied_array_buffer.IsEmpty() &&
+      (copied_array_buffer->IsSharedArrayBuffer() ||
+       copied_array_buffer->ByteLength() < kMinCopiedArrayBufferSize ||
+       std::find(array_buffers.begin(), array_buffers.end(),
+                 copied_array_buffer) != array_buffers.end())) {
+    copied_array_buffer.Clear();
+  }
+  if (!copied_array_buffer.IsEmpty())
+    serializer.TransferArrayBuffer(array_buffers.size(), copied_array_buffer);
+
   serializer.WriteHeader();
   if (serializer.WriteValue(context, input).IsNothing()) {
     return Nothing<bool>();
@@ -391,6 +537,13 @@ Maybe<bool> Message::Serialize(Environment* env,
         static_cast<char*>(contents.Data()), contents.ByteLength()});
   }
 
+  if (!copied_array_buffer.IsEmpty()) {
+    ArrayBuffer::Contents contents = copied_array_buffer->GetContents();
+    MallocedBuffer<char> copy(contents.ByteLength());
+    memcpy(copy.data, contents.Data(), contents.ByteLength());
+    array_buffer_contents_.emplace_back(std::move(copy));
+  }
+
   delegate.Finish();
 
   // The serializer gave us a buffer allocated using `malloc()`.
@@ -407,6 +560,67 @@ void Message::MemoryInfo(MemoryTracker* tracker) const {
   tracker->TrackField("message_ports", message_ports_);
 }
 
+IncomingMessageQueue::IncomingMessageQueue()
+    : head_(&stub_), tail_(&stub_), stub_(Message()) { }
+
+IncomingMessageQueue::~IncomingMessageQueue() {
+  Message message;
+  while (Pop(&message)) {}
+}
+
+void IncomingMessageQueue::PushNode(Node* node) {
+  node->next.store(nullptr, std::memory_order_relaxed);
+  Node* prev = head_.exchange(node, std::memory_order_acq_rel);
+  // Between the exchange and this store, the consumer cannot get past `prev`.
+  prev->next.store(node, std::memory_order_release);
+}
+
+void IncomingMessageQueue::Push(Message&& message) {
+  PushNode(new Node(std::move(message)));
+}
+
+bool IncomingMessageQueue::Pop(Message* message) {
+  Node* tail = tail_;
+  Node* next = tail->next.load(std::memory_order_acquire);
+  if (tail == &stub_) {
+    if (next == nullptr)
+      return false;
+    tail_ = tail = next;
+    next = next->next.load(std::memory_order_acquire);
+  }
+
+  if (next == nullptr) {
+    // `tail` is the last node that has been linked. If it is not the head,
+    // a Push() has not finished yet. Otherwise, the stub goes after it, so
+    // that `tail` can be taken out.
+    if (tail != head_.load(std::memory_order_acquire))
+      return false;
+    PushNode(&stub_);
+    next = tail->next.load(std::memory_order_acquire);
+    if (next == nullptr)
+      return false;
+  }
+
+  tail_ = next;
+  *message = std::move(tail->message);
+  delete tail;
+  return true;
+}
+
+bool IncomingMessageQueue::IsEmpty() const {
+  return tail_ == &stub_ &&
+         stub_.next.load(std::memory_order_acquire) == nullptr;
+}
+
+void IncomingMessageQueue::MemoryInfo(MemoryTracker* tracker) const {
+  for (Node* node = tail_;
+       node != nullptr;
+       node = node->next.load(std::memory_order_acquire)) {
+    if (node != &stub_)
+      tracker->TrackField("message", node->message);
+  }
+}
+
 MessagePortData::MessagePortData(MessagePort* owner) : owner_(owner) { }
 
 MessagePortData::~MessagePortData() {
@@ -415,17 +629,21 @@ MessagePortData::~MessagePortData() {
 }
 
 void MessagePortData::MemoryInfo(MemoryTracker* tracker) const {
-  Mutex::ScopedLock lock(mutex_);
   tracker->TrackField("incoming_messages", incoming_messages_);
 }
 
 void MessagePortData::AddToIncomingQueue(Message&& message) {
   // This function will be called by other threads.
-  Mutex::ScopedLock lock(mutex_);
-  incoming_messages_.emplace_back(std::move(message));
+  incoming_messages_.Push(std::move(message));
+
+  // If the owner has already been notified and has not started to take
+  // messages out of the queue yet, it will also see this one.
+  if (wakeup_pending_.exchange(true))
+    return;
 
+  Mutex::ScopedLock lock(mutex_);
   if (owner_ != nullptr) {
-    Debug(owner_, "Adding message to incoming queue");
+    Debug(owner_, "Notifying owner about incoming messages");
     owner_->TriggerAsync();
   }
 }
@@ -486,7 +704,7 @@ MessagePort::MessagePort(Environment* env,
   auto onmessage = [](uv_async_t* handle) {
     // Called when data has been put into the queue.
     MessagePort* channel = ContainerOf(&MessagePort::async_, handle);
-    channel->OnMessage();
+    channel->OnMessage(channel->env()->options()->message_port_batch_size);
   };
   CHECK_EQ(uv_async_init(env->event_loop(),
                          &async_,
@@ -572,31 +790,35 @@ MessagePort* MessagePort::New(
   return port;
 }
 
-void MessagePort::OnMessage() {
+void MessagePort::OnMessage(uint64_t budget) {
   Debug(this, "Running MessagePort::OnMessage()");
   HandleScope handle_scope(env()->isolate());
   Local<Context> context = object(env()->isolate())->CreationContext();
 
+  // Messages that are added to the queue from here on notify this port again.
+  if (data_)
+    data_->wakeup_pending_.exchange(false);
+
   // data_ can only ever be modified by the owner thread, so no need to lock.
   // However, the message port may be transferred while it is processing
   // messages, so we need to check that this handle still owns its `data_` field
   // on every iteration.
+  uint64_t processed = 0;
   while (data_) {
-    Message received;
-    {
-      // Get the head of the message queue.
-      Mutex::ScopedLock lock(data_->mutex_);
-
-      Debug(this, "MessagePort has message, receiving = %d",
-            static_cast<int>(data_->receiving_messages_));
-
-      if (!data_->receiving_messages_)
-        break;
-      if (data_->incoming_messages_.empty())
-        break;
-      received = std::move(data_->incoming_messages_.front());
-      data_->incoming_messages_.pop_front();
+    Debug(this, "MessagePort has message, receiving = %d",
+          static_cast<int>(data_->receiving_messages_));
+
+    if (!data_->receiving_messages_)
+      break;
+    if (budget != 0 && processed == budget) {
+      // Let the event loop run other callbacks before emitting the rest.
+      TriggerAsync();
+      return;
     }
+    Message received;
+    if (!data_->incoming_messages_.Pop(&received))
+      break;
+    processed++;
 
     if (!env()->can_call_into_js()) {
       Debug(this, "MessagePort drains queue because !can_call_into_js()");
@@ -722,15 +944,13 @@ void MessagePort::PostMessage(const FunctionCallbackInfo<Value>& args) {
 }
 
 void MessagePort::Start() {
-  Mutex::ScopedLock lock(data_->mutex_);
   Debug(this, "Start receiving messages");
   data_->receiving_messages_ = true;
-  if (!data_->incoming_messages_.empty())
+  if (!data_->incoming_messages_.IsEmpty())
     TriggerAsync();
 }
 
 void MessagePort::Stop() {
-  Mutex::ScopedLock lock(data_->mutex_);
   Debug(this, "Stop receiving messages");
   data_->receiving_messages_ = false;
 }
@@ -758,7 +978,7 @@ void MessagePort::Drain(const FunctionCallbackInfo<Value>& args) {
   MessagePort* port;
   CHECK(args[0]->IsObject());
   ASSIGN_OR_RETURN_UNWRAP(&port, args[0].As<Object>());
-  port->OnMessage();
+  port->OnMessage(0);
 }
 
 void MessagePort::MoveToContext(const FunctionCallbackInfo<Value>& args) {
@@ -6,7 +6,7 @@
 #include "env.h"
 #include "node_mutex.h"
 #include "sharedarraybuffer_metadata.h"
-#include <list>
+#include <atomic>
 
 namespace node {
 namespace worker {
@@ -64,6 +64,13 @@ class Message : public MemoryRetainer {
   SET_SELF_SIZE(Message)
 
  private:
+  // Messages that consist of a single primitive value and do not transfer
+  // anything are encoded without going through V8's ValueSerializer.
+  // SerializePrimitive() returns false if `input` is not such a value.
+  bool SerializePrimitive(v8::Isolate* isolate, v8::Local<v8::Value> input);
+  bool IsPrimitive() const;
+  v8::Local<v8::Value> DeserializePrimitive(v8::Isolate* isolate);
+
   MallocedBuffer<char> main_message_buf_;
   std::vector<MallocedBuffer<char>> array_buffer_contents_;
   std::vector<SharedArrayBufferMetadataReference> shared_array_buffers_;
@@ -73,6 +80,53 @@ class Message : public MemoryRetainer {
   friend class MessagePort;
 };
 
+// A queue of messages that any number of threads can add to without taking a
+// lock, while a single thread at a time, the owner of the receiving port,
+// takes them out. This is Dmitry Vyukov's intrusive MPSC queue: each message
+// is allocated together with the pointer to the next one, producers only swap
+// the head pointer and link the previous head to their node, and the consumer
+// follows the links from the tail.
+class IncomingMessageQueue : public MemoryRetainer {
+ public:
+  IncomingMessageQueue();
+  ~IncomingMessageQueue() override;
+
+  IncomingMessageQueue(const IncomingMessageQueue&) = delete;
+  IncomingMessageQueue& operator=(const IncomingMessageQueue&) = delete;
+
+  // This may be called from any thread.
+  void Push(Message&& message);
+  // These may only be called by the consumer. Pop() returns false if the queue
+  // is empty, or if the message that a concurrent Push() adds has not been
+  // linked to the queue yet.
+  bool Pop(Message* message);
+  bool IsEmpty() const;
+
+  void MemoryInfo(MemoryTracker* tracker) const override;
+
+  SET_MEMORY_INFO_NAME(IncomingMessageQueue)
+  SET_SELF_SIZE(IncomingMessageQueue)
+
+ private:
+  struct Node {
+    explicit Node(Message&& message) : message(std::move(message)) {}
+
+    std::atomic<Node*> next { nullptr };
+    Message message;
+  };
+
+  void PushNode(Node* node);
+
+  // The most recently added node.
+  std::atomic<Node*> head_;
+  // The oldest node that has not been taken out yet, or `stub_`. Only the
+  // consumer accesses this.
+  Node* tail_;
+  // A node without a message that is linked into the queue whenever the last
+  // node is taken out, so that the queue never needs to be entirely empty.
+  Node stub_;
+};
+
 // This contains all data for a `MessagePort` instance that is not tied to
 // a specific Environment/Isolate/event loop, for easier transfer between those.
 class MessagePortData : public MemoryRetainer {
@@ -113,11 +167,17 @@ class MessagePortData : public MemoryRetainer {
   // is asynchronously triggered, so that it can close down naturally.
   void PingOwnerAfterDisentanglement();
 
+  IncomingMessageQueue incoming_messages_;
+  // Set when the owner has been notified about new messages, and cleared
+  // once it starts taking them out of the queue, so that the owner is only
+  // notified once for a whole batch of messages.
+  std::atomic<bool> wakeup_pending_ { false };
+  // Only accessed by the thread that owns the port.
+  bool receiving_messages_ = false;
+
   // This mutex protects all fields below it, with the exception of
   // sibling_.
   mutable Mutex mutex_;
-  bool receiving_messages_ = false;
-  std::list<Message> incoming_messages_;
   MessagePort* owner_ = nullptr;
   // This mutex protects the sibling_ field and is shared between two entangled
   // MessagePorts. If both mutexes are acquired, this one needs to be
@@ -201,7 +261,9 @@ class MessagePort : public HandleWrap {
 
  private:
   void OnClose() override;
-  void OnMessage();
+  // Emits at most `budget` messages, or all of them if `budget` is 0, and
+  // schedules another call if more messages are left.
+  void OnMessage(uint64_t budget);
   void TriggerAsync();
 
   std::unique_ptr<MessagePortData> data_ = nullptr;
@@ -253,6 +253,11 @@ EnvironmentOptionsParser::EnvironmentOptionsParser() {
             "custom loader",
             &EnvironmentOptions::userland_loader,
             kAllowedInEnvironment);
+  AddOption("--message-port-batch-size",
+            "maximum number of messages a MessagePort emits before "
+            "yielding to the event loop, 0 for no limit (default: 1000)",
+            &EnvironmentOptions::message_port_batch_size,
+            kAllowedInEnvironment);
   AddOption("--no-deprecation",
             "silence deprecation warnings",
             &EnvironmentOptions::no_deprecation,
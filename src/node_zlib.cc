@@ -19,8 +19,10 @@
 // OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
 // USE OR OTHER DEALINGS IN THE SOFTWARE.
 
+#include "node_zlib.h"
 #include "node.h"
 #include "node_buffer.h"
+#include "node_mutex.h"
 
 #include "async_wrap-inl.h"
 #include "env-inl.h"
@@ -38,12 +40,17 @@
 #include <cstdlib>
 #include <cstring>
 #include <atomic>
+#include <list>
+#include <string>
+#include <unordered_map>
 
 namespace node {
 
 using v8::Array;
 using v8::ArrayBuffer;
+using v8::ArrayBufferView;
 using v8::Context;
+using v8::Float64Array;
 using v8::Function;
 using v8::FunctionCallbackInfo;
 using v8::FunctionTemplate;
@@ -51,6 +58,8 @@ using v8::HandleScope;
 using v8::Int32;
 using v8::Integer;
 using v8::Local;
+using v8::MaybeLocal;
+using v8::Number;
 using v8::Object;
 using v8::String;
 using v8::Uint32;
@@ -132,9 +141,17 @@ class ZlibContext : public MemoryRetainer {
   inline void SetMode(node_zlib_mode mode) { mode_ = mode; }
   CompressionError ResetStream();
 
+  // Hands the stream over to the Environment's pool of compression contexts
+  // instead of closing it, along with the `memory` that was allocated for it.
+  // Returns false if it has to be closed normally.
+  bool ReleaseToPool(Environment* env, size_t memory);
+
   // Zlib-specific:
+  // Deflate streams are taken from `pool` when possible, in which case
+  // `*pooled_memory` is set to the memory that was allocated for them.
   CompressionError Init(int level, int window_bits, int mem_level, int strategy,
-                        std::vector<unsigned char>&& dictionary);
+                        std::vector<unsigned char>&& dictionary,
+                        zlib::ZlibContextPool* pool, size_t* pooled_memory);
   void SetAllocationFunctions(alloc_func alloc, free_func free, void* opaque);
   CompressionError SetParams(int level, int strategy);
 
@@ -161,8 +178,11 @@ class ZlibContext : public MemoryRetainer {
   int window_bits_ = 0;
   unsigned int gzip_id_bytes_read_ = 0;
   std::vector<unsigned char> dictionary_;
+  alloc_func alloc_ = nullptr;
+  free_func free_ = nullptr;
+  void* alloc_opaque_ = nullptr;
 
-  z_stream strm_;
+  zlib::ZlibContextPool::StreamPointer strm_{new z_stream()};
 };
 
 // Brotli has different data types for compression and decompression streams,
@@ -175,6 +195,8 @@ class BrotliContext : public MemoryRetainer {
   void SetFlush(int flush);
   void GetAfterWriteOffsets(uint32_t* avail_in, uint32_t* avail_out) const;
   inline void SetMode(node_zlib_mode mode) { mode_ = mode; }
+  // Brotli states cannot be reset, so they are never pooled.
+  inline bool ReleaseToPool(Environment* env, size_t memory) { return false; }
 
   BrotliContext(const BrotliContext&) = delete;
   BrotliContext& operator=(const BrotliContext&) = delete;
@@ -264,7 +286,12 @@ class CompressionStream : public AsyncWrap, public ThreadPoolWork {
     CHECK(init_done_ && "close before init");
 
     AllocScope alloc_scope(this);
-    ctx_.Close();
+    AdjustAmountOfExternalAllocatedMemory();
+    // Contexts that go back into the pool take their memory with them.
+    if (ctx_.ReleaseToPool(env(), zlib_memory_))
+      zlib_memory_ = 0;
+    else
+      ctx_.Close();
   }
 
 
@@ -449,6 +476,12 @@ class CompressionStream : public AsyncWrap, public ThreadPoolWork {
  protected:
   CompressionContext* context() { return &ctx_; }
 
+  // Takes over memory that zlib allocated for a pooled context and that has
+  // already been reported to V8.
+  void AdoptPooledMemory(size_t size) {
+    zlib_memory_ += size;
+  }
+
   void InitStream(uint32_t* write_result, Local<Function> write_js_callback) {
     write_result_ = write_result;
     write_js_callback_.Reset(env()->isolate(), write_js_callback);
@@ -606,9 +639,13 @@ class ZlibStream : public CompressionStream<ZlibContext> {
     AllocScope alloc_scope(wrap);
     wrap->context()->SetAllocationFunctions(
         AllocForZlib, FreeForZlib, static_cast<CompressionStream*>(wrap));
+    size_t pooled_memory = 0;
     const CompressionError err =
         wrap->context()->Init(level, window_bits, mem_level, strategy,
-                              std::move(dictionary));
+                              std::move(dictionary),
+                              wrap->env()->zlib_context_pool(),
+                              &pooled_memory);
+    wrap->AdoptPooledMemory(pooled_memory);
     if (err.IsError())
       wrap->EmitError(err);
 
@@ -719,10 +756,10 @@ void ZlibContext::Close() {
 
   int status = Z_OK;
   if (mode_ == DEFLATE || mode_ == GZIP || mode_ == DEFLATERAW) {
-    status = deflateEnd(&strm_);
+    status = deflateEnd(strm_.get());
   } else if (mode_ == INFLATE || mode_ == GUNZIP || mode_ == INFLATERAW ||
              mode_ == UNZIP) {
-    status = inflateEnd(&strm_);
+    status = inflateEnd(strm_.get());
   }
 
   CHECK(status == Z_OK || status == Z_DATA_ERROR);
@@ -732,6 +769,28 @@ void ZlibContext::Close() {
 }
 
 
+bool ZlibContext::ReleaseToPool(Environment* env, size_t memory) {
+  if (mode_ != DEFLATE && mode_ != GZIP && mode_ != DEFLATERAW)
+    return false;
+  // Streams that failed may be in any state.
+  if (err_ != Z_OK && err_ != Z_STREAM_END && err_ != Z_BUF_ERROR)
+    return false;
+
+  zlib::ZlibContextPool* pool = env->zlib_context_pool();
+  if (pool == nullptr ||
+      !pool->Release({ level_, window_bits_, mem_level_, strategy_ },
+                     &strm_,
+                     memory)) {
+    return false;
+  }
+
+  strm_.reset(new z_stream());
+  mode_ = NONE;
+  dictionary_.clear();
+  return true;
+}
+
+
 void ZlibContext::DoThreadPoolWork() {
   const Bytef* next_expected_header_byte = nullptr;
 
@@ -742,11 +801,11 @@ void ZlibContext::DoThreadPoolWork() {
     case DEFLATE:
     case GZIP:
     case DEFLATERAW:
-      err_ = deflate(&strm_, flush_);
+      err_ = deflate(strm_.get(), flush_);
       break;
     case UNZIP:
-      if (strm_.avail_in > 0) {
-        next_expected_header_byte = strm_.next_in;
+      if (strm_->avail_in > 0) {
+        next_expected_header_byte = strm_->next_in;
       }
 
       switch (gzip_id_bytes_read_) {
@@ -759,7 +818,7 @@ void ZlibContext::DoThreadPoolWork() {
             gzip_id_bytes_read_ = 1;
             next_expected_header_byte++;
 
-            if (strm_.avail_in == 1) {
+            if (strm_->avail_in == 1) {
               // The only available byte was already read.
               break;
             }
@@ -792,7 +851,7 @@ void ZlibContext::DoThreadPoolWork() {
     case INFLATE:
     case GUNZIP:
     case INFLATERAW:
-      err_ = inflate(&strm_, flush_);
+      err_ = inflate(strm_.get(), flush_);
 
       // If data was encoded with dictionary (INFLATERAW will have it set in
       // SetDictionary, don't repeat that here)
@@ -800,12 +859,12 @@ void ZlibContext::DoThreadPoolWork() {
           err_ == Z_NEED_DICT &&
           !dictionary_.empty()) {
         // Load it
-        err_ = inflateSetDictionary(&strm_,
+        err_ = inflateSetDictionary(strm_.get(),
                                     dictionary_.data(),
                                     dictionary_.size());
         if (err_ == Z_OK) {
           // And try to decode again
-          err_ = inflate(&strm_, flush_);
+          err_ = inflate(strm_.get(), flush_);
         } else if (err_ == Z_DATA_ERROR) {
           // Both inflateSetDictionary() and inflate() return Z_DATA_ERROR.
           // Make it possible for After() to tell a bad dictionary from bad
@@ -814,17 +873,17 @@ void ZlibContext::DoThreadPoolWork() {
         }
       }
 
-      while (strm_.avail_in > 0 &&
+      while (strm_->avail_in > 0 &&
              mode_ == GUNZIP &&
              err_ == Z_STREAM_END &&
-             strm_.next_in[0] != 0x00) {
+             strm_->next_in[0] != 0x00) {
         // Bytes remain in input buffer. Perhaps this is another compressed
         // member in the same archive, or just trailing garbage.
         // Trailing zero bytes are okay, though, since they are frequently
         // used for padding.
 
         ResetStream();
-        err_ = inflate(&strm_, flush_);
+        err_ = inflate(strm_.get(), flush_);
       }
       break;
     default:
@@ -835,10 +894,10 @@ void ZlibContext::DoThreadPoolWork() {
 
 void ZlibContext::SetBuffers(char* in, uint32_t in_len,
                              char* out, uint32_t out_len) {
-  strm_.avail_in = in_len;
-  strm_.next_in = reinterpret_cast<Bytef*>(in);
-  strm_.avail_out = out_len;
-  strm_.next_out = reinterpret_cast<Bytef*>(out);
+  strm_->avail_in = in_len;
+  strm_->next_in = reinterpret_cast<Bytef*>(in);
+  strm_->avail_out = out_len;
+  strm_->next_out = reinterpret_cast<Bytef*>(out);
 }
 
 
@@ -849,14 +908,14 @@ void ZlibContext::SetFlush(int flush) {
 
 void ZlibContext::GetAfterWriteOffsets(uint32_t* avail_in,
                                        uint32_t* avail_out) const {
-  *avail_in = strm_.avail_in;
-  *avail_out = strm_.avail_out;
+  *avail_in = strm_->avail_in;
+  *avail_out = strm_->avail_out;
 }
 
 
 CompressionError ZlibContext::ErrorForMessage(const char* message) const {
-  if (strm_.msg != nullptr)
-    message = strm_.msg;
+  if (strm_->msg != nullptr)
+    message = strm_->msg;
 
   return CompressionError { message, ZlibStrerror(err_), err_ };
 }
@@ -867,7 +926,7 @@ CompressionError ZlibContext::GetErrorInfo() const {
   switch (err_) {
   case Z_OK:
   case Z_BUF_ERROR:
-    if (strm_.avail_out != 0 && flush_ == Z_FINISH) {
+    if (strm_->avail_out != 0 && flush_ == Z_FINISH) {
       return ErrorForMessage("unexpected end of file");
     }
   case Z_STREAM_END:
@@ -894,12 +953,12 @@ CompressionError ZlibContext::ResetStream() {
     case DEFLATE:
     case DEFLATERAW:
     case GZIP:
-      err_ = deflateReset(&strm_);
+      err_ = deflateReset(strm_.get());
       break;
     case INFLATE:
     case INFLATERAW:
     case GUNZIP:
-      err_ = inflateReset(&strm_);
+      err_ = inflateReset(strm_.get());
       break;
     default:
       break;
@@ -915,15 +974,19 @@ CompressionError ZlibContext::ResetStream() {
 void ZlibContext::SetAllocationFunctions(alloc_func alloc,
                                          free_func free,
                                          void* opaque) {
-  strm_.zalloc = alloc;
-  strm_.zfree = free;
-  strm_.opaque = opaque;
+  alloc_ = alloc;
+  free_ = free;
+  alloc_opaque_ = opaque;
+  strm_->zalloc = alloc;
+  strm_->zfree = free;
+  strm_->opaque = opaque;
 }
 
 
 CompressionError ZlibContext::Init(
     int level, int window_bits, int mem_level, int strategy,
-    std::vector<unsigned char>&& dictionary) {
+    std::vector<unsigned char>&& dictionary,
+    zlib::ZlibContextPool* pool, size_t* pooled_memory) {
   if (!((window_bits == 0) &&
         (mode_ == INFLATE ||
          mode_ == GUNZIP ||
@@ -965,11 +1028,24 @@ CompressionError ZlibContext::Init(
     window_bits_ *= -1;
   }
 
+  zlib::ZlibContextPool::StreamPointer pooled;
   switch (mode_) {
     case DEFLATE:
     case GZIP:
     case DEFLATERAW:
-      err_ = deflateInit2(&strm_,
+      if (pool != nullptr) {
+        pooled = pool->Acquire({ level_, window_bits_, mem_level_, strategy_ },
+                               pooled_memory);
+      }
+      if (pooled) {
+        strm_ = std::move(pooled);
+        strm_->zalloc = alloc_;
+        strm_->zfree = free_;
+        strm_->opaque = alloc_opaque_;
+        err_ = Z_OK;
+        break;
+      }
+      err_ = deflateInit2(strm_.get(),
                           level_,
                           Z_DEFLATED,
                           window_bits_,
@@ -980,7 +1056,7 @@ CompressionError ZlibContext::Init(
     case GUNZIP:
     case INFLATERAW:
     case UNZIP:
-      err_ = inflateInit2(&strm_, window_bits_);
+      err_ = inflateInit2(strm_.get(), window_bits_);
       break;
     default:
       UNREACHABLE();
@@ -1007,14 +1083,14 @@ CompressionError ZlibContext::SetDictionary() {
   switch (mode_) {
     case DEFLATE:
     case DEFLATERAW:
-      err_ = deflateSetDictionary(&strm_,
+      err_ = deflateSetDictionary(strm_.get(),
                                   dictionary_.data(),
                                   dictionary_.size());
       break;
     case INFLATERAW:
       // The other inflate cases will have the dictionary set when inflate()
       // returns Z_NEED_DICT in Process()
-      err_ = inflateSetDictionary(&strm_,
+      err_ = inflateSetDictionary(strm_.get(),
                                   dictionary_.data(),
                                   dictionary_.size());
       break;
@@ -1036,7 +1112,11 @@ CompressionError ZlibContext::SetParams(int level, int strategy) {
   switch (mode_) {
     case DEFLATE:
     case DEFLATERAW:
-      err_ = deflateParams(&strm_, level, strategy);
+      err_ = deflateParams(strm_.get(), level, strategy);
+      if (err_ == Z_OK) {
+        level_ = level;
+        strategy_ = strategy;
+      }
       break;
     default:
       break;
@@ -1205,6 +1285,407 @@ CompressionError BrotliDecoderContext::GetErrorInfo() const {
 }
 
 
+// Compresses a single block of a deflate stream whose input is split into
+// blocks that are compressed in parallel on the threadpool (see
+// lib/internal/zlib/parallel.js). Every block is a raw deflate stream of its
+// own that is primed with the input preceding it as a dictionary, and ends on
+// a byte boundary, so the outputs of all blocks can simply be concatenated.
+class DeflateBlock : public AsyncWrap, public ThreadPoolWork {
+ public:
+  DeflateBlock(Environment* env, Local<Object> wrap)
+      : AsyncWrap(env, wrap, AsyncWrap::PROVIDER_ZLIB),
+        ThreadPoolWork(env) {
+    MakeWeak();
+  }
+
+  static void New(const FunctionCallbackInfo<Value>& args) {
+    Environment* env = Environment::GetCurrent(args);
+    CHECK(args.IsConstructCall());
+    new DeflateBlock(env, args.This());
+  }
+
+  // compress(mode, input, dictionary, level, windowBits, memLevel, strategy,
+  //          finish)
+  // Calls back into `ondone(output, checksum)` or `onerror(message, errno,
+  // code)`, synchronously for the sync version. The input and dictionary
+  // buffers must stay alive and unmodified until then.
+  template <bool async>
+  static void Compress(const FunctionCallbackInfo<Value>& args) {
+    Environment* env = Environment::GetCurrent(args);
+    CHECK_EQ(args.Length(), 8);
+    DeflateBlock* block;
+    ASSIGN_OR_RETURN_UNWRAP(&block, args.Holder());
+    CHECK(!block->in_progress_);
+
+    CHECK(args[0]->IsInt32());
+    block->mode_ = static_cast<node_zlib_mode>(args[0].As<Int32>()->Value());
+    CHECK(block->mode_ == DEFLATE ||
+          block->mode_ == GZIP ||
+          block->mode_ == DEFLATERAW);
+
+    CHECK(Buffer::HasInstance(args[1]));
+    block->input_ = reinterpret_cast<Bytef*>(Buffer::Data(args[1]));
+    block->input_len_ = Buffer::Length(args[1]);
+    CHECK_LE(block->input_len_, std::numeric_limits<uInt>::max() / 2);
+
+    if (args[2]->IsUndefined()) {
+      block->dictionary_ = nullptr;
+      block->dictionary_len_ = 0;
+    } else {
+      CHECK(Buffer::HasInstance(args[2]));
+      block->dictionary_ = reinterpret_cast<Bytef*>(Buffer::Data(args[2]));
+      block->dictionary_len_ = Buffer::Length(args[2]);
+    }
+
+    CHECK(args[3]->IsInt32());
+    CHECK(args[4]->IsInt32());
+    CHECK(args[5]->IsInt32());
+    CHECK(args[6]->IsInt32());
+    block->level_ = args[3].As<Int32>()->Value();
+    block->window_bits_ = args[4].As<Int32>()->Value();
+    block->mem_level_ = args[5].As<Int32>()->Value();
+    block->strategy_ = args[6].As<Int32>()->Value();
+    block->finish_ = args[7]->IsTrue();
+
+    // Large enough for stored blocks and the trailing sync flush marker, even
+    // with the small windows and memory levels that make deflateBound() grow.
+    size_t len = block->input_len_;
+    block->output_ =
+        env->AllocateManaged(len + ((len + 7) >> 3) + ((len + 63) >> 6) + 64);
+
+    block->in_progress_ = true;
+    block->ClearWeak();
+
+    if (!async) {
+      env->PrintSyncTrace();
+      block->DoThreadPoolWork();
+      block->AfterThreadPoolWork(0);
+      return;
+    }
+
+    block->ScheduleWork();
+  }
+
+  // thread pool!
+  void DoThreadPoolWork() override {
+    z_stream strm;
+    memset(&strm, 0, sizeof(strm));
+    checksum_ = 0;
+    err_ = deflateInit2(&strm, level_, Z_DEFLATED, -window_bits_, mem_level_,
+                        strategy_);
+    if (err_ != Z_OK)
+      return;
+
+    if (dictionary_ != nullptr)
+      err_ = deflateSetDictionary(&strm, dictionary_, dictionary_len_);
+
+    if (err_ == Z_OK) {
+      strm.next_in = input_;
+      strm.avail_in = input_len_;
+      strm.next_out = reinterpret_cast<Bytef*>(output_.data());
+      strm.avail_out = output_.size();
+      err_ = deflate(&strm, finish_ ? Z_FINISH : Z_SYNC_FLUSH);
+      if (err_ == (finish_ ? Z_STREAM_END : Z_OK) && strm.avail_out > 0) {
+        err_ = Z_OK;
+        output_len_ = strm.total_out;
+      } else if (err_ >= Z_OK) {
+        err_ = Z_BUF_ERROR;
+      }
+    }
+
+    if (err_ != Z_OK && strm.msg != nullptr)
+      message_ = strm.msg;
+    deflateEnd(&strm);
+
+    if (err_ == Z_OK && mode_ == GZIP)
+      checksum_ = crc32_z(0, input_, input_len_);
+    else if (err_ == Z_OK && mode_ == DEFLATE)
+      checksum_ = adler32_z(1, input_, input_len_);
+  }
+
+  // v8 land!
+  void AfterThreadPoolWork(int status) override {
+    OnScopeLeave on_scope_leave([&]() {
+      in_progress_ = false;
+      MakeWeak();
+    });
+
+    HandleScope handle_scope(env()->isolate());
+    Context::Scope context_scope(env()->context());
+
+    if (status == UV_ECANCELED) {
+      output_ = AllocatedBuffer();
+      return;
+    }
+    CHECK_EQ(status, 0);
+
+    if (err_ != Z_OK) {
+      output_ = AllocatedBuffer();
+      Local<Value> args[3] = {
+        OneByteString(env()->isolate(),
+                      message_ != nullptr ? message_ : "Zlib error"),
+        Integer::New(env()->isolate(), err_),
+        OneByteString(env()->isolate(), ZlibStrerror(err_))
+      };
+      MakeCallback(env()->onerror_string(), arraysize(args), args);
+      return;
+    }
+
+    output_.Resize(output_len_);
+    Local<Value> args[2] = {
+      output_.ToBuffer().ToLocalChecked(),
+      Integer::NewFromUnsigned(env()->isolate(), checksum_)
+    };
+    MakeCallback(env()->ondone_string(), arraysize(args), args);
+  }
+
+  SET_NO_MEMORY_INFO()
+  SET_MEMORY_INFO_NAME(DeflateBlock)
+  SET_SELF_SIZE(DeflateBlock)
+
+ private:
+  bool in_progress_ = false;
+  node_zlib_mode mode_ = NONE;
+  Bytef* input_ = nullptr;
+  size_t input_len_ = 0;
+  Bytef* dictionary_ = nullptr;
+  size_t dictionary_len_ = 0;
+  int level_ = 0;
+  int window_bits_ = 0;
+  int mem_level_ = 0;
+  int strategy_ = 0;
+  bool finish_ = false;
+  AllocatedBuffer output_;
+  size_t output_len_ = 0;
+  uLong checksum_ = 0;
+  int err_ = Z_OK;
+  const char* message_ = nullptr;
+};
+
+// checksum(mode, data) returns the CRC-32 (gzip) or Adler-32 (deflate) of data.
+void Checksum(const FunctionCallbackInfo<Value>& args) {
+  CHECK(args[0]->IsInt32());
+  CHECK(Buffer::HasInstance(args[1]));
+  const Bytef* data = reinterpret_cast<const Bytef*>(Buffer::Data(args[1]));
+  size_t len = Buffer::Length(args[1]);
+  uLong checksum = args[0].As<Int32>()->Value() == GZIP ?
+      crc32_z(0, data, len) : adler32_z(1, data, len);
+  args.GetReturnValue().Set(static_cast<uint32_t>(checksum));
+}
+
+// combineChecksums(mode, checksum1, checksum2, length2) returns the checksum
+// of two consecutive pieces of data, given the checksums of both and the
+// length of the second one.
+void CombineChecksums(const FunctionCallbackInfo<Value>& args) {
+  CHECK(args[0]->IsInt32());
+  CHECK(args[1]->IsUint32());
+  CHECK(args[2]->IsUint32());
+  CHECK(args[3]->IsNumber());
+  uLong checksum1 = args[1].As<Uint32>()->Value();
+  uLong checksum2 = args[2].As<Uint32>()->Value();
+  z_off_t length2 = static_cast<z_off_t>(args[3].As<Number>()->Value());
+  uLong checksum = args[0].As<Int32>()->Value() == GZIP ?
+      crc32_combine(checksum1, checksum2, length2) :
+      adler32_combine(checksum1, checksum2, length2);
+  args.GetReturnValue().Set(static_cast<uint32_t>(checksum));
+}
+
+
+// Holds the output of the one-shot compression functions for inputs that
+// were compressed with the `cache` option before, keyed by the input and a
+// string describing the compression parameters. The cache is shared by all
+// threads of the process and drops its least recently used entries once it
+// holds more than kMaxBytes. The input is stored along with the output, so
+// that hash collisions can never return the wrong data. The mutex only
+// guards the index; entries are immutable and compared and copied after it
+// has been released.
+class CompressionCache {
+ public:
+  static constexpr size_t kMaxBytes = 16 * 1024 * 1024;
+
+  struct Stats {
+    uint64_t entries;
+    uint64_t size;
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t evictions;
+  };
+
+  // Returns a copy of the cached output, or an empty handle.
+  MaybeLocal<Object> Lookup(Environment* env,
+                            const std::string& key,
+                            const char* data,
+                            size_t length);
+  void Store(const std::string& key,
+             const char* data,
+             size_t length,
+             const char* output,
+             size_t output_length);
+
+  Stats GetStats();
+
+ private:
+  struct Contents {
+    std::string key;
+    std::string input;
+    std::string output;
+  };
+
+  struct Entry {
+    uint64_t hash;
+    // Shared with lookups that are still using it after it was evicted.
+    std::shared_ptr<const Contents> contents;
+
+    inline size_t size() const {
+      return contents->key.size() + contents->input.size() +
+             contents->output.size() + sizeof(Contents) + sizeof(*this);
+    }
+  };
+
+  static uint64_t Hash(const std::string& key, const char* data, size_t length);
+
+  Mutex mutex_;
+  // Most recently used entries first.
+  std::list<Entry> entries_;
+  std::unordered_map<uint64_t, std::list<Entry>::iterator> index_;
+  size_t size_ = 0;
+  std::atomic<uint64_t> hits_{0};
+  std::atomic<uint64_t> misses_{0};
+  uint64_t evictions_ = 0;
+};
+
+namespace per_process {
+// Never destroyed, because Worker threads may still use it while the main
+// thread runs static destructors at exit.
+CompressionCache* const compression_cache = new CompressionCache();
+}  // namespace per_process
+
+
+uint64_t CompressionCache::Hash(const std::string& key,
+                                const char* data,
+                                size_t length) {
+  uLong crc = crc32_z(0, reinterpret_cast<const Bytef*>(key.data()),
+                      key.size());
+  crc = crc32_z(crc, reinterpret_cast<const Bytef*>(data), length);
+  return static_cast<uint64_t>(length) << 32 | crc;
+}
+
+
+MaybeLocal<Object> CompressionCache::Lookup(Environment* env,
+                                            const std::string& key,
+                                            const char* data,
+                                            size_t length) {
+  const uint64_t hash = Hash(key, data, length);
+  std::shared_ptr<const Contents> contents;
+  {
+    Mutex::ScopedLock lock(mutex_);
+    auto it = index_.find(hash);
+    if (it != index_.end()) {
+      contents = it->second->contents;
+      entries_.splice(entries_.begin(), entries_, it->second);
+    }
+  }
+
+  if (!contents ||
+      contents->key != key ||
+      contents->input.compare(0, std::string::npos, data, length) != 0) {
+    misses_++;
+    return MaybeLocal<Object>();
+  }
+  hits_++;
+  return Buffer::Copy(env, contents->output.data(), contents->output.size());
+}
+
+
+void CompressionCache::Store(const std::string& key,
+                             const char* data,
+                             size_t length,
+                             const char* output,
+                             size_t output_length) {
+  Entry entry { Hash(key, data, length),
+                std::make_shared<const Contents>(Contents {
+                    key,
+                    std::string(data, length),
+                    std::string(output, output_length) }) };
+  if (entry.size() > kMaxBytes)
+    return;
+
+  Mutex::ScopedLock lock(mutex_);
+  auto it = index_.find(entry.hash);
+  if (it != index_.end()) {
+    size_ -= it->second->size();
+    entries_.erase(it->second);
+    index_.erase(it);
+  }
+  size_ += entry.size();
+  entries_.push_front(std::move(entry));
+  index_.emplace(entries_.front().hash, entries_.begin());
+
+  while (size_ > kMaxBytes) {
+    const Entry& oldest = entries_.back();
+    size_ -= oldest.size();
+    index_.erase(oldest.hash);
+    entries_.pop_back();
+    evictions_++;
+  }
+}
+
+
+CompressionCache::Stats CompressionCache::GetStats() {
+  Mutex::ScopedLock lock(mutex_);
+  return Stats { entries_.size(), size_, hits_, misses_, evictions_ };
+}
+
+
+// cacheLookup(key, data) returns the cached output for data, or undefined.
+void CacheLookup(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CHECK(args[0]->IsString());
+  CHECK(args[1]->IsArrayBufferView());
+  const node::Utf8Value key(env->isolate(), args[0]);
+  ArrayBufferViewContents<char> data(args[1].As<ArrayBufferView>());
+  Local<Object> output;
+  if (per_process::compression_cache->Lookup(env, *key, data.data(),
+                                            data.length()).ToLocal(&output)) {
+    args.GetReturnValue().Set(output);
+  }
+}
+
+
+// cacheStore(key, data, output) adds the output for data to the cache.
+void CacheStore(const FunctionCallbackInfo<Value>& args) {
+  CHECK(args[0]->IsString());
+  CHECK(args[1]->IsArrayBufferView());
+  CHECK(args[2]->IsArrayBufferView());
+  const node::Utf8Value key(args.GetIsolate(), args[0]);
+  ArrayBufferViewContents<char> data(args[1].As<ArrayBufferView>());
+  ArrayBufferViewContents<char> output(args[2].As<ArrayBufferView>());
+  per_process::compression_cache->Store(*key, data.data(), data.length(),
+                                        output.data(), output.length());
+}
+
+
+void GetCacheStats(const FunctionCallbackInfo<Value>& args) {
+  CHECK(args[0]->IsFloat64Array());
+  Local<Float64Array> array = args[0].As<Float64Array>();
+  CHECK_EQ(array->Length(), 5);
+  double* fields = static_cast<double*>(array->Buffer()->GetContents().Data());
+  CompressionCache::Stats stats = per_process::compression_cache->GetStats();
+  fields[0] = static_cast<double>(stats.entries);
+  fields[1] = static_cast<double>(stats.size);
+  fields[2] = static_cast<double>(stats.hits);
+  fields[3] = static_cast<double>(stats.misses);
+  fields[4] = static_cast<double>(stats.evictions);
+}
+
+
+// For tests: the memory held by the deflate streams in the context pool.
+void GetPooledContextBytes(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  args.GetReturnValue().Set(
+      static_cast<double>(env->zlib_context_pool()->pooled_bytes()));
+}
+
 template <typename Stream>
 struct MakeClass {
   static void Make(Environment* env, Local<Object> target, const char* name) {
@@ -1239,6 +1720,26 @@ void Initialize(Local<Object> target,
   MakeClass<BrotliEncoderStream>::Make(env, target, "BrotliEncoder");
   MakeClass<BrotliDecoderStream>::Make(env, target, "BrotliDecoder");
 
+  Local<FunctionTemplate> block = env->NewFunctionTemplate(DeflateBlock::New);
+  block->InstanceTemplate()->SetInternalFieldCount(1);
+  block->Inherit(AsyncWrap::GetConstructorTemplate(env));
+  env->SetProtoMethod(block, "compress", DeflateBlock::Compress<true>);
+  env->SetProtoMethod(block, "compressSync", DeflateBlock::Compress<false>);
+  Local<String> block_string =
+      FIXED_ONE_BYTE_STRING(env->isolate(), "DeflateBlock");
+  block->SetClassName(block_string);
+  target->Set(env->context(),
+              block_string,
+              block->GetFunction(env->context()).ToLocalChecked()).FromJust();
+
+  env->SetMethod(target, "checksum", Checksum);
+  env->SetMethod(target, "combineChecksums", CombineChecksums);
+  env->SetMethod(target, "cacheLookup", CacheLookup);
+  env->SetMethod(target, "cacheStore", CacheStore);
+  env->SetMethodNoSideEffect(target, "getCacheStats", GetCacheStats);
+  env->SetMethodNoSideEffect(target, "getPooledContextBytes",
+                             GetPooledContextBytes);
+
   target->Set(env->context(),
               FIXED_ONE_BYTE_STRING(env->isolate(), "ZLIB_VERSION"),
               FIXED_ONE_BYTE_STRING(env->isolate(), ZLIB_VERSION)).FromJust();
@@ -1246,6 +1747,82 @@ void Initialize(Local<Object> target,
 
 }  // anonymous namespace
 
+namespace zlib {
+
+namespace {
+
+// Pooled streams do not belong to any CompressionStream. They are only ended,
+// which frees the memory that CompressionStream::AllocForBrotli()
+// allocated, while the pool does the accounting for it.
+void* AllocForPooledStream(void* data, uInt items, uInt size) {
+  UNREACHABLE();
+}
+
+void FreeForPooledStream(void* data, void* pointer) {
+  if (UNLIKELY(pointer == nullptr)) return;
+  free(static_cast<char*>(pointer) - sizeof(size_t));
+}
+
+}  // anonymous namespace
+
+
+void ZlibContextPool::StreamDeleter::operator()(z_stream_s* strm) const {
+  delete strm;
+}
+
+
+ZlibContextPool::ZlibContextPool(v8::Isolate* isolate) : isolate_(isolate) {}
+
+
+ZlibContextPool::~ZlibContextPool() {
+  while (!entries_.empty())
+    Evict();
+}
+
+
+ZlibContextPool::StreamPointer ZlibContextPool::Acquire(const Params& params,
+                                                        size_t* memory) {
+  for (auto it = entries_.rbegin(); it != entries_.rend(); ++it) {
+    if (!(it->params == params))
+      continue;
+    StreamPointer strm = std::move(it->strm);
+    *memory = it->memory;
+    pooled_bytes_ -= it->memory;
+    entries_.erase(std::next(it).base());
+    return strm;
+  }
+  return StreamPointer();
+}
+
+
+bool ZlibContextPool::Release(const Params& params,
+                              StreamPointer* strm,
+                              size_t memory) {
+  if (memory > kMaxPooledBytes || deflateReset(strm->get()) != Z_OK)
+    return false;
+  while (pooled_bytes_ + memory > kMaxPooledBytes)
+    Evict();
+
+  (*strm)->zalloc = AllocForPooledStream;
+  (*strm)->zfree = FreeForPooledStream;
+  (*strm)->opaque = this;
+  entries_.push_back(Entry { params, std::move(*strm), memory });
+  pooled_bytes_ += memory;
+  return true;
+}
+
+
+void ZlibContextPool::Evict() {
+  Entry& entry = entries_.front();
+  CHECK_EQ(deflateEnd(entry.strm.get()), Z_OK);
+  pooled_bytes_ -= entry.memory;
+  isolate_->AdjustAmountOfExternalAllocatedMemory(
+      -static_cast<int64_t>(entry.memory));
+  entries_.erase(entries_.begin());
+}
+
+}  // namespace zlib
+
 void DefineZlibConstants(Local<Object> target) {
   NODE_DEFINE_CONSTANT(target, Z_NO_FLUSH);
   NODE_DEFINE_CONSTANT(target, Z_PARTIAL_FLUSH);
@@ -0,0 +1,92 @@
+#ifndef SRC_NODE_ZLIB_H_
+#define SRC_NODE_ZLIB_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include "memory_tracker.h"
+#include "v8.h"
+
+#include <memory>
+#include <vector>
+
+struct z_stream_s;
+
+namespace node {
+namespace zlib {
+
+// Keeps the deflate streams of closed compression streams of one Environment
+// around, so that new streams with the same parameters can take them over
+// after a deflateReset() rather than going through deflateInit2(), which
+// allocates and sets up about 256 KB of window and hash tables every time.
+// At most kMaxPooledBytes are kept; the streams that were released the
+// longest time ago are ended first.
+class ZlibContextPool : public MemoryRetainer {
+ public:
+  static constexpr size_t kMaxPooledBytes = 8 * 1024 * 1024;
+
+  // The arguments to deflateInit2(), which deflateReset() keeps.
+  struct Params {
+    int level;
+    int window_bits;
+    int mem_level;
+    int strategy;
+
+    inline bool operator==(const Params& other) const {
+      return level == other.level &&
+             window_bits == other.window_bits &&
+             mem_level == other.mem_level &&
+             strategy == other.strategy;
+    }
+  };
+
+  struct StreamDeleter {
+    void operator()(z_stream_s* strm) const;
+  };
+  using StreamPointer = std::unique_ptr<z_stream_s, StreamDeleter>;
+
+  explicit ZlibContextPool(v8::Isolate* isolate);
+  ~ZlibContextPool() override;
+
+  ZlibContextPool(const ZlibContextPool&) = delete;
+  ZlibContextPool& operator=(const ZlibContextPool&) = delete;
+
+  // Returns a stream that was initialized with `params` and has been reset
+  // since, or nullptr. The caller takes over the `*memory` bytes that
+  // zlib has allocated for it, which have already been reported to V8, and
+  // has to install its own allocation functions.
+  StreamPointer Acquire(const Params& params, size_t* memory);
+  // Resets and takes over an initialized deflate stream that zlib has
+  // allocated `memory` bytes for with the allocation functions in
+  // node_zlib.cc. Returns false if the caller should end the stream instead.
+  bool Release(const Params& params, StreamPointer* strm, size_t memory);
+
+  inline size_t pooled_bytes() const { return pooled_bytes_; }
+
+  void MemoryInfo(MemoryTracker* tracker) const override {
+    tracker->TrackFieldWithSize("free_streams", pooled_bytes_, "z_stream");
+  }
+
+  SET_MEMORY_INFO_NAME(ZlibContextPool)
+  SET_SELF_SIZE(ZlibContextPool)
+
+ private:
+  struct Entry {
+    Params params;
+    StreamPointer strm;
+    size_t memory;
+  };
+
+  void Evict();
+
+  v8::Isolate* const isolate_;
+  size_t pooled_bytes_ = 0;
+  // From the least recently released stream to the most recently released.
+  std::vector<Entry> entries_;
+};
+
+}  // namespace zlib
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#endif  // SRC_NODE_ZLIB_H_
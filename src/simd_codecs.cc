@@ -0,0 +1,579 @@
+#include "simd_codecs.h"
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define NODE_SIMD_CODECS_X86 1
+#include <immintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define NODE_SIMD_CODECS_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace node {
+namespace simd {
+
+namespace {
+
+size_t NoBase64Encode(const char* src, size_t slen, char* dst) {
+  return 0;
+}
+
+size_t NoBase64Decode(const char* src, size_t slen, char* dst, size_t dlen) {
+  return 0;
+}
+
+size_t NoHexEncode(const char* src, size_t slen, char* dst) {
+  return 0;
+}
+
+size_t NoHexDecode(const char* src, size_t slen, char* dst, size_t dlen) {
+  return 0;
+}
+
+#if defined(NODE_SIMD_CODECS_X86)
+
+// The kernels are compiled for their instruction set individually so that
+// the rest of the binary keeps the baseline target; they are only called
+// after the CPU has been checked for support.
+#define SSE41_TARGET __attribute__((target("sse4.1")))
+#define AVX2_TARGET __attribute__((target("avx2")))
+
+// Spreads the 3-byte groups in the low 12 bytes of `in` over 4 bytes each,
+// leaving one 6-bit base64 index per byte (Wojciech Muła's method).
+SSE41_TARGET inline __m128i Base64SplitSSE(__m128i in) {
+  in = _mm_shuffle_epi8(in, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7,
+                                         4, 5, 3, 4, 1, 2, 0, 1));
+  const __m128i t0 = _mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00));
+  const __m128i t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+  const __m128i t2 = _mm_and_si128(in, _mm_set1_epi32(0x003f03f0));
+  const __m128i t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+  return _mm_or_si128(t1, t3);
+}
+
+// Maps 6-bit indices to the standard base64 alphabet by adding a per-range
+// offset looked up with pshufb.
+SSE41_TARGET inline __m128i Base64TranslateSSE(__m128i indices) {
+  const __m128i shift_lut = _mm_setr_epi8(
+      'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+      '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62,
+      '/' - 63, 'A', 0, 0);
+  __m128i reduced = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+  const __m128i less = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+  reduced = _mm_or_si128(reduced, _mm_and_si128(less, _mm_set1_epi8(13)));
+  return _mm_add_epi8(_mm_shuffle_epi8(shift_lut, reduced), indices);
+}
+
+// Signed byte compares; bytes >= 0x80 are negative and never in range.
+SSE41_TARGET inline __m128i InRangeSSE(__m128i c, char lo, char hi) {
+  return _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8(lo - 1)),
+                       _mm_cmpgt_epi8(_mm_set1_epi8(hi + 1), c));
+}
+
+// Maps base64 characters of either alphabet to their 6-bit values. Returns
+// false if any byte is something else.
+SSE41_TARGET inline bool Base64ValuesSSE(__m128i c, __m128i* values) {
+  const __m128i upper = InRangeSSE(c, 'A', 'Z');
+  const __m128i lower = InRangeSSE(c, 'a', 'z');
+  const __m128i digit = InRangeSSE(c, '0', '9');
+  const __m128i v62 = _mm_or_si128(_mm_cmpeq_epi8(c, _mm_set1_epi8('+')),
+                                   _mm_cmpeq_epi8(c, _mm_set1_epi8('-')));
+  const __m128i v63 = _mm_or_si128(_mm_cmpeq_epi8(c, _mm_set1_epi8('/')),
+                                   _mm_cmpeq_epi8(c, _mm_set1_epi8('_')));
+  const __m128i valid = _mm_or_si128(_mm_or_si128(upper, lower),
+                                     _mm_or_si128(_mm_or_si128(digit, v62),
+                                                  v63));
+  if (_mm_movemask_epi8(valid) != 0xffff)
+    return false;
+
+  __m128i shift = _mm_and_si128(upper, _mm_set1_epi8(-'A'));
+  shift = _mm_or_si128(shift, _mm_and_si128(lower, _mm_set1_epi8(26 - 'a')));
+  shift = _mm_or_si128(shift, _mm_and_si128(digit, _mm_set1_epi8(52 - '0')));
+  __m128i v = _mm_add_epi8(c, shift);
+  v = _mm_blendv_epi8(v, _mm_set1_epi8(62), v62);
+  v = _mm_blendv_epi8(v, _mm_set1_epi8(63), v63);
+  *values = v;
+  return true;
+}
+
+// Packs 16 6-bit values into 12 bytes, in the low 12 bytes of the result.
+SSE41_TARGET inline __m128i Base64PackSSE(__m128i values) {
+  const __m128i merged =
+      _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+  const __m128i packed = _mm_madd_epi16(merged, _mm_set1_epi32(0x00011000));
+  return _mm_shuffle_epi8(packed, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9,
+                                                8, 14, 13, 12, -1, -1, -1, -1));
+}
+
+// Maps hex digits of either case to their values. Returns false if any byte
+// is something else.
+SSE41_TARGET inline bool HexValuesSSE(__m128i c, __m128i* values) {
+  const __m128i digit = _mm_sub_epi8(c, _mm_set1_epi8('0'));
+  const __m128i letter = _mm_sub_epi8(_mm_or_si128(c, _mm_set1_epi8(0x20)),
+                                      _mm_set1_epi8('a'));
+  const __m128i is_digit =
+      _mm_and_si128(_mm_cmpgt_epi8(digit, _mm_set1_epi8(-1)),
+                    _mm_cmpgt_epi8(_mm_set1_epi8(10), digit));
+  const __m128i is_letter =
+      _mm_and_si128(_mm_cmpgt_epi8(letter, _mm_set1_epi8(-1)),
+                    _mm_cmpgt_epi8(_mm_set1_epi8(6), letter));
+  if (_mm_movemask_epi8(_mm_or_si128(is_digit, is_letter)) != 0xffff)
+    return false;
+  *values = _mm_or_si128(
+      _mm_and_si128(is_digit, digit),
+      _mm_and_si128(is_letter, _mm_add_epi8(letter, _mm_set1_epi8(10))));
+  return true;
+}
+
+SSE41_TARGET size_t Base64EncodeSSE41(const char* src, size_t slen,
+                                      char* dst) {
+  size_t i = 0;
+  size_t k = 0;
+  // Each step reads 16 bytes but only consumes 12 of them.
+  while (i + 16 <= slen) {
+    const __m128i in =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    const __m128i out = Base64TranslateSSE(Base64SplitSSE(in));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + k), out);
+    i += 12;
+    k += 16;
+  }
+  return i;
+}
+
+SSE41_TARGET size_t Base64DecodeSSE41(const char* src, size_t slen,
+                                      char* dst, size_t dlen) {
+  size_t i = 0;
+  size_t k = 0;
+  while (i + 16 <= slen && k + 12 <= dlen) {
+    const __m128i in =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    __m128i values;
+    if (!Base64ValuesSSE(in, &values))
+      break;
+    // Store exactly the 12 decoded bytes; the caller's buffer past the
+    // decoded data must stay untouched.
+    const __m128i out = Base64PackSSE(values);
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + k), out);
+    const int32_t tail = _mm_extract_epi32(out, 2);
+    memcpy(dst + k + 8, &tail, sizeof(tail));
+    i += 16;
+    k += 12;
+  }
+  return i;
+}
+
+SSE41_TARGET size_t HexEncodeSSE41(const char* src, size_t slen, char* dst) {
+  const __m128i lut = _mm_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7',
+                                    '8', '9', 'a', 'b', 'c', 'd', 'e', 'f');
+  const __m128i mask = _mm_set1_epi8(0x0f);
+  size_t i = 0;
+  for (; i + 16 <= slen; i += 16) {
+    const __m128i in =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    const __m128i hi =
+        _mm_shuffle_epi8(lut, _mm_and_si128(_mm_srli_epi16(in, 4), mask));
+    const __m128i lo = _mm_shuffle_epi8(lut, _mm_and_si128(in, mask));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 2 * i),
+                     _mm_unpacklo_epi8(hi, lo));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 2 * i + 16),
+                     _mm_unpackhi_epi8(hi, lo));
+  }
+  return i;
+}
+
+SSE41_TARGET size_t HexDecodeSSE41(const char* src, size_t slen,
+                                   char* dst, size_t dlen) {
+  const __m128i weights = _mm_set1_epi16(0x0110);
+  size_t i = 0;
+  size_t k = 0;
+  while (i + 32 <= slen && k + 16 <= dlen) {
+    __m128i a;
+    __m128i b;
+    if (!HexValuesSSE(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)), &a) ||
+        !HexValuesSSE(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 16)),
+            &b)) {
+      break;
+    }
+    const __m128i out = _mm_packus_epi16(_mm_maddubs_epi16(a, weights),
+                                         _mm_maddubs_epi16(b, weights));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + k), out);
+    i += 32;
+    k += 16;
+  }
+  return i;
+}
+
+// The AVX2 kernels run the SSE4.1 algorithms on both 128-bit lanes at once.
+
+AVX2_TARGET inline __m256i Base64SplitAVX2(__m256i in) {
+  in = _mm256_shuffle_epi8(in, _mm256_set_epi8(
+      10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1,
+      10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+  const __m256i t0 = _mm256_and_si256(in, _mm256_set1_epi32(0x0fc0fc00));
+  const __m256i t1 = _mm256_mulhi_epu16(t0, _mm256_set1_epi32(0x04000040));
+  const __m256i t2 = _mm256_and_si256(in, _mm256_set1_epi32(0x003f03f0));
+  const __m256i t3 = _mm256_mullo_epi16(t2, _mm256_set1_epi32(0x01000010));
+  return _mm256_or_si256(t1, t3);
+}
+
+AVX2_TARGET inline __m256i Base64TranslateAVX2(__m256i indices) {
+  const __m256i shift_lut = _mm256_setr_epi8(
+      'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+      '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62,
+      '/' - 63, 'A', 0, 0,
+      'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+      '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62,
+      '/' - 63, 'A', 0, 0);
+  __m256i reduced = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+  const __m256i less = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices);
+  reduced =
+      _mm256_or_si256(reduced, _mm256_and_si256(less, _mm256_set1_epi8(13)));
+  return _mm256_add_epi8(_mm256_shuffle_epi8(shift_lut, reduced), indices);
+}
+
+AVX2_TARGET inline __m256i InRangeAVX2(__m256i c, char lo, char hi) {
+  return _mm256_and_si256(_mm256_cmpgt_epi8(c, _mm256_set1_epi8(lo - 1)),
+                          _mm256_cmpgt_epi8(_mm256_set1_epi8(hi + 1), c));
+}
+
+AVX2_TARGET inline bool Base64ValuesAVX2(__m256i c, __m256i* values) {
+  const __m256i upper = InRangeAVX2(c, 'A', 'Z');
+  const __m256i lower = InRangeAVX2(c, 'a', 'z');
+  const __m256i digit = InRangeAVX2(c, '0', '9');
+  const __m256i v62 =
+      _mm256_or_si256(_mm256_cmpeq_epi8(c, _mm256_set1_epi8('+')),
+                      _mm256_cmpeq_epi8(c, _mm256_set1_epi8('-')));
+  const __m256i v63 =
+      _mm256_or_si256(_mm256_cmpeq_epi8(c, _mm256_set1_epi8('/')),
+                      _mm256_cmpeq_epi8(c, _mm256_set1_epi8('_')));
+  const __m256i valid =
+      _mm256_or_si256(_mm256_or_si256(upper, lower),
+                      _mm256_or_si256(_mm256_or_si256(digit, v62), v63));
+  if (_mm256_movemask_epi8(valid) != -1)
+    return false;
+
+  __m256i shift = _mm256_and_si256(upper, _mm256_set1_epi8(-'A'));
+  shift = _mm256_or_si256(
+      shift, _mm256_and_si256(lower, _mm256_set1_epi8(26 - 'a')));
+  shift = _mm256_or_si256(
+      shift, _mm256_and_si256(digit, _mm256_set1_epi8(52 - '0')));
+  __m256i v = _mm256_add_epi8(c, shift);
+  v = _mm256_blendv_epi8(v, _mm256_set1_epi8(62), v62);
+  v = _mm256_blendv_epi8(v, _mm256_set1_epi8(63), v63);
+  *values = v;
+  return true;
+}
+
+// Packs 32 6-bit values into 24 bytes, in the low 24 bytes of the result.
+AVX2_TARGET inline __m256i Base64PackAVX2(__m256i values) {
+  const __m256i merged =
+      _mm256_maddubs_epi16(values, _mm256_set1_epi32(0x01400140));
+  const __m256i packed =
+      _mm256_madd_epi16(merged, _mm256_set1_epi32(0x00011000));
+  const __m256i shuffled = _mm256_shuffle_epi8(packed, _mm256_setr_epi8(
+      2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+      2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+  return _mm256_permutevar8x32_epi32(shuffled,
+                                     _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7));
+}
+
+AVX2_TARGET inline bool HexValuesAVX2(__m256i c, __m256i* values) {
+  const __m256i digit = _mm256_sub_epi8(c, _mm256_set1_epi8('0'));
+  const __m256i letter = _mm256_sub_epi8(
+      _mm256_or_si256(c, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+  const __m256i is_digit =
+      _mm256_and_si256(_mm256_cmpgt_epi8(digit, _mm256_set1_epi8(-1)),
+                       _mm256_cmpgt_epi8(_mm256_set1_epi8(10), digit));
+  const __m256i is_letter =
+      _mm256_and_si256(_mm256_cmpgt_epi8(letter, _mm256_set1_epi8(-1)),
+                       _mm256_cmpgt_epi8(_mm256_set1_epi8(6), letter));
+  if (_mm256_movemask_epi8(_mm256_or_si256(is_digit, is_letter)) != -1)
+    return false;
+  *values = _mm256_or_si256(
+      _mm256_and_si256(is_digit, digit),
+      _mm256_and_si256(is_letter,
+                       _mm256_add_epi8(letter, _mm256_set1_epi8(10))));
+  return true;
+}
+
+AVX2_TARGET size_t Base64EncodeAVX2(const char* src, size_t slen, char* dst) {
+  size_t i = 0;
+  size_t k = 0;
+  // Each step reads 28 bytes but only consumes 24 of them.
+  while (i + 28 <= slen) {
+    const __m128i lo =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    const __m128i hi =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 12));
+    const __m256i in = _mm256_inserti128_si256(_mm256_castsi128_si256(lo),
+                                               hi, 1);
+    const __m256i out = Base64TranslateAVX2(Base64SplitAVX2(in));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + k), out);
+    i += 24;
+    k += 32;
+  }
+  return i + Base64EncodeSSE41(src + i, slen - i, dst + k);
+}
+
+AVX2_TARGET size_t Base64DecodeAVX2(const char* src, size_t slen,
+                                    char* dst, size_t dlen) {
+  size_t i = 0;
+  size_t k = 0;
+  while (i + 32 <= slen && k + 24 <= dlen) {
+    const __m256i in =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+    __m256i values;
+    if (!Base64ValuesAVX2(in, &values))
+      break;
+    // Store exactly the 24 decoded bytes, as above.
+    const __m256i out = Base64PackAVX2(values);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + k),
+                     _mm256_castsi256_si128(out));
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + k + 16),
+                     _mm256_extracti128_si256(out, 1));
+    i += 32;
+    k += 24;
+  }
+  return i + Base64DecodeSSE41(src + i, slen - i, dst + k, dlen - k);
+}
+
+AVX2_TARGET size_t HexEncodeAVX2(const char* src, size_t slen, char* dst) {
+  const __m256i lut = _mm256_setr_epi8(
+      '0', '1', '2', '3', '4', '5', '6', '7',
+      '8', '9', 'a', 'b', 'c', 'd', 'e', 'f',
+      '0', '1', '2', '3', '4', '5', '6', '7',
+      '8', '9', 'a', 'b', 'c', 'd', 'e', 'f');
+  const __m256i mask = _mm256_set1_epi8(0x0f);
+  size_t i = 0;
+  for (; i + 32 <= slen; i += 32) {
+    const __m256i in =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+    const __m256i hi = _mm256_shuffle_epi8(
+        lut, _mm256_and_si256(_mm256_srli_epi16(in, 4), mask));
+    const __m256i lo = _mm256_shuffle_epi8(lut, _mm256_and_si256(in, mask));
+    // The unpacks interleave within each 128-bit lane only.
+    const __m256i first = _mm256_unpacklo_epi8(hi, lo);
+    const __m256i second = _mm256_unpackhi_epi8(hi, lo);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + 2 * i),
+                        _mm256_permute2x128_si256(first, second, 0x20));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + 2 * i + 32),
+                        _mm256_permute2x128_si256(first, second, 0x31));
+  }
+  return i + HexEncodeSSE41(src + i, slen - i, dst + 2 * i);
+}
+
+AVX2_TARGET size_t HexDecodeAVX2(const char* src, size_t slen,
+                                 char* dst, size_t dlen) {
+  const __m256i weights = _mm256_set1_epi16(0x0110);
+  size_t i = 0;
+  size_t k = 0;
+  while (i + 64 <= slen && k + 32 <= dlen) {
+    __m256i a;
+    __m256i b;
+    if (!HexValuesAVX2(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i)),
+            &a) ||
+        !HexValuesAVX2(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i + 32)),
+            &b)) {
+      break;
+    }
+    // packus works per 128-bit lane; restore the order of the 64-bit halves.
+    const __m256i packed =
+        _mm256_packus_epi16(_mm256_maddubs_epi16(a, weights),
+                            _mm256_maddubs_epi16(b, weights));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + k),
+                        _mm256_permute4x64_epi64(packed, 0xd8));
+    i += 64;
+    k += 32;
+  }
+  return i + HexDecodeSSE41(src + i, slen - i, dst + k, dlen - k);
+}
+
+#elif defined(NODE_SIMD_CODECS_NEON)
+
+const uint8_t kBase64Table[64] = {
+  'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H', 'I', 'J', 'K', 'L', 'M',
+  'N', 'O', 'P', 'Q', 'R', 'S', 'T', 'U', 'V', 'W', 'X', 'Y', 'Z',
+  'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h', 'i', 'j', 'k', 'l', 'm',
+  'n', 'o', 'p', 'q', 'r', 's', 't', 'u', 'v', 'w', 'x', 'y', 'z',
+  '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', '+', '/'
+};
+
+const uint8_t kHexTable[16] = {
+  '0', '1', '2', '3', '4', '5', '6', '7',
+  '8', '9', 'a', 'b', 'c', 'd', 'e', 'f'
+};
+
+// Maps base64 characters of either alphabet to their 6-bit values and
+// clears bytes of `valid` for anything else.
+inline uint8x16_t Base64ValuesNEON(uint8x16_t c, uint8x16_t* valid) {
+  const uint8x16_t upper = vsubq_u8(c, vdupq_n_u8('A'));
+  const uint8x16_t lower = vsubq_u8(c, vdupq_n_u8('a'));
+  const uint8x16_t digit = vsubq_u8(c, vdupq_n_u8('0'));
+  const uint8x16_t is_upper = vcltq_u8(upper, vdupq_n_u8(26));
+  const uint8x16_t is_lower = vcltq_u8(lower, vdupq_n_u8(26));
+  const uint8x16_t is_digit = vcltq_u8(digit, vdupq_n_u8(10));
+  const uint8x16_t is_62 = vorrq_u8(vceqq_u8(c, vdupq_n_u8('+')),
+                                    vceqq_u8(c, vdupq_n_u8('-')));
+  const uint8x16_t is_63 = vorrq_u8(vceqq_u8(c, vdupq_n_u8('/')),
+                                    vceqq_u8(c, vdupq_n_u8('_')));
+  *valid = vandq_u8(*valid,
+                    vorrq_u8(vorrq_u8(is_upper, is_lower),
+                             vorrq_u8(vorrq_u8(is_digit, is_62), is_63)));
+  uint8x16_t v = vandq_u8(is_upper, upper);
+  v = vorrq_u8(v, vandq_u8(is_lower, vaddq_u8(lower, vdupq_n_u8(26))));
+  v = vorrq_u8(v, vandq_u8(is_digit, vaddq_u8(digit, vdupq_n_u8(52))));
+  v = vorrq_u8(v, vandq_u8(is_62, vdupq_n_u8(62)));
+  v = vorrq_u8(v, vandq_u8(is_63, vdupq_n_u8(63)));
+  return v;
+}
+
+// Maps hex digits of either case to their values and clears bytes of
+// `valid` for anything else.
+inline uint8x16_t HexValuesNEON(uint8x16_t c, uint8x16_t* valid) {
+  const uint8x16_t digit = vsubq_u8(c, vdupq_n_u8('0'));
+  const uint8x16_t letter =
+      vsubq_u8(vorrq_u8(c, vdupq_n_u8(0x20)), vdupq_n_u8('a'));
+  const uint8x16_t is_digit = vcltq_u8(digit, vdupq_n_u8(10));
+  const uint8x16_t is_letter = vcltq_u8(letter, vdupq_n_u8(6));
+  *valid = vandq_u8(*valid, vorrq_u8(is_digit, is_letter));
+  return vorrq_u8(vandq_u8(is_digit, digit),
+                  vandq_u8(is_letter, vaddq_u8(letter, vdupq_n_u8(10))));
+}
+
+size_t Base64EncodeNEON(const char* src, size_t slen, char* dst) {
+  uint8x16x4_t table;
+  table.val[0] = vld1q_u8(kBase64Table);
+  table.val[1] = vld1q_u8(kBase64Table + 16);
+  table.val[2] = vld1q_u8(kBase64Table + 32);
+  table.val[3] = vld1q_u8(kBase64Table + 48);
+  const uint8x16_t mask = vdupq_n_u8(0x3f);
+  size_t i = 0;
+  size_t k = 0;
+  for (; i + 48 <= slen; i += 48, k += 64) {
+    // De-interleaving load: val[n] holds byte n of every 3-byte group.
+    const uint8x16x3_t in =
+        vld3q_u8(reinterpret_cast<const uint8_t*>(src + i));
+    uint8x16x4_t out;
+    out.val[0] = vshrq_n_u8(in.val[0], 2);
+    out.val[1] = vandq_u8(vorrq_u8(vshlq_n_u8(in.val[0], 4),
+                                   vshrq_n_u8(in.val[1], 4)), mask);
+    out.val[2] = vandq_u8(vorrq_u8(vshlq_n_u8(in.val[1], 2),
+                                   vshrq_n_u8(in.val[2], 6)), mask);
+    out.val[3] = vandq_u8(in.val[2], mask);
+    for (int n = 0; n < 4; n++)
+      out.val[n] = vqtbl4q_u8(table, out.val[n]);
+    vst4q_u8(reinterpret_cast<uint8_t*>(dst + k), out);
+  }
+  return i;
+}
+
+size_t Base64DecodeNEON(const char* src, size_t slen, char* dst, size_t dlen) {
+  size_t i = 0;
+  size_t k = 0;
+  for (; i + 64 <= slen && k + 48 <= dlen; i += 64, k += 48) {
+    const uint8x16x4_t in =
+        vld4q_u8(reinterpret_cast<const uint8_t*>(src + i));
+    uint8x16_t valid = vdupq_n_u8(0xff);
+    const uint8x16_t a = Base64ValuesNEON(in.val[0], &valid);
+    const uint8x16_t b = Base64ValuesNEON(in.val[1], &valid);
+    const uint8x16_t c = Base64ValuesNEON(in.val[2], &valid);
+    const uint8x16_t d = Base64ValuesNEON(in.val[3], &valid);
+    if (vminvq_u8(valid) != 0xff)
+      break;
+    uint8x16x3_t out;
+    out.val[0] = vorrq_u8(vshlq_n_u8(a, 2), vshrq_n_u8(b, 4));
+    out.val[1] = vorrq_u8(vshlq_n_u8(b, 4), vshrq_n_u8(c, 2));
+    out.val[2] = vorrq_u8(vshlq_n_u8(c, 6), d);
+    vst3q_u8(reinterpret_cast<uint8_t*>(dst + k), out);
+  }
+  return i;
+}
+
+size_t HexEncodeNEON(const char* src, size_t slen, char* dst) {
+  const uint8x16_t lut = vld1q_u8(kHexTable);
+  const uint8x16_t mask = vdupq_n_u8(0x0f);
+  size_t i = 0;
+  for (; i + 16 <= slen; i += 16) {
+    const uint8x16_t in = vld1q_u8(reinterpret_cast<const uint8_t*>(src + i));
+    uint8x16x2_t out;
+    out.val[0] = vqtbl1q_u8(lut, vshrq_n_u8(in, 4));
+    out.val[1] = vqtbl1q_u8(lut, vandq_u8(in, mask));
+    vst2q_u8(reinterpret_cast<uint8_t*>(dst + 2 * i), out);
+  }
+  return i;
+}
+
+size_t HexDecodeNEON(const char* src, size_t slen, char* dst, size_t dlen) {
+  size_t i = 0;
+  size_t k = 0;
+  for (; i + 32 <= slen && k + 16 <= dlen; i += 32, k += 16) {
+    // De-interleaving load: val[0] holds the high and val[1] the low nibbles.
+    const uint8x16x2_t in =
+        vld2q_u8(reinterpret_cast<const uint8_t*>(src + i));
+    uint8x16_t valid = vdupq_n_u8(0xff);
+    const uint8x16_t hi = HexValuesNEON(in.val[0], &valid);
+    const uint8x16_t lo = HexValuesNEON(in.val[1], &valid);
+    if (vminvq_u8(valid) != 0xff)
+      break;
+    vst1q_u8(reinterpret_cast<uint8_t*>(dst + k),
+             vorrq_u8(vshlq_n_u8(hi, 4), lo));
+  }
+  return i;
+}
+
+#endif  // defined(NODE_SIMD_CODECS_NEON)
+
+struct Kernels {
+  size_t (*base64_encode)(const char*, size_t, char*);
+  size_t (*base64_decode)(const char*, size_t, char*, size_t);
+  size_t (*hex_encode)(const char*, size_t, char*);
+  size_t (*hex_decode)(const char*, size_t, char*, size_t);
+};
+
+Kernels SelectKernels() {
+#if defined(NODE_SIMD_CODECS_X86)
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) {
+    return Kernels { Base64EncodeAVX2, Base64DecodeAVX2,
+                     HexEncodeAVX2, HexDecodeAVX2 };
+  }
+  if (__builtin_cpu_supports("sse4.1")) {
+    return Kernels { Base64EncodeSSE41, Base64DecodeSSE41,
+                     HexEncodeSSE41, HexDecodeSSE41 };
+  }
+#elif defined(NODE_SIMD_CODECS_NEON)
+  // Advanced SIMD is a mandatory part of AArch64.
+  return Kernels { Base64EncodeNEON, Base64DecodeNEON,
+                   HexEncodeNEON, HexDecodeNEON };
+#endif
+  return Kernels { NoBase64Encode, NoBase64Decode, NoHexEncode, NoHexDecode };
+}
+
+const Kernels kernels = SelectKernels();
+
+}  // anonymous namespace
+
+size_t Base64Encode(const char* src, size_t slen, char* dst) {
+  return kernels.base64_encode(src, slen, dst);
+}
+
+size_t Base64Decode(const char* src, size_t slen, char* dst, size_t dlen) {
+  return kernels.base64_decode(src, slen, dst, dlen);
+}
+
+size_t HexEncode(const char* src, size_t slen, char* dst) {
+  return kernels.hex_encode(src, slen, dst);
+}
+
+size_t HexDecode(const char* src, size_t slen, char* dst, size_t dlen) {
+  return kernels.hex_decode(src, slen, dst, dlen);
+}
+
+}  // namespace simd
+}  // namespace node
@@ -0,0 +1,44 @@
+#ifndef SRC_SIMD_CODECS_H_
+#define SRC_SIMD_CODECS_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include <cstddef>
+
+namespace node {
+namespace simd {
+
+// Vectorized bulk kernels for the base64 and hex codecs in base64.h and
+// string_bytes.cc. The implementation (SSE4.1, AVX2 or NEON) is picked once
+// at startup based on what the CPU supports; without any of them every
+// function consumes nothing.
+//
+// Each function only handles a prefix of the input in whole vector blocks
+// and returns how much of it was consumed. The caller finishes the rest with
+// the scalar code, which also owns all error, whitespace and padding
+// handling: the decoders stop in front of the first block that contains
+// anything other than plain alphabet characters. Only the bytes that are
+// actually produced are written to `dst`.
+
+// Consumes a multiple of 3 bytes of `src` and writes 4/3 as many characters
+// to `dst`.
+size_t Base64Encode(const char* src, size_t slen, char* dst);
+
+// Accepts both the standard and the URL-safe alphabet. Consumes a multiple
+// of 4 characters of `src`, writes 3/4 as many bytes to `dst` and never
+// writes at or past dst[dlen].
+size_t Base64Decode(const char* src, size_t slen, char* dst, size_t dlen);
+
+// Consumes bytes of `src` and writes twice as many characters to `dst`.
+size_t HexEncode(const char* src, size_t slen, char* dst);
+
+// Consumes an even number of characters of `src`, writes half as many bytes
+// to `dst` and never writes at or past dst[dlen].
+size_t HexDecode(const char* src, size_t slen, char* dst, size_t dlen);
+
+}  // namespace simd
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#endif  // SRC_SIMD_CODECS_H_
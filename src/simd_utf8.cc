@@ -0,0 +1,511 @@
+#include "simd_utf8.h"
+
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define NODE_SIMD_UTF8_X86 1
+#include <immintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define NODE_SIMD_UTF8_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace node {
+namespace simd {
+
+namespace {
+
+size_t AsciiPrefixLengthScalar(const char* src, size_t len) {
+  size_t i = 0;
+  for (; i + sizeof(uint64_t) <= len; i += sizeof(uint64_t)) {
+    uint64_t word;
+    memcpy(&word, src + i, sizeof(word));
+    if (word & 0x8080808080808080ull)
+      break;
+  }
+  while (i < len && !(src[i] & 0x80))
+    i++;
+  return i;
+}
+
+// Table 3-7 "Well-Formed UTF-8 Byte Sequences" of the Unicode standard.
+bool IsValidUtf8Scalar(const char* src, size_t len) {
+  const uint8_t* s = reinterpret_cast<const uint8_t*>(src);
+  size_t i = 0;
+  while (i < len) {
+    const uint8_t c = s[i];
+    if (c < 0x80) {
+      i++;
+      continue;
+    }
+    size_t n;
+    uint8_t lo = 0x80;
+    uint8_t hi = 0xbf;
+    if (c >= 0xc2 && c <= 0xdf) {
+      n = 1;
+    } else if (c >= 0xe0 && c <= 0xef) {
+      n = 2;
+      if (c == 0xe0) lo = 0xa0;
+      if (c == 0xed) hi = 0x9f;
+    } else if (c >= 0xf0 && c <= 0xf4) {
+      n = 3;
+      if (c == 0xf0) lo = 0x90;
+      if (c == 0xf4) hi = 0x8f;
+    } else {
+      return false;
+    }
+    if (len - i - 1 < n)
+      return false;
+    if (s[i + 1] < lo || s[i + 1] > hi)
+      return false;
+    for (size_t j = 2; j <= n; j++) {
+      if ((s[i + j] & 0xc0) != 0x80)
+        return false;
+    }
+    i += n + 1;
+  }
+  return true;
+}
+
+// Decodes the well-formed sequence at src[*i].
+inline void DecodeSequence(const uint8_t* src, size_t* i,
+                           uint16_t* dst, size_t* k) {
+  const uint32_t c = src[*i];
+  if (c < 0x80) {
+    dst[(*k)++] = c;
+    *i += 1;
+  } else if (c < 0xe0) {
+    dst[(*k)++] = ((c & 0x1f) << 6) | (src[*i + 1] & 0x3f);
+    *i += 2;
+  } else if (c < 0xf0) {
+    dst[(*k)++] = ((c & 0x0f) << 12) |
+                  ((src[*i + 1] & 0x3f) << 6) |
+                  (src[*i + 2] & 0x3f);
+    *i += 3;
+  } else {
+    const uint32_t code_point = ((c & 0x07) << 18) |
+                                ((src[*i + 1] & 0x3f) << 12) |
+                                ((src[*i + 2] & 0x3f) << 6) |
+                                (src[*i + 3] & 0x3f);
+    dst[(*k)++] = 0xd800 + ((code_point - 0x10000) >> 10);
+    dst[(*k)++] = 0xdc00 + (code_point & 0x3ff);
+    *i += 4;
+  }
+}
+
+size_t Utf8ToUtf16Scalar(const char* src, size_t len, uint16_t* dst) {
+  const uint8_t* s = reinterpret_cast<const uint8_t*>(src);
+  size_t i = 0;
+  size_t k = 0;
+  while (i < len)
+    DecodeSequence(s, &i, dst, &k);
+  return k;
+}
+
+#if defined(NODE_SIMD_UTF8_X86) || defined(NODE_SIMD_UTF8_NEON)
+
+// The validators use the lookup algorithm from "Validating UTF-8 In Less Than
+// One Instruction Per Byte" by John Keiser and Daniel Lemire. Each byte is
+// classified together with the byte before it through three 16-entry tables,
+// indexed by the high and low nibble of the previous byte and the high nibble
+// of the current byte. Every error class is one bit, and an error is present
+// if some bit survives in all three lookups. Whether a byte has to be the
+// second or third continuation byte is checked separately.
+enum : uint8_t {
+  kTooShort = 1 << 0,     // 11______ 0_______ or 11______ 11______
+  kTooLong = 1 << 1,      // 0_______ 10______
+  kOverlong3 = 1 << 2,    // 11100000 100_____
+  kTooLarge = 1 << 3,     // 11110100 1001____ or 11110100 101_____ and up
+  kSurrogate = 1 << 4,    // 11101101 101_____
+  kOverlong2 = 1 << 5,    // 1100000_ 10______
+  kTooLarge1000 = 1 << 6,  // 11110101 1000____ and up
+  kOverlong4 = 1 << 6,    // 11110000 1000____
+  kTwoConts = 1 << 7,     // 10______ 10______
+  kCarry = kTooShort | kTooLong | kTwoConts
+};
+
+#define PREV_HIGH_NIBBLE_TABLE                                                \
+  kTooLong, kTooLong, kTooLong, kTooLong,                                     \
+  kTooLong, kTooLong, kTooLong, kTooLong,                                     \
+  kTwoConts, kTwoConts, kTwoConts, kTwoConts,                                 \
+  kTooShort | kOverlong2,                                                     \
+  kTooShort,                                                                  \
+  kTooShort | kOverlong3 | kSurrogate,                                        \
+  kTooShort | kTooLarge | kTooLarge1000 | kOverlong4
+
+#define PREV_LOW_NIBBLE_TABLE                                                 \
+  kCarry | kOverlong3 | kOverlong2 | kOverlong4,                              \
+  kCarry | kOverlong2,                                                        \
+  kCarry,                                                                     \
+  kCarry,                                                                     \
+  kCarry | kTooLarge,                                                         \
+  kCarry | kTooLarge | kTooLarge1000,                                         \
+  kCarry | kTooLarge | kTooLarge1000,                                         \
+  kCarry | kTooLarge | kTooLarge1000,                                         \
+  kCarry | kTooLarge | kTooLarge1000,                                         \
+  kCarry | kTooLarge | kTooLarge1000,                                         \
+  kCarry | kTooLarge | kTooLarge1000,                                         \
+  kCarry | kTooLarge | kTooLarge1000,                                         \
+  kCarry | kTooLarge | kTooLarge1000,                                         \
+  kCarry | kTooLarge | kTooLarge1000 | kSurrogate,                            \
+  kCarry | kTooLarge | kTooLarge1000,                                         \
+  kCarry | kTooLarge | kTooLarge1000
+
+#define CUR_HIGH_NIBBLE_TABLE                                                 \
+  kTooShort, kTooShort, kTooShort, kTooShort,                                 \
+  kTooShort, kTooShort, kTooShort, kTooShort,                                 \
+  kTooLong | kOverlong2 | kTwoConts | kOverlong3 |                            \
+      kTooLarge1000 | kOverlong4,                                             \
+  kTooLong | kOverlong2 | kTwoConts | kOverlong3 | kTooLarge,                 \
+  kTooLong | kOverlong2 | kTwoConts | kSurrogate | kTooLarge,                 \
+  kTooLong | kOverlong2 | kTwoConts | kSurrogate | kTooLarge,                 \
+  kTooShort, kTooShort, kTooShort, kTooShort
+
+// A block ending in one of these must be followed by continuation bytes:
+// anything at or above 0xf0, 0xe0 or 0xc0 in the last three positions.
+#define INCOMPLETE_MAX_TAIL 0xef, 0xdf, 0xbf
+
+#endif  // defined(NODE_SIMD_UTF8_X86) || defined(NODE_SIMD_UTF8_NEON)
+
+#if defined(NODE_SIMD_UTF8_X86)
+
+#define SSE41_TARGET __attribute__((target("sse4.1")))
+#define AVX2_TARGET __attribute__((target("avx2")))
+
+// Decodes the run of non-ASCII sequences at src[*i], if any.
+inline void DecodeNonAsciiRun(const char* src, size_t len, size_t* i,
+                              uint16_t* dst, size_t* k) {
+  const uint8_t* s = reinterpret_cast<const uint8_t*>(src);
+  while (*i < len && s[*i] >= 0x80)
+    DecodeSequence(s, i, dst, k);
+}
+
+SSE41_TARGET size_t AsciiPrefixLengthSSE41(const char* src, size_t len) {
+  size_t i = 0;
+  for (; i + 16 <= len; i += 16) {
+    const int mask = _mm_movemask_epi8(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)));
+    if (mask != 0)
+      return i + __builtin_ctz(mask);
+  }
+  return i + AsciiPrefixLengthScalar(src + i, len - i);
+}
+
+SSE41_TARGET inline void CheckUtf8BlockSSE(__m128i in, __m128i* prev,
+                                           __m128i* incomplete,
+                                           __m128i* error) {
+  if (_mm_movemask_epi8(in) == 0) {
+    // An ASCII block is only an error if the previous one left a sequence
+    // unfinished.
+    *error = _mm_or_si128(*error, *incomplete);
+  } else {
+    const __m128i table1 = _mm_setr_epi8(PREV_HIGH_NIBBLE_TABLE);
+    const __m128i table2 = _mm_setr_epi8(PREV_LOW_NIBBLE_TABLE);
+    const __m128i table3 = _mm_setr_epi8(CUR_HIGH_NIBBLE_TABLE);
+    const __m128i nibble = _mm_set1_epi8(0x0f);
+    const __m128i prev1 = _mm_alignr_epi8(in, *prev, 15);
+    const __m128i prev2 = _mm_alignr_epi8(in, *prev, 14);
+    const __m128i prev3 = _mm_alignr_epi8(in, *prev, 13);
+    const __m128i special = _mm_and_si128(
+        _mm_and_si128(
+            _mm_shuffle_epi8(table1,
+                             _mm_and_si128(_mm_srli_epi16(prev1, 4), nibble)),
+            _mm_shuffle_epi8(table2, _mm_and_si128(prev1, nibble))),
+        _mm_shuffle_epi8(table3, _mm_and_si128(_mm_srli_epi16(in, 4), nibble)));
+    // Bytes two or three positions after a three or four byte lead must be
+    // continuation bytes; that is exactly where kTwoConts is expected.
+    const __m128i is_third = _mm_subs_epu8(prev2, _mm_set1_epi8(0xe0 - 0x80));
+    const __m128i is_fourth = _mm_subs_epu8(prev3, _mm_set1_epi8(0xf0 - 0x80));
+    const __m128i must_be_cont = _mm_and_si128(
+        _mm_or_si128(is_third, is_fourth), _mm_set1_epi8(0x80));
+    *error = _mm_or_si128(*error, _mm_xor_si128(must_be_cont, special));
+    *incomplete = _mm_subs_epu8(in, _mm_setr_epi8(
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        INCOMPLETE_MAX_TAIL));
+  }
+  *prev = in;
+}
+
+SSE41_TARGET bool IsValidUtf8SSE41(const char* src, size_t len) {
+  __m128i prev = _mm_setzero_si128();
+  __m128i incomplete = _mm_setzero_si128();
+  __m128i error = _mm_setzero_si128();
+  size_t i = 0;
+  for (; i + 16 <= len; i += 16) {
+    CheckUtf8BlockSSE(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)),
+        &prev, &incomplete, &error);
+  }
+  if (i < len) {
+    // Zero padding is ASCII, which also flags a truncated final sequence.
+    char tail[16] = {};
+    memcpy(tail, src + i, len - i);
+    CheckUtf8BlockSSE(_mm_loadu_si128(reinterpret_cast<const __m128i*>(tail)),
+                      &prev, &incomplete, &error);
+  }
+  error = _mm_or_si128(error, incomplete);
+  return _mm_testz_si128(error, error) != 0;
+}
+
+SSE41_TARGET size_t Utf8ToUtf16SSE41(const char* src, size_t len,
+                                     uint16_t* dst) {
+  size_t i = 0;
+  size_t k = 0;
+  while (i + 16 <= len) {
+    const __m128i in =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    // Widen all 16 bytes even if only a prefix of them is ASCII; the rest
+    // is overwritten below. k <= i, so this stays within `len` code units.
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + k),
+                     _mm_cvtepu8_epi16(in));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + k + 8),
+                     _mm_cvtepu8_epi16(_mm_srli_si128(in, 8)));
+    const int mask = _mm_movemask_epi8(in);
+    if (mask == 0) {
+      i += 16;
+      k += 16;
+      continue;
+    }
+    const int ascii = __builtin_ctz(mask);
+    i += ascii;
+    k += ascii;
+    DecodeNonAsciiRun(src, len, &i, dst, &k);
+  }
+  return k + Utf8ToUtf16Scalar(src + i, len - i, dst + k);
+}
+
+AVX2_TARGET size_t AsciiPrefixLengthAVX2(const char* src, size_t len) {
+  size_t i = 0;
+  for (; i + 32 <= len; i += 32) {
+    const uint32_t mask = _mm256_movemask_epi8(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i)));
+    if (mask != 0)
+      return i + __builtin_ctz(mask);
+  }
+  return i + AsciiPrefixLengthSSE41(src + i, len - i);
+}
+
+// prev(N) of the SSE version: `in` shifted right by N bytes across the two
+// lanes, with the last N bytes of `prev` shifted in.
+#define PREV_AVX2(in, prev, n)                                                \
+  _mm256_alignr_epi8((in), _mm256_permute2x128_si256((prev), (in), 0x21),     \
+                     16 - (n))
+
+AVX2_TARGET inline void CheckUtf8BlockAVX2(__m256i in, __m256i* prev,
+                                           __m256i* incomplete,
+                                           __m256i* error) {
+  if (_mm256_movemask_epi8(in) == 0) {
+    *error = _mm256_or_si256(*error, *incomplete);
+  } else {
+    const __m256i table1 = _mm256_setr_epi8(PREV_HIGH_NIBBLE_TABLE,
+                                            PREV_HIGH_NIBBLE_TABLE);
+    const __m256i table2 = _mm256_setr_epi8(PREV_LOW_NIBBLE_TABLE,
+                                            PREV_LOW_NIBBLE_TABLE);
+    const __m256i table3 = _mm256_setr_epi8(CUR_HIGH_NIBBLE_TABLE,
+                                            CUR_HIGH_NIBBLE_TABLE);
+    const __m256i nibble = _mm256_set1_epi8(0x0f);
+    const __m256i prev1 = PREV_AVX2(in, *prev, 1);
+    const __m256i prev2 = PREV_AVX2(in, *prev, 2);
+    const __m256i prev3 = PREV_AVX2(in, *prev, 3);
+    const __m256i special = _mm256_and_si256(
+        _mm256_and_si256(
+            _mm256_shuffle_epi8(
+                table1, _mm256_and_si256(_mm256_srli_epi16(prev1, 4), nibble)),
+            _mm256_shuffle_epi8(table2, _mm256_and_si256(prev1, nibble))),
+        _mm256_shuffle_epi8(
+            table3, _mm256_and_si256(_mm256_srli_epi16(in, 4), nibble)));
+    const __m256i is_third =
+        _mm256_subs_epu8(prev2, _mm256_set1_epi8(0xe0 - 0x80));
+    const __m256i is_fourth =
+        _mm256_subs_epu8(prev3, _mm256_set1_epi8(0xf0 - 0x80));
+    const __m256i must_be_cont = _mm256_and_si256(
+        _mm256_or_si256(is_third, is_fourth), _mm256_set1_epi8(0x80));
+    *error =
+        _mm256_or_si256(*error, _mm256_xor_si256(must_be_cont, special));
+    *incomplete = _mm256_subs_epu8(in, _mm256_setr_epi8(
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        INCOMPLETE_MAX_TAIL));
+  }
+  *prev = in;
+}
+
+#undef PREV_AVX2
+
+AVX2_TARGET bool IsValidUtf8AVX2(const char* src, size_t len) {
+  __m256i prev = _mm256_setzero_si256();
+  __m256i incomplete = _mm256_setzero_si256();
+  __m256i error = _mm256_setzero_si256();
+  size_t i = 0;
+  for (; i + 32 <= len; i += 32) {
+    CheckUtf8BlockAVX2(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i)),
+        &prev, &incomplete, &error);
+  }
+  if (i < len) {
+    char tail[32] = {};
+    memcpy(tail, src + i, len - i);
+    CheckUtf8BlockAVX2(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(tail)),
+        &prev, &incomplete, &error);
+  }
+  error = _mm256_or_si256(error, incomplete);
+  return _mm256_testz_si256(error, error) != 0;
+}
+
+AVX2_TARGET size_t Utf8ToUtf16AVX2(const char* src, size_t len,
+                                   uint16_t* dst) {
+  size_t i = 0;
+  size_t k = 0;
+  while (i + 32 <= len) {
+    const __m256i in =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + k),
+                        _mm256_cvtepu8_epi16(_mm256_castsi256_si128(in)));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + k + 16),
+                        _mm256_cvtepu8_epi16(_mm256_extracti128_si256(in, 1)));
+    const uint32_t mask = _mm256_movemask_epi8(in);
+    if (mask == 0) {
+      i += 32;
+      k += 32;
+      continue;
+    }
+    const int ascii = __builtin_ctz(mask);
+    i += ascii;
+    k += ascii;
+    DecodeNonAsciiRun(src, len, &i, dst, &k);
+  }
+  return k + Utf8ToUtf16SSE41(src + i, len - i, dst + k);
+}
+
+#elif defined(NODE_SIMD_UTF8_NEON)
+
+size_t AsciiPrefixLengthNEON(const char* src, size_t len) {
+  size_t i = 0;
+  for (; i + 16 <= len; i += 16) {
+    const uint8x16_t in = vld1q_u8(reinterpret_cast<const uint8_t*>(src + i));
+    if (vmaxvq_u8(in) >= 0x80)
+      break;
+  }
+  return i + AsciiPrefixLengthScalar(src + i, len - i);
+}
+
+inline void CheckUtf8BlockNEON(uint8x16_t in, uint8x16_t* prev,
+                               uint8x16_t* incomplete, uint8x16_t* error) {
+  if (vmaxvq_u8(in) < 0x80) {
+    *error = vorrq_u8(*error, *incomplete);
+  } else {
+    static const uint8_t kTables[3][16] = {
+      { PREV_HIGH_NIBBLE_TABLE },
+      { PREV_LOW_NIBBLE_TABLE },
+      { CUR_HIGH_NIBBLE_TABLE }
+    };
+    static const uint8_t kMaxTail[16] = {
+      0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+      0xff, INCOMPLETE_MAX_TAIL
+    };
+    const uint8x16_t nibble = vdupq_n_u8(0x0f);
+    const uint8x16_t prev1 = vextq_u8(*prev, in, 15);
+    const uint8x16_t prev2 = vextq_u8(*prev, in, 14);
+    const uint8x16_t prev3 = vextq_u8(*prev, in, 13);
+    const uint8x16_t special = vandq_u8(
+        vandq_u8(vqtbl1q_u8(vld1q_u8(kTables[0]), vshrq_n_u8(prev1, 4)),
+                 vqtbl1q_u8(vld1q_u8(kTables[1]), vandq_u8(prev1, nibble))),
+        vqtbl1q_u8(vld1q_u8(kTables[2]), vshrq_n_u8(in, 4)));
+    const uint8x16_t is_third = vqsubq_u8(prev2, vdupq_n_u8(0xe0 - 0x80));
+    const uint8x16_t is_fourth = vqsubq_u8(prev3, vdupq_n_u8(0xf0 - 0x80));
+    const uint8x16_t must_be_cont =
+        vandq_u8(vorrq_u8(is_third, is_fourth), vdupq_n_u8(0x80));
+    *error = vorrq_u8(*error, veorq_u8(must_be_cont, special));
+    *incomplete = vqsubq_u8(in, vld1q_u8(kMaxTail));
+  }
+  *prev = in;
+}
+
+bool IsValidUtf8NEON(const char* src, size_t len) {
+  uint8x16_t prev = vdupq_n_u8(0);
+  uint8x16_t incomplete = vdupq_n_u8(0);
+  uint8x16_t error = vdupq_n_u8(0);
+  size_t i = 0;
+  for (; i + 16 <= len; i += 16) {
+    CheckUtf8BlockNEON(vld1q_u8(reinterpret_cast<const uint8_t*>(src + i)),
+                       &prev, &incomplete, &error);
+  }
+  if (i < len) {
+    uint8_t tail[16] = {};
+    memcpy(tail, src + i, len - i);
+    CheckUtf8BlockNEON(vld1q_u8(tail), &prev, &incomplete, &error);
+  }
+  error = vorrq_u8(error, incomplete);
+  return vmaxvq_u8(error) == 0;
+}
+
+size_t Utf8ToUtf16NEON(const char* src, size_t len, uint16_t* dst) {
+  size_t i = 0;
+  size_t k = 0;
+  while (i + 16 <= len) {
+    const uint8x16_t in = vld1q_u8(reinterpret_cast<const uint8_t*>(src + i));
+    if (vmaxvq_u8(in) < 0x80) {
+      vst1q_u16(dst + k, vmovl_u8(vget_low_u8(in)));
+      vst1q_u16(dst + k + 8, vmovl_high_u8(in));
+      i += 16;
+      k += 16;
+      continue;
+    }
+    // Decode up to the end of this block, finishing the last sequence.
+    const uint8_t* s = reinterpret_cast<const uint8_t*>(src);
+    const size_t end = i + 16;
+    while (i < end)
+      DecodeSequence(s, &i, dst, &k);
+  }
+  return k + Utf8ToUtf16Scalar(src + i, len - i, dst + k);
+}
+
+#endif  // defined(NODE_SIMD_UTF8_NEON)
+
+#undef PREV_HIGH_NIBBLE_TABLE
+#undef PREV_LOW_NIBBLE_TABLE
+#undef CUR_HIGH_NIBBLE_TABLE
+#undef INCOMPLETE_MAX_TAIL
+
+struct Kernels {
+  size_t (*ascii_prefix_length)(const char*, size_t);
+  bool (*is_valid_utf8)(const char*, size_t);
+  size_t (*utf8_to_utf16)(const char*, size_t, uint16_t*);
+};
+
+Kernels SelectKernels() {
+#if defined(NODE_SIMD_UTF8_X86)
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) {
+    return Kernels { AsciiPrefixLengthAVX2, IsValidUtf8AVX2, Utf8ToUtf16AVX2 };
+  }
+  if (__builtin_cpu_supports("sse4.1")) {
+    return Kernels { AsciiPrefixLengthSSE41, IsValidUtf8SSE41,
+                     Utf8ToUtf16SSE41 };
+  }
+#elif defined(NODE_SIMD_UTF8_NEON)
+  return Kernels { AsciiPrefixLengthNEON, IsValidUtf8NEON, Utf8ToUtf16NEON };
+#endif
+  return Kernels { AsciiPrefixLengthScalar, IsValidUtf8Scalar,
+                   Utf8ToUtf16Scalar };
+}
+
+const Kernels kernels = SelectKernels();
+
+}  // anonymous namespace
+
+size_t AsciiPrefixLength(const char* src, size_t len) {
+  return kernels.ascii_prefix_length(src, len);
+}
+
+bool IsValidUtf8(const char* src, size_t len) {
+  return kernels.is_valid_utf8(src, len);
+}
+
+size_t Utf8ToUtf16(const char* src, size_t len, uint16_t* dst) {
+  return kernels.utf8_to_utf16(src, len, dst);
+}
+
+}  // namespace simd
+}  // namespace node
@@ -0,0 +1,34 @@
+#ifndef SRC_SIMD_UTF8_H_
+#define SRC_SIMD_UTF8_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include <cstddef>
+#include <cstdint>
+
+namespace node {
+namespace simd {
+
+// Vectorized UTF-8 scanning and decoding. Like the codecs in simd_codecs.h,
+// the implementation is picked once at startup; unlike them, these functions
+// always process the whole input and fall back to scalar code themselves.
+
+// Returns the length of the longest prefix of `src` that is plain ASCII.
+size_t AsciiPrefixLength(const char* src, size_t len);
+
+// Returns true if `src` is well-formed UTF-8 as defined by the Unicode
+// standard: no overlong forms, no surrogates, nothing above U+10FFFF and no
+// truncated sequence at the end.
+bool IsValidUtf8(const char* src, size_t len);
+
+// Decodes `src`, which must have passed IsValidUtf8(), to UTF-16 and returns
+// the number of code units written. `dst` must have room for `len` code units;
+// its contents past the returned length are unspecified.
+size_t Utf8ToUtf16(const char* src, size_t len, uint16_t* dst);
+
+}  // namespace simd
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#endif  // SRC_SIMD_UTF8_H_
@@ -0,0 +1,168 @@
+#include "slab_allocator.h"
+#include "node_options.h"
+#include "util-inl.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace node {
+
+using v8::ArrayBuffer;
+using v8::ArrayBufferCreationMode;
+using v8::Isolate;
+using v8::Local;
+using v8::WeakCallbackInfo;
+using v8::WeakCallbackType;
+
+namespace {
+// Number of released slabs whose memory is kept for reuse.
+constexpr size_t kMaxFreeSlabs = 4;
+// Chunks are carved at this alignment.
+constexpr size_t kChunkAlignment = 16;
+}  // anonymous namespace
+
+SlabAllocator::SlabAllocator(Isolate* isolate) : isolate_(isolate) {}
+
+SlabAllocator::~SlabAllocator() {
+  // Slabs that JS can still see are freed by their weak callback instead.
+  for (Slab* slab : slabs_) {
+    slab->allocator = nullptr;
+    slab->retired = true;
+    if (!slab->array_buffer.IsEmpty()) {
+      slab->array_buffer.SetWeak(slab, WeakCallback,
+                                 WeakCallbackType::kParameter);
+      continue;
+    }
+    free(slab->data);
+    isolate_->AdjustAmountOfExternalAllocatedMemory(
+        -static_cast<int64_t>(kSlabSize));
+    delete slab;
+  }
+
+  for (char* data : free_list_) {
+    free(data);
+    isolate_->AdjustAmountOfExternalAllocatedMemory(
+        -static_cast<int64_t>(kSlabSize));
+  }
+}
+
+uv_buf_t SlabAllocator::Allocate(size_t size) {
+  if (size == 0 || size > kSlabSize)
+    return uv_buf_init(nullptr, 0);
+
+  if (current_ != nullptr && kSlabSize - current_->used < size) {
+    Retire(current_);
+    current_ = nullptr;
+  }
+
+  if (current_ == nullptr) {
+    const bool zero_fill = per_process::cli_options->zero_fill_all_buffers;
+    char* data;
+    if (!free_list_.empty()) {
+      data = free_list_.back();
+      free_list_.pop_back();
+      if (zero_fill)
+        memset(data, 0, kSlabSize);
+    } else {
+      data = zero_fill ? UncheckedCalloc(kSlabSize)
+                       : UncheckedMalloc(kSlabSize);
+      if (data == nullptr)
+        return uv_buf_init(nullptr, 0);
+      isolate_->AdjustAmountOfExternalAllocatedMemory(kSlabSize);
+    }
+
+    current_ = new Slab();
+    current_->allocator = this;
+    current_->data = data;
+    slabs_.push_back(current_);
+  }
+
+  char* chunk = current_->data + current_->used;
+  current_->used += size;
+  current_->outstanding++;
+  return uv_buf_init(chunk, size);
+}
+
+bool SlabAllocator::Finish(const uv_buf_t& buf,
+                           ssize_t nread,
+                           Local<ArrayBuffer>* array_buffer,
+                           size_t* offset) {
+  auto it = std::find_if(slabs_.begin(), slabs_.end(), [&](Slab* slab) {
+    return buf.base >= slab->data && buf.base < slab->data + kSlabSize;
+  });
+  if (it == slabs_.end())
+    return false;
+
+  Slab* slab = *it;
+  CHECK_GT(slab->outstanding, 0);
+  slab->outstanding--;
+
+  const size_t start = buf.base - slab->data;
+  const size_t claimed =
+      nread > 0 ? RoundUp(static_cast<size_t>(nread), kChunkAlignment) : 0;
+  // Give back the unused tail if no other chunk has been carved after it.
+  if (slab == current_ && start + buf.len == slab->used)
+    slab->used = std::min(start + claimed, slab->used);
+
+  if (nread > 0) {
+    CHECK_LE(static_cast<size_t>(nread), buf.len);
+    if (slab->array_buffer.IsEmpty()) {
+      Local<ArrayBuffer> ab =
+          ArrayBuffer::New(isolate_,
+                           slab->data,
+                           kSlabSize,
+                           ArrayBufferCreationMode::kExternalized);
+      slab->array_buffer.Reset(isolate_, ab);
+      if (slab->retired) {
+        slab->array_buffer.SetWeak(slab, WeakCallback,
+                                   WeakCallbackType::kParameter);
+      }
+    }
+    *array_buffer = slab->array_buffer.Get(isolate_);
+    *offset = start;
+  }
+
+  MaybeRelease(slab);
+  return true;
+}
+
+void SlabAllocator::Retire(Slab* slab) {
+  slab->retired = true;
+  if (!slab->array_buffer.IsEmpty()) {
+    slab->array_buffer.SetWeak(slab, WeakCallback,
+                               WeakCallbackType::kParameter);
+  }
+  MaybeRelease(slab);
+}
+
+void SlabAllocator::MaybeRelease(Slab* slab) {
+  if (!slab->retired ||
+      slab->outstanding > 0 ||
+      !slab->array_buffer.IsEmpty()) {
+    return;
+  }
+
+  slabs_.erase(std::find(slabs_.begin(), slabs_.end(), slab));
+  if (free_list_.size() < kMaxFreeSlabs) {
+    free_list_.push_back(slab->data);
+  } else {
+    free(slab->data);
+    isolate_->AdjustAmountOfExternalAllocatedMemory(
+        -static_cast<int64_t>(kSlabSize));
+  }
+  delete slab;
+}
+
+void SlabAllocator::WeakCallback(const WeakCallbackInfo<Slab>& data) {
+  Slab* slab = data.GetParameter();
+  slab->array_buffer.Reset();
+  if (slab->allocator != nullptr)
+    return slab->allocator->MaybeRelease(slab);
+
+  free(slab->data);
+  data.GetIsolate()->AdjustAmountOfExternalAllocatedMemory(
+      -static_cast<int64_t>(kSlabSize));
+  delete slab;
+}
+
+}  // namespace node
@@ -0,0 +1,72 @@
+#ifndef SRC_SLAB_ALLOCATOR_H_
+#define SRC_SLAB_ALLOCATOR_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include "uv.h"
+#include "v8.h"
+
+#include <vector>
+
+namespace node {
+
+// Hands out read buffers for streams by carving them from large, fixed-size
+// slabs, so that a read does not cost a malloc(), a realloc() and a new
+// ArrayBuffer backing store of its own. Data read into a slab is passed to JS
+// as a view on one ArrayBuffer per slab.
+//
+// Every Allocate() must be paired with a Finish() for the same buffer. Only
+// the bytes that were actually read stay claimed; the rest of the chunk goes
+// back to the slab if nothing was carved after it. A slab that has been
+// filled is retired, and its memory is reused for a later slab once every
+// Buffer pointing into it has been garbage collected.
+class SlabAllocator {
+ public:
+  static constexpr size_t kSlabSize = 256 * 1024;
+
+  explicit SlabAllocator(v8::Isolate* isolate);
+  ~SlabAllocator();
+
+  SlabAllocator(const SlabAllocator&) = delete;
+  SlabAllocator& operator=(const SlabAllocator&) = delete;
+
+  // Returns a chunk of `size` bytes, or an empty buffer if the request cannot
+  // be served from a slab and the caller should allocate memory itself.
+  uv_buf_t Allocate(size_t size);
+
+  // Returns false if `buf` was not handed out by Allocate(). Otherwise,
+  // releases the unused part of the chunk and, if `nread` is positive, sets
+  // `array_buffer` and `offset` to the location of the data that was read.
+  bool Finish(const uv_buf_t& buf,
+              ssize_t nread,
+              v8::Local<v8::ArrayBuffer>* array_buffer,
+              size_t* offset);
+
+ private:
+  struct Slab {
+    SlabAllocator* allocator;
+    char* data;
+    size_t used = 0;         // Bytes carved from the start of the slab.
+    size_t outstanding = 0;  // Chunks returned by Allocate() but not Finish().
+    bool retired = false;
+    // Strong while the slab is current, weak once it is retired.
+    v8::Global<v8::ArrayBuffer> array_buffer;
+  };
+
+  void Retire(Slab* slab);
+  void MaybeRelease(Slab* slab);
+  static void WeakCallback(const v8::WeakCallbackInfo<Slab>& data);
+
+  v8::Isolate* const isolate_;
+  Slab* current_ = nullptr;
+  // All slabs that have not been released yet, including the current one.
+  std::vector<Slab*> slabs_;
+  // Memory of released slabs, kept around to avoid fresh page faults.
+  std::vector<char*> free_list_;
+};
+
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#endif  // SRC_SLAB_ALLOCATOR_H_
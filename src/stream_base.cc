@@ -7,6 +7,7 @@
 #include "node_errors.h"
 #include "env-inl.h"
 #include "js_stream.h"
+#include "slab_allocator.h"
 #include "string_bytes.h"
 #include "util-inl.h"
 #include "v8.h"
@@ -25,6 +26,7 @@ using v8::FunctionCallbackInfo;
 using v8::HandleScope;
 using v8::Integer;
 using v8::Local;
+using v8::MaybeLocal;
 using v8::Object;
 using v8::ReadOnly;
 using v8::String;
@@ -50,6 +52,15 @@ int StreamBase::ReadStopJS(const FunctionCallbackInfo<Value>& args) {
 }
 
 
+int StreamBase::UseUserBuffer(const FunctionCallbackInfo<Value>& args) {
+  CHECK(Buffer::HasInstance(args[0]));
+
+  uv_buf_t buf = uv_buf_init(Buffer::Data(args[0]), Buffer::Length(args[0]));
+  PushStreamListener(new CustomBufferJSListener(buf));
+  return 0;
+}
+
+
 int StreamBase::Shutdown(const FunctionCallbackInfo<Value>& args) {
   CHECK(args[0]->IsObject());
   Local<Object> req_wrap_obj = args[0].As<Object>();
@@ -290,19 +301,22 @@ int StreamBase::WriteString(const FunctionCallbackInfo<Value>& args) {
 }
 
 
-void StreamBase::CallJSOnreadMethod(ssize_t nread,
-                                    Local<ArrayBuffer> ab,
-                                    size_t offset) {
+MaybeLocal<Value> StreamBase::CallJSOnreadMethod(ssize_t nread,
+                                                 Local<ArrayBuffer> ab,
+                                                 size_t offset,
+                                                 StreamBaseJSChecks checks) {
   Environment* env = env_;
 
   DCHECK_EQ(static_cast<int32_t>(nread), nread);
   DCHECK_LE(offset, INT32_MAX);
 
-  if (ab.IsEmpty()) {
-    DCHECK_EQ(offset, 0);
-    DCHECK_LE(nread, 0);
-  } else {
-    DCHECK_GE(nread, 0);
+  if (checks == DONT_SKIP_NREAD_CHECKS) {
+    if (ab.IsEmpty()) {
+      DCHECK_EQ(offset, 0);
+      DCHECK_LE(nread, 0);
+    } else {
+      DCHECK_GE(nread, 0);
+    }
   }
 
   env->stream_base_state()[kReadBytesOrError] = nread;
@@ -314,7 +328,7 @@ void StreamBase::CallJSOnreadMethod(ssize_t nread,
 
   AsyncWrap* wrap = GetAsyncWrap();
   CHECK_NOT_NULL(wrap);
-  wrap->MakeCallback(env->onread_string(), arraysize(argv), argv);
+  return wrap->MakeCallback(env->onread_string(), arraysize(argv), argv);
 }
 
 
@@ -328,6 +342,16 @@ int StreamBase::GetFD() {
 }
 
 
+fs::FileHandle* StreamBase::GetFileHandle() {
+  return nullptr;
+}
+
+
+bool StreamBase::HasQueuedWrites() {
+  return false;
+}
+
+
 Local<Object> StreamBase::GetObject() {
   return GetAsyncWrap()->object();
 }
@@ -362,6 +386,8 @@ void StreamBase::AddMethods(Environment* env, Local<FunctionTemplate> t) {
       env, sig, attributes, t, GetBytesWritten, env->bytes_written_string());
   env->SetProtoMethod(t, "readStart", JSMethod<&StreamBase::ReadStartJS>);
   env->SetProtoMethod(t, "readStop", JSMethod<&StreamBase::ReadStopJS>);
+  env->SetProtoMethod(
+      t, "useUserBuffer", JSMethod<&StreamBase::UseUserBuffer>);
   env->SetProtoMethod(t, "shutdown", JSMethod<&StreamBase::Shutdown>);
   env->SetProtoMethod(t, "writev", JSMethod<&StreamBase::Writev>);
   env->SetProtoMethod(t, "writeBuffer", JSMethod<&StreamBase::WriteBuffer>);
@@ -441,6 +467,9 @@ void StreamResource::ClearError() {
 uv_buf_t EmitToJSStreamListener::OnStreamAlloc(size_t suggested_size) {
   CHECK_NOT_NULL(stream_);
   Environment* env = static_cast<StreamBase*>(stream_)->stream_env();
+  uv_buf_t buf = env->read_slab_allocator()->Allocate(suggested_size);
+  if (buf.base != nullptr)
+    return buf;
   return env->AllocateManaged(suggested_size).release();
 }
 
@@ -450,6 +479,17 @@ void EmitToJSStreamListener::OnStreamRead(ssize_t nread, const uv_buf_t& buf_) {
   Environment* env = stream->stream_env();
   HandleScope handle_scope(env->isolate());
   Context::Scope context_scope(env->context());
+
+  Local<ArrayBuffer> ab;
+  size_t offset = 0;
+  if (env->read_slab_allocator()->Finish(buf_, nread, &ab, &offset)) {
+    if (nread > 0)
+      stream->CallJSOnreadMethod(nread, ab, offset);
+    else if (nread < 0)
+      stream->CallJSOnreadMethod(nread, Local<ArrayBuffer>());
+    return;
+  }
+
   AllocatedBuffer buf(env, buf_);
 
   if (nread <= 0)  {
@@ -465,6 +505,32 @@ void EmitToJSStreamListener::OnStreamRead(ssize_t nread, const uv_buf_t& buf_) {
 }
 
 
+uv_buf_t CustomBufferJSListener::OnStreamAlloc(size_t suggested_size) {
+  return buffer_;
+}
+
+void CustomBufferJSListener::OnStreamRead(ssize_t nread, const uv_buf_t& buf) {
+  CHECK_NOT_NULL(stream_);
+
+  StreamBase* stream = static_cast<StreamBase*>(stream_);
+  Environment* env = stream->stream_env();
+  HandleScope handle_scope(env->isolate());
+  Context::Scope context_scope(env->context());
+
+  // The data is already where JS expects it; only nread needs to be passed.
+  MaybeLocal<Value> ret =
+      stream->CallJSOnreadMethod(nread,
+                                 Local<ArrayBuffer>(),
+                                 0,
+                                 StreamBase::SKIP_NREAD_CHECKS);
+  Local<Value> next_buf_v;
+  if (ret.ToLocal(&next_buf_v) && Buffer::HasInstance(next_buf_v)) {
+    buffer_.base = Buffer::Data(next_buf_v);
+    buffer_.len = Buffer::Length(next_buf_v);
+  }
+}
+
+
 void ReportWritesToJSStreamListener::OnStreamAfterReqFinished(
     StreamReq* req_wrap, int status) {
   StreamBase* stream = static_cast<StreamBase*>(stream_);
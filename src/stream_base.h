@@ -18,6 +18,10 @@ class WriteWrap;
 class StreamBase;
 class StreamResource;
 
+namespace fs {
+class FileHandle;
+}  // namespace fs
+
 struct StreamWriteResult {
   bool async;
   int err;
@@ -180,6 +184,23 @@ class EmitToJSStreamListener : public ReportWritesToJSStreamListener {
 };
 
 
+// An emitter that reads into a buffer supplied by JS land and only reports
+// the number of bytes read, so no new Buffer is created per chunk. The value
+// returned by the JS .onread method, if it is a buffer, is used for the next
+// read.
+class CustomBufferJSListener : public ReportWritesToJSStreamListener {
+ public:
+  explicit CustomBufferJSListener(uv_buf_t buffer) : buffer_(buffer) {}
+
+  uv_buf_t OnStreamAlloc(size_t suggested_size) override;
+  void OnStreamRead(ssize_t nread, const uv_buf_t& buf) override;
+  void OnStreamDestroy() override { delete this; }
+
+ private:
+  uv_buf_t buffer_;
+};
+
+
 // A generic stream, comparable to JS land’s `Duplex` streams.
 // A stream is always controlled through one `StreamListener` instance.
 class StreamResource {
@@ -268,10 +289,21 @@ class StreamBase : public StreamResource {
   virtual bool IsClosing() = 0;
   virtual bool IsIPCPipe();
   virtual int GetFD();
-
-  void CallJSOnreadMethod(ssize_t nread,
-                          v8::Local<v8::ArrayBuffer> ab,
-                          size_t offset = 0);
+  // Returns the FileHandle behind this stream if it reads from a file, which
+  // lets StreamPipe move the data with sendfile(2).
+  virtual fs::FileHandle* GetFileHandle();
+  // Returns true if data written to this stream has not reached the fd
+  // returned by GetFD() yet, so that writing to the fd directly, like
+  // StreamPipe does with sendfile(2), would reorder it.
+  virtual bool HasQueuedWrites();
+
+  enum StreamBaseJSChecks { DONT_SKIP_NREAD_CHECKS, SKIP_NREAD_CHECKS };
+
+  v8::MaybeLocal<v8::Value> CallJSOnreadMethod(
+      ssize_t nread,
+      v8::Local<v8::ArrayBuffer> ab,
+      size_t offset = 0,
+      StreamBaseJSChecks checks = DONT_SKIP_NREAD_CHECKS);
 
   // This is named `stream_env` to avoid name clashes, because a lot of
   // subclasses are also `BaseObject`s.
@@ -314,6 +346,7 @@ class StreamBase : public StreamResource {
   // JS Methods
   int ReadStartJS(const v8::FunctionCallbackInfo<v8::Value>& args);
   int ReadStopJS(const v8::FunctionCallbackInfo<v8::Value>& args);
+  int UseUserBuffer(const v8::FunctionCallbackInfo<v8::Value>& args);
   int Shutdown(const v8::FunctionCallbackInfo<v8::Value>& args);
   int Writev(const v8::FunctionCallbackInfo<v8::Value>& args);
   int WriteBuffer(const v8::FunctionCallbackInfo<v8::Value>& args);
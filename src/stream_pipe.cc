@@ -1,6 +1,10 @@
 #include "stream_pipe.h"
 #include "stream_base-inl.h"
 #include "node_buffer.h"
+#include "node_file.h"
+#if HAVE_OPENSSL
+#include "tls_wrap.h"
+#endif
 
 using v8::Context;
 using v8::Function;
@@ -24,7 +28,26 @@ StreamPipe::StreamPipe(StreamBase* source,
   source->PushStreamListener(&readable_listener_);
   sink->PushStreamListener(&writable_listener_);
 
-  CHECK(sink->HasWantsWrite());
+#ifdef __linux__
+  // Other platforms emulate sendfile(2) for sockets in a way that blocks the
+  // threadpool while the sink is full. The provider check rules out sinks
+  // like TLSWrap that report the fd of a stream they transform data for,
+  // unless the kernel does the encryption for it.
+  fs::FileHandle* file = source->GetFileHandle();
+  AsyncWrap::ProviderType sink_type = sink->GetAsyncWrap()->provider_type();
+  if (file != nullptr && file->CanSendFile() &&
+      (sink_type == AsyncWrap::PROVIDER_TCPWRAP ||
+       sink_type == AsyncWrap::PROVIDER_PIPEWRAP)) {
+    use_sendfile_ = sink->GetFD() >= 0;
+  }
+#if HAVE_OPENSSL
+  if (file != nullptr && file->CanSendFile() &&
+      sink_type == AsyncWrap::PROVIDER_TLSWRAP &&
+      static_cast<TLSWrap*>(sink)->HasKernelTLS()) {
+    use_sendfile_ = sink->GetFD() >= 0;
+  }
+#endif
+#endif
 
   // Set up links between this object and the source/sink objects.
   // In particular, this makes sure that they are garbage collected as a group,
@@ -59,11 +82,15 @@ void StreamPipe::Unpipe() {
   // Note that we possibly cannot use virtual methods on `source` and `sink`
   // here, because this function can be called from their destructors via
   // `OnStreamDestroy()`.
-  if (!source_destroyed_)
+  if (!source_destroyed_) {
     source()->ReadStop();
+    if (is_sending_file_)
+      source()->GetFileHandle()->CancelSendFile();
+  }
 
   is_closed_ = true;
   is_reading_ = false;
+  is_sending_file_ = false;
   source()->RemoveStreamListener(&readable_listener_);
   sink()->RemoveStreamListener(&writable_listener_);
 
@@ -137,9 +164,65 @@ void StreamPipe::ReadableListener::OnStreamRead(ssize_t nread,
     return;
   }
 
+  // A buffered chunk in sendfile mode only bridges a full sink, go back to
+  // sendfile(2) once it has been written.
+  if (pipe->use_sendfile_) {
+    pipe->is_reading_ = false;
+    stream()->ReadStop();
+  }
+
   pipe->ProcessData(nread, std::move(buf));
 }
 
+void StreamPipe::ReadSource() {
+  is_reading_ = true;
+  if (use_sendfile_)
+    SendFile();
+  else
+    source()->ReadStart();
+}
+
+void StreamPipe::SendFile() {
+  // Anything written to the sink before, like HTTP headers, has to reach the
+  // socket ahead of the file. Until it has, take the buffered path.
+  if (sink()->HasQueuedWrites()) {
+    source()->ReadStart();
+    return;
+  }
+
+  fs::FileHandle* file = source()->GetFileHandle();
+  int err = file->SendFile(sink()->GetFD(), kSendFileChunkSize,
+                           AfterSendFile, this);
+  if (err == 0) {
+    is_sending_file_ = true;
+  } else {
+    readable_listener_.OnStreamRead(err, uv_buf_init(nullptr, 0));
+  }
+}
+
+void StreamPipe::AfterSendFile(ssize_t result, void* data) {
+  StreamPipe* pipe = static_cast<StreamPipe*>(data);
+  pipe->is_sending_file_ = false;
+
+  HandleScope handle_scope(pipe->env()->isolate());
+  Context::Scope context_scope(pipe->env()->context());
+
+  if (result == UV_EAGAIN) {
+    // The sink is full. Let the next chunk take the buffered path, which
+    // queues the write in libuv until the sink is writable again.
+    AsyncScope async_scope(pipe);
+    pipe->source()->ReadStart();
+    return;
+  }
+
+  if (result < 0) {
+    pipe->readable_listener_.OnStreamRead(result, uv_buf_init(nullptr, 0));
+    return;
+  }
+
+  pipe->SendFile();
+}
+
 void StreamPipe::ProcessData(size_t nread, AllocatedBuffer&& buf) {
   uv_buf_t buffer = uv_buf_init(buf.data(), nread);
   StreamWriteResult res = sink()->Write(&buffer, 1);
@@ -176,6 +259,11 @@ void StreamPipe::WritableListener::OnStreamAfterWrite(WriteWrap* w,
     prev->OnStreamAfterWrite(w, status);
     return;
   }
+
+  // Without `OnStreamWantsWrite()`, a completed write is the signal that the
+  // sink can take more data.
+  if (!pipe->sink()->HasWantsWrite())
+    OnStreamWantsWrite(pipe->wanted_data_);
 }
 
 void StreamPipe::WritableListener::OnStreamAfterShutdown(ShutdownWrap* w,
@@ -208,8 +296,7 @@ void StreamPipe::WritableListener::OnStreamWantsWrite(size_t suggested_size) {
   if (pipe->is_reading_ || pipe->is_closed_)
     return;
   AsyncScope async_scope(pipe);
-  pipe->is_reading_ = true;
-  pipe->source()->ReadStart();
+  pipe->ReadSource();
 }
 
 uv_buf_t StreamPipe::WritableListener::OnStreamAlloc(size_t suggested_size) {
@@ -237,6 +324,8 @@ void StreamPipe::Start(const FunctionCallbackInfo<Value>& args) {
   StreamPipe* pipe;
   ASSIGN_OR_RETURN_UNWRAP(&pipe, args.Holder());
   pipe->is_closed_ = false;
+  if (!pipe->sink()->HasWantsWrite())
+    pipe->wanted_data_ = kDefaultChunkSize;
   if (pipe->wanted_data_ > 0)
     pipe->writable_listener_.OnStreamWantsWrite(pipe->wanted_data_);
 }
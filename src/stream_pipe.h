@@ -27,6 +27,9 @@ class StreamPipe : public AsyncWrap {
   inline StreamBase* sink();
 
   inline void ShutdownWritable();
+  void ReadSource();
+  void SendFile();
+  static void AfterSendFile(ssize_t result, void* data);
 
   bool is_reading_ = false;
   bool is_writing_ = false;
@@ -41,6 +44,20 @@ class StreamPipe : public AsyncWrap {
   // `OnStreamWantsWrite()` support.
   size_t wanted_data_ = 0;
 
+  // Sinks without `OnStreamWantsWrite()` support get chunks of this size.
+  static constexpr size_t kDefaultChunkSize = 64 * 1024;
+  // Length of every sendfile(2) call, see `use_sendfile_`. Sinks with an fd
+  // don't size their requests, so this is large enough to keep threadpool
+  // round trips rare and small enough not to tie up a thread for long.
+  static constexpr size_t kSendFileChunkSize = 1024 * 1024;
+
+  // When the source is a file and the sink a socket or pipe, the data is
+  // handed to the kernel with sendfile(2) instead of being read into a
+  // buffer and written out again. When the sink is full, the next chunk goes
+  // through the buffered path, which waits for the sink to drain.
+  bool use_sendfile_ = false;
+  bool is_sending_file_ = false;
+
   void ProcessData(size_t nread, AllocatedBuffer&& buf);
 
   class ReadableListener : public StreamListener {
@@ -33,6 +33,7 @@
 
 #include <cstring>  // memcpy()
 #include <climits>  // INT_MAX
+#include <memory>
 
 
 namespace node {
@@ -127,6 +128,31 @@ LibuvStreamWrap::LibuvStreamWrap(Environment* env,
 }
 
 
+// Lets a scheduled flush find out whether its stream is gone by now.
+struct LibuvStreamWrap::FlushRequest {
+  LibuvStreamWrap* wrap;
+};
+
+
+struct LibuvStreamWrap::FailedWrites {
+  LibuvStreamWrap* wrap;
+  std::vector<std::pair<WriteWrap*, int>> writes;
+};
+
+
+LibuvStreamWrap::~LibuvStreamWrap() {
+  if (flush_request_ != nullptr)
+    flush_request_->wrap = nullptr;
+  if (failed_writes_ != nullptr) {
+    // Nobody is left to report the failures to.
+    for (const auto& write : failed_writes_->writes)
+      write.first->Dispose();
+    failed_writes_->writes.clear();
+    failed_writes_->wrap = nullptr;
+  }
+}
+
+
 Local<FunctionTemplate> LibuvStreamWrap::GetConstructorTemplate(
     Environment* env) {
   Local<FunctionTemplate> tmpl = env->libuv_stream_wrap_ctor_template();
@@ -292,7 +318,8 @@ void LibuvStreamWrap::GetWriteQueueSize(
     return;
   }
 
-  uint32_t write_queue_size = wrap->stream()->write_queue_size;
+  uint32_t write_queue_size =
+      wrap->stream()->write_queue_size + wrap->coalesced_bytes_;
   info.GetReturnValue().Set(write_queue_size);
 }
 
@@ -321,7 +348,82 @@ WriteWrap* LibuvStreamWrap::CreateWriteWrap(Local<Object> object) {
 }
 
 
+void LibuvStreamWrap::Close(Local<Value> close_callback) {
+  // Pending writes are handed to libuv first, which fails whatever it cannot
+  // write before the handle is closed with UV_ECANCELED, as before.
+  FlushWrites();
+  HandleWrap::Close(close_callback);
+}
+
+
+void LibuvStreamWrap::set_coalesce_writes(bool coalesce) {
+  coalesce_writes_ = coalesce;
+  if (!coalesce)
+    FlushWrites();
+}
+
+
+bool LibuvStreamWrap::ShouldCoalesce(size_t bytes) {
+  if (!coalesce_writes_ || !is_tcp() || IsClosing())
+    return false;
+  return !coalesced_writes_.empty() || bytes < kCoalesceThreshold;
+}
+
+
+void LibuvStreamWrap::FlushWrites() {
+  if (coalesced_writes_.empty())
+    return;
+
+  std::vector<WriteWrap*> batch;
+  std::vector<uv_buf_t> bufs;
+  batch.swap(coalesced_writes_);
+  bufs.swap(coalesced_bufs_);
+  coalesced_bytes_ = 0;
+
+  LibuvWriteWrap* carrier = static_cast<LibuvWriteWrap*>(batch.back());
+  batch.pop_back();
+  int err = carrier->Dispatch(uv_write2,
+                              stream(),
+                              bufs.data(),
+                              bufs.size(),
+                              nullptr,
+                              AfterUvWrite);
+  if (err != 0) {
+    // uv_write2() only fails synchronously if the stream cannot be written
+    // to at all, e.g. after it was shut down.
+    batch.push_back(carrier);
+    FailWrites(batch, err);
+    return;
+  }
+
+  if (!batch.empty())
+    flushed_batches_.emplace_back(carrier, std::move(batch));
+}
+
+
+void LibuvStreamWrap::FailWrites(const std::vector<WriteWrap*>& batch,
+                                 int status) {
+  if (failed_writes_ == nullptr) {
+    failed_writes_ = new FailedWrites { this, {} };
+    env()->SetImmediate([](Environment* env, void* data) {
+      std::unique_ptr<FailedWrites> failed(static_cast<FailedWrites*>(data));
+      if (failed->wrap == nullptr)
+        return;
+      failed->wrap->failed_writes_ = nullptr;
+      HandleScope scope(env->isolate());
+      Context::Scope context_scope(env->context());
+      for (const auto& write : failed->writes)
+        write.first->Done(write.second);
+    }, failed_writes_);
+  }
+
+  for (WriteWrap* w : batch)
+    failed_writes_->writes.emplace_back(w, status);
+}
+
+
 int LibuvStreamWrap::DoShutdown(ShutdownWrap* req_wrap_) {
+  FlushWrites();
   LibuvShutdownWrap* req_wrap = static_cast<LibuvShutdownWrap*>(req_wrap_);
   return req_wrap->Dispatch(uv_shutdown, stream(), AfterUvShutdown);
 }
@@ -347,6 +449,13 @@ int LibuvStreamWrap::DoTryWrite(uv_buf_t** bufs, size_t* count) {
   uv_buf_t* vbufs = *bufs;
   size_t vcount = *count;
 
+  // Leave the data to DoWrite(), which adds it to the next flush.
+  size_t total_bytes = 0;
+  for (size_t i = 0; i < vcount; i++)
+    total_bytes += vbufs[i].len;
+  if (ShouldCoalesce(total_bytes))
+    return 0;
+
   err = uv_try_write(stream(), vbufs, vcount);
   if (err == UV_ENOSYS || err == UV_EAGAIN)
     return 0;
@@ -381,6 +490,36 @@ int LibuvStreamWrap::DoWrite(WriteWrap* req_wrap,
                              uv_buf_t* bufs,
                              size_t count,
                              uv_stream_t* send_handle) {
+  size_t total_bytes = 0;
+  for (size_t i = 0; i < count; i++)
+    total_bytes += bufs[i].len;
+
+  if (send_handle == nullptr && ShouldCoalesce(total_bytes)) {
+    if (coalesced_bytes_ + total_bytes >= kCoalesceThreshold)
+      FlushWrites();
+
+    if (total_bytes < kCoalesceThreshold) {
+      coalesced_writes_.push_back(req_wrap);
+      coalesced_bufs_.insert(coalesced_bufs_.end(), bufs, bufs + count);
+      coalesced_bytes_ += total_bytes;
+
+      if (flush_request_ == nullptr) {
+        flush_request_ = new FlushRequest { this };
+        env()->SetImmediate([](Environment* env, void* data) {
+          std::unique_ptr<FlushRequest> req(static_cast<FlushRequest*>(data));
+          if (req->wrap == nullptr)
+            return;
+          req->wrap->flush_request_ = nullptr;
+          req->wrap->FlushWrites();
+        }, flush_request_);
+      }
+      return 0;
+    }
+  } else {
+    // Keep the order of writes.
+    FlushWrites();
+  }
+
   LibuvWriteWrap* w = static_cast<LibuvWriteWrap*>(req_wrap);
   return w->Dispatch(uv_write2,
                      stream(),
@@ -398,6 +537,16 @@ void LibuvStreamWrap::AfterUvWrite(uv_write_t* req, int status) {
   CHECK_NOT_NULL(req_wrap);
   HandleScope scope(req_wrap->env()->isolate());
   Context::Scope context_scope(req_wrap->env()->context());
+
+  LibuvStreamWrap* wrap = static_cast<LibuvStreamWrap*>(req_wrap->stream());
+  auto& batches = wrap->flushed_batches_;
+  if (!batches.empty() && batches.front().first == req_wrap) {
+    std::vector<WriteWrap*> batch = std::move(batches.front().second);
+    batches.pop_front();
+    for (WriteWrap* w : batch)
+      w->Done(status);
+  }
+
   req_wrap->Done(status);
 }
 
@@ -31,6 +31,10 @@
 #include "string_bytes.h"
 #include "v8.h"
 
+#include <deque>
+#include <utility>
+#include <vector>
+
 namespace node {
 
 class LibuvStreamWrap : public HandleWrap, public StreamBase {
@@ -77,6 +81,20 @@ class LibuvStreamWrap : public HandleWrap, public StreamBase {
   ShutdownWrap* CreateShutdownWrap(v8::Local<v8::Object> object) override;
   WriteWrap* CreateWriteWrap(v8::Local<v8::Object> object) override;
 
+  void Close(
+      v8::Local<v8::Value> close_callback = v8::Local<v8::Value>()) override;
+
+  // Small writes to TCP sockets are not passed to libuv right away. All
+  // writes issued within the same tick are handed over as a single uv_write()
+  // once the loop reaches the check phase, or as soon as kCoalesceThreshold
+  // bytes have piled up. Turning this off flushes anything that is pending.
+  static constexpr size_t kCoalesceThreshold = 64 * 1024;
+  void set_coalesce_writes(bool coalesce);
+
+  bool HasQueuedWrites() override {
+    return stream()->write_queue_size > 0 || !coalesced_writes_.empty();
+  }
+
   static LibuvStreamWrap* From(Environment* env, v8::Local<v8::Object> object);
 
  protected:
@@ -84,6 +102,7 @@ class LibuvStreamWrap : public HandleWrap, public StreamBase {
                   v8::Local<v8::Object> object,
                   uv_stream_t* stream,
                   AsyncWrap::ProviderType provider);
+  ~LibuvStreamWrap() override;
 
   AsyncWrap* GetAsyncWrap() override;
 
@@ -110,8 +129,28 @@ class LibuvStreamWrap : public HandleWrap, public StreamBase {
   static void AfterUvWrite(uv_write_t* req, int status);
   static void AfterUvShutdown(uv_shutdown_t* req, int status);
 
+  bool ShouldCoalesce(size_t bytes);
+  void FlushWrites();
+  void FailWrites(const std::vector<WriteWrap*>& batch, int status);
+
   uv_stream_t* const stream_;
 
+  // Writes waiting for the next flush, and the buffers they cover.
+  bool coalesce_writes_ = true;
+  std::vector<WriteWrap*> coalesced_writes_;
+  std::vector<uv_buf_t> coalesced_bufs_;
+  size_t coalesced_bytes_ = 0;
+  // A flushed batch is written with the uv_write_t of its last request; the
+  // other requests are completed along with it.
+  std::deque<std::pair<WriteWrap*, std::vector<WriteWrap*>>> flushed_batches_;
+  struct FlushRequest;
+  FlushRequest* flush_request_ = nullptr;
+  // Requests of batches that libuv refused. They are completed from an
+  // immediate, because a flush can happen while JS is in the middle of a
+  // write or shutdown.
+  struct FailedWrites;
+  FailedWrites* failed_writes_ = nullptr;
+
 #ifdef _WIN32
   // We don't always have an FD that we could look up on the stream_
   // object itself on Windows. However, for some cases, we open handles
@@ -25,6 +25,8 @@
 #include "env-inl.h"
 #include "node_buffer.h"
 #include "node_errors.h"
+#include "simd_codecs.h"
+#include "simd_utf8.h"
 #include "util.h"
 
 #include <climits>
@@ -244,13 +246,32 @@ static inline unsigned unhex(uint8_t x) {
   return unhex_table[x];
 }
 
+// Only plain char input is handed to the vector decoder; other code unit
+// types always take the scalar path.
+static inline size_t hex_decode_simd(char* buf,
+                                     size_t len,
+                                     const char* src,
+                                     const size_t srcLen) {
+  return simd::HexDecode(src, srcLen, buf, len) / 2;
+}
+
+template <typename TypeName>
+static inline size_t hex_decode_simd(char* buf,
+                                     size_t len,
+                                     const TypeName* src,
+                                     const size_t srcLen) {
+  return 0;
+}
+
 template <typename TypeName>
 static size_t hex_decode(char* buf,
                          size_t len,
                          const TypeName* src,
                          const size_t srcLen) {
   size_t i;
-  for (i = 0; i < len && i * 2 + 1 < srcLen; ++i) {
+  for (i = hex_decode_simd(buf, len, src, srcLen);
+       i < len && i * 2 + 1 < srcLen;
+       ++i) {
     unsigned a = unhex(src[i * 2 + 0]);
     unsigned b = unhex(src[i * 2 + 1]);
     if (!~a || !~b)
@@ -365,6 +386,14 @@ size_t StringBytes::Write(Isolate* isolate,
       if (str->IsExternalOneByte()) {
         auto ext = str->GetExternalOneByteStringResource();
         nbytes = base64_decode(buf, buflen, ext->data(), ext->length());
+      } else if (str->IsOneByte()) {
+        MaybeStackBuffer<char> value(str->Length());
+        str->WriteOneByte(isolate,
+                          reinterpret_cast<uint8_t*>(*value),
+                          0,
+                          value.length(),
+                          flags);
+        nbytes = base64_decode(buf, buflen, *value, value.length());
       } else {
         String::Value value(isolate, str);
         nbytes = base64_decode(buf, buflen, *value, value.length());
@@ -376,6 +405,14 @@ size_t StringBytes::Write(Isolate* isolate,
       if (str->IsExternalOneByte()) {
         auto ext = str->GetExternalOneByteStringResource();
         nbytes = hex_decode(buf, buflen, ext->data(), ext->length());
+      } else if (str->IsOneByte()) {
+        MaybeStackBuffer<char> value(str->Length());
+        str->WriteOneByte(isolate,
+                          reinterpret_cast<uint8_t*>(*value),
+                          0,
+                          value.length(),
+                          flags);
+        nbytes = hex_decode(buf, buflen, *value, value.length());
       } else {
         String::Value value(isolate, str);
         nbytes = hex_decode(buf, buflen, *value, value.length());
@@ -493,54 +530,8 @@ Maybe<size_t> StringBytes::Size(Isolate* isolate,
 
 
 
-static bool contains_non_ascii_slow(const char* buf, size_t len) {
-  for (size_t i = 0; i < len; ++i) {
-    if (buf[i] & 0x80)
-      return true;
-  }
-  return false;
-}
-
-
 static bool contains_non_ascii(const char* src, size_t len) {
-  if (len < 16) {
-    return contains_non_ascii_slow(src, len);
-  }
-
-  const unsigned bytes_per_word = sizeof(uintptr_t);
-  const unsigned align_mask = bytes_per_word - 1;
-  const unsigned unaligned = reinterpret_cast<uintptr_t>(src) & align_mask;
-
-  if (unaligned > 0) {
-    const unsigned n = bytes_per_word - unaligned;
-    if (contains_non_ascii_slow(src, n))
-      return true;
-    src += n;
-    len -= n;
-  }
-
-
-#if defined(_WIN64) || defined(_LP64)
-  const uintptr_t mask = 0x8080808080808080ll;
-#else
-  const uintptr_t mask = 0x80808080l;
-#endif
-
-  const uintptr_t* srcw = reinterpret_cast<const uintptr_t*>(src);
-
-  for (size_t i = 0, n = len / bytes_per_word; i < n; ++i) {
-    if (srcw[i] & mask)
-      return true;
-  }
-
-  const unsigned remainder = len & align_mask;
-  if (remainder > 0) {
-    const size_t offset = len - remainder;
-    if (contains_non_ascii_slow(src + offset, remainder))
-      return true;
-  }
-
-  return false;
+  return simd::AsciiPrefixLength(src, len) != len;
 }
 
 
@@ -602,7 +593,8 @@ static size_t hex_encode(const char* src, size_t slen, char* dst, size_t dlen) {
       "not enough space provided for hex encode");
 
   dlen = slen * 2;
-  for (uint32_t i = 0, k = 0; k < dlen; i += 1, k += 2) {
+  const size_t n = simd::HexEncode(src, slen, dst);
+  for (size_t i = n, k = n * 2; k < dlen; i += 1, k += 2) {
     static const char hex[] = "0123456789abcdef";
     uint8_t val = static_cast<uint8_t>(src[i]);
     dst[k + 0] = hex[val >> 4];
@@ -663,7 +655,42 @@ MaybeLocal<Value> StringBytes::Encode(Isolate* isolate,
         return ExternOneByteString::NewFromCopy(isolate, buf, buflen, error);
       }
 
-    case UTF8:
+    case UTF8: {
+      // Well-formed input is decoded here, which keeps ASCII runs on the
+      // vector path. Anything else is left to V8, which owns the semantics
+      // of replacement characters.
+      const size_t ascii = simd::AsciiPrefixLength(buf, buflen);
+      if (ascii == buflen)
+        return ExternOneByteString::NewFromCopy(isolate, buf, buflen, error);
+
+      if (simd::IsValidUtf8(buf + ascii, buflen - ascii)) {
+        if (buflen < EXTERN_APEX) {
+          // V8 narrows this to a one-byte string where possible.
+          MaybeStackBuffer<uint16_t> out(buflen);
+          const size_t length = simd::Utf8ToUtf16(buf, buflen, *out);
+          return ExternTwoByteString::NewFromCopy(isolate, *out, length, error);
+        }
+
+        uint16_t* out = node::UncheckedMalloc<uint16_t>(buflen);
+        if (out == nullptr) {
+          *error = node::ERR_MEMORY_ALLOCATION_FAILED(isolate);
+          return MaybeLocal<Value>();
+        }
+        const size_t length = simd::Utf8ToUtf16(buf, buflen, out);
+        if (!std::all_of(out, out + length,
+                         [](uint16_t c) { return c <= 0xff; })) {
+          return ExternTwoByteString::New(isolate, out, length, error);
+        }
+        // Latin-1 text keeps the compact one-byte representation, which V8
+        // does not do for external strings by itself.
+        char* narrow = reinterpret_cast<char*>(out);
+        for (size_t i = 0; i < length; i++)
+          narrow[i] = static_cast<char>(out[i]);
+        if (char* shrunk = node::UncheckedRealloc(narrow, length))
+          narrow = shrunk;
+        return ExternOneByteString::New(isolate, narrow, length, error);
+      }
+
       val = String::NewFromUtf8(isolate,
                                 buf,
                                 v8::NewStringType::kNormal,
@@ -673,6 +700,7 @@ MaybeLocal<Value> StringBytes::Encode(Isolate* isolate,
         return MaybeLocal<Value>();
       }
       return val.ToLocalChecked();
+    }
 
     case LATIN1:
       return ExternOneByteString::NewFromCopy(isolate, buf, buflen, error);
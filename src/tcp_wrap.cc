@@ -129,6 +129,7 @@ void TCPWrap::Initialize(Local<Object> target,
   NODE_DEFINE_CONSTANT(constants, SOCKET);
   NODE_DEFINE_CONSTANT(constants, SERVER);
   NODE_DEFINE_CONSTANT(constants, UV_TCP_IPV6ONLY);
+  NODE_DEFINE_CONSTANT(constants, UV_TCP_REUSEPORT);
   target->Set(context,
               env->constants_string(),
               constants).FromJust();
@@ -177,6 +178,9 @@ void TCPWrap::SetNoDelay(const FunctionCallbackInfo<Value>& args) {
                           args.GetReturnValue().Set(UV_EBADF));
   int enable = static_cast<int>(args[0]->IsTrue());
   int err = uv_tcp_nodelay(&wrap->handle_, enable);
+  // Sockets that ask for no delay should not wait for the tick to end either.
+  if (err == 0)
+    wrap->set_coalesce_writes(!enable);
   args.GetReturnValue().Set(err);
 }
 
@@ -239,10 +243,7 @@ void TCPWrap::Bind(
   int port;
   unsigned int flags = 0;
   if (!args[1]->Int32Value(env->context()).To(&port)) return;
-  if (family == AF_INET6 &&
-      !args[2]->Uint32Value(env->context()).To(&flags)) {
-    return;
-  }
+  if (!args[2]->Uint32Value(env->context()).To(&flags)) return;
 
   T addr;
   int err = uv_ip_addr(*ip_address, port, &addr);
@@ -26,6 +26,9 @@
 #include "node_crypto_bio.h"  // NodeBIO
 // ClientHelloParser
 #include "node_crypto_clienthello-inl.h"
+#include "node_crypto_ktls.h"
+#include "node_errors.h"
+#include "node_internals.h"  // ThreadPoolWork
 #include "stream_base-inl.h"
 #include "util-inl.h"
 
@@ -40,6 +43,7 @@ using v8::Exception;
 using v8::Function;
 using v8::FunctionCallbackInfo;
 using v8::FunctionTemplate;
+using v8::Global;
 using v8::Isolate;
 using v8::Local;
 using v8::Object;
@@ -119,6 +123,10 @@ void TLSWrap::InitSSL() {
   // - https://wiki.openssl.org/index.php/TLS1.3#Non-application_data_records
   SSL_set_mode(ssl_.get(), SSL_MODE_AUTO_RETRY);
 
+  // See StartAsyncKeyOperation().
+  if (is_server() && sc_->async_private_key_)
+    SSL_set_mode(ssl_.get(), SSL_MODE_ASYNC);
+
   SSL_set_app_data(ssl_.get(), this);
   // Using InfoCallback isn't how we are supposed to check handshake progress:
   //   https://github.com/openssl/openssl/issues/7199#issuecomment-420915993
@@ -232,13 +240,25 @@ void TLSWrap::SSLInfoCallback(const SSL* ssl_, int where, int ret) {
   if (where & SSL_CB_HANDSHAKE_START) {
     // Start is tracked to limit number and frequency of renegotiation attempts,
     // since excessive renegotiation may be an attack.
-    Local<Value> callback;
-
-    if (object->Get(env->context(), env->onhandshakestart_string())
-          .ToLocal(&callback) && callback->IsFunction()) {
-      Local<Value> argv[] = { env->GetNow() };
-      c->MakeCallback(callback.As<Function>(), arraysize(argv), argv);
-    }
+    auto on_handshake_start = [](Environment* env, void* data) {
+      TLSWrap* c = static_cast<TLSWrap*>(data);
+      HandleScope handle_scope(env->isolate());
+      Context::Scope context_scope(env->context());
+      Local<Value> callback;
+
+      if (c->object()->Get(env->context(), env->onhandshakestart_string())
+            .ToLocal(&callback) && callback->IsFunction()) {
+        Local<Value> argv[] = { env->GetNow() };
+        c->MakeCallback(callback.As<Function>(), arraysize(argv), argv);
+      }
+    };
+
+    // JS must not run on the stack of an OpenSSL async job, see
+    // StartAsyncKeyOperation().
+    if (ASYNC_get_current_job() != nullptr)
+      env->SetImmediate(on_handshake_start, c, object);
+    else
+      on_handshake_start(env, c);
   }
 
   // SSL_CB_HANDSHAKE_START and SSL_CB_HANDSHAKE_DONE are called
@@ -278,6 +298,11 @@ void TLSWrap::EncOut() {
   if (ssl_ == nullptr)
     return;
 
+  if (kernel_tls_) {
+    FlushKernelTLSControl();
+    return;
+  }
+
   // No encrypted output ready to write to the underlying stream.
   if (BIO_pending(enc_out_) == 0) {
     if (pending_cleartext_input_.empty()) {
@@ -352,6 +377,14 @@ void TLSWrap::OnStreamAfterWrite(WriteWrap* req_wrap, int status) {
     return;
   }
 
+  // Clear text written by DoWrite(), there is nothing to commit.
+  if (kernel_tls_) {
+    InvokeQueued(0);
+    if (!kernel_tls_control_.empty())
+      FlushKernelTLSControl();
+    return;
+  }
+
   // Commit
   crypto::NodeBIO::FromBIO(enc_out_)->Read(nullptr, write_size_);
 
@@ -361,6 +394,8 @@ void TLSWrap::OnStreamAfterWrite(WriteWrap* req_wrap, int status) {
   // Try writing more data
   write_size_ = 0;
   EncOut();
+
+  MaybeStartKernelTLS();
 }
 
 
@@ -377,6 +412,7 @@ Local<Value> TLSWrap::GetSSLError(int status, int* err, std::string* msg) {
     case SSL_ERROR_WANT_READ:
     case SSL_ERROR_WANT_WRITE:
     case SSL_ERROR_WANT_X509_LOOKUP:
+    case SSL_ERROR_WANT_ASYNC:
       return Local<Value>();
 
     case SSL_ERROR_ZERO_RETURN:
@@ -457,6 +493,12 @@ void TLSWrap::ClearOut() {
   if (ssl_ == nullptr)
     return;
 
+  if (async_key_operation_)
+    return;
+
+  MaybeStopAsyncMode();
+  LoadSNIContextForAsyncJob();
+
   crypto::MarkPopErrorOnReturn mark_pop_error_on_return;
 
   char out[kClearOutChunkSize];
@@ -464,6 +506,10 @@ void TLSWrap::ClearOut() {
   for (;;) {
     read = SSL_read(ssl_.get(), out, sizeof(out));
 
+    MaybeEmitSNIContextError();
+    if (ssl_ == nullptr)
+      return;
+
     if (read <= 0)
       break;
 
@@ -472,6 +518,10 @@ void TLSWrap::ClearOut() {
       int avail = read;
 
       uv_buf_t buf = EmitAlloc(avail);
+      if (buf.base == nullptr || buf.len == 0) {
+        EmitRead(UV_ENOBUFS);
+        return;
+      }
       if (static_cast<int>(buf.len) < avail)
         avail = buf.len;
       memcpy(buf.base, current, avail);
@@ -499,9 +549,14 @@ void TLSWrap::ClearOut() {
   // See node#1642 and SSL_read(3SSL) for details.
   if (read <= 0) {
     HandleScope handle_scope(env()->isolate());
-    int err;
+    int err = SSL_ERROR_NONE;
     Local<Value> arg = GetSSLError(read, &err, nullptr);
 
+    if (err == SSL_ERROR_WANT_ASYNC) {
+      StartAsyncKeyOperation(false);
+      return;
+    }
+
     // Ignore ZERO_RETURN after EOF, it is basically not a error
     if (err == SSL_ERROR_ZERO_RETURN && eof_)
       return;
@@ -526,6 +581,12 @@ void TLSWrap::ClearIn() {
   if (ssl_ == nullptr)
     return;
 
+  if (async_key_operation_)
+    return;
+
+  MaybeStopAsyncMode();
+  LoadSNIContextForAsyncJob();
+
   std::vector<uv_buf_t> buffers;
   buffers.swap(pending_cleartext_input_);
 
@@ -542,6 +603,10 @@ void TLSWrap::ClearIn() {
       break;
   }
 
+  MaybeEmitSNIContextError();
+  if (ssl_ == nullptr)
+    return;
+
   // All written
   if (i == buffers.size()) {
     // We wrote all the buffers, so no writes failed (written < 0 on failure).
@@ -568,6 +633,8 @@ void TLSWrap::ClearIn() {
     pending_cleartext_input_.insert(pending_cleartext_input_.end(),
                                     buffers.begin() + i,
                                     buffers.end());
+    if (err == SSL_ERROR_WANT_ASYNC)
+      StartAsyncKeyOperation(true);
   }
 
   return;
@@ -640,6 +707,24 @@ int TLSWrap::DoWrite(WriteWrap* w,
     return UV_EPROTO;
   }
 
+  // The kernel encrypts, pass the clear text through. Like with EncOut(),
+  // Done() is only called once the underlying stream is done with the data.
+  if (kernel_tls_) {
+    CHECK_NULL(current_write_);
+    StreamWriteResult res = underlying_stream()->Write(bufs, count);
+    if (res.err != 0)
+      return res.err;
+
+    current_write_ = w;
+    write_callback_scheduled_ = true;
+    if (!res.async) {
+      env()->SetImmediate([](Environment* env, void* data) {
+        static_cast<TLSWrap*>(data)->OnStreamAfterWrite(nullptr, 0);
+      }, this, object());
+    }
+    return 0;
+  }
+
   bool empty = true;
   size_t i;
   for (i = 0; i < count; i++) {
@@ -686,6 +771,17 @@ int TLSWrap::DoWrite(WriteWrap* w,
     return 0;
   }
 
+  // The handshake waits for a private key operation, leave the data to
+  // ClearIn().
+  if (async_key_operation_) {
+    pending_cleartext_input_.insert(pending_cleartext_input_.end(),
+                                    &bufs[0],
+                                    &bufs[count]);
+    return 0;
+  }
+
+  MaybeStopAsyncMode();
+
   crypto::MarkPopErrorOnReturn mark_pop_error_on_return;
 
   int written = 0;
@@ -710,6 +806,8 @@ int TLSWrap::DoWrite(WriteWrap* w,
     pending_cleartext_input_.insert(pending_cleartext_input_.end(),
                                     &bufs[i],
                                     &bufs[count]);
+    if (err == SSL_ERROR_WANT_ASYNC)
+      StartAsyncKeyOperation(true);
   }
 
   // Write any encrypted/handshake output that may be ready.
@@ -786,6 +884,11 @@ int TLSWrap::DoShutdown(ShutdownWrap* req_wrap) {
 
   shutdown_ = true;
   EncOut();
+  if (!kernel_tls_control_.empty()) {
+    CHECK_NULL(kernel_tls_shutdown_);
+    kernel_tls_shutdown_ = req_wrap;
+    return 0;
+  }
   return stream_->DoShutdown(req_wrap);
 }
 
@@ -851,13 +954,30 @@ void TLSWrap::DestroySSL(const FunctionCallbackInfo<Value>& args) {
   // And destroy
   wrap->InvokeQueued(UV_ECANCELED, "Canceled because of SSL destruction");
 
+  // A paused async job can only be released by letting it finish, see
+  // OnAsyncKeyOperationDone().
+  if (wrap->async_key_operation_ && wrap->ssl_) {
+    SSL_up_ref(wrap->ssl_.get());
+    wrap->async_key_ssl_.reset(wrap->ssl_.get());
+  }
+
   // Destroy the SSL structure and friends
   wrap->SSLWrap<TLSWrap>::DestroySSL();
   wrap->enc_in_ = nullptr;
   wrap->enc_out_ = nullptr;
 
-  if (wrap->stream_ != nullptr)
+  if (wrap->stream_ != nullptr) {
     wrap->stream_->RemoveStreamListener(wrap);
+    // The alerts it waited for cannot be sent anymore.
+    ShutdownWrap* req_wrap = wrap->kernel_tls_shutdown_;
+    wrap->kernel_tls_shutdown_ = nullptr;
+    wrap->kernel_tls_control_.clear();
+    if (req_wrap != nullptr) {
+      int err = wrap->stream_->DoShutdown(req_wrap);
+      if (err != 0)
+        req_wrap->Done(err);
+    }
+  }
 }
 
 
@@ -868,6 +988,315 @@ void TLSWrap::EnableCertCb(const FunctionCallbackInfo<Value>& args) {
 }
 
 
+void TLSWrap::EnableKernelTLS(const FunctionCallbackInfo<Value>& args) {
+  TLSWrap* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap, args.Holder());
+  CHECK_NOT_NULL(wrap->ssl_);
+
+  // The keys are installed on the socket, so only TCP can be offloaded.
+  if (wrap->stream_ == nullptr ||
+      wrap->underlying_stream()->GetAsyncWrap()->provider_type() !=
+          AsyncWrap::PROVIDER_TCPWRAP) {
+    return;
+  }
+
+  wrap->kernel_tls_requested_ = true;
+  // The record sequence number is tracked through the message callback. The
+  // TLS 1.3 traffic secret is only made available to the key log callback.
+  // SetSNIContext() installs it on an SNI context as well.
+  SSL_CTX_set_keylog_callback(SSL_get_SSL_CTX(wrap->ssl_.get()),
+                              KeylogCallback);
+  SSL_set_msg_callback(wrap->ssl_.get(), MessageCallback);
+  SSL_set_msg_callback_arg(wrap->ssl_.get(), wrap);
+}
+
+
+void TLSWrap::IsKernelTLS(const FunctionCallbackInfo<Value>& args) {
+  TLSWrap* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap, args.Holder());
+  args.GetReturnValue().Set(wrap->kernel_tls_);
+}
+
+
+void TLSWrap::KeylogCallback(const SSL* ssl, const char* line) {
+  TLSWrap* wrap = static_cast<TLSWrap*>(SSL_get_app_data(ssl));
+  if (wrap == nullptr || !wrap->kernel_tls_requested_)
+    return;
+
+  // "<label> <client random> <secret>", all but the label in hex.
+  const char* label = wrap->is_server() ? "SERVER_TRAFFIC_SECRET_0 " :
+                                          "CLIENT_TRAFFIC_SECRET_0 ";
+  size_t label_len = strlen(label);
+  if (strncmp(line, label, label_len) != 0)
+    return;
+  const char* hex = strchr(line + label_len, ' ');
+  if (hex == nullptr)
+    return;
+
+  auto nibble = [](char c) {
+    return c <= '9' ? c - '0' : (c | 0x20) - 'a' + 10;
+  };
+  std::vector<unsigned char>& secret = wrap->kernel_tls_secret_;
+  secret.clear();
+  for (hex++; hex[0] != '\0' && hex[1] != '\0'; hex += 2)
+    secret.push_back(nibble(hex[0]) << 4 | nibble(hex[1]));
+}
+
+
+void TLSWrap::MessageCallback(int write_p,
+                              int version,
+                              int content_type,
+                              const void* buf,
+                              size_t len,
+                              SSL* ssl,
+                              void* arg) {
+  if (!write_p)
+    return;
+
+  TLSWrap* wrap = static_cast<TLSWrap*>(arg);
+  const unsigned char* data = static_cast<const unsigned char*>(buf);
+
+  if (wrap->kernel_tls_) {
+    if (content_type == SSL3_RT_ALERT || content_type == SSL3_RT_HANDSHAKE) {
+      wrap->kernel_tls_control_.emplace_back(
+          content_type, std::string(reinterpret_cast<const char*>(data), len));
+    }
+    return;
+  }
+
+  // Every record written reports its header. The write keys change with our
+  // Finished message, which was sent with the new keys as record 0 in TLS 1.2,
+  // and with the old keys in TLS 1.3.
+  if (content_type == SSL3_RT_HEADER) {
+    wrap->kernel_tls_write_seq_++;
+  } else if (content_type == SSL3_RT_HANDSHAKE && len > 0 &&
+             data[0] == SSL3_MT_FINISHED) {
+    wrap->kernel_tls_write_seq_ = SSL_version(ssl) == TLS1_3_VERSION ? 0 : 1;
+  }
+}
+
+
+void TLSWrap::MaybeStartKernelTLS() {
+  if (!kernel_tls_requested_ || !established_ || shutdown_ ||
+      ssl_ == nullptr || stream_ == nullptr || SSL_in_init(ssl_.get())) {
+    return;
+  }
+
+  // Everything OpenSSL encrypted must have reached the socket, otherwise the
+  // kernel would encrypt it a second time.
+  if (write_size_ != 0 ||
+      current_write_ != nullptr ||
+      current_empty_write_ != nullptr ||
+      !pending_cleartext_input_.empty() ||
+      BIO_pending(enc_out_) != 0 ||
+      underlying_stream()->HasQueuedWrites()) {
+    return;
+  }
+
+  // Only try once. On failure, OpenSSL simply keeps encrypting.
+  kernel_tls_requested_ = false;
+  int err = crypto::EnableKernelTLSTransmit(ssl_.get(),
+                                            GetFD(),
+                                            kernel_tls_secret_,
+                                            kernel_tls_write_seq_);
+  OPENSSL_cleanse(kernel_tls_secret_.data(), kernel_tls_secret_.size());
+  kernel_tls_secret_.clear();
+  if (err != 0) {
+    SSL_set_msg_callback(ssl_.get(), nullptr);
+    return;
+  }
+
+  kernel_tls_ = true;
+  // OpenSSL's replies to a renegotiation could not be sent anymore, make it
+  // refuse them with an alert instead.
+  SSL_set_options(ssl_.get(), SSL_OP_NO_RENEGOTIATION);
+}
+
+
+void TLSWrap::FlushKernelTLSControl() {
+  // These records were encrypted with keys and sequence numbers that the
+  // kernel owns now, they must not reach the socket.
+  crypto::NodeBIO* enc_out = crypto::NodeBIO::FromBIO(enc_out_);
+  enc_out->Read(nullptr, enc_out->Length());
+
+  // Clear text written before has to reach the socket first. The completion
+  // of the write that is in flight tries again.
+  if (current_write_ != nullptr || underlying_stream()->HasQueuedWrites())
+    return;
+
+  std::vector<std::pair<int, std::string>> records;
+  records.swap(kernel_tls_control_);
+  for (const auto& record : records) {
+    if (record.first == SSL3_RT_ALERT) {
+      // Best effort, like any alert that is sent before the socket closes.
+      crypto::SendKernelTLSRecord(GetFD(),
+                                  SSL3_RT_ALERT,
+                                  record.second.data(),
+                                  record.second.size());
+      continue;
+    }
+
+    // A handshake message, i.e. the KeyUpdate a TLS 1.3 peer asked for. The
+    // kernel cannot switch to new write keys, so the connection cannot go on.
+    HandleScope handle_scope(env()->isolate());
+    Context::Scope context_scope(env()->context());
+    Local<Value> arg = ERR_TLS_KERNEL_OFFLOAD(env()->isolate());
+    MakeCallback(env()->onerror_string(), 1, &arg);
+    return;
+  }
+
+  if (kernel_tls_shutdown_ != nullptr) {
+    ShutdownWrap* req_wrap = kernel_tls_shutdown_;
+    kernel_tls_shutdown_ = nullptr;
+    int err = stream_->DoShutdown(req_wrap);
+    if (err != 0)
+      req_wrap->Done(err);
+  }
+}
+
+
+class TLSWrap::AsyncKeyWork : public ThreadPoolWork {
+ public:
+  AsyncKeyWork(TLSWrap* wrap,
+               std::shared_ptr<crypto::AsyncKeyOperation> operation)
+      : ThreadPoolWork(wrap->env()),
+        wrap_(wrap),
+        object_(wrap->env()->isolate(), wrap->object()),
+        operation_(std::move(operation)) {}
+
+  void DoThreadPoolWork() override {
+    operation_->Run();
+  }
+
+  void AfterThreadPoolWork(int status) override {
+    std::unique_ptr<AsyncKeyWork> self(this);
+    CHECK_EQ(status, 0);
+    operation_->done = true;
+    wrap_->OnAsyncKeyOperationDone();
+  }
+
+ private:
+  TLSWrap* const wrap_;
+  // The job refers to the TLSWrap through SSL_get_app_data().
+  Global<Object> object_;
+  std::shared_ptr<crypto::AsyncKeyOperation> operation_;
+};
+
+
+void TLSWrap::StartAsyncKeyOperation(bool write) {
+  std::shared_ptr<crypto::AsyncKeyOperation> operation =
+      crypto::TakeAsyncKeyOperation();
+  // Jobs are only paused by keys that crypto::EnableAsyncPrivateKey() set up.
+  CHECK(operation);
+
+  async_key_operation_ = operation;
+  async_key_operation_from_write_ = write;
+  (new AsyncKeyWork(this, std::move(operation)))->ScheduleWork();
+}
+
+
+void TLSWrap::OnAsyncKeyOperationDone() {
+  async_key_operation_.reset();
+
+  // Run the job to completion, synchronously if it needs another key
+  // operation, where ClearOut() and ClearIn() would not resume it anymore.
+  // Otherwise OpenSSL would not release it along with the SSL.
+  auto finish_job = [this](SSL* ssl) {
+    crypto::MarkPopErrorOnReturn mark_pop_error_on_return;
+    char buf[1] = { 0 };
+    for (;;) {
+      int ret = async_key_operation_from_write_ ?
+          SSL_write(ssl, buf, sizeof(buf)) : SSL_read(ssl, buf, sizeof(buf));
+      if (SSL_get_error(ssl, ret) != SSL_ERROR_WANT_ASYNC)
+        break;
+      std::shared_ptr<crypto::AsyncKeyOperation> operation =
+          crypto::TakeAsyncKeyOperation();
+      CHECK(operation);
+      operation->Run();
+      operation->done = true;
+    }
+  };
+
+  // DestroySSL() was called while the job was paused.
+  if (async_key_ssl_) {
+    finish_job(async_key_ssl_.get());
+    async_key_ssl_.reset();
+    return;
+  }
+
+  if (ssl_ == nullptr)
+    return;
+
+  HandleScope handle_scope(env()->isolate());
+  Context::Scope context_scope(env()->context());
+
+  // Only the function that started the job can resume it, with the arguments
+  // of the original call.
+  if (async_key_operation_from_write_)
+    ClearIn();
+  else if (!eof_)
+    ClearOut();
+  else
+    finish_job(ssl_.get());
+  Cycle();
+}
+
+
+void TLSWrap::MaybeStopAsyncMode() {
+  // The first flight, and with it the signature, is only flushed to enc_out_
+  // once it is complete. Everything after it waits for the client.
+  if ((SSL_get_mode(ssl_.get()) & SSL_MODE_ASYNC) == 0 ||
+      SSL_waiting_for_async(ssl_.get()) ||
+      BIO_number_written(enc_out_) == 0) {
+    return;
+  }
+  SSL_clear_mode(ssl_.get(), SSL_MODE_ASYNC);
+  async_sni_context_ = nullptr;
+  async_sni_context_invalid_ = false;
+}
+
+
+void TLSWrap::LoadSNIContextForAsyncJob() {
+  if ((SSL_get_mode(ssl_.get()) & SSL_MODE_ASYNC) == 0)
+    return;
+
+  HandleScope handle_scope(env()->isolate());
+  Local<Value> ctx;
+  async_sni_context_ = nullptr;
+  async_sni_context_invalid_ = false;
+  if (!object()->Get(env()->context(), env()->sni_context_string())
+           .ToLocal(&ctx) ||
+      !ctx->IsObject()) {
+    return;
+  }
+
+  if (!env()->secure_context_constructor_template()->HasInstance(ctx)) {
+    async_sni_context_invalid_ = true;
+    return;
+  }
+  sni_context_.Reset(env()->isolate(), ctx);
+  async_sni_context_ = Unwrap<crypto::SecureContext>(ctx.As<Object>());
+}
+
+
+void TLSWrap::MaybeEmitSNIContextError() {
+  if (!sni_context_error_)
+    return;
+  sni_context_error_ = false;
+
+  HandleScope handle_scope(env()->isolate());
+  Context::Scope context_scope(env()->context());
+  Local<Value> err = Exception::TypeError(env()->sni_context_err_string());
+  MakeCallback(env()->onerror_string(), 1, &err);
+}
+
+
+bool TLSWrap::HasQueuedWrites() {
+  return current_write_ != nullptr ||
+         underlying_stream()->HasQueuedWrites();
+}
+
+
 void TLSWrap::OnClientHelloParseEnd(void* arg) {
   TLSWrap* c = static_cast<TLSWrap*>(arg);
   c->Cycle();
@@ -919,6 +1348,18 @@ int TLSWrap::SelectSNIContextCallback(SSL* s, int* ad, void* arg) {
   if (servername == nullptr)
     return SSL_TLSEXT_ERR_OK;
 
+  // Inside an async job, only use what LoadSNIContextForAsyncJob() found.
+  if (ASYNC_get_current_job() != nullptr) {
+    if (p->async_sni_context_invalid_) {
+      p->sni_context_error_ = true;
+      return SSL_TLSEXT_ERR_NOACK;
+    }
+    if (p->async_sni_context_ == nullptr)
+      return SSL_TLSEXT_ERR_NOACK;
+    p->SetSNIContext(p->async_sni_context_);
+    return SSL_TLSEXT_ERR_OK;
+  }
+
   HandleScope handle_scope(env->isolate());
   Context::Scope context_scope(env->context());
 
@@ -1007,6 +1448,8 @@ void TLSWrap::Initialize(Local<Object> target,
   env->SetProtoMethod(t, "enableSessionCallbacks", EnableSessionCallbacks);
   env->SetProtoMethod(t, "destroySSL", DestroySSL);
   env->SetProtoMethod(t, "enableCertCb", EnableCertCb);
+  env->SetProtoMethod(t, "enableKernelTLS", EnableKernelTLS);
+  env->SetProtoMethod(t, "isKernelTLS", IsKernelTLS);
 
   StreamBase::AddMethods(env, t);
   SSLWrap<TLSWrap>::AddMethods(env, t);
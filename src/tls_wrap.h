@@ -26,6 +26,7 @@
 
 #include "node.h"
 #include "node_crypto.h"  // SSLWrap
+#include "node_crypto_async_key.h"
 
 #include "async_wrap.h"
 #include "env.h"
@@ -34,7 +35,10 @@
 
 #include <openssl/ssl.h>
 
+#include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace node {
 
@@ -84,6 +88,16 @@ class TLSWrap : public AsyncWrap,
   // Called by the done() callback of the 'newSession' event.
   void NewSessionDoneCb();
 
+  // True once the kernel encrypts outgoing records, see EnableKernelTLS().
+  // Clear text written to the underlying socket's fd is then sent as TLS.
+  inline bool HasKernelTLS() const { return kernel_tls_; }
+  bool HasQueuedWrites() override;
+  // OpenSSL only has a key log callback per SSL_CTX. It is installed on the
+  // contexts of connections that asked for kernel TLS, and returns early for
+  // any other connection that shares them.
+  static void KeylogCallback(const SSL* ssl, const char* line);
+  inline bool WantsKeylog() const { return kernel_tls_requested_; }
+
   // Implement MemoryRetainer:
   void MemoryInfo(MemoryTracker* tracker) const override;
   SET_MEMORY_INFO_NAME(TLSWrap)
@@ -128,6 +142,32 @@ class TLSWrap : public AsyncWrap,
   // Call Done() on outstanding WriteWrap request.
   bool InvokeQueued(int status, const char* error_str = nullptr);
 
+  // Hand outgoing records to the kernel once the handshake is done and all
+  // data encrypted by OpenSSL so far has reached the socket.
+  void MaybeStartKernelTLS();
+  // Once the kernel owns the write keys, discard what OpenSSL encrypted and
+  // send the alerts it produced through the kernel instead. They are sent
+  // directly to the fd, so they wait for clear text that is still queued.
+  void FlushKernelTLSControl();
+
+  // Server-side handshakes with an async private key run in an OpenSSL async
+  // job until the first flight is written. The job pauses when it needs a
+  // signature, and SSL_read() or SSL_write(), whichever started it, fails with
+  // SSL_ERROR_WANT_ASYNC. The key operation then runs on the threadpool, and
+  // the same function is called again once it is done, which resumes the job.
+  // `write` tells which function started the job.
+  class AsyncKeyWork;
+  void StartAsyncKeyOperation(bool write);
+  void OnAsyncKeyOperationDone();
+  // Leaves async mode once the first flight is written, so that callbacks
+  // which call into JS never run inside a job.
+  void MaybeStopAsyncMode();
+  // SelectSNIContextCallback() must not enter V8 inside a job. While in async
+  // mode, the SNI context is looked up before each call that can start or
+  // resume the job, and an invalid one is reported after that call returns.
+  void LoadSNIContextForAsyncJob();
+  void MaybeEmitSNIContextError();
+
   // Drive the SSL state machine by attempting to SSL_read() and SSL_write() to
   // it. Transparent handshakes mean SSL_read() might trigger I/O on the
   // underlying stream even if there is no clear text to read or write.
@@ -142,6 +182,8 @@ class TLSWrap : public AsyncWrap,
       // EncIn() doesn't exist, it happens via stream listener callbacks.
       EncOut();
     }
+
+    MaybeStartKernelTLS();
   }
 
   // Implement StreamListener:
@@ -160,6 +202,15 @@ class TLSWrap : public AsyncWrap,
   static void EnableSessionCallbacks(
       const v8::FunctionCallbackInfo<v8::Value>& args);
   static void EnableCertCb(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void EnableKernelTLS(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void IsKernelTLS(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void MessageCallback(int write_p,
+                              int version,
+                              int content_type,
+                              const void* buf,
+                              size_t len,
+                              SSL* ssl,
+                              void* arg);
   static void DestroySSL(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void GetServername(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void SetServername(const v8::FunctionCallbackInfo<v8::Value>& args);
@@ -186,6 +237,32 @@ class TLSWrap : public AsyncWrap,
   // after the `UV_EOF` on socket.
   bool eof_ = false;
 
+  // Kernel TLS offload of outgoing records. OpenSSL keeps decrypting incoming
+  // data. Until the keys are installed, kernel_tls_write_seq_ counts the
+  // records sent under the current write keys.
+  bool kernel_tls_requested_ = false;
+  bool kernel_tls_ = false;
+  uint64_t kernel_tls_write_seq_ = 0;
+  std::vector<unsigned char> kernel_tls_secret_;
+  // Alerts and handshake messages OpenSSL sent after the offload, as
+  // (content type, plain text) pairs.
+  std::vector<std::pair<int, std::string>> kernel_tls_control_;
+  // A shutdown that waits for kernel_tls_control_ to be sent, so that the FIN
+  // does not overtake the close_notify alert.
+  ShutdownWrap* kernel_tls_shutdown_ = nullptr;
+
+  // Neither ClearIn() nor ClearOut() call into OpenSSL while the handshake
+  // waits for async_key_operation_, see StartAsyncKeyOperation().
+  std::shared_ptr<crypto::AsyncKeyOperation> async_key_operation_;
+  bool async_key_operation_from_write_ = false;
+  // Keeps the SSL alive if DestroySSL() is called in the meantime, so that
+  // the job can finish.
+  crypto::SSLPointer async_key_ssl_;
+  // See LoadSNIContextForAsyncJob(). Kept alive by sni_context_.
+  crypto::SecureContext* async_sni_context_ = nullptr;
+  bool async_sni_context_invalid_ = false;
+  bool sni_context_error_ = false;
+
  private:
   static void GetWriteQueueSize(
       const v8::FunctionCallbackInfo<v8::Value>& info);
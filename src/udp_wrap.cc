@@ -77,12 +77,20 @@ inline bool SendWrap::have_callback() const {
 }
 
 
-UDPWrap::UDPWrap(Environment* env, Local<Object> object)
+// Largest datagram a single read can return.
+static constexpr size_t kMaxDatagramSize = 64 * 1024;
+
+
+UDPWrap::UDPWrap(Environment* env, Local<Object> object, bool recvmmsg)
     : HandleWrap(env,
                  object,
                  reinterpret_cast<uv_handle_t*>(&handle_),
                  AsyncWrap::PROVIDER_UDPWRAP) {
-  int r = uv_udp_init(env->event_loop(), &handle_);
+  // With `recvmmsg`, ask libuv to read in batches where the platform supports
+  // it (recvmmsg on Linux); the flag is ignored elsewhere.
+  int r = uv_udp_init_ex(env->event_loop(),
+                         &handle_,
+                         AF_UNSPEC | (recvmmsg ? UV_UDP_RECVMMSG : 0));
   CHECK_EQ(r, 0);  // can't fail anyway
 }
 
@@ -120,6 +128,8 @@ void UDPWrap::Initialize(Local<Object> target,
   env->SetProtoMethod(t, "send", Send);
   env->SetProtoMethod(t, "bind6", Bind6);
   env->SetProtoMethod(t, "send6", Send6);
+  env->SetProtoMethod(t, "sendBatch", SendBatch);
+  env->SetProtoMethod(t, "sendBatch6", SendBatch6);
   env->SetProtoMethod(t, "recvStart", RecvStart);
   env->SetProtoMethod(t, "recvStop", RecvStop);
   env->SetProtoMethod(t, "getsockname",
@@ -154,6 +164,7 @@ void UDPWrap::Initialize(Local<Object> target,
 
   Local<Object> constants = Object::New(env->isolate());
   NODE_DEFINE_CONSTANT(constants, UV_UDP_IPV6ONLY);
+  NODE_DEFINE_CONSTANT(constants, UV_UDP_SEGMENT);
   target->Set(context,
               env->constants_string(),
               constants).FromJust();
@@ -163,7 +174,7 @@ void UDPWrap::Initialize(Local<Object> target,
 void UDPWrap::New(const FunctionCallbackInfo<Value>& args) {
   CHECK(args.IsConstructCall());
   Environment* env = Environment::GetCurrent(args);
-  new UDPWrap(env, args.This());
+  new UDPWrap(env, args.This(), args[0]->IsTrue());
 }
 
 
@@ -422,6 +433,58 @@ void UDPWrap::Send6(const FunctionCallbackInfo<Value>& args) {
 }
 
 
+void UDPWrap::DoSendBatch(const FunctionCallbackInfo<Value>& args,
+                          int family) {
+  Environment* env = Environment::GetCurrent(args);
+
+  UDPWrap* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap,
+                          args.Holder(),
+                          args.GetReturnValue().Set(UV_EBADF));
+
+  // sendBatch(list, list.length, port, address, flags)
+  CHECK(args[0]->IsArray());
+  CHECK(args[1]->IsUint32());
+  CHECK(args[2]->IsUint32());
+  CHECK(args[3]->IsString());
+  CHECK(args[4]->IsUint32());
+
+  Local<Array> chunks = args[0].As<Array>();
+  size_t count = args[1].As<Uint32>()->Value();
+  const unsigned short port = args[2].As<Uint32>()->Value();
+  node::Utf8Value address(env->isolate(), args[3]);
+  const unsigned int flags = args[4].As<Uint32>()->Value();
+
+  // Unlike send(), every buffer in the list is a datagram of its own.
+  MaybeStackBuffer<uv_buf_t, 16> bufs(count);
+  for (size_t i = 0; i < count; i++) {
+    Local<Value> chunk = chunks->Get(env->context(), i).ToLocalChecked();
+    bufs[i] = uv_buf_init(Buffer::Data(chunk), Buffer::Length(chunk));
+  }
+
+  struct sockaddr_storage addr_storage;
+  int err = sockaddr_for_family(family, address.out(), port, &addr_storage);
+  if (err == 0) {
+    // Returns the number of datagrams that were sent, which may be fewer
+    // than `count` when the socket buffer fills up.
+    const sockaddr* addr = reinterpret_cast<const sockaddr*>(&addr_storage);
+    err = uv_udp_try_send_batch(&wrap->handle_, *bufs, count, addr, flags);
+  }
+
+  args.GetReturnValue().Set(err);
+}
+
+
+void UDPWrap::SendBatch(const FunctionCallbackInfo<Value>& args) {
+  DoSendBatch(args, AF_INET);
+}
+
+
+void UDPWrap::SendBatch6(const FunctionCallbackInfo<Value>& args) {
+  DoSendBatch(args, AF_INET6);
+}
+
+
 void UDPWrap::RecvStart(const FunctionCallbackInfo<Value>& args) {
   UDPWrap* wrap;
   ASSIGN_OR_RETURN_UNWRAP(&wrap,
@@ -464,6 +527,20 @@ void UDPWrap::OnAlloc(uv_handle_t* handle,
                       size_t suggested_size,
                       uv_buf_t* buf) {
   UDPWrap* wrap = static_cast<UDPWrap*>(handle->data);
+
+  // Batched reads ask for room for many datagrams at once. They all go into
+  // the same slab, which OnRecv() copies each datagram out of, so that
+  // neither the slab nor a retained datagram holds on to more memory than
+  // it needs.
+  if (suggested_size > kMaxDatagramSize) {
+    if (wrap->recv_slab_size_ < suggested_size) {
+      wrap->recv_slab_.reset(new char[suggested_size]);
+      wrap->recv_slab_size_ = suggested_size;
+    }
+    *buf = uv_buf_init(wrap->recv_slab_.get(), suggested_size);
+    return;
+  }
+
   *buf = wrap->env()->AllocateManaged(suggested_size).release();
 }
 
@@ -475,14 +552,32 @@ void UDPWrap::OnRecv(uv_udp_t* handle,
   UDPWrap* wrap = static_cast<UDPWrap*>(handle->data);
   Environment* env = wrap->env();
 
-  AllocatedBuffer buf(env, *buf_);
+  HandleScope handle_scope(env->isolate());
+  Context::Scope context_scope(env->context());
+
+  AllocatedBuffer buf(env);
+  if (flags & UV_UDP_MMSG_CHUNK) {
+    // Part of a recvmmsg() batch. The chunk points into the slab, which libuv
+    // hands back separately once the batch has been delivered.
+    if (nread >= 0) {
+      buf = env->AllocateManaged(nread > 0 ? nread : 1);
+      memcpy(buf.data(), buf_->base, nread);
+    }
+  } else if (buf_->base != nullptr && buf_->base == wrap->recv_slab_.get()) {
+    // The end of a batch, or a plain read into the slab after recvmmsg()
+    // turned out to be unavailable.
+    if (nread > 0) {
+      buf = env->AllocateManaged(nread);
+      memcpy(buf.data(), buf_->base, nread);
+    }
+  } else {
+    buf = AllocatedBuffer(env, *buf_);
+  }
+
   if (nread == 0 && addr == nullptr) {
     return;
   }
 
-  HandleScope handle_scope(env->isolate());
-  Context::Scope context_scope(env->context());
-
   Local<Object> wrap_obj = wrap->object();
   Local<Value> argv[] = {
     Integer::New(env->isolate(), nread),
@@ -0,0 +1,100 @@
+'use strict';
+require('../common');
+const assert = require('assert');
+
+// The base64 and hex codecs process long inputs in vector-sized blocks and
+// fall back to byte-at-a-time code around anything unusual. Check that the
+// result does not depend on where in the input such things appear.
+
+const bytes = Buffer.allocUnsafe(1027);
+for (let i = 0; i < bytes.length; i++)
+  bytes[i] = (i * 131 + 7) & 0xff;
+
+function referenceBase64(buf) {
+  const table =
+    'ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/';
+  let out = '';
+  for (let i = 0; i < buf.length; i += 3) {
+    const n = (buf[i] << 16) | ((buf[i + 1] || 0) << 8) | (buf[i + 2] || 0);
+    out += table[n >> 18] + table[(n >> 12) & 63];
+    out += i + 1 < buf.length ? table[(n >> 6) & 63] : '=';
+    out += i + 2 < buf.length ? table[n & 63] : '=';
+  }
+  return out;
+}
+
+function referenceHex(buf) {
+  let out = '';
+  for (let i = 0; i < buf.length; i++)
+    out += (buf[i] < 16 ? '0' : '') + buf[i].toString(16);
+  return out;
+}
+
+for (let len = 0; len <= bytes.length; len += len < 80 ? 1 : 97) {
+  const buf = bytes.slice(0, len);
+  const base64 = buf.toString('base64');
+  const hex = buf.toString('hex');
+  assert.strictEqual(base64, referenceBase64(buf));
+  assert.strictEqual(hex, referenceHex(buf));
+  assert.deepStrictEqual(Buffer.from(base64, 'base64'), buf);
+  assert.deepStrictEqual(Buffer.from(hex, 'hex'), buf);
+  assert.deepStrictEqual(Buffer.from(hex.toUpperCase(), 'hex'), buf);
+
+  // URL-safe alphabet and missing padding.
+  const urlsafe =
+    base64.replace(/\+/g, '-').replace(/\//g, '_').replace(/=+$/, '');
+  assert.deepStrictEqual(Buffer.from(urlsafe, 'base64'), buf);
+}
+
+// Whitespace and other characters outside the alphabet are skipped wherever
+// they appear in a long input.
+{
+  const base64 = bytes.toString('base64');
+  for (let pos = 0; pos < 200; pos++) {
+    for (const junk of [' \n', '\u00ff', '*']) {
+      const s = base64.slice(0, pos) + junk + base64.slice(pos);
+      assert.deepStrictEqual(Buffer.from(s, 'base64'), bytes);
+    }
+  }
+}
+
+// Decoding stops at '=' in base64 and at the first invalid character in hex,
+// wherever they are, and the destination past the decoded bytes is left
+// untouched.
+{
+  const base64 = bytes.toString('base64');
+  const hex = bytes.toString('hex');
+  for (const pos of [0, 5, 16, 31, 32, 47, 64, 100, 200, 333]) {
+    const b64 = `${base64.slice(0, pos)}=${base64.slice(pos + 1)}`;
+    const out = Buffer.alloc(bytes.length, 0xaa);
+    const written = out.write(b64, 'base64');
+    const partial = pos % 4 ? pos % 4 - 1 : 0;
+    assert.strictEqual(written, Math.floor(pos / 4) * 3 + partial);
+    assert.deepStrictEqual(out.slice(0, written), bytes.slice(0, written));
+    assert(out.slice(written).every((b) => b === 0xaa));
+
+    const hx = `${hex.slice(0, pos)}g${hex.slice(pos + 1)}`;
+    const hout = Buffer.alloc(bytes.length, 0xaa);
+    const hwritten = hout.write(hx, 'hex');
+    assert.strictEqual(hwritten, Math.floor(pos / 2));
+    assert.deepStrictEqual(hout.slice(0, hwritten), bytes.slice(0, hwritten));
+    assert(hout.slice(hwritten).every((b) => b === 0xaa));
+  }
+}
+
+// A destination shorter than the decoded data is filled exactly.
+{
+  const base64 = bytes.toString('base64');
+  const hex = bytes.toString('hex');
+  for (const size of [1, 11, 12, 13, 23, 24, 25, 47, 100]) {
+    const out = Buffer.alloc(size + 8, 0xaa);
+    assert.strictEqual(out.write(base64, 0, size, 'base64'), size);
+    assert.deepStrictEqual(out.slice(0, size), bytes.slice(0, size));
+    assert(out.slice(size).every((b) => b === 0xaa));
+
+    const hout = Buffer.alloc(size + 8, 0xaa);
+    assert.strictEqual(hout.write(hex, 0, size, 'hex'), size);
+    assert.deepStrictEqual(hout.slice(0, size), bytes.slice(0, size));
+    assert(hout.slice(size).every((b) => b === 0xaa));
+  }
+}
@@ -0,0 +1,81 @@
+'use strict';
+require('../common');
+const assert = require('assert');
+const { TextDecoder } = require('util');
+
+// Well-formed UTF-8 is decoded in vector-sized blocks with scalar handling of
+// multi-byte sequences; malformed input takes V8's decoder. Check that both
+// agree with the expected strings wherever the interesting bytes appear.
+
+const samples = [
+  'a',
+  '\u00e9',        // Two bytes, Latin-1.
+  '\u0416',        // Two bytes, outside Latin-1.
+  '\u20ac',        // Three bytes.
+  '\ud83d\ude00',  // Four bytes, a surrogate pair.
+];
+
+for (const sample of samples) {
+  for (let prefix = 0; prefix < 70; prefix++) {
+    for (const suffix of [0, 1, 15, 33]) {
+      const str = 'x'.repeat(prefix) + sample + 'y'.repeat(suffix);
+      const buf = Buffer.from(str);
+      assert.strictEqual(buf.toString(), str);
+      assert.strictEqual(buf.toString('utf8', 0, buf.length), str);
+      assert.strictEqual(new TextDecoder().decode(buf), str);
+      assert.strictEqual(new TextDecoder('utf-8', { fatal: true }).decode(buf),
+                         str);
+    }
+  }
+}
+
+// Long strings, including ones that become external strings.
+for (const sample of samples) {
+  for (const count of [1000, 300000]) {
+    const str = ('abc' + sample).repeat(count);
+    assert.strictEqual(Buffer.from(str).toString(), str);
+    assert.strictEqual(new TextDecoder().decode(Buffer.from(str)), str);
+  }
+}
+
+// Malformed input still yields replacement characters.
+{
+  const ascii = 'a'.repeat(100);
+  const latin1 = '\u00e9'.repeat(50);
+  for (const bad of [[0xff], [0xc0, 0x80], [0xed, 0xa0, 0x80],
+                     [0xf4, 0x90, 0x80, 0x80]]) {
+    const buf = Buffer.concat([Buffer.from(ascii), Buffer.from(bad),
+                               Buffer.from(latin1)]);
+    const str = buf.toString();
+    assert(str.startsWith(`${ascii}\ufffd`));
+    assert(str.endsWith(`\ufffd${latin1}`));
+    assert(!str.slice(ascii.length, -latin1.length).replace(/\ufffd/g, ''));
+    assert.strictEqual(new TextDecoder().decode(buf), str);
+    assert.throws(() => new TextDecoder('utf-8', { fatal: true }).decode(buf),
+                  { code: 'ERR_ENCODING_INVALID_ENCODED_DATA' });
+  }
+}
+
+// A sequence split across chunks is completed by the next chunk.
+{
+  const str = 'abc\u20acdef\ud83d\ude00';
+  const buf = Buffer.from(str);
+  for (let split = 0; split <= buf.length; split++) {
+    const decoder = new TextDecoder();
+    const result = decoder.decode(buf.slice(0, split), { stream: true }) +
+                   decoder.decode(buf.slice(split));
+    assert.strictEqual(result, str);
+  }
+}
+
+// The BOM is stripped once at the start of the stream, and kept with
+// ignoreBOM.
+{
+  const buf = Buffer.from('\ufeffabc\u20ac');
+  const decoder = new TextDecoder();
+  assert.strictEqual(decoder.decode(buf, { stream: true }), 'abc\u20ac');
+  assert.strictEqual(decoder.decode(buf), '\ufeffabc\u20ac');
+  assert.strictEqual(decoder.decode(buf), 'abc\u20ac');
+  assert.strictEqual(new TextDecoder('utf-8', { ignoreBOM: true }).decode(buf),
+                     '\ufeffabc\u20ac');
+}
@@ -0,0 +1,170 @@
+'use strict';
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+
+const assert = require('assert');
+const crypto = require('crypto');
+
+// The asynchronous variants of update(), digest() and final() produce the
+// same results as the synchronous ones, for inputs that are small enough to
+// be processed on the main thread and for inputs that are split into chunks
+// on the threadpool.
+
+const small = Buffer.from('some data to hash');
+const large = Buffer.alloc(3 * 1024 * 1024 + 17);
+for (let i = 0; i < large.length; i++)
+  large[i] = i % 251;
+
+function syncHash(algorithm, ...inputs) {
+  const hash = crypto.createHash(algorithm);
+  for (const input of inputs)
+    hash.update(input);
+  return hash.digest('hex');
+}
+
+// Hash
+{
+  const hash = crypto.createHash('sha256');
+  let updates = 0;
+  assert.strictEqual(hash.update(large, common.mustCall((err) => {
+    assert.ifError(err);
+    assert.strictEqual(updates++, 0);
+  })), hash);
+  hash.update('some data to hash', 'utf8', common.mustCall((err) => {
+    assert.ifError(err);
+    assert.strictEqual(updates++, 1);
+  }));
+
+  assert.throws(() => hash.update(small), {
+    code: 'ERR_CRYPTO_OPERATION_PENDING'
+  });
+  assert.throws(() => hash.update(small, 'utf8', 42), {
+    code: 'ERR_INVALID_CALLBACK'
+  });
+
+  hash.digest('hex', common.mustCall((err, digest) => {
+    assert.ifError(err);
+    assert.strictEqual(updates, 2);
+    assert.strictEqual(digest, syncHash('sha256', large, small));
+  }));
+
+  assert.throws(() => hash.digest(common.mustNotCall()), {
+    code: 'ERR_CRYPTO_HASH_FINALIZED'
+  });
+}
+
+{
+  const hash = crypto.createHash('md5');
+  hash.update(small, common.mustCall((err) => {
+    assert.ifError(err);
+    hash.digest(common.mustCall((err, digest) => {
+      assert.ifError(err);
+      assert(Buffer.isBuffer(digest));
+      assert.strictEqual(digest.toString('hex'), syncHash('md5', small));
+    }));
+  }));
+}
+
+// Hmac
+{
+  const expected = crypto.createHmac('sha512', 'key')
+    .update(large).update(small).digest('base64');
+  const hmac = crypto.createHmac('sha512', 'key');
+  hmac.update(large, common.mustCall((err) => assert.ifError(err)));
+  hmac.update(small, common.mustCall((err) => assert.ifError(err)));
+  hmac.digest('base64', common.mustCall((err, digest) => {
+    assert.ifError(err);
+    assert.strictEqual(digest, expected);
+  }));
+}
+
+// Cipher and Decipher
+{
+  const key = Buffer.alloc(32, 1);
+  const iv = Buffer.alloc(16, 2);
+
+  const cipher = crypto.createCipheriv('aes-256-cbc', key, iv);
+  const expected = Buffer.concat([cipher.update(large), cipher.update(small),
+                                  cipher.final()]);
+
+  const asyncCipher = crypto.createCipheriv('aes-256-cbc', key, iv);
+  const chunks = [];
+  asyncCipher.update(large, common.mustCall((err, data) => {
+    assert.ifError(err);
+    chunks.push(data);
+  }));
+  asyncCipher.update(small, common.mustCall((err, data) => {
+    assert.ifError(err);
+    chunks.push(data);
+  }));
+  assert.throws(() => asyncCipher.setAutoPadding(false), {
+    code: 'ERR_CRYPTO_OPERATION_PENDING'
+  });
+  asyncCipher.final(common.mustCall((err, data) => {
+    assert.ifError(err);
+    chunks.push(data);
+    const encrypted = Buffer.concat(chunks);
+    assert.deepStrictEqual(encrypted, expected);
+
+    const decipher = crypto.createDecipheriv('aes-256-cbc', key, iv);
+    let decrypted = '';
+    decipher.update(encrypted, undefined, 'latin1',
+                    common.mustCall((err, data) => {
+                      assert.ifError(err);
+                      decrypted += data;
+                    }));
+    decipher.final('latin1', common.mustCall((err, data) => {
+      assert.ifError(err);
+      decrypted += data;
+      assert.strictEqual(decrypted,
+                         Buffer.concat([large, small]).toString('latin1'));
+    }));
+  }));
+}
+
+{
+  // Authentication failures are reported to the callback of final().
+  const key = Buffer.alloc(16);
+  const iv = Buffer.alloc(12);
+  const cipher = crypto.createCipheriv('aes-128-gcm', key, iv);
+  const encrypted = Buffer.concat([cipher.update(large), cipher.final()]);
+  const tag = cipher.getAuthTag();
+  tag[0] ^= 1;
+
+  const decipher = crypto.createDecipheriv('aes-128-gcm', key, iv);
+  decipher.setAuthTag(tag);
+  decipher.update(encrypted, common.mustCall((err, data) => {
+    assert.ifError(err);
+    assert.strictEqual(data.length, large.length);
+  }));
+  decipher.final(common.mustCall((err) => {
+    assert.strictEqual(err.message,
+                       'Unsupported state or unable to authenticate data');
+  }));
+}
+
+// crypto.hash()
+{
+  crypto.hash('sha1', large, common.mustCall(function(err, digest) {
+    assert.ifError(err);
+    assert(Buffer.isBuffer(digest));
+    assert.strictEqual(digest.toString('hex'), syncHash('sha1', large));
+  }));
+
+  crypto.hash('sha256', 'some data to hash', 'hex',
+              common.mustCall((err, digest) => {
+                assert.ifError(err);
+                assert.strictEqual(digest, syncHash('sha256', small));
+              }));
+
+  assert.throws(() => crypto.hash('nope', small, common.mustNotCall()), {
+    code: 'ERR_CRYPTO_INVALID_DIGEST'
+  });
+  assert.throws(() => crypto.hash('sha256', 42, common.mustNotCall()), {
+    code: 'ERR_INVALID_ARG_TYPE'
+  });
+  assert.throws(() => crypto.hash('sha256', small), {
+    code: 'ERR_INVALID_CALLBACK'
+  });
+}
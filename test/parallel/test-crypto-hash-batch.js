@@ -0,0 +1,114 @@
+'use strict';
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+
+const assert = require('assert');
+const crypto = require('crypto');
+
+function expected(algorithm, inputs) {
+  return Buffer.concat(inputs.map((input) => {
+    return crypto.createHash(algorithm).update(input).digest();
+  }));
+}
+
+const blobs = [];
+for (let i = 0; i < 100; i++)
+  blobs.push(Buffer.alloc(i * 7, i));
+const data = Buffer.concat(blobs);
+const offsets = [];
+for (let i = 0, offset = 0; i < blobs.length; offset += blobs[i++].length)
+  offsets.push(offset);
+
+for (const algorithm of ['md5', 'sha1', 'sha256', 'sha512']) {
+  const digests = expected(algorithm, blobs);
+  assert.deepStrictEqual(crypto.hashBatch(algorithm, blobs), digests);
+  assert.deepStrictEqual(crypto.hashBatch(algorithm, data, { offsets }),
+                         digests);
+  assert.deepStrictEqual(
+    crypto.hashBatch(algorithm, data, { offsets: new Uint32Array(offsets) }),
+    digests);
+
+  crypto.hashBatch(algorithm, blobs, common.mustCall((err, result) => {
+    assert.ifError(err);
+    assert.deepStrictEqual(result, digests);
+  }));
+  crypto.hashBatch(algorithm, data, { offsets },
+                   common.mustCall((err, result) => {
+                     assert.ifError(err);
+                     assert.deepStrictEqual(result, digests);
+                   }));
+}
+
+// Typed arrays and DataViews are hashed like the bytes they refer to.
+assert.deepStrictEqual(
+  crypto.hashBatch('sha256', [new Uint16Array([1, 2]),
+                              new DataView(data.buffer, data.byteOffset, 3)]),
+  expected('sha256', [Buffer.from([1, 0, 2, 0]), data.slice(0, 3)]));
+
+// Empty batches.
+assert.deepStrictEqual(crypto.hashBatch('sha256', []), Buffer.alloc(0));
+assert.deepStrictEqual(crypto.hashBatch('sha256', data, { offsets: [] }),
+                       Buffer.alloc(0));
+crypto.hashBatch('sha256', [], common.mustCall((err, result) => {
+  assert.ifError(err);
+  assert.deepStrictEqual(result, Buffer.alloc(0));
+}));
+
+// Batches that are large enough to be split across threads.
+{
+  const large = [];
+  for (let i = 0; i < 9; i++)
+    large.push(Buffer.alloc(512 * 1024 + i, i));
+  const digests = expected('sha1', large);
+  crypto.hashBatch('sha1', large, common.mustCall((err, result) => {
+    assert.ifError(err);
+    assert.deepStrictEqual(result, digests);
+  }));
+
+  const offsets = [0, 1, 2, large[0].length, 3 * 1024 * 1024];
+  const data = Buffer.concat(large);
+  crypto.hashBatch('sha1', data, { offsets }, common.mustCall((err, result) => {
+    assert.ifError(err);
+    assert.deepStrictEqual(result, expected('sha1', [
+      data.slice(0, 1),
+      data.slice(1, 2),
+      data.slice(2, large[0].length),
+      data.slice(large[0].length, 3 * 1024 * 1024),
+      data.slice(3 * 1024 * 1024)
+    ]));
+  }));
+}
+
+// Invalid arguments.
+for (const callback of [undefined, common.mustNotCall()]) {
+  assert.throws(() => crypto.hashBatch('nope', blobs, callback), {
+    code: 'ERR_CRYPTO_INVALID_DIGEST'
+  });
+  assert.throws(() => crypto.hashBatch(42, blobs, callback), {
+    code: 'ERR_INVALID_ARG_TYPE'
+  });
+  assert.throws(() => crypto.hashBatch('sha256', 'abc', callback), {
+    code: 'ERR_INVALID_ARG_TYPE'
+  });
+  assert.throws(() => crypto.hashBatch('sha256', [blobs[0], 'abc'], callback), {
+    code: 'ERR_INVALID_ARG_TYPE',
+    message: /"data\[1\]"/
+  });
+  assert.throws(() => crypto.hashBatch('sha256', data, callback), {
+    code: 'ERR_INVALID_ARG_TYPE'
+  });
+  assert.throws(() => crypto.hashBatch('sha256', data, 'abc', callback), {
+    code: 'ERR_INVALID_ARG_TYPE'
+  });
+  for (const offsets of [[1, 0], [0, data.length + 1], [-1], [0.5]]) {
+    assert.throws(() => crypto.hashBatch('sha256', data, { offsets },
+                                         callback), {
+      code: 'ERR_OUT_OF_RANGE'
+    });
+  }
+}
+
+assert.throws(() => crypto.hashBatch('sha256', blobs, {}, 42), {
+  code: 'ERR_INVALID_CALLBACK'
+});
@@ -0,0 +1,41 @@
+'use strict';
+
+const common = require('../common');
+const assert = require('assert');
+const dgram = require('dgram');
+
+// With the recvmmsg option, datagrams may be read in batches. Each of them is
+// still delivered in a Buffer of its own that does not keep the batch alive.
+
+{
+  const receiver = dgram.createSocket({ type: 'udp4', recvmmsg: true });
+  const sender = dgram.createSocket('udp4');
+  const count = 50;
+  const messages = [];
+  for (let i = 0; i < count; i++)
+    messages.push(Buffer.alloc(1 + i * 20, i));
+  const received = [];
+
+  receiver.on('message', common.mustCall((buf, rinfo) => {
+    assert.strictEqual(rinfo.port, sender.address().port);
+    received.push(buf);
+    if (received.length === count) {
+      assert.deepStrictEqual(received, messages);
+      for (const buf of received)
+        assert.strictEqual(buf.buffer.byteLength, buf.length);
+      receiver.close();
+      sender.close();
+    }
+  }, count));
+
+  receiver.bind(0, common.localhostIPv4, common.mustCall(() => {
+    sender.sendBatch(messages, receiver.address().port, common.localhostIPv4);
+  }));
+}
+
+for (const recvmmsg of [1, 'yes', null]) {
+  common.expectsError(() => dgram.createSocket({ type: 'udp4', recvmmsg }), {
+    code: 'ERR_INVALID_ARG_TYPE',
+    type: TypeError
+  });
+}
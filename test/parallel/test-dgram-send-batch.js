@@ -0,0 +1,100 @@
+'use strict';
+
+const common = require('../common');
+const assert = require('assert');
+const dgram = require('dgram');
+
+// Each element of the list passed to sendBatch() is a datagram of its own.
+
+{
+  const client = dgram.createSocket('udp4');
+  const messages = [
+    Buffer.alloc(256, 'x'),
+    new Uint8Array([1, 2, 3]),
+    'hello',
+    Buffer.alloc(0)
+  ];
+  const expected = messages.map((msg) => Buffer.from(msg));
+  const received = [];
+
+  client.on('message', common.mustCall((buf) => {
+    received.push(buf);
+    if (received.length === expected.length) {
+      assert.deepStrictEqual(received, expected);
+      client.close();
+    }
+  }, expected.length));
+
+  client.bind(0, common.mustCall(() => {
+    const port = client.address().port;
+    const bytes = expected.reduce((sum, buf) => sum + buf.length, 0);
+    client.sendBatch(messages, port, common.localhostIPv4,
+                     common.mustCall((err, sent) => {
+                       assert.ifError(err);
+                       assert.strictEqual(sent, bytes);
+                     }));
+  }));
+}
+
+// Equally sized datagrams are eligible for UDP_SEGMENT. Whether or not the
+// kernel supports it, the receiver sees the individual datagrams.
+{
+  const client = dgram.createSocket({ type: 'udp4', udpSegment: true });
+  const count = 32;
+  const messages = [];
+  for (let i = 0; i < count; i++)
+    messages.push(Buffer.alloc(1000, i));
+  let received = 0;
+
+  client.on('message', common.mustCall((buf) => {
+    assert.ok(buf.equals(messages[received]));
+    if (++received === count)
+      client.close();
+  }, count));
+
+  client.bind(0, common.mustCall(() => {
+    const port = client.address().port;
+    client.sendBatch(messages, port, common.mustCall((err, sent) => {
+      assert.ifError(err);
+      assert.strictEqual(sent, count * 1000);
+    }));
+  }));
+}
+
+// Sending on an unbound socket binds it first.
+{
+  const receiver = dgram.createSocket('udp4');
+  const client = dgram.createSocket('udp4');
+
+  receiver.on('message', common.mustCall((buf) => {
+    if (buf.toString() === 'b') {
+      receiver.close();
+      client.close();
+    }
+  }, 2));
+
+  receiver.bind(0, common.mustCall(() => {
+    client.sendBatch(['a', 'b'], receiver.address().port);
+  }));
+}
+
+{
+  const client = dgram.createSocket('udp4');
+
+  common.expectsError(() => client.sendBatch('hello', 1234), {
+    code: 'ERR_INVALID_ARG_TYPE',
+    type: TypeError
+  });
+
+  common.expectsError(() => client.sendBatch([{}], 1234), {
+    code: 'ERR_INVALID_ARG_TYPE',
+    type: TypeError
+  });
+
+  common.expectsError(() => client.sendBatch(['hello'], 0), {
+    code: 'ERR_SOCKET_BAD_PORT',
+    type: RangeError
+  });
+
+  client.close();
+}
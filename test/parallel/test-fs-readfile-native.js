@@ -0,0 +1,85 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+const { pathToFileURL } = require('url');
+const tmpdir = require('../common/tmpdir');
+
+// fs.readFile() and fs.promises.readFile() read a file by path in one
+// threadpool job. Check the result for a range of sizes and encodings and
+// that errors still look like the ones from the individual calls.
+
+tmpdir.refresh();
+
+const data = Buffer.allocUnsafe(200 * 1024);
+for (let i = 0; i < data.length; i++)
+  data[i] = (i * 7 + 3) & 0xff;
+
+for (const size of [0, 1, 4095, 65536, 65537, data.length]) {
+  const file = path.join(tmpdir.path, `native-${size}.bin`);
+  const expected = data.slice(0, size);
+  fs.writeFileSync(file, expected);
+
+  fs.readFile(file, common.mustCall((err, buf) => {
+    assert.ifError(err);
+    assert.deepStrictEqual(buf, expected);
+  }));
+
+  fs.readFile(pathToFileURL(file), common.mustCall((err, buf) => {
+    assert.ifError(err);
+    assert.deepStrictEqual(buf, expected);
+  }));
+
+  for (const encoding of ['hex', 'base64', 'latin1', 'utf8']) {
+    fs.readFile(file, encoding, common.mustCall((err, str) => {
+      assert.ifError(err);
+      assert.strictEqual(str, expected.toString(encoding));
+    }));
+  }
+
+  fs.promises.readFile(file).then(common.mustCall((buf) => {
+    assert.deepStrictEqual(buf, expected);
+  }));
+
+  fs.promises.readFile(file, 'hex').then(common.mustCall((str) => {
+    assert.strictEqual(str, expected.toString('hex'));
+  }));
+}
+
+// Errors from open() carry the path.
+{
+  const file = path.join(tmpdir.path, 'does-not-exist');
+  const expected = {
+    code: 'ENOENT',
+    syscall: 'open',
+    path: file
+  };
+
+  fs.readFile(file, common.mustCall((err, buf) => {
+    common.expectsError(expected)(err);
+    assert.strictEqual(buf, undefined);
+  }));
+
+  assert.rejects(fs.promises.readFile(file), expected)
+    .then(common.mustCall());
+}
+
+// Errors from read() do not.
+if (!common.isWindows && !common.isAIX) {
+  fs.readFile(tmpdir.path, common.mustCall((err) => {
+    assert.strictEqual(err.code, 'EISDIR');
+    assert.strictEqual(err.syscall, 'read');
+    assert.strictEqual(err.path, undefined);
+  }));
+}
+
+// The flag is honoured.
+{
+  const file = path.join(tmpdir.path, 'created-by-flag');
+  fs.readFile(file, { flag: 'a+' }, common.mustCall((err, buf) => {
+    assert.ifError(err);
+    assert.strictEqual(buf.length, 0);
+    assert(fs.existsSync(file));
+  }));
+}
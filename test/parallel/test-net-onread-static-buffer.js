@@ -0,0 +1,132 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const net = require('net');
+
+const message = Buffer.from('hello world');
+
+// Test typical usage
+net.createServer(common.mustCall(function(socket) {
+  this.close();
+  socket.end(message);
+})).listen(0, function() {
+  let received = 0;
+  const buffers = [];
+  const sockBuf = Buffer.alloc(8);
+  net.connect({
+    port: this.address().port,
+    onread: {
+      buffer: sockBuf,
+      callback: function(nread, buf) {
+        assert.strictEqual(buf, sockBuf);
+        received += nread;
+        buffers.push(Buffer.from(buf.slice(0, nread)));
+      }
+    }
+  }).on('data', common.mustNotCall()).on('end', common.mustCall(() => {
+    assert.strictEqual(received, message.length);
+    assert.deepStrictEqual(Buffer.concat(buffers), message);
+  }));
+});
+
+// Test Uint8Array support
+net.createServer(common.mustCall(function(socket) {
+  this.close();
+  socket.end(message);
+})).listen(0, function() {
+  let incoming = new Uint8Array(0);
+  const sockBuf = new Uint8Array(8);
+  net.connect({
+    port: this.address().port,
+    onread: {
+      buffer: sockBuf,
+      callback: function(nread, buf) {
+        assert.strictEqual(buf, sockBuf);
+        const newIncoming = new Uint8Array(incoming.length + nread);
+        newIncoming.set(incoming);
+        newIncoming.set(buf.slice(0, nread), incoming.length);
+        incoming = newIncoming;
+      }
+    }
+  }).on('data', common.mustNotCall()).on('end', common.mustCall(() => {
+    assert.deepStrictEqual(Buffer.from(incoming), message);
+  }));
+});
+
+// Test a ring of buffers handed out by a function
+net.createServer(common.mustCall(function(socket) {
+  this.close();
+  socket.end(message);
+})).listen(0, function() {
+  const ring = [Buffer.alloc(4), Buffer.alloc(4), Buffer.alloc(4)];
+  let next = 0;
+  let expected = null;
+  const buffers = [];
+  net.connect({
+    port: this.address().port,
+    onread: {
+      buffer: common.mustCallAtLeast(() => {
+        expected = ring[next++ % ring.length];
+        return expected;
+      }),
+      callback: function(nread, buf) {
+        assert.strictEqual(buf, expected);
+        buffers.push(Buffer.from(buf.slice(0, nread)));
+      }
+    }
+  }).on('data', common.mustNotCall()).on('end', common.mustCall(() => {
+    assert.deepStrictEqual(Buffer.concat(buffers), message);
+    assert(next > 1);
+  }));
+});
+
+// Test that returning false from the callback stops reading until resume()
+net.createServer(common.mustCall(function(socket) {
+  this.close();
+  socket.write('a');
+  setTimeout(() => socket.end('b'), common.platformTimeout(10));
+})).listen(0, function() {
+  const chunks = [];
+  const client = net.connect({
+    port: this.address().port,
+    onread: {
+      buffer: Buffer.alloc(16),
+      callback: common.mustCall(function(nread, buf) {
+        chunks.push(buf.toString('latin1', 0, nread));
+        if (chunks.length === 1) {
+          setTimeout(() => {
+            assert.deepStrictEqual(chunks, ['a']);
+            client.resume();
+          }, common.platformTimeout(50));
+          return false;
+        }
+      }, 2)
+    }
+  });
+  client.on('data', common.mustNotCall());
+  client.on('end', common.mustCall(() => {
+    assert.deepStrictEqual(chunks, ['a', 'b']);
+  }));
+});
+
+// Test that empty buffers are rejected, since nothing could be read into them
+{
+  const expectedError = {
+    code: 'ERR_INVALID_ARG_VALUE',
+    type: TypeError
+  };
+  common.expectsError(() => net.connect({
+    port: common.PORT,
+    onread: {
+      buffer: Buffer.alloc(0),
+      callback: common.mustNotCall()
+    }
+  }), expectedError);
+  common.expectsError(() => net.connect({
+    port: common.PORT,
+    onread: {
+      buffer: () => new Uint8Array(0),
+      callback: common.mustNotCall()
+    }
+  }), expectedError);
+}
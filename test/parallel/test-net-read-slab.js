@@ -0,0 +1,47 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const net = require('net');
+
+// Socket reads are carved out of shared slabs. Data handed to JS must stay
+// intact while later reads, from the same or other sockets, land next to it.
+
+const kSockets = 4;
+const kWrites = 200;
+
+function payload(id, i) {
+  return Buffer.alloc(1 + (i * 37 + id * 101) % 3000, `${id}:${i};`);
+}
+
+const server = net.createServer(common.mustCall((socket) => {
+  socket.once('data', common.mustCall((data) => {
+    const id = Number(data.toString());
+    let i = 0;
+    (function write() {
+      while (i < kWrites) {
+        if (!socket.write(payload(id, i++)))
+          return socket.once('drain', write);
+      }
+      socket.end();
+    })();
+  }));
+}, kSockets));
+
+server.listen(0, common.mustCall(() => {
+  let pending = kSockets;
+  for (let id = 0; id < kSockets; id++) {
+    const chunks = [];
+    const client = net.connect(server.address().port, () => {
+      client.write(String(id));
+    });
+    client.on('data', (chunk) => chunks.push(chunk));
+    client.on('end', common.mustCall(() => {
+      const expected = [];
+      for (let i = 0; i < kWrites; i++)
+        expected.push(payload(id, i));
+      assert.deepStrictEqual(Buffer.concat(chunks), Buffer.concat(expected));
+      if (--pending === 0)
+        server.close();
+    }));
+  }
+}));
@@ -0,0 +1,30 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const net = require('net');
+
+if (!common.isLinux && !common.isFreeBSD)
+  common.skip('SO_REUSEPORT load balancing is not supported on this platform');
+
+const host = common.localhostIPv4;
+const server1 = net.createServer(common.mustNotCall());
+const server2 = net.createServer(common.mustNotCall());
+const server3 = net.createServer(common.mustNotCall());
+
+server1.listen({ port: 0, host, reusePort: true }, common.mustCall(() => {
+  const { port } = server1.address();
+
+  // A second socket that opts in shares the port.
+  server2.listen({ port, host, reusePort: true }, common.mustCall(() => {
+    assert.strictEqual(server2.address().port, port);
+
+    // One that doesn't opt in can't join the group.
+    server3.listen({ port, host }, common.mustNotCall());
+  }));
+}));
+
+server3.on('error', common.mustCall((err) => {
+  assert.strictEqual(err.code, 'EADDRINUSE');
+  server1.close();
+  server2.close();
+}));
@@ -0,0 +1,96 @@
+'use strict';
+
+// socket.sendFile() sends a file after anything written before and ends the
+// socket. On Linux, StreamPipe hands the file to the socket with sendfile(2),
+// so most of it never passes through the socket's own writes.
+
+const common = require('../common');
+const assert = require('assert');
+const fs = require('fs');
+const net = require('net');
+const path = require('path');
+
+const tmpdir = require('../common/tmpdir');
+tmpdir.refresh();
+
+const file = path.join(tmpdir.path, 'socket-send-file.bin');
+const content = Buffer.alloc(4 * 1024 * 1024);
+for (let i = 0; i < content.length; i += 4)
+  content.writeUInt32LE(i, i);
+fs.writeFileSync(file, content);
+
+const header = Buffer.from('header\n');
+const offset = 1024;
+const length = content.length - 2048;
+const expected = Buffer.concat([
+  header,
+  content.slice(offset, offset + length)
+]);
+
+function receive(socket, expected, cb) {
+  const chunks = [];
+  socket.on('data', (chunk) => chunks.push(chunk));
+  socket.on('end', common.mustCall(() => {
+    assert(Buffer.concat(chunks).equals(expected));
+    socket.end();
+    cb();
+  }));
+}
+
+// From a server, after a write that is still pending.
+{
+  const server = net.createServer(common.mustCall((socket) => {
+    const fd = fs.openSync(file, 'r');
+    socket.resume();
+    socket.write(header);
+    socket.sendFile(fd, { offset, length }, common.mustCall(() => {
+      const written = socket._handle.bytesWritten;
+      if (common.isLinux)
+        assert(written < expected.length, `${written}`);
+      else
+        assert.strictEqual(written, expected.length);
+      // The fd is left open.
+      fs.closeSync(fd);
+    }));
+  }));
+
+  server.listen(0, common.mustCall(() => {
+    const client = net.connect(server.address().port);
+    receive(client, expected, common.mustCall(() => server.close()));
+  }));
+}
+
+// From a client that is still connecting, with the default options.
+{
+  const server = net.createServer(common.mustCall((socket) => {
+    receive(socket, content, common.mustCall(() => server.close()));
+  }));
+
+  server.listen(0, common.mustCall(() => {
+    const fd = fs.openSync(file, 'r');
+    const client = net.connect(server.address().port);
+    assert.strictEqual(client.sendFile(fd, common.mustCall(() => {
+      fs.closeSync(fd);
+    })), client);
+    client.resume();
+  }));
+}
+
+{
+  const socket = new net.Socket();
+  assert.throws(() => socket.sendFile('1'), {
+    code: 'ERR_INVALID_ARG_TYPE'
+  });
+  assert.throws(() => socket.sendFile(-1), {
+    code: 'ERR_OUT_OF_RANGE'
+  });
+  assert.throws(() => socket.sendFile(0, null), {
+    code: 'ERR_INVALID_ARG_TYPE'
+  });
+  assert.throws(() => socket.sendFile(0, { offset: '1' }), {
+    code: 'ERR_INVALID_OPT_VALUE'
+  });
+  assert.throws(() => socket.sendFile(0, { length: '1' }), {
+    code: 'ERR_INVALID_OPT_VALUE'
+  });
+}
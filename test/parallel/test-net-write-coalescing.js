@@ -0,0 +1,82 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const async_hooks = require('async_hooks');
+const net = require('net');
+
+// Small writes to a TCP socket within one tick are sent together. Check that
+// this saves write requests, that data still arrives in order, mixed with
+// large writes and strings, and that write callbacks run in order.
+
+function run(noDelay, done) {
+  const expected = [];
+  const server = net.createServer(common.mustCall((socket) => {
+    const chunks = [];
+    socket.on('data', (chunk) => chunks.push(chunk));
+    socket.on('end', common.mustCall(() => {
+      assert.deepStrictEqual(Buffer.concat(chunks), Buffer.concat(expected));
+      server.close();
+      done();
+    }));
+  }));
+
+  server.listen(0, common.mustCall(() => {
+    const client = net.connect(server.address().port, common.mustCall(() => {
+      if (noDelay)
+        client.setNoDelay(true);
+
+      const order = [];
+      let n = 0;
+      function write(data, encoding, cb) {
+        const i = n++;
+        expected.push(Buffer.from(data, encoding));
+        client.write(data, encoding, common.mustCall((err) => {
+          assert.ifError(err);
+          order.push(i);
+          if (cb)
+            cb();
+        }));
+      }
+
+      // The first small write is held back until the check phase, and the
+      // Writable buffers the others until it has completed. Together they
+      // take two write requests instead of one each.
+      let writeWraps = 0;
+      const hook = async_hooks.createHook({
+        init(id, type) {
+          if (type === 'WRITEWRAP')
+            writeWraps++;
+        }
+      }).enable();
+      for (let i = 0; i < 99; i++)
+        write(`small ${i}\n`, 'latin1');
+      write('small 99\n', 'latin1', common.mustCall(() => {
+        hook.disable();
+        assert.strictEqual(writeWraps, noDelay ? 100 : 2);
+        writeMany();
+      }));
+      assert.strictEqual(client._handle.writeQueueSize,
+                         noDelay ? 0 : 'small 0\n'.length);
+      setImmediate(common.mustCall(() => {
+        assert.strictEqual(client._handle.writeQueueSize, 0);
+      }));
+
+      function writeMany() {
+        for (let i = 0; i < 100; i++) {
+          write(`line ${i}\r\n`, 'latin1');
+          write(Buffer.from([i, i + 1, i + 2]));
+          if (i % 25 === 0)
+            write(Buffer.alloc(100 * 1024, i));
+          if (i % 10 === 0)
+            write('\u20ac'.repeat(i), 'utf8');
+        }
+
+        client.end(common.mustCall(() => {
+          assert.deepStrictEqual(order, [...Array(n).keys()]);
+        }));
+      }
+    }));
+  }));
+}
+
+run(false, common.mustCall(() => run(true, common.mustCall())));
@@ -0,0 +1,53 @@
+// Flags: --expose-internals
+'use strict';
+
+// Pipes a FileHandle into a TCP socket with the native StreamPipe. On Linux
+// this takes the sendfile(2) path; the file is large enough for the socket
+// to fill up, which exercises the fallback to buffered writes as well.
+
+const common = require('../common');
+const assert = require('assert');
+const fs = require('fs');
+const net = require('net');
+const path = require('path');
+const { internalBinding } = require('internal/test/binding');
+const { FileHandle } = internalBinding('fs');
+const { StreamPipe } = internalBinding('stream_pipe');
+
+const tmpdir = require('../common/tmpdir');
+tmpdir.refresh();
+
+const file = path.join(tmpdir.path, 'stream-pipe-sendfile.bin');
+const content = Buffer.alloc(8 * 1024 * 1024);
+for (let i = 0; i < content.length; i += 4)
+  content.writeUInt32LE(i, i);
+fs.writeFileSync(file, content);
+
+// Skip the first kilobyte to check that the read position is honored.
+const offset = 1024;
+const expected = content.slice(offset);
+
+const server = net.createServer(common.mustCall((socket) => {
+  const fd = fs.openSync(file, 'r');
+  const handle = new FileHandle(fd, offset, expected.length);
+  handle.onread = common.mustCall();
+
+  const pipe = new StreamPipe(handle, socket._handle);
+  pipe.onunpipe = common.mustCall(function() {
+    this.source.close().then(common.mustCall());
+    // All data is in the kernel's send buffer by now.
+    socket.destroy();
+  });
+  pipe.start();
+}));
+
+server.listen(0, common.mustCall(() => {
+  const client = net.connect(server.address().port);
+  const chunks = [];
+  client.on('data', (chunk) => chunks.push(chunk));
+  client.on('end', common.mustCall(() => {
+    assert(Buffer.concat(chunks).equals(expected));
+    client.end();
+    server.close();
+  }));
+}));
@@ -0,0 +1,92 @@
+'use strict';
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+
+const assert = require('assert');
+const { fork } = require('child_process');
+const crypto = require('crypto');
+const tls = require('tls');
+const fixtures = require('../common/fixtures');
+
+// Servers that sign their handshakes on the threadpool complete them like
+// any other server, with RSA and EC keys, with and without SNICallback.
+// The test runs with a single threadpool thread, which each connection
+// occupies with a slow pbkdf2() before the handshake starts. The handshake
+// can only complete after it, because the signature waits for the thread.
+
+if (process.argv[2] !== 'child') {
+  const env = { ...process.env, UV_THREADPOOL_SIZE: '1' };
+  fork(__filename, ['child'], { env }).on('exit', common.mustCall((code) => {
+    assert.strictEqual(code, 0);
+  }));
+  return;
+}
+
+const keys = [
+  { key: fixtures.readKey('agent2-key.pem'),
+    cert: fixtures.readKey('agent2-cert.pem') },
+  { key: fixtures.readKey('ec-key.pem'),
+    cert: fixtures.readKey('ec-cert.pem') },
+];
+
+function test(credentials, version, useSNICallback, next) {
+  const options = {
+    ...credentials,
+    asyncPrivateKey: true,
+    maxVersion: version
+  };
+  if (useSNICallback) {
+    const context = tls.createSecureContext(options);
+    options.SNICallback = common.mustCall((servername, callback) => {
+      assert.strictEqual(servername, 'example.com');
+      setImmediate(callback, null, context);
+    });
+  }
+
+  let blocked = false;
+  const server = tls.createServer(options, common.mustCall((socket) => {
+    assert.strictEqual(blocked, false);
+    assert.strictEqual(socket.getProtocol(), version);
+    socket.pipe(socket);
+  }));
+  // The client has resolved the address by now, so blocking the threadpool
+  // only holds up the server.
+  server.on('connection', common.mustCall(() => {
+    blocked = true;
+    crypto.pbkdf2('password', 'salt', 200000, 64, 'sha512',
+                  common.mustCall(() => blocked = false));
+  }));
+
+  server.listen(0, common.mustCall(() => {
+    const client = tls.connect({
+      port: server.address().port,
+      servername: 'example.com',
+      rejectUnauthorized: false
+    }, common.mustCall(() => {
+      client.end('hello');
+    }));
+
+    let data = '';
+    client.setEncoding('utf8');
+    client.on('data', (chunk) => data += chunk);
+    client.on('end', common.mustCall(() => {
+      assert.strictEqual(data, 'hello');
+      server.close(next);
+    }));
+  }));
+}
+
+const cases = [];
+for (const credentials of keys) {
+  for (const version of ['TLSv1.2', 'TLSv1.3']) {
+    cases.push([credentials, version, false]);
+    cases.push([credentials, version, true]);
+  }
+}
+
+(function next() {
+  const args = cases.shift();
+  if (args !== undefined)
+    test(...args, common.mustCall(next));
+})();
@@ -0,0 +1,97 @@
+'use strict';
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+
+const assert = require('assert');
+const fs = require('fs');
+const os = require('os');
+const tls = require('tls');
+const fixtures = require('../common/fixtures');
+
+// With enableKernelTLS, data has to arrive intact in both directions whether
+// or not the kernel could take over the encryption, and the connection has to
+// end cleanly.
+
+// Linux 5.11 supports all of the cipher suites below. Whether the kernel
+// takes over is only checked if the tls module is loaded, because it might
+// be missing otherwise.
+function kernelTLSAvailable() {
+  if (!common.isLinux)
+    return false;
+  const [major, minor] = os.release().split('.').map(Number);
+  if (major < 5 || (major === 5 && minor < 11))
+    return false;
+  try {
+    return fs.readFileSync('/proc/sys/net/ipv4/tcp_available_ulp', 'latin1')
+      .split(/\s+/).includes('tls');
+  } catch {
+    return false;
+  }
+}
+
+const kernelTLS = kernelTLSAvailable();
+if (!kernelTLS)
+  common.printSkipMessage('kernel TLS is not available, only checking data');
+
+function checkKernelTLS(socket) {
+  if (kernelTLS)
+    assert.strictEqual(socket._handle.isKernelTLS(), true);
+}
+
+const message = Buffer.alloc(256 * 1024);
+for (let i = 0; i < message.length; i++)
+  message[i] = i % 251;
+
+function test(version, ciphers, next) {
+  const server = tls.createServer({
+    key: fixtures.readKey('agent2-key.pem'),
+    cert: fixtures.readKey('agent2-cert.pem'),
+    minVersion: version,
+    maxVersion: version,
+    ciphers,
+    enableKernelTLS: true
+  }, common.mustCall((socket) => {
+    // Echo the message once it is complete. The close_notify alert must not
+    // overtake the data.
+    const chunks = [];
+    let length = 0;
+    socket.on('data', (chunk) => {
+      chunks.push(chunk);
+      length += chunk.length;
+      if (length < message.length)
+        return;
+      const received = Buffer.concat(chunks);
+      assert.deepStrictEqual(received, message);
+      checkKernelTLS(socket);
+      socket.write(received.slice(0, 1000));
+      socket.end(received.slice(1000));
+    });
+    socket.on('end', common.mustCall());
+  }));
+
+  server.listen(0, common.mustCall(() => {
+    const client = tls.connect({
+      port: server.address().port,
+      rejectUnauthorized: false,
+      enableKernelTLS: true
+    }, common.mustCall(() => {
+      assert.strictEqual(client.getProtocol(), version);
+      // Not end(), the kernel only takes over before the shutdown.
+      client.write(message);
+    }));
+    const chunks = [];
+    client.on('data', (chunk) => chunks.push(chunk));
+    client.on('end', common.mustCall(() => {
+      assert.deepStrictEqual(Buffer.concat(chunks), message);
+      checkKernelTLS(client);
+      server.close(next);
+    }));
+  }));
+}
+
+test('TLSv1.2', 'ECDHE-RSA-AES128-GCM-SHA256', common.mustCall(() => {
+  test('TLSv1.2', 'ECDHE-RSA-CHACHA20-POLY1305', common.mustCall(() => {
+    test('TLSv1.3', 'TLS_AES_256_GCM_SHA384', common.mustCall());
+  }));
+}));
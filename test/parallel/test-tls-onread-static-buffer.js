@@ -0,0 +1,51 @@
+'use strict';
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+
+const assert = require('assert');
+const tls = require('tls');
+const fixtures = require('../common/fixtures');
+
+// Decrypted data is read into the user-supplied buffer, chunk by chunk.
+
+const options = {
+  key: fixtures.readKey('agent2-key.pem'),
+  cert: fixtures.readKey('agent2-cert.pem')
+};
+
+const message = Buffer.alloc(100 * 1024, 'hello tls ');
+
+const server = tls.createServer(options, common.mustCall((socket) => {
+  socket.end(message);
+})).listen(0, common.mustCall(() => {
+  const sockBuf = Buffer.alloc(1000);
+  const buffers = [];
+  tls.connect({
+    port: server.address().port,
+    rejectUnauthorized: false,
+    onread: {
+      buffer: sockBuf,
+      callback: common.mustCallAtLeast((nread, buf) => {
+        assert.strictEqual(buf, sockBuf);
+        assert(nread > 0 && nread <= sockBuf.length);
+        buffers.push(Buffer.from(buf.slice(0, nread)));
+      })
+    }
+  }).on('data', common.mustNotCall()).on('end', common.mustCall(() => {
+    assert.deepStrictEqual(Buffer.concat(buffers), message);
+    server.close();
+  }));
+}));
+
+// Empty buffers are rejected rather than read into forever.
+common.expectsError(() => tls.connect({
+  port: common.PORT,
+  onread: {
+    buffer: Buffer.alloc(0),
+    callback: common.mustNotCall()
+  }
+}), {
+  code: 'ERR_INVALID_ARG_VALUE',
+  type: TypeError
+});
@@ -0,0 +1,91 @@
+'use strict';
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+
+const assert = require('assert');
+const tls = require('tls');
+const fixtures = require('../common/fixtures');
+const { SSL_OP_NO_TICKET } = require('crypto').constants;
+
+// Two servers that use the same session cache can resume each other's
+// sessions, both from session identifiers and from session tickets.
+
+const key = fixtures.readKey('agent2-key.pem');
+const cert = fixtures.readKey('agent2-cert.pem');
+
+assert.strictEqual(tls.getSessionCacheStats('test-shared'), undefined);
+
+assert.throws(() => tls.createSecureContext({ sessionCache: 42 }), {
+  code: 'ERR_INVALID_ARG_TYPE'
+});
+assert.throws(() => tls.createSecureContext({ sessionCache: {} }), {
+  code: 'ERR_INVALID_ARG_TYPE'
+});
+
+function createServer(secureOptions) {
+  return tls.createServer({
+    key,
+    cert,
+    secureOptions,
+    sessionCache: { name: 'test-shared', maxEntries: 100 }
+  }, (socket) => socket.end());
+}
+
+function connect(server, options, callback) {
+  server.listen(0, common.mustCall(() => {
+    let session;
+    const client = tls.connect({
+      port: server.address().port,
+      rejectUnauthorized: false,
+      ...options
+    }, common.mustCall(() => {
+      const reused = client.isSessionReused();
+      client.on('close', common.mustCall(() => {
+        server.close();
+        callback(reused, session);
+      }));
+      client.resume();
+    }));
+    client.on('session', (newSession) => {
+      if (session === undefined)
+        session = newSession;
+    });
+  }));
+}
+
+function test(version, secureOptions, next) {
+  const options = { maxVersion: version };
+  const first = createServer(secureOptions);
+  connect(first, options, common.mustCall((reused, session) => {
+    assert.strictEqual(reused, false);
+    const second = createServer(secureOptions);
+    connect(second, { ...options, session }, common.mustCall((reused) => {
+      assert.strictEqual(reused, true);
+      next();
+    }));
+  }));
+}
+
+test('TLSv1.2', SSL_OP_NO_TICKET, common.mustCall(() => {
+  const stats = tls.getSessionCacheStats('test-shared');
+  assert.strictEqual(stats.size, 1);
+  assert.strictEqual(stats.hits, 1);
+  assert.strictEqual(stats.ticketHits, 0);
+
+  // An existing cache can only be shared with the parameters it has.
+  for (const sessionCache of ['test-shared',
+                              { name: 'test-shared', maxEntries: 200 },
+                              { name: 'test-shared', maxEntries: 100,
+                                ticketKeyRotation: 60 }]) {
+    assert.throws(() => tls.createSecureContext({ key, cert, sessionCache }), {
+      code: 'ERR_INVALID_ARG_VALUE'
+    });
+  }
+
+  test('TLSv1.3', 0, common.mustCall(() => {
+    const stats = tls.getSessionCacheStats('test-shared');
+    assert.strictEqual(stats.hits, 1);
+    assert(stats.ticketHits >= 1);
+  }));
+}));
@@ -0,0 +1,51 @@
+// Flags: --message-port-batch-size=10
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const { MessageChannel, Worker } = require('worker_threads');
+
+// A port emits at most --message-port-batch-size messages at once and lets
+// the event loop run in between, without losing or reordering messages.
+
+const expected = Array.from({ length: 100 }, (_, i) => i);
+
+{
+  const { port1, port2 } = new MessageChannel();
+  const received = [];
+  const seenByImmediates = [];
+
+  port2.on('message', common.mustCall((i) => {
+    received.push(i);
+    if (received.length === expected.length) {
+      assert.deepStrictEqual(received, expected);
+      port2.close();
+    }
+  }, expected.length));
+  for (const i of expected)
+    port1.postMessage(i);
+
+  setImmediate(function check() {
+    seenByImmediates.push(received.length);
+    if (received.length < expected.length)
+      setImmediate(check);
+  });
+
+  process.on('exit', () => {
+    assert(seenByImmediates.some((n) => n > 0 && n < expected.length),
+           `${seenByImmediates}`);
+  });
+}
+
+// All messages of a Worker that exits are emitted.
+{
+  const w = new Worker(`
+    const { parentPort } = require('worker_threads');
+    for (let i = 0; i < 100; i++)
+      parentPort.postMessage(i);
+  `, { eval: true });
+  const received = [];
+  w.on('message', (i) => received.push(i));
+  w.on('exit', common.mustCall(() => {
+    assert.deepStrictEqual(received, expected);
+  }));
+}
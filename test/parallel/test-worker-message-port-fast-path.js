@@ -0,0 +1,93 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const { MessageChannel } = require('worker_threads');
+
+// Primitive values, and large ArrayBuffers that are posted directly or through
+// a view, are cloned without going through V8's serializer. The result must be
+// the same as with it.
+
+const large = new ArrayBuffer(256 * 1024);
+new Uint8Array(large).forEach((_, i, array) => array[i] = i % 251);
+
+const values = [
+  undefined,
+  null,
+  true,
+  false,
+  0,
+  -0,
+  NaN,
+  Infinity,
+  -1.5,
+  2 ** 53,
+  '',
+  'plain ascii',
+  'latin-1 éÿ',
+  'two-byte ☃ 😀',
+  'x'.repeat(100000),
+  { nested: ['objects', 1, null] },
+  [1, 'two', 3],
+  large,
+  new Uint8Array(large, 1000, 5000),
+  new Float64Array(large, 8, 10),
+  new DataView(large, 3, 100),
+  Buffer.from(large, 10, 10),
+  new Uint8Array(1024)
+];
+
+{
+  const { port1, port2 } = new MessageChannel();
+  const received = [];
+  port2.on('message', common.mustCall((value) => {
+    received.push(value);
+    if (received.length === values.length) {
+      port2.close();
+      values.forEach((value, i) => {
+        assert.deepStrictEqual(received[i], value);
+        assert(Object.is(received[i], value) || typeof value === 'object');
+      });
+
+      // Views get a copy of the whole underlying buffer, at the same offset.
+      assert.strictEqual(received[18].buffer.byteLength, large.byteLength);
+      assert.strictEqual(received[18].byteOffset, 1000);
+      assert.strictEqual(received[21].byteOffset, 10);
+      assert.strictEqual(received[22].byteLength, 1024);
+    }
+  }, values.length));
+
+  for (const value of values)
+    port1.postMessage(value);
+
+  // Modifying the data after posting it does not change what is received.
+  const copy = large.slice(0);
+  new Uint8Array(large).fill(0);
+  values[17] = copy;
+  values[18] = new Uint8Array(copy, 1000, 5000);
+  values[19] = new Float64Array(copy, 8, 10);
+  values[20] = new DataView(copy, 3, 100);
+  // Buffers are received as plain Uint8Arrays.
+  values[21] = new Uint8Array(copy, 10, 10);
+}
+
+// Transfer lists still apply to primitive values and large buffers.
+{
+  const { port1, port2 } = new MessageChannel();
+  const transferred = new ArrayBuffer(128 * 1024);
+  const { port1: transferredPort } = new MessageChannel();
+  port2.on('message', common.mustCall((value) => {
+    if (typeof value === 'object') {
+      assert.strictEqual(value.byteLength, 128 * 1024);
+      port2.close();
+    } else {
+      assert.strictEqual(value, 42);
+    }
+  }, 2));
+  port1.postMessage(42, [transferredPort]);
+  port1.postMessage(transferred, [transferred]);
+  assert.strictEqual(transferred.byteLength, 0);
+
+  assert.throws(() => port1.postMessage('x', [port1]), {
+    name: 'DataCloneError'
+  });
+}
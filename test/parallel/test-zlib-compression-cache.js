@@ -0,0 +1,137 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const zlib = require('zlib');
+const { Worker } = require('worker_threads');
+
+// The convenience methods return cached output for inputs that were
+// compressed with the same options and the `cache` option before.
+
+const input = Buffer.from('{"hello":"world"}'.repeat(100));
+
+function statsDelta(before) {
+  const after = zlib.getCompressionCacheStats();
+  return {
+    hits: after.hits - before.hits,
+    misses: after.misses - before.misses
+  };
+}
+
+{
+  const before = zlib.getCompressionCacheStats();
+  const first = zlib.gzipSync(input, { cache: true });
+  const second = zlib.gzipSync(input, { cache: true });
+  assert.deepStrictEqual(first, zlib.gzipSync(input));
+  assert.deepStrictEqual(second, first);
+  assert.deepStrictEqual(statsDelta(before), { hits: 1, misses: 1 });
+
+  // Every hit returns a new Buffer.
+  second.fill(0);
+  assert.deepStrictEqual(zlib.gzipSync(input, { cache: true }), first);
+}
+
+// The options and the whole input are part of the key.
+{
+  const before = zlib.getCompressionCacheStats();
+  const other = Buffer.from(input);
+  other[other.length - 1] = 0x20;
+  zlib.gzipSync(other, { cache: true });
+  zlib.gzipSync(input, { cache: true, level: 1 });
+  zlib.deflateSync(input, { cache: true });
+  zlib.deflateRawSync(input, { cache: true });
+  zlib.brotliCompressSync(input, { cache: true });
+  assert.deepStrictEqual(statsDelta(before), { hits: 0, misses: 5 });
+
+  assert.deepStrictEqual(
+    zlib.brotliDecompressSync(zlib.brotliCompressSync(input, { cache: true })),
+    input);
+  assert.deepStrictEqual(
+    zlib.inflateSync(zlib.deflateSync(input.toString(), { cache: true })),
+    input);
+  assert.deepStrictEqual(
+    zlib.inflateSync(zlib.deflateSync(new Uint8Array(input), { cache: true })),
+    input);
+  assert.deepStrictEqual(statsDelta(before), { hits: 3, misses: 5 });
+}
+
+// Without the option, and for decompression, the cache is not used.
+{
+  const before = zlib.getCompressionCacheStats();
+  zlib.gzipSync(input);
+  zlib.gunzipSync(zlib.gzipSync(input), { cache: true });
+  zlib.gzipSync(input, { cache: true, info: true });
+  zlib.deflateSync(input, { cache: true, dictionary: input.slice(0, 10) });
+  assert.deepStrictEqual(statsDelta(before), { hits: 0, misses: 0 });
+}
+
+// The asynchronous methods share the cache with the synchronous ones.
+{
+  const brotliInput = Buffer.from('brotli'.repeat(1000));
+  const options = { cache: true };
+  zlib.brotliCompress(brotliInput, options, common.mustCall((err, a) => {
+    assert.ifError(err);
+    const before = zlib.getCompressionCacheStats();
+    assert.deepStrictEqual(zlib.brotliCompressSync(brotliInput, options), a);
+    zlib.gzip(input, options, common.mustCall((err, b) => {
+      assert.ifError(err);
+      assert.deepStrictEqual(b, zlib.gzipSync(input));
+      assert.deepStrictEqual(statsDelta(before), { hits: 2, misses: 0 });
+      testWorker();
+    }));
+  }));
+}
+
+// The cache is shared with Worker threads.
+function testWorker() {
+  const data = Buffer.from('shared between threads'.repeat(100));
+  const w = new Worker(`
+    const zlib = require('zlib');
+    zlib.gzipSync(Buffer.from('shared between threads'.repeat(100)),
+                  { cache: true });
+  `, { eval: true });
+  w.on('exit', common.mustCall((code) => {
+    assert.strictEqual(code, 0);
+    const before = zlib.getCompressionCacheStats();
+    zlib.gzipSync(data, { cache: true });
+    assert.deepStrictEqual(statsDelta(before), { hits: 1, misses: 0 });
+    testEviction();
+  }));
+}
+
+// The cache is limited in size.
+function testEviction() {
+  const before = zlib.getCompressionCacheStats();
+  const data = Buffer.alloc(1024 * 1024);
+  for (let i = 0; i < 20; i++) {
+    data[0] = i;
+    zlib.deflateSync(data, { cache: true, level: 0 });
+  }
+  const after = zlib.getCompressionCacheStats();
+  assert(after.evictions > before.evictions);
+  assert(after.size <= 16 * 1024 * 1024);
+  assert(after.entries > 0);
+  testModifiedInput();
+}
+
+// Changing the input while it is compressed asynchronously doesn't affect
+// what is cached for it.
+function testModifiedInput() {
+  const original = Buffer.from('modified later'.repeat(1000));
+  const data = Buffer.from(original);
+  zlib.deflate(data, { cache: true }, common.mustCall((err, output) => {
+    assert.ifError(err);
+    assert.deepStrictEqual(zlib.inflateSync(output), original);
+    assert.deepStrictEqual(zlib.deflateSync(original, { cache: true }),
+                           output);
+    assert.deepStrictEqual(zlib.inflateSync(zlib.deflateSync(data,
+                                                             { cache: true })),
+                           data);
+  }));
+  data.fill(0);
+}
+
+for (const cache of [1, 'yes', null]) {
+  assert.throws(() => zlib.gzipSync(input, { cache }), {
+    code: 'ERR_INVALID_ARG_TYPE'
+  });
+}
@@ -0,0 +1,102 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const zlib = require('zlib');
+
+// Streams that are compressed in parallel blocks decompress to their input,
+// with every combination of block boundaries, flushes and options.
+
+const data = Buffer.alloc(1024 * 1024 + 17);
+for (let i = 0; i < data.length; i++)
+  data[i] = (i * 7 + (i >> 12)) % 251 < 128 ? 97 + i % 7 : (i * 31) % 256;
+
+const formats = [
+  ['gzip', 'gzipSync', 'gunzipSync', 'createGzip'],
+  ['deflate', 'deflateSync', 'inflateSync', 'createDeflate'],
+  ['deflateRaw', 'deflateRawSync', 'inflateRawSync', 'createDeflateRaw']
+];
+
+for (const [compress, compressSync, decompressSync] of formats) {
+  for (const length of [0, 1, 32 * 1024, 128 * 1024, 128 * 1024 + 1,
+                        data.length]) {
+    const input = data.slice(0, length);
+    for (const options of [{ parallel: 1 }, { parallel: 4, level: 1 },
+                           { parallel: 3, level: 9, windowBits: 9 }]) {
+      assert.deepStrictEqual(
+        zlib[decompressSync](zlib[compressSync](input, options)), input);
+      zlib[compress](input, options, common.mustCall((err, result) => {
+        assert.ifError(err);
+        assert.deepStrictEqual(zlib[decompressSync](result), input);
+      }));
+    }
+  }
+}
+
+// The headers are the same as for regular streams.
+assert.deepStrictEqual(zlib.gzipSync('abc', { parallel: 2 }).slice(0, 10),
+                       zlib.gzipSync('abc').slice(0, 10));
+for (const options of [{ level: 1 }, { level: 9, windowBits: 10 }]) {
+  assert.deepStrictEqual(
+    zlib.deflateSync('abc', { parallel: 2, ...options }).slice(0, 2),
+    zlib.deflateSync('abc', options).slice(0, 2));
+}
+
+// Dictionaries are used for the first block.
+{
+  const dictionary = Buffer.from('abcdefg'.repeat(10));
+  const input = data.slice(0, 300 * 1024);
+  assert.deepStrictEqual(
+    zlib.inflateSync(zlib.deflateSync(input, { parallel: 2, dictionary }),
+                     { dictionary }),
+    input);
+  assert.deepStrictEqual(
+    zlib.inflateRawSync(zlib.deflateRawSync(input, { parallel: 2, dictionary }),
+                        { dictionary }),
+    input);
+  assert.throws(() => zlib.gzipSync(input, { parallel: 2, dictionary }), {
+    code: 'ERR_ZLIB_INITIALIZATION_FAILED'
+  });
+}
+
+// Streams with small writes, flushes and parameter changes.
+for (const [, , decompressSync, create] of formats) {
+  const stream = zlib[create]({ parallel: 2 });
+  const chunks = [];
+  stream.on('data', (chunk) => chunks.push(chunk));
+  stream.on('end', common.mustCall(() => {
+    assert.deepStrictEqual(zlib[decompressSync](Buffer.concat(chunks)), data);
+  }));
+
+  const flushed = 200 * 1024;
+  for (let i = 0; i < flushed; i += 1000) {
+    // The input can be reused once it has been written.
+    const chunk = Buffer.from(data.slice(i, Math.min(i + 1000, flushed)));
+    stream.write(chunk, common.mustCall(() => chunk.fill(0)));
+  }
+  stream.flush(common.mustCall(() => {
+    const output = zlib[decompressSync](Buffer.concat(chunks), {
+      finishFlush: zlib.constants.Z_SYNC_FLUSH
+    });
+    assert.deepStrictEqual(output, data.slice(0, flushed));
+    stream.params(1, zlib.constants.Z_DEFAULT_STRATEGY, common.mustCall(() => {
+      stream.end(data.slice(flushed));
+    }));
+  }));
+}
+
+// Invalid values.
+for (const parallel of [0, 129, -1]) {
+  assert.throws(() => zlib.createGzip({ parallel }), {
+    code: 'ERR_OUT_OF_RANGE'
+  });
+}
+assert.throws(() => zlib.createDeflate({ parallel: '2' }), {
+  code: 'ERR_INVALID_ARG_TYPE'
+});
+
+// Decompression and brotli streams ignore the option.
+assert.deepStrictEqual(
+  zlib.gunzipSync(zlib.gzipSync(data), { parallel: 4 }), data);
+assert.deepStrictEqual(
+  zlib.brotliDecompressSync(zlib.brotliCompressSync('abc', { parallel: 4 })),
+  Buffer.from('abc'));
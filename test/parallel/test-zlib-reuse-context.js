@@ -0,0 +1,86 @@
+// Flags: --expose-internals
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const zlib = require('zlib');
+const { internalBinding } = require('internal/test/binding');
+const { getPooledContextBytes } = internalBinding('zlib');
+
+// Compression streams hand their deflate state over to later streams with the
+// same parameters once they are closed. The output must not depend on what
+// the earlier streams did.
+
+const input = Buffer.from('Hello, hello, hello, world! '.repeat(1000));
+const dictionary = Buffer.from('Hello, world!');
+
+const cases = [
+  ['deflateSync', 'inflateSync', {}],
+  ['deflateSync', 'inflateSync', { level: 1 }],
+  ['deflateSync', 'inflateSync', { dictionary }],
+  ['gzipSync', 'gunzipSync', {}],
+  ['gzipSync', 'gunzipSync', { level: 9, memLevel: 9 }],
+  ['deflateRawSync', 'inflateRawSync', { windowBits: 9 }],
+  ['deflateRawSync', 'inflateRawSync', { dictionary }]
+];
+
+const expected = cases.map(([compress, , options]) => {
+  return zlib[compress](input, options);
+});
+
+// Every case with its own parameters left a stream in the pool, and the
+// ones after it take those over rather than adding more.
+const pooled = getPooledContextBytes();
+assert(pooled > 0);
+
+for (let i = 0; i < 3; i++) {
+  cases.forEach(([compress, decompress, options], index) => {
+    const before = getPooledContextBytes();
+    const output = zlib[compress](input, options);
+    assert.strictEqual(getPooledContextBytes(), before);
+    assert.deepStrictEqual(output, expected[index]);
+    assert.deepStrictEqual(zlib[decompress](output, options), input);
+  });
+  assert.strictEqual(getPooledContextBytes(), pooled);
+}
+
+// A stream that is still open holds on to the one it took over.
+{
+  const stream = zlib.createDeflate();
+  assert(getPooledContextBytes() < pooled);
+  stream.close();
+  assert.strictEqual(getPooledContextBytes(), pooled);
+}
+
+// Streams that were closed halfway through, or whose parameters were
+// changed, do not affect later streams either.
+{
+  const stream = zlib.createDeflate();
+  stream.write(input.slice(0, 1000), common.mustCall(() => {
+    stream.close();
+    assert.deepStrictEqual(zlib.deflateSync(input), expected[0]);
+  }));
+}
+
+{
+  const stream = zlib.createDeflate();
+  const chunks = [];
+  stream.on('data', (chunk) => chunks.push(chunk));
+  stream.write(input.slice(0, 1000));
+  stream.params(1, zlib.constants.Z_DEFAULT_STRATEGY, common.mustCall(() => {
+    stream.end(input.slice(1000));
+  }));
+  stream.on('end', common.mustCall(() => {
+    assert.deepStrictEqual(zlib.inflateSync(Buffer.concat(chunks)), input);
+    assert.deepStrictEqual(zlib.deflateSync(input), expected[0]);
+    assert.deepStrictEqual(zlib.deflateSync(input, { level: 1 }), expected[1]);
+  }));
+}
+
+zlib.gzip(input, common.mustCall((err, output) => {
+  assert.ifError(err);
+  assert.deepStrictEqual(output, expected[3]);
+  zlib.gzip(input, common.mustCall((err, output) => {
+    assert.ifError(err);
+    assert.deepStrictEqual(output, expected[3]);
+  }));
+}));
@@ -129,6 +129,14 @@ if (common.hasCrypto) { // eslint-disable-line node-core/crypto-check
       testInitialized(this, 'AsyncWrap');
     }));
   }
+
+  crypto.hash('sha256', 'x', common.mustCall(function() {
+    testInitialized(this, 'AsyncWrap');
+  }));
+
+  // Large enough to be encrypted on the threadpool.
+  crypto.createCipheriv('aes-128-cbc', Buffer.alloc(16), Buffer.alloc(16))
+    .update(Buffer.alloc(128 * 1024), common.mustCall());
 }
 
 
@@ -202,6 +210,14 @@ if (common.hasCrypto) { // eslint-disable-line node-core/crypto-check
   openTest().then(common.mustCall());
 }
 
+{
+  const binding = internalBinding('fs');
+  const ctx = {};
+  const handle = binding.opendir(__dirname, undefined, ctx);
+  testInitialized(handle, 'DirHandle');
+  handle.close(undefined, ctx);
+}
+
 {
   const binding = internalBinding('stream_wrap');
   testUninitialized(new binding.WriteWrap(), 'WriteWrap');